@@ -0,0 +1,94 @@
+#include "BenchWorld.hpp"
+
+#include <algorithm>
+#include <filesystem>
+
+#include <shared/utils/Utils.hpp>
+#include <shared/world/world_manager/WorldManager.hpp>
+
+namespace onion::voxel::bench
+{
+	std::shared_ptr<Chunk> BuildTerrainChunk(const glm::ivec2& position, int subChunkCount, std::mt19937& rng)
+	{
+		auto chunk = std::make_shared<Chunk>(position, subChunkCount);
+
+		const uint16_t idxBedrock = chunk->GetOrAddPaletteIndex(BlockState(BlockId::Bedrock));
+		const uint16_t idxStone = chunk->GetOrAddPaletteIndex(BlockState(BlockId::Stone));
+		const uint16_t idxDirt = chunk->GetOrAddPaletteIndex(BlockState(BlockId::Dirt));
+		const uint16_t idxGrass = chunk->GetOrAddPaletteIndex(BlockState(BlockId::GrassBlock));
+		const uint16_t idxWater = chunk->GetOrAddPaletteIndex(BlockState(BlockId::Water));
+		const uint16_t idxOre = chunk->GetOrAddPaletteIndex(BlockState(BlockId::CoalOre));
+
+		std::uniform_int_distribution<int> heightDelta(-1, 1);
+		std::uniform_int_distribution<int> oreChance(0, 63);
+
+		constexpr int SEA_LEVEL = 100;
+		int height = 96;
+
+		for (int z = 0; z < WorldConstants::CHUNK_SIZE; z++)
+		{
+			for (int x = 0; x < WorldConstants::CHUNK_SIZE; x++)
+			{
+				height = std::clamp(height + heightDelta(rng), 80, 120);
+
+				chunk->FillColumn_Unsafe((uint8_t) x, 0, 0, (uint8_t) z, idxBedrock);
+				chunk->FillColumn_Unsafe((uint8_t) x, 1, (uint16_t) (height - 4), (uint8_t) z, idxStone);
+				chunk->FillColumn_Unsafe((uint8_t) x, (uint16_t) (height - 3), (uint16_t) (height - 1), (uint8_t) z,
+										 idxDirt);
+				chunk->FillColumn_Unsafe((uint8_t) x, (uint16_t) height, (uint16_t) height, (uint8_t) z, idxGrass);
+
+				if (height < SEA_LEVEL)
+					chunk->FillColumn_Unsafe((uint8_t) x, (uint16_t) (height + 1), SEA_LEVEL, (uint8_t) z, idxWater);
+
+				for (int y = 1; y < height - 4; y++)
+				{
+					if (oreChance(rng) == 0)
+						chunk->FillColumn_Unsafe((uint8_t) x, (uint16_t) y, (uint16_t) y, (uint8_t) z, idxOre);
+				}
+			}
+		}
+
+		chunk->Optimize();
+
+		return chunk;
+	}
+
+	void BuildFlatWorld(WorldManager& worldManager, const FlatWorldSettings& settings)
+	{
+		for (int cx = 0; cx < settings.ChunkCount; cx++)
+		{
+			for (int cz = 0; cz < settings.ChunkCount; cz++)
+			{
+				auto chunk = std::make_shared<Chunk>(glm::ivec2(cx, cz), 2);
+
+				const uint16_t idxBedrock =
+					settings.HasBedrock ? chunk->GetOrAddPaletteIndex(BlockState(BlockId::Bedrock)) : 0;
+				const uint16_t idxStone = chunk->GetOrAddPaletteIndex(BlockState(BlockId::Stone));
+				const uint16_t stoneBottom = settings.HasBedrock ? 1 : 0;
+
+				for (int z = 0; z < WorldConstants::CHUNK_SIZE; z++)
+				{
+					for (int x = 0; x < WorldConstants::CHUNK_SIZE; x++)
+					{
+						if (settings.HasBedrock)
+							chunk->FillColumn_Unsafe((uint8_t) x, 0, 0, (uint8_t) z, idxBedrock);
+						chunk->FillColumn_Unsafe(
+							(uint8_t) x, stoneBottom, (uint16_t) (settings.GroundHeight - 1), (uint8_t) z, idxStone);
+
+						if (settings.DecorateColumn)
+							settings.DecorateColumn(*chunk, (uint8_t) x, (uint8_t) z);
+					}
+				}
+
+				chunk->Optimize();
+				worldManager.AddChunk(chunk);
+			}
+		}
+	}
+
+	bool HasBlockAssets()
+	{
+		const std::filesystem::path assets = Utils::GetExecutableDirectory() / "assets";
+		return std::filesystem::exists(assets / "blockstates.zip") && std::filesystem::exists(assets / "models.zip");
+	}
+} // namespace onion::voxel::bench
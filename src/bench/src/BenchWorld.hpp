@@ -0,0 +1,36 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <random>
+
+#include <shared/world/chunk/Chunk.hpp>
+
+namespace onion::voxel
+{
+	class WorldManager;
+}
+
+namespace onion::voxel::bench
+{
+	struct FlatWorldSettings
+	{
+		int ChunkCount = 2;		 // ChunkCount x ChunkCount chunks, from chunk (0, 0)
+		int GroundHeight = 64;	 // Stone up to GroundHeight - 1
+		bool HasBedrock = false; // Bedrock at y = 0, under the stone
+
+		/// Called for each column once the ground is placed, to add features on it
+		std::function<void(Chunk& chunk, uint8_t x, uint8_t z)> DecorateColumn;
+	};
+
+	/// @brief Add flat chunks of 2 subchunks to the world : a stone ground, optionally on bedrock and decorated.
+	void BuildFlatWorld(WorldManager& worldManager, const FlatWorldSettings& settings);
+
+	/// @brief Build a terrain-like chunk : stone with scattered ores, dirt and grass under a noisy surface,
+	/// water in the valleys. Gives a mix of mono, RLE and raw subchunks, like generated worlds.
+	std::shared_ptr<Chunk> BuildTerrainChunk(const glm::ivec2& position, int subChunkCount, std::mt19937& rng);
+
+	/// @brief Whether blockstates.zip and models.zip are next to the executable (copied there by the build).
+	/// Generation and raycasts resolve block models through the BlockstateRegistry, which loads them.
+	bool HasBlockAssets();
+} // namespace onion::voxel::bench
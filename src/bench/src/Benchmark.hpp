@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace onion::voxel::bench
+{
+	/// @brief Result of one measured case of a benchmark.
+	struct BenchmarkResult
+	{
+		std::string Name;
+		uint64_t Items = 0;	  // Number of processed items (chunks, bodies, ...)
+		std::string ItemUnit; // What an item is, used to print the throughput (e.g. "chunks")
+		double Seconds = 0.0; // Measured time
+
+		double GetItemsPerSecond() const { return Seconds > 0.0 ? static_cast<double>(Items) / Seconds : 0.0; }
+	};
+
+	struct Benchmark
+	{
+		std::string Name;
+		std::function<std::vector<BenchmarkResult>()> Run;
+	};
+
+	// ----- Benchmarks -----
+	std::vector<BenchmarkResult> RunBlockEditBench();
+	std::vector<BenchmarkResult> RunChunkDecodeBench();
+	std::vector<BenchmarkResult> RunChunkEncodeBench();
+	std::vector<BenchmarkResult> RunEntityStoreBench();
+	std::vector<BenchmarkResult> RunMeshBuildBench();
+	std::vector<BenchmarkResult> RunPhysicsStepBench();
+	std::vector<BenchmarkResult> RunRaycastBench();
+	std::vector<BenchmarkResult> RunTerrainCollisionBench();
+	std::vector<BenchmarkResult> RunTextureAtlasBench();
+	std::vector<BenchmarkResult> RunWorldGenerationBench();
+	std::vector<BenchmarkResult> RunWorldSaveBench();
+} // namespace onion::voxel::bench
@@ -0,0 +1,146 @@
+#include "Benchmark.hpp"
+#include "BenchWorld.hpp"
+
+#include <iostream>
+
+#include <shared/utils/Stopwatch.hpp>
+#include <shared/world/world_manager/WorldManager.hpp>
+
+namespace onion::voxel::bench
+{
+	namespace
+	{
+		constexpr int WORLD_CHUNKS = 2;
+		constexpr int GROUND_HEIGHT = 64;
+		constexpr int PASSES = 4;
+		constexpr size_t BLOCK_UPDATES_PER_TICK = 8192;
+
+		// 50 x 40 x 50 = 100k blocks, across the 4 chunks
+		constexpr glm::ivec3 SCHEMATIC_MIN{39, GROUND_HEIGHT, 39};
+		constexpr glm::ivec3 SCHEMATIC_SIZE{50, 40, 50};
+
+		// Single-block path, kept smaller
+		constexpr glm::ivec3 SINGLE_SIZE{20, 25, 20};
+
+		/// @brief Run the scheduled block updates until none is left, like consecutive server ticks.
+		size_t RunBlockUpdates(WorldManager& worldManager, size_t& ticks)
+		{
+			size_t updates = 0;
+			while (worldManager.GetPendingBlockUpdateCount() > 0)
+			{
+				updates += worldManager.ProcessBlockUpdates(BLOCK_UPDATES_PER_TICK);
+				ticks++;
+			}
+			return updates;
+		}
+
+		/// @brief A building-like schematic : walls of the pass' material, glass every other block of the walls,
+		/// a fence grid on the roof (connected states, so neighbor updates have work), air inside.
+		std::vector<Block> BuildSchematic(const glm::ivec3& min, const glm::ivec3& size, BlockId material)
+		{
+			std::vector<Block> blocks;
+			blocks.reserve(static_cast<size_t>(size.x) * size.y * size.z);
+
+			for (int y = 0; y < size.y; y++)
+			{
+				for (int z = 0; z < size.z; z++)
+				{
+					for (int x = 0; x < size.x; x++)
+					{
+						const bool isWall = x == 0 || z == 0 || x == size.x - 1 || z == size.z - 1;
+						const bool isRoof = y == size.y - 1;
+
+						BlockId id = BlockId::Air;
+						if (isRoof)
+							id = (x % 4 == 0 || z % 4 == 0) ? BlockId::DarkOakFence : BlockId::Air;
+						else if (isWall)
+							id = ((x + y + z) % 2 == 0) ? BlockId::Glass : material;
+						else if (y == 0)
+							id = material;
+
+						blocks.emplace_back(min + glm::ivec3(x, y, z), BlockState(id));
+					}
+				}
+			}
+
+			return blocks;
+		}
+	} // namespace
+
+	std::vector<BenchmarkResult> RunBlockEditBench()
+	{
+		WorldManager worldManager("", true);
+		BuildFlatWorld(worldManager, {.ChunkCount = WORLD_CHUNKS, .GroundHeight = GROUND_HEIGHT});
+
+		// Alternating the material, so every pass changes blocks
+		const std::vector<Block> schematics[2] = {
+			BuildSchematic(SCHEMATIC_MIN, SCHEMATIC_SIZE, BlockId::Cobblestone),
+			BuildSchematic(SCHEMATIC_MIN, SCHEMATIC_SIZE, BlockId::DarkOakPlanks),
+		};
+		const std::vector<Block> smallSchematics[2] = {
+			BuildSchematic(SCHEMATIC_MIN, SINGLE_SIZE, BlockId::Cobblestone),
+			BuildSchematic(SCHEMATIC_MIN, SINGLE_SIZE, BlockId::DarkOakPlanks),
+		};
+
+		std::vector<BenchmarkResult> results;
+
+		// Whole schematic in one SetBlocks call
+		{
+			size_t changed = 0;
+			size_t updates = 0;
+			size_t ticks = 0;
+			uint64_t items = 0;
+
+			Stopwatch stopwatch;
+			stopwatch.Start();
+
+			for (int pass = 0; pass < PASSES; pass++)
+			{
+				const std::vector<Block>& blocks = schematics[pass % 2];
+				changed += worldManager.SetBlocks(blocks, WorldManager::BlocksChangedEventArgs::eOrigin::Unknown);
+				updates += RunBlockUpdates(worldManager, ticks);
+				items += blocks.size();
+			}
+
+			BenchmarkResult result;
+			result.Name = "set_blocks_schematic";
+			result.Items = items;
+			result.ItemUnit = "blocks";
+			result.Seconds = stopwatch.ElapsedSeconds();
+			results.push_back(result);
+
+			std::cout << "  " << items / PASSES << " blocks per schematic, " << changed / PASSES << " changed and "
+					  << updates / PASSES << " block updates over " << ticks / PASSES << " ticks per pass, "
+					  << stopwatch.ElapsedMs() / PASSES << " ms per schematic\n";
+		}
+
+		// Same kind of edit, one SetBlock call per block
+		{
+			uint64_t items = 0;
+			size_t ticks = 0;
+
+			Stopwatch stopwatch;
+			stopwatch.Start();
+
+			for (int pass = 0; pass < PASSES; pass++)
+			{
+				for (const Block& block : smallSchematics[pass % 2])
+				{
+					worldManager.SetBlock(block, WorldManager::BlocksChangedEventArgs::eOrigin::Unknown);
+					items++;
+				}
+
+				RunBlockUpdates(worldManager, ticks);
+			}
+
+			BenchmarkResult result;
+			result.Name = "set_block_single";
+			result.Items = items;
+			result.ItemUnit = "blocks";
+			result.Seconds = stopwatch.ElapsedSeconds();
+			results.push_back(result);
+		}
+
+		return results;
+	}
+} // namespace onion::voxel::bench
@@ -0,0 +1,125 @@
+#include "Benchmark.hpp"
+#include "BenchWorld.hpp"
+
+#include <cereal/archives/binary.hpp>
+
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <streambuf>
+
+#include <shared/data_transfer_objects/serializer/SerializerDTO.hpp>
+#include <shared/network_messages/NetworkMessages.hpp>
+#include <shared/utils/Stopwatch.hpp>
+
+namespace onion::voxel::bench
+{
+	namespace
+	{
+		constexpr uint32_t SEED = 1337;
+		constexpr int CHUNK_COUNT = 64;
+		constexpr int SUBCHUNK_COUNT = 4;
+		constexpr int PASSES = 20;
+
+		/// @brief Serialize a ChunkDataMsg the way NetworkServer does (MessageHeader, then the message).
+		std::string BuildPacket(const std::shared_ptr<Chunk>& chunk)
+		{
+			std::ostringstream stream(std::ios::binary);
+			cereal::BinaryOutputArchive archive(stream);
+
+			ChunkDataMsg msg;
+			msg.Chunk = SerializerDTO::SerializeChunk(chunk);
+
+			MessageHeader header;
+			header.Type = ChunkDataMsg::StaticType;
+
+			archive(header);
+			archive(msg);
+
+			return stream.str();
+		}
+
+		struct MemoryStream : std::streambuf
+		{
+			MemoryStream(const char* data, std::size_t size)
+			{
+				char* ptr = const_cast<char*>(data);
+				setg(ptr, ptr, ptr + size);
+			}
+		};
+
+		/// @brief Previous receive path : istream + cereal into ChunkDTO, then DTO to Chunk.
+		std::shared_ptr<Chunk> DecodeThroughDTO(const std::string& packet)
+		{
+			MemoryStream memStream(packet.data(), packet.size());
+			std::istream stream(&memStream);
+			cereal::BinaryInputArchive archive(stream);
+
+			MessageHeader header;
+			archive(header);
+
+			NetworkMessage msg = DeserializeMessage(archive, header.Type);
+			return SerializerDTO::DeserializeChunk(std::get<ChunkDataMsg>(msg).Chunk);
+		}
+
+		/// @brief Direct receive path : packet bytes to Chunk.
+		std::shared_ptr<Chunk> DecodeDirect(const std::string& packet)
+		{
+			const auto* data = reinterpret_cast<const uint8_t*>(packet.data());
+			return SerializerDTO::DecodeChunk(data + MessageHeader::BINARY_SIZE,
+											  packet.size() - MessageHeader::BINARY_SIZE);
+		}
+
+		template <typename DecodeFunction>
+		BenchmarkResult Measure(const std::string& name, const std::vector<std::string>& packets, DecodeFunction decode)
+		{
+			size_t checksum = 0;
+
+			Stopwatch stopwatch;
+			stopwatch.Start();
+
+			for (int pass = 0; pass < PASSES; pass++)
+			{
+				for (const std::string& packet : packets)
+				{
+					std::shared_ptr<Chunk> chunk = decode(packet);
+					checksum += static_cast<size_t>(chunk->GetSubChunkCount());
+				}
+			}
+
+			BenchmarkResult result;
+			result.Name = name;
+			result.Items = static_cast<uint64_t>(PASSES) * packets.size();
+			result.ItemUnit = "chunks";
+			result.Seconds = stopwatch.ElapsedSeconds();
+
+			// Keeps the decoding from being optimized out
+			if (checksum == 0)
+				result.Name += " (empty)";
+
+			return result;
+		}
+	} // namespace
+
+	std::vector<BenchmarkResult> RunChunkDecodeBench()
+	{
+		std::mt19937 rng(SEED);
+
+		std::vector<std::string> packets;
+		packets.reserve(CHUNK_COUNT);
+
+		size_t totalBytes = 0;
+		for (int i = 0; i < CHUNK_COUNT; i++)
+		{
+			packets.emplace_back(BuildPacket(BuildTerrainChunk({i % 8, i / 8}, SUBCHUNK_COUNT, rng)));
+			totalBytes += packets.back().size();
+		}
+
+		std::cout << "  " << CHUNK_COUNT << " chunks, " << totalBytes / CHUNK_COUNT << " bytes per packet on average\n";
+
+		return {
+			Measure("decode_through_dto", packets, &DecodeThroughDTO),
+			Measure("decode_direct", packets, &DecodeDirect),
+		};
+	}
+} // namespace onion::voxel::bench
@@ -0,0 +1,91 @@
+#include "Benchmark.hpp"
+#include "BenchWorld.hpp"
+
+#include <cereal/archives/binary.hpp>
+
+#include <random>
+#include <sstream>
+
+#include <shared/data_transfer_objects/serializer/SerializerDTO.hpp>
+#include <shared/network_messages/NetworkMessages.hpp>
+#include <shared/utils/Stopwatch.hpp>
+
+namespace onion::voxel::bench
+{
+	namespace
+	{
+		constexpr uint32_t SEED = 1337;
+		constexpr int CHUNK_COUNT = 64;
+		constexpr int SUBCHUNK_COUNT = 4;
+		constexpr int PASSES = 20;
+
+		/// @brief Chunk to DTO only.
+		size_t SerializeToDTO(const std::shared_ptr<Chunk>& chunk)
+		{
+			ChunkDTO dto = SerializerDTO::SerializeChunk(chunk);
+			return dto.SubChunks.size();
+		}
+
+		/// @brief Full send path : DTO, then a ChunkDataMsg packet the way NetworkServer builds it.
+		size_t EncodePacket(const std::shared_ptr<Chunk>& chunk)
+		{
+			std::ostringstream stream(std::ios::binary);
+			cereal::BinaryOutputArchive archive(stream);
+
+			ChunkDataMsg msg;
+			msg.Chunk = SerializerDTO::SerializeChunk(chunk);
+
+			MessageHeader header;
+			header.Type = ChunkDataMsg::StaticType;
+
+			archive(header);
+			archive(msg);
+
+			return stream.str().size();
+		}
+
+		template <typename EncodeFunction>
+		BenchmarkResult Measure(const std::string& name,
+								const std::vector<std::shared_ptr<Chunk>>& chunks,
+								EncodeFunction encode)
+		{
+			size_t checksum = 0;
+
+			Stopwatch stopwatch;
+			stopwatch.Start();
+
+			for (int pass = 0; pass < PASSES; pass++)
+			{
+				for (const std::shared_ptr<Chunk>& chunk : chunks)
+					checksum += encode(chunk);
+			}
+
+			BenchmarkResult result;
+			result.Name = name;
+			result.Items = static_cast<uint64_t>(PASSES) * chunks.size();
+			result.ItemUnit = "chunks";
+			result.Seconds = stopwatch.ElapsedSeconds();
+
+			// Keeps the encoding from being optimized out
+			if (checksum == 0)
+				result.Name += " (empty)";
+
+			return result;
+		}
+	} // namespace
+
+	std::vector<BenchmarkResult> RunChunkEncodeBench()
+	{
+		std::mt19937 rng(SEED);
+
+		std::vector<std::shared_ptr<Chunk>> chunks;
+		chunks.reserve(CHUNK_COUNT);
+		for (int i = 0; i < CHUNK_COUNT; i++)
+			chunks.push_back(BuildTerrainChunk({i % 8, i / 8}, SUBCHUNK_COUNT, rng));
+
+		return {
+			Measure("serialize_dto", chunks, &SerializeToDTO),
+			Measure("encode_packet", chunks, &EncodePacket),
+		};
+	}
+} // namespace onion::voxel::bench
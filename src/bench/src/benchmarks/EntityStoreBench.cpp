@@ -0,0 +1,125 @@
+#include "Benchmark.hpp"
+
+#include <random>
+
+#include <shared/data_transfer_objects/serializer/SerializerDTO.hpp>
+#include <shared/utils/Stopwatch.hpp>
+
+namespace onion::voxel::bench
+{
+	namespace
+	{
+		constexpr uint32_t SEED = 1337;
+		constexpr size_t ENTITY_COUNT = 10000;
+		constexpr int INTEGRATE_PASSES = 100;
+		constexpr int SNAPSHOT_PASSES = 10;
+		constexpr float DELTA_TIME = 1.0f / 20.0f;
+
+		/// @brief Entities bound to one store, like the EntityManager does.
+		std::vector<std::shared_ptr<Entity>> SpawnEntities(const std::shared_ptr<EntityStore>& store)
+		{
+			std::mt19937 rng(SEED);
+			std::uniform_real_distribution<float> position(0.0f, 256.0f);
+			std::uniform_real_distribution<float> speed(-3.0f, 3.0f);
+
+			std::vector<std::shared_ptr<Entity>> entities;
+			entities.reserve(ENTITY_COUNT);
+
+			for (size_t i = 0; i < ENTITY_COUNT; i++)
+			{
+				auto entity = std::make_shared<Entity>(EntityType::None, "bench-" + std::to_string(i));
+
+				Transform transform;
+				transform.Position = glm::vec3(position(rng), 64.0f, position(rng));
+				entity->SetTransform(transform);
+
+				PhysicsBody physicsBody;
+				physicsBody.Velocity = glm::vec3(speed(rng), 0.f, speed(rng));
+				entity->SetPhysicsBody(physicsBody);
+
+				entity->SetHealth(Health{20});
+
+				entity->BindToStore(store);
+				entities.push_back(entity);
+			}
+
+			return entities;
+		}
+
+		BenchmarkResult MakeResult(const std::string& name, uint64_t items, double seconds)
+		{
+			BenchmarkResult result;
+			result.Name = name;
+			result.Items = items;
+			result.ItemUnit = "entities";
+			result.Seconds = seconds;
+			return result;
+		}
+	} // namespace
+
+	std::vector<BenchmarkResult> RunEntityStoreBench()
+	{
+		auto store = std::make_shared<EntityStore>();
+		const std::vector<std::shared_ptr<Entity>> entities = SpawnEntities(store);
+
+		std::vector<BenchmarkResult> results;
+		Stopwatch stopwatch;
+
+		// Integrate the positions through the façade : two locks and two copies per component access
+		stopwatch.Start();
+		for (int pass = 0; pass < INTEGRATE_PASSES; pass++)
+		{
+			for (const auto& entity : entities)
+			{
+				Transform transform = entity->GetTransform();
+				transform.Position += entity->GetPhysicsBody().Velocity * DELTA_TIME;
+				entity->SetTransform(transform);
+			}
+		}
+		results.push_back(
+			MakeResult("integrate_facade", INTEGRATE_PASSES * entities.size(), stopwatch.ElapsedSeconds()));
+
+		// Same work on the store's arrays, one lock for the pass
+		stopwatch.Start();
+		for (int pass = 0; pass < INTEGRATE_PASSES; pass++)
+		{
+			std::unique_lock lock(store->GetMutex());
+
+			const ComponentArray<PhysicsBody>& physicsBodies = store->PhysicsBodies();
+			ComponentArray<Transform>& transforms = store->Transforms();
+
+			for (size_t slot = 0; slot < physicsBodies.Size(); slot++)
+			{
+				Transform* transform = transforms.Find(physicsBodies.GetOwners()[slot]);
+				if (transform)
+					transform->Position += physicsBodies.GetComponents()[slot].Velocity * DELTA_TIME;
+			}
+		}
+		results.push_back(
+			MakeResult("integrate_store", INTEGRATE_PASSES * entities.size(), stopwatch.ElapsedSeconds()));
+
+		// Snapshot serialization, as done by the server
+		size_t serialized = 0;
+
+		stopwatch.Start();
+		for (int pass = 0; pass < SNAPSHOT_PASSES; pass++)
+		{
+			std::vector<EntityDTO> dtos;
+			for (const auto& entity : entities)
+				dtos.push_back(SerializerDTO::SerializeEntity(*entity));
+			serialized += dtos.size();
+		}
+		results.push_back(MakeResult("snapshot_facade", serialized, stopwatch.ElapsedSeconds()));
+
+		serialized = 0;
+
+		stopwatch.Start();
+		for (int pass = 0; pass < SNAPSHOT_PASSES; pass++)
+		{
+			serialized += SerializerDTO::SerializeEntities(*store).size();
+		}
+		results.push_back(MakeResult("snapshot_store", serialized, stopwatch.ElapsedSeconds()));
+
+		return results;
+	}
+} // namespace onion::voxel::bench
@@ -0,0 +1,188 @@
+#include "Benchmark.hpp"
+#include "BenchWorld.hpp"
+
+#include <iostream>
+#include <random>
+
+#include <renderer/world_renderer/chunk_mesh/MeshGeometry.hpp>
+
+#include <shared/utils/Stopwatch.hpp>
+
+namespace onion::voxel::bench
+{
+	namespace
+	{
+		constexpr uint32_t SEED = 1337;
+		constexpr int WORLD_CHUNKS = 4; // WORLD_CHUNKS x WORLD_CHUNKS terrain chunks, all of them meshed
+		constexpr int SUBCHUNK_COUNT = 8;
+		constexpr int PASSES = 4;
+		constexpr int ATLAS_GRID = 64; // Tiles per row of the stand-in atlas
+
+		/// @brief A chunk to mesh and its neighbors, null at the border of the world like unloaded chunks.
+		struct ChunkToMesh
+		{
+			std::shared_ptr<Chunk> Center;
+			std::shared_ptr<Chunk> PosX;
+			std::shared_ptr<Chunk> NegX;
+			std::shared_ptr<Chunk> PosZ;
+			std::shared_ptr<Chunk> NegZ;
+		};
+
+		std::vector<ChunkToMesh> BuildChunks(std::mt19937& rng)
+		{
+			std::vector<std::shared_ptr<Chunk>> grid;
+			for (int cx = 0; cx < WORLD_CHUNKS; cx++)
+				for (int cz = 0; cz < WORLD_CHUNKS; cz++)
+					grid.push_back(BuildTerrainChunk({cx, cz}, SUBCHUNK_COUNT, rng));
+
+			auto at = [&](int cx, int cz) -> std::shared_ptr<Chunk>
+			{
+				if (cx < 0 || cz < 0 || cx >= WORLD_CHUNKS || cz >= WORLD_CHUNKS)
+					return nullptr;
+				return grid[cx * WORLD_CHUNKS + cz];
+			};
+
+			std::vector<ChunkToMesh> chunks;
+			for (int cx = 0; cx < WORLD_CHUNKS; cx++)
+				for (int cz = 0; cz < WORLD_CHUNKS; cz++)
+					chunks.push_back({at(cx, cz), at(cx + 1, cz), at(cx - 1, cz), at(cx, cz + 1), at(cx, cz - 1)});
+
+			return chunks;
+		}
+
+		/// @brief Full cubes with one texture per block, tinted like grass and water.
+		/// Stands in for the BlockRenderRegistry, which needs the GL atlas to resolve the texture IDs.
+		std::vector<BlockTextures> BuildBlockTextures()
+		{
+			std::vector<BlockTextures> blocks(static_cast<size_t>(BlockId::Count));
+			for (size_t id = 0; id < blocks.size(); id++)
+			{
+				const BlockId blockId = static_cast<BlockId>(id);
+
+				for (uint8_t face = 0; face < static_cast<uint8_t>(Face::Count); face++)
+				{
+					TextureInfo info;
+					info.texture = static_cast<uint16_t>(id % (ATLAS_GRID * ATLAS_GRID));
+					info.face = static_cast<Face>(face);
+
+					if (blockId == BlockId::Water)
+					{
+						info.textureType = Transparency::Transparent;
+						info.tintType = Tint::Water;
+					}
+					else if (blockId == BlockId::GrassBlock && info.face == Face::Up)
+					{
+						info.tintType = Tint::Grass;
+					}
+
+					blocks[id].faces.push_back(info);
+				}
+			}
+
+			return blocks;
+		}
+
+		BenchmarkResult MakeResult(const std::string& name, uint64_t items, double seconds)
+		{
+			BenchmarkResult result;
+			result.Name = name;
+			result.Items = items;
+			result.ItemUnit = "subchunks";
+			result.Seconds = seconds;
+			return result;
+		}
+	} // namespace
+
+	std::vector<BenchmarkResult> RunMeshBuildBench()
+	{
+		std::mt19937 rng(SEED);
+
+		const std::vector<ChunkToMesh> chunks = BuildChunks(rng);
+		const uint64_t subChunksPerPass = static_cast<uint64_t>(chunks.size()) * SUBCHUNK_COUNT;
+
+		const std::vector<BlockTextures> blockTextures = BuildBlockTextures();
+		const MeshGeometry::TexturesGetter getTextures = [&](const BlockState& block) -> const BlockTextures&
+		{ return blockTextures[static_cast<size_t>(block.ID)]; };
+		const MeshGeometry::UvGetter getUv = [](uint16_t texture)
+		{
+			constexpr float TILE = 1.0f / ATLAS_GRID;
+			const glm::vec2 uvMin(static_cast<float>(texture % ATLAS_GRID) * TILE,
+								  static_cast<float>(texture / ATLAS_GRID) * TILE);
+			return MeshGeometry::UvRect{uvMin, uvMin + glm::vec2(TILE)};
+		};
+
+		std::vector<BenchmarkResult> results;
+
+		// ----- Ambient occlusion maps -----
+		std::vector<std::vector<uint8_t>> occlusionMaps(subChunksPerPass);
+		{
+			Stopwatch stopwatch;
+			stopwatch.Start();
+
+			for (int pass = 0; pass < PASSES; pass++)
+			{
+				size_t index = 0;
+				for (const ChunkToMesh& c : chunks)
+				{
+					for (int sub = 0; sub < SUBCHUNK_COUNT; sub++)
+					{
+						occlusionMaps[index++] =
+							MeshGeometry::BuildOcclusionMap(sub, c.Center, c.PosX, c.NegX, c.PosZ, c.NegZ);
+					}
+				}
+			}
+
+			results.push_back(
+				MakeResult("ambient_occlusion_maps", PASSES * subChunksPerPass, stopwatch.ElapsedSeconds()));
+		}
+
+		// ----- Face visibility and vertex generation, on the occlusion maps above -----
+		{
+			size_t vertexCount = 0;
+
+			Stopwatch stopwatch;
+			stopwatch.Start();
+
+			for (int pass = 0; pass < PASSES; pass++)
+			{
+				size_t index = 0;
+				for (const ChunkToMesh& c : chunks)
+				{
+					for (int sub = 0; sub < SUBCHUNK_COUNT; sub++)
+					{
+						// Fresh lists for each subchunk : the client gives them to GL then releases them
+						std::vector<MeshGeometry::Vertex> verticesOpaque, verticesCutout, verticesTransparent;
+						std::vector<uint32_t> indicesOpaque, indicesCutout, indicesTransparent;
+
+						MeshGeometry::MeshOutput output;
+						output.VerticesOpaque = &verticesOpaque;
+						output.IndicesOpaque = &indicesOpaque;
+						output.VerticesCutout = &verticesCutout;
+						output.IndicesCutout = &indicesCutout;
+						output.VerticesTransparent = &verticesTransparent;
+						output.IndicesTransparent = &indicesTransparent;
+
+						MeshGeometry::BuildSubChunk(output,
+													occlusionMaps[index++],
+													sub,
+													c.Center,
+													c.PosX,
+													c.NegX,
+													c.PosZ,
+													c.NegZ,
+													getTextures,
+													getUv);
+
+						vertexCount += verticesOpaque.size() + verticesCutout.size() + verticesTransparent.size();
+					}
+				}
+			}
+
+			results.push_back(MakeResult("subchunk_meshing", PASSES * subChunksPerPass, stopwatch.ElapsedSeconds()));
+
+			std::cout << "  " << vertexCount / PASSES << " vertices for " << subChunksPerPass << " subchunks\n";
+		}
+
+		return results;
+	}
+} // namespace onion::voxel::bench
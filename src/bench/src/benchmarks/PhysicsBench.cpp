@@ -0,0 +1,111 @@
+#include "Benchmark.hpp"
+#include "BenchWorld.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#include <shared/physics/PhysicsSimulation.hpp>
+#include <shared/utils/Stopwatch.hpp>
+
+namespace onion::voxel::bench
+{
+	namespace
+	{
+		constexpr uint32_t SEED = 1337;
+		constexpr int WORLD_CHUNKS = 4; // WORLD_CHUNKS x WORLD_CHUNKS flat chunks
+		constexpr int GROUND_HEIGHT = 64;
+		constexpr int WARMUP_STEPS = 5;
+		constexpr int STEPS = 50;
+		constexpr float DELTA_TIME = 1.0f / 20.0f;
+
+		/// @brief Entities scattered over the world, dropped from a few blocks high with a random walk velocity.
+		void SpawnEntities(EntityStore& store, size_t count)
+		{
+			std::mt19937 rng(SEED);
+
+			const float worldSize = static_cast<float>(WORLD_CHUNKS * WorldConstants::CHUNK_SIZE);
+			std::uniform_real_distribution<float> horizontal(1.0f, worldSize - 1.0f);
+			std::uniform_real_distribution<float> height(GROUND_HEIGHT + 1.0f, GROUND_HEIGHT + 4.0f);
+			std::uniform_real_distribution<float> speed(-3.0f, 3.0f);
+
+			std::unique_lock lock(store.GetMutex());
+
+			for (size_t i = 0; i < count; i++)
+			{
+				const EntityHandle entity = store.Create(EntityType::None, "bench-" + std::to_string(i));
+
+				Transform transform;
+				transform.Position = glm::vec3(horizontal(rng), height(rng), horizontal(rng));
+				store.Transforms().Set(entity.Index, transform);
+
+				PhysicsBody physicsBody;
+				physicsBody.HalfSize = glm::vec3(0.3f, 0.9f, 0.3f);
+				physicsBody.Offset = glm::vec3(0.f, 0.9f, 0.f);
+				physicsBody.Velocity = glm::vec3(speed(rng), 0.f, speed(rng));
+				store.PhysicsBodies().Set(entity.Index, physicsBody);
+			}
+		}
+
+		BenchmarkResult Measure(WorldManager& worldManager, size_t entityCount, size_t threadCount)
+		{
+			PhysicsSimulation simulation(worldManager);
+			simulation.SetThreadCount(threadCount);
+
+			EntityStore store;
+			SpawnEntities(store, entityCount);
+
+			for (int step = 0; step < WARMUP_STEPS; step++)
+				simulation.Step(DELTA_TIME, store);
+
+			PhysicsSimulation::StepStats totals;
+
+			Stopwatch stopwatch;
+			stopwatch.Start();
+
+			for (int step = 0; step < STEPS; step++)
+			{
+				const PhysicsSimulation::StepStats stats = simulation.Step(DELTA_TIME, store);
+				totals.Pairs += stats.Pairs;
+				totals.Islands += stats.Islands;
+				totals.BroadphaseMs += stats.BroadphaseMs;
+				totals.SolveMs += stats.SolveMs;
+			}
+
+			BenchmarkResult result;
+			result.Name = std::to_string(entityCount) + " entities, " + std::to_string(threadCount) + " threads";
+			result.Items = static_cast<uint64_t>(STEPS) * entityCount;
+			result.ItemUnit = "entities";
+			result.Seconds = stopwatch.ElapsedSeconds();
+
+			std::cout << "  " << result.Name << " : " << result.Seconds * 1000.0 / STEPS << " ms/step (broadphase "
+					  << totals.BroadphaseMs / STEPS << " ms, solve " << totals.SolveMs / STEPS << " ms), "
+					  << totals.Pairs / STEPS << " pairs, " << totals.Islands / STEPS << " islands\n";
+
+			return result;
+		}
+	} // namespace
+
+	std::vector<BenchmarkResult> RunPhysicsStepBench()
+	{
+		WorldManager worldManager("", true);
+		BuildFlatWorld(worldManager, {.ChunkCount = WORLD_CHUNKS, .GroundHeight = GROUND_HEIGHT, .HasBedrock = true});
+
+		// 1, 2, 4, ... up to the hardware threads
+		std::vector<size_t> threadCounts;
+		const size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+		for (size_t threads = 1; threads < hardwareThreads; threads *= 2)
+			threadCounts.push_back(threads);
+		threadCounts.push_back(hardwareThreads);
+
+		std::vector<BenchmarkResult> results;
+		for (size_t entityCount : {size_t(1000), size_t(10000)})
+		{
+			for (size_t threadCount : threadCounts)
+				results.push_back(Measure(worldManager, entityCount, threadCount));
+		}
+
+		return results;
+	}
+} // namespace onion::voxel::bench
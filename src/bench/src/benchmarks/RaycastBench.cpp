@@ -0,0 +1,94 @@
+#include "Benchmark.hpp"
+#include "BenchWorld.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include <shared/utils/Stopwatch.hpp>
+#include <shared/world/raycast/Raycast.hpp>
+
+namespace onion::voxel::bench
+{
+	namespace
+	{
+		constexpr uint32_t SEED = 1337;
+		constexpr int WORLD_CHUNKS = 4; // WORLD_CHUNKS x WORLD_CHUNKS terrain chunks
+		constexpr int SUBCHUNK_COUNT = 4;
+		constexpr int RAY_COUNT = 20000;
+
+		// Same parameters as the block selection of the client
+		constexpr float MAX_DISTANCE = 10.0f;
+		constexpr int STEPS = 500;
+
+		struct Ray
+		{
+			glm::vec3 Origin;
+			glm::vec3 Direction;
+		};
+
+		/// @brief Rays from eye height above the terrain (80 to 120 high), looking around and down, like a player.
+		std::vector<Ray> BuildRays(std::mt19937& rng)
+		{
+			const float worldSize = static_cast<float>(WORLD_CHUNKS * WorldConstants::CHUNK_SIZE);
+			std::uniform_real_distribution<float> horizontal(MAX_DISTANCE, worldSize - MAX_DISTANCE);
+			std::uniform_real_distribution<float> height(100.0f, 124.0f);
+			std::uniform_real_distribution<float> yaw(0.0f, 6.2831853f);
+			std::uniform_real_distribution<float> pitch(-1.4f, 0.2f);
+
+			std::vector<Ray> rays(RAY_COUNT);
+			for (Ray& ray : rays)
+			{
+				const float y = yaw(rng);
+				const float p = pitch(rng);
+
+				ray.Origin = glm::vec3(horizontal(rng), height(rng), horizontal(rng));
+				ray.Direction = glm::vec3(std::cos(p) * std::cos(y), std::sin(p), std::cos(p) * std::sin(y));
+			}
+
+			return rays;
+		}
+	} // namespace
+
+	std::vector<BenchmarkResult> RunRaycastBench()
+	{
+		if (!HasBlockAssets())
+		{
+			std::cout << "  Skipped : the block assets are not next to the executable\n";
+			return {};
+		}
+
+		std::mt19937 rng(SEED);
+
+		WorldManager worldManager("", true);
+		for (int cx = 0; cx < WORLD_CHUNKS; cx++)
+			for (int cz = 0; cz < WORLD_CHUNKS; cz++)
+				worldManager.AddChunk(BuildTerrainChunk({cx, cz}, SUBCHUNK_COUNT, rng));
+
+		const std::vector<Ray> rays = BuildRays(rng);
+
+		// Loads the block models outside of the measure
+		Raycaster::Raycast(worldManager, rays.front().Origin, rays.front().Direction, MAX_DISTANCE, STEPS);
+
+		size_t hits = 0;
+
+		Stopwatch stopwatch;
+		stopwatch.Start();
+
+		for (const Ray& ray : rays)
+		{
+			if (Raycaster::Raycast(worldManager, ray.Origin, ray.Direction, MAX_DISTANCE, STEPS))
+				hits++;
+		}
+
+		BenchmarkResult result;
+		result.Name = "block_selection_rays";
+		result.Items = rays.size();
+		result.ItemUnit = "rays";
+		result.Seconds = stopwatch.ElapsedSeconds();
+
+		std::cout << "  " << hits << " / " << rays.size() << " rays hit a block\n";
+
+		return {result};
+	}
+} // namespace onion::voxel::bench
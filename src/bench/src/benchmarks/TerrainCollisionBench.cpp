@@ -0,0 +1,144 @@
+#include "Benchmark.hpp"
+#include "BenchWorld.hpp"
+
+#include <iostream>
+#include <random>
+
+#include <shared/physics/PhysicsEngine.hpp>
+#include <shared/utils/Stopwatch.hpp>
+
+namespace onion::voxel::bench
+{
+	namespace
+	{
+		constexpr uint32_t SEED = 1337;
+		constexpr int WORLD_CHUNKS = 2;
+		constexpr int GROUND_HEIGHT = 64;
+		constexpr size_t ENTITY_COUNT = 256;
+		constexpr int STEPS = 200;
+		constexpr float DELTA_TIME = 1.0f / 20.0f;
+
+		/// @brief Flat ground with scattered pillars and slabs, so sweeps hit walls, floors and partial blocks.
+		void BuildWorld(WorldManager& worldManager, std::mt19937& rng)
+		{
+			std::uniform_int_distribution<int> feature(0, 15);
+
+			FlatWorldSettings settings{.ChunkCount = WORLD_CHUNKS, .GroundHeight = GROUND_HEIGHT};
+			settings.DecorateColumn = [&](Chunk& chunk, uint8_t x, uint8_t z)
+			{
+				const int f = feature(rng);
+				if (f == 0)
+				{
+					const uint16_t idxPillar = chunk.GetOrAddPaletteIndex(BlockState(BlockId::Cobblestone));
+					chunk.FillColumn_Unsafe(x, GROUND_HEIGHT, GROUND_HEIGHT + 2, z, idxPillar);
+				}
+				else if (f == 1)
+				{
+					const uint16_t idxSlab = chunk.GetOrAddPaletteIndex(BlockState(BlockId::StoneSlab));
+					chunk.FillColumn_Unsafe(x, GROUND_HEIGHT, GROUND_HEIGHT, z, idxSlab);
+				}
+			};
+
+			BuildFlatWorld(worldManager, settings);
+		}
+
+		std::vector<std::shared_ptr<Entity>> SpawnEntities(std::mt19937& rng)
+		{
+			const float worldSize = static_cast<float>(WORLD_CHUNKS * WorldConstants::CHUNK_SIZE);
+			std::uniform_real_distribution<float> horizontal(4.0f, worldSize - 4.0f);
+			std::uniform_real_distribution<float> speed(-6.0f, 6.0f);
+
+			std::vector<std::shared_ptr<Entity>> entities;
+			for (size_t i = 0; i < ENTITY_COUNT; i++)
+			{
+				auto entity = std::make_shared<Entity>(EntityType::None, "bench-" + std::to_string(i));
+
+				Transform transform;
+				transform.Position = glm::vec3(horizontal(rng), GROUND_HEIGHT + 3.0f, horizontal(rng));
+				entity->SetTransform(transform);
+
+				PhysicsBody physicsBody;
+				physicsBody.HalfSize = glm::vec3(0.3f, 0.9f, 0.3f);
+				physicsBody.Offset = glm::vec3(0.f, 0.9f, 0.f);
+				physicsBody.Velocity = glm::vec3(speed(rng), 0.f, speed(rng));
+				entity->SetPhysicsBody(physicsBody);
+
+				entities.push_back(entity);
+			}
+
+			return entities;
+		}
+	} // namespace
+
+	std::vector<BenchmarkResult> RunTerrainCollisionBench()
+	{
+		std::mt19937 rng(SEED);
+
+		WorldManager worldManager("", true);
+		BuildWorld(worldManager, rng);
+
+		PhysicsEngine physicsEngine(worldManager);
+		std::vector<std::shared_ptr<Entity>> entities = SpawnEntities(rng);
+
+		// Keep the entities walking : friction would stop them after a few steps
+		std::vector<glm::vec3> walkVelocities;
+		for (const auto& entity : entities)
+			walkVelocities.push_back(entity->GetPhysicsBody().Velocity);
+
+		std::vector<BenchmarkResult> results;
+
+		// Each step resolves the Y, X and Z sweeps, the step up test and the ground probe
+		{
+			Stopwatch stopwatch;
+			stopwatch.Start();
+
+			for (int step = 0; step < STEPS; step++)
+			{
+				for (size_t i = 0; i < entities.size(); i++)
+				{
+					PhysicsBody physicsBody = entities[i]->GetPhysicsBody();
+					physicsBody.Velocity.x = walkVelocities[i].x;
+					physicsBody.Velocity.z = walkVelocities[i].z;
+					entities[i]->SetPhysicsBody(physicsBody);
+
+					physicsEngine.StepEntity(entities[i], DELTA_TIME);
+				}
+			}
+
+			BenchmarkResult result;
+			result.Name = "terrain_sweep";
+			result.Items = static_cast<uint64_t>(STEPS) * entities.size();
+			result.ItemUnit = "sweeps";
+			result.Seconds = stopwatch.ElapsedSeconds();
+			results.push_back(result);
+		}
+
+		{
+			size_t supported = 0;
+
+			Stopwatch stopwatch;
+			stopwatch.Start();
+
+			for (int step = 0; step < STEPS; step++)
+			{
+				for (const auto& entity : entities)
+				{
+					const PhysicsBody physicsBody = entity->GetPhysicsBody();
+					if (physicsEngine.HasGroundSupport(entity->GetPosition(), physicsBody.HalfSize, physicsBody.Offset))
+						supported++;
+				}
+			}
+
+			BenchmarkResult result;
+			result.Name = "ground_support";
+			result.Items = static_cast<uint64_t>(STEPS) * entities.size();
+			result.ItemUnit = "queries";
+			result.Seconds = stopwatch.ElapsedSeconds();
+			results.push_back(result);
+
+			std::cout << "  " << supported * 100 / result.Items << "% of the queries found ground\n";
+		}
+
+		return results;
+	}
+} // namespace onion::voxel::bench
@@ -0,0 +1,148 @@
+#include "Benchmark.hpp"
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+#include <miniz.h>
+
+#include <renderer/assets_manager/asset_cache/AssetCache.hpp>
+#include <renderer/texture_atlas/TextureAtlasBuilder.hpp>
+#include <shared/utils/Stopwatch.hpp>
+
+namespace onion::voxel::bench
+{
+	namespace
+	{
+		constexpr uint32_t SEED = 1337;
+		constexpr int TEXTURE_COUNT = 1500; // About the number of block textures of a resource pack
+		constexpr int TEXTURE_SIZE = 16;
+		constexpr int PASSES = 5;
+
+		/// @brief Encode noisy textures as PNG, in memory. A quarter has holes (cutout), a few are translucent,
+		/// some are animated strips like water and lava.
+		std::unordered_map<std::string, std::vector<unsigned char>> BuildTextures()
+		{
+			std::mt19937 rng(SEED);
+			std::uniform_int_distribution<int> channel(0, 255);
+			std::uniform_int_distribution<int> kind(0, 15);
+
+			std::unordered_map<std::string, std::vector<unsigned char>> files;
+
+			for (int i = 0; i < TEXTURE_COUNT; i++)
+			{
+				const int textureKind = kind(rng);
+				const int frames = textureKind == 0 ? 16 : 1;
+				const int height = TEXTURE_SIZE * frames;
+
+				std::vector<unsigned char> pixels(static_cast<size_t>(TEXTURE_SIZE) * height * 4);
+				for (size_t p = 0; p < pixels.size(); p += 4)
+				{
+					pixels[p + 0] = (unsigned char) channel(rng);
+					pixels[p + 1] = (unsigned char) channel(rng);
+					pixels[p + 2] = (unsigned char) channel(rng);
+
+					unsigned char alpha = 255;
+					if (textureKind < 4 && channel(rng) < 64)
+						alpha = 0;
+					else if (textureKind == 15)
+						alpha = 160;
+					pixels[p + 3] = alpha;
+				}
+
+				std::vector<unsigned char>& file = files["block/texture_" + std::to_string(i) + ".png"];
+				stbi_write_png_to_func(
+					[](void* context, void* data, int size)
+					{
+						auto* out = static_cast<std::vector<unsigned char>*>(context);
+						const auto* bytes = static_cast<const unsigned char*>(data);
+						out->insert(out->end(), bytes, bytes + size);
+					},
+					&file,
+					TEXTURE_SIZE,
+					height,
+					4,
+					pixels.data(),
+					TEXTURE_SIZE * 4);
+			}
+
+			return files;
+		}
+
+		template <typename Reader>
+		BenchmarkResult MeasureBuild(const std::string& name,
+									 const std::unordered_set<std::string>& textureNames,
+									 const Reader& readTexture,
+									 size_t threadCount)
+		{
+			size_t checksum = 0;
+
+			Stopwatch stopwatch;
+			stopwatch.Start();
+
+			for (int pass = 0; pass < PASSES; pass++)
+			{
+				AtlasImage image = TextureAtlasBuilder::Build(textureNames, readTexture, threadCount);
+				checksum += image.Pixels.size() + image.Pixels[image.Pixels.size() / 2];
+			}
+
+			BenchmarkResult result;
+			result.Name = name;
+			result.Items = static_cast<uint64_t>(textureNames.size()) * PASSES;
+			result.ItemUnit = "textures";
+			result.Seconds = stopwatch.ElapsedSeconds();
+
+			if (checksum == 0)
+				result.Name += " (empty atlas)";
+
+			return result;
+		}
+	} // namespace
+
+	std::vector<BenchmarkResult> RunTextureAtlasBench()
+	{
+		const std::unordered_map<std::string, std::vector<unsigned char>> files = BuildTextures();
+
+		std::unordered_set<std::string> textureNames;
+		for (const auto& [name, file] : files)
+			textureNames.insert(name);
+
+		// In-memory files : measures decoding and packing only, not the resource pack reads
+		const TextureAtlasBuilder::FileReader readFile = [&files](const std::string& textureName)
+		{ return files.at(textureName); };
+
+		const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+
+		std::vector<BenchmarkResult> results;
+		results.push_back(MeasureBuild("build_atlas_1_thread", textureNames, readFile, 1));
+		if (cores > 1)
+		{
+			results.push_back(
+				MeasureBuild("build_atlas_" + std::to_string(cores) + "_threads", textureNames, readFile, cores));
+		}
+
+		// Rebuild after a resource pack switch : every texture is already in the asset cache
+		AssetCache cache;
+		std::unordered_map<std::string, uint64_t> keys;
+		for (const auto& [name, file] : files)
+		{
+			const uint32_t crc = static_cast<uint32_t>(mz_crc32(MZ_CRC32_INIT, file.data(), file.size()));
+			keys[name] = AssetCache::MakeKey(crc, file.size(), AssetCache::AssetKind::Image, true, 4);
+		}
+
+		const TextureAtlasBuilder::ImageReader readCachedImage = [&](const std::string& textureName)
+		{
+			return cache.GetImage(keys.at(textureName),
+								  [&]() { return DecodedImage::Decode(files.at(textureName), textureName, true, 4); });
+		};
+		TextureAtlasBuilder::Build(textureNames, readCachedImage, cores);
+
+		results.push_back(MeasureBuild("build_atlas_cached", textureNames, readCachedImage, cores));
+
+		return results;
+	}
+} // namespace onion::voxel::bench
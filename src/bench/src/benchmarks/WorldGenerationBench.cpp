@@ -0,0 +1,99 @@
+#include "Benchmark.hpp"
+#include "BenchWorld.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+
+#include <shared/utils/Stopwatch.hpp>
+#include <shared/world/block/BlockstateRegistry.hpp>
+#include <shared/world/world_generator/WorldGenerator.hpp>
+
+namespace onion::voxel::bench
+{
+	namespace
+	{
+		constexpr uint32_t SEED = 1337;
+		constexpr int GRID_SIZE = 8; // GRID_SIZE x GRID_SIZE chunks per generation type
+		constexpr auto TIMEOUT = std::chrono::minutes(2);
+
+		/// @brief Generate a square of chunks on the generator's own thread pool, as the server does.
+		BenchmarkResult Measure(WorldGenerator::eWorldGenerationType type)
+		{
+			WorldGenerator generator;
+			generator.SetSeed(SEED);
+			generator.SetWorldGenerationType(type);
+
+			std::vector<glm::ivec2> positions;
+			for (int x = 0; x < GRID_SIZE; x++)
+				for (int z = 0; z < GRID_SIZE; z++)
+					positions.emplace_back(x - GRID_SIZE / 2, z - GRID_SIZE / 2);
+
+			std::mutex mutex;
+			std::condition_variable generated;
+			size_t generatedCount = 0;
+			size_t subChunkCount = 0; // Keeps the generation from being optimized out
+
+			EventHandle handle = generator.EvtChunkGenerated.Subscribe(
+				[&](const WorldGenerator::GenChunk& genChunk)
+				{
+					std::lock_guard lock(mutex);
+					generatedCount++;
+					if (genChunk.chunk)
+						subChunkCount += static_cast<size_t>(genChunk.chunk->GetSubChunkCount());
+					generated.notify_one();
+				});
+
+			Stopwatch stopwatch;
+			stopwatch.Start();
+
+			generator.GenerateChunksAsync(positions);
+
+			bool timedOut = false;
+			{
+				std::unique_lock lock(mutex);
+				timedOut = !generated.wait_for(lock, TIMEOUT, [&]() { return generatedCount == positions.size(); });
+			}
+
+			std::string typeName = WorldGenerator::WorldGenerationTypeToString(type);
+			std::transform(typeName.begin(),
+						   typeName.end(),
+						   typeName.begin(),
+						   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+			BenchmarkResult result;
+			result.Name = "generate_" + typeName;
+			result.Items = generatedCount;
+			result.ItemUnit = "chunks";
+			result.Seconds = stopwatch.ElapsedSeconds();
+
+			if (timedOut)
+				result.Name += " (timed out)";
+			else if (subChunkCount == 0)
+				result.Name += " (empty)";
+
+			return result;
+		}
+	} // namespace
+
+	std::vector<BenchmarkResult> RunWorldGenerationBench()
+	{
+		if (!HasBlockAssets())
+		{
+			std::cout << "  Skipped : the block assets are not next to the executable\n";
+			return {};
+		}
+
+		// Loaded once, outside of the measures
+		BlockstateRegistry::Get();
+
+		std::vector<BenchmarkResult> results;
+		for (uint8_t type = 0; type < static_cast<uint8_t>(WorldGenerator::eWorldGenerationType::Count); type++)
+			results.push_back(Measure(static_cast<WorldGenerator::eWorldGenerationType>(type)));
+
+		return results;
+	}
+} // namespace onion::voxel::bench
@@ -0,0 +1,97 @@
+#include "Benchmark.hpp"
+#include "BenchWorld.hpp"
+
+#include <filesystem>
+#include <iostream>
+#include <random>
+
+#include <shared/utils/Stopwatch.hpp>
+#include <shared/world/world_save/WorldSave.hpp>
+
+namespace onion::voxel::bench
+{
+	namespace
+	{
+		constexpr uint32_t SEED = 1337;
+		constexpr int GRID_SIZE = 16; // GRID_SIZE x GRID_SIZE chunks, half of a region
+		constexpr int SUBCHUNK_COUNT = 4;
+
+		/// @brief Queue every chunk, then let the destructor write them (its final SaveAll), like on server stop.
+		BenchmarkResult MeasureSave(const std::filesystem::path& saveDirectory,
+									const std::vector<std::shared_ptr<Chunk>>& chunks)
+		{
+			Stopwatch stopwatch;
+			stopwatch.Start();
+
+			{
+				WorldSave worldSave(saveDirectory);
+				for (const std::shared_ptr<Chunk>& chunk : chunks)
+					worldSave.SaveChunkAsync(chunk);
+			}
+
+			BenchmarkResult result;
+			result.Name = "save_chunks";
+			result.Items = chunks.size();
+			result.ItemUnit = "chunks";
+			result.Seconds = stopwatch.ElapsedSeconds();
+
+			return result;
+		}
+
+		BenchmarkResult MeasureLoad(const std::filesystem::path& saveDirectory,
+									const std::vector<std::shared_ptr<Chunk>>& chunks)
+		{
+			WorldSave worldSave(saveDirectory);
+
+			size_t loaded = 0;
+
+			Stopwatch stopwatch;
+			stopwatch.Start();
+
+			for (const std::shared_ptr<Chunk>& chunk : chunks)
+			{
+				if (worldSave.LoadChunk(chunk->GetPosition()))
+					loaded++;
+			}
+
+			BenchmarkResult result;
+			result.Name = "load_chunks";
+			result.Items = loaded;
+			result.ItemUnit = "chunks";
+			result.Seconds = stopwatch.ElapsedSeconds();
+
+			if (loaded != chunks.size())
+				result.Name += " (" + std::to_string(chunks.size() - loaded) + " missing)";
+
+			return result;
+		}
+	} // namespace
+
+	std::vector<BenchmarkResult> RunWorldSaveBench()
+	{
+		const std::filesystem::path saveDirectory =
+			std::filesystem::temp_directory_path() / "onion_voxel_bench_world";
+		std::filesystem::remove_all(saveDirectory);
+
+		WorldInfos infos;
+		infos.Version = "bench";
+		infos.Name = "bench";
+		infos.Seed = SEED;
+		infos.SaveDirectory = saveDirectory;
+		WorldSave::CreateWorld(saveDirectory, infos);
+
+		std::mt19937 rng(SEED);
+		std::vector<std::shared_ptr<Chunk>> chunks;
+		for (int x = 0; x < GRID_SIZE; x++)
+			for (int z = 0; z < GRID_SIZE; z++)
+				chunks.push_back(BuildTerrainChunk({x, z}, SUBCHUNK_COUNT, rng));
+
+		std::vector<BenchmarkResult> results;
+		results.push_back(MeasureSave(saveDirectory, chunks));
+		results.push_back(MeasureLoad(saveDirectory, chunks));
+
+		std::filesystem::remove_all(saveDirectory);
+
+		return results;
+	}
+} // namespace onion::voxel::bench
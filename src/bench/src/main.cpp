@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "Benchmark.hpp"
+
+#ifndef ONION_VOXEL_BENCH_VERSION
+#define ONION_VOXEL_BENCH_VERSION "unknown"
+#endif
+
+using namespace onion::voxel::bench;
+
+namespace
+{
+	const std::vector<Benchmark>& GetBenchmarks()
+	{
+		static const std::vector<Benchmark> benchmarks = {
+			{"block_edit", &RunBlockEditBench},
+			{"chunk_decode", &RunChunkDecodeBench},
+			{"chunk_encode", &RunChunkEncodeBench},
+			{"entity_store", &RunEntityStoreBench},
+			{"mesh_build", &RunMeshBuildBench},
+			{"physics_step", &RunPhysicsStepBench},
+			{"raycast", &RunRaycastBench},
+			{"terrain_collision", &RunTerrainCollisionBench},
+			{"texture_atlas", &RunTextureAtlasBench},
+			{"world_generation", &RunWorldGenerationBench},
+			{"world_save", &RunWorldSaveBench},
+		};
+
+		return benchmarks;
+	}
+
+	void PrintResult(const BenchmarkResult& result)
+	{
+		std::printf("  %-40s %12llu %-8s %10.3f s %14.1f %s/s\n",
+					result.Name.c_str(),
+					static_cast<unsigned long long>(result.Items),
+					result.ItemUnit.c_str(),
+					result.Seconds,
+					result.GetItemsPerSecond(),
+					result.ItemUnit.c_str());
+	}
+
+	/// @brief Machine readable results, one entry per measured case, to track regressions between builds.
+	bool WriteJson(const std::string& filePath, const nlohmann::ordered_json& results)
+	{
+		nlohmann::ordered_json json;
+		json["version"] = ONION_VOXEL_BENCH_VERSION;
+		json["hardware_threads"] = std::thread::hardware_concurrency();
+		json["results"] = results;
+
+		std::ofstream file(filePath);
+		if (!file.is_open())
+		{
+			std::cerr << "Failed to open " << filePath << " for writing\n";
+			return false;
+		}
+
+		file << json.dump(4) << "\n";
+		return true;
+	}
+} // namespace
+
+// Usage : onion_voxel_bench [--json <file>] [benchmark names...] (runs every benchmark when no name is given)
+int main(int argc, char** argv)
+{
+	std::vector<std::string> selected;
+	std::string jsonFilePath;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+		if (arg == "--json")
+		{
+			if (i + 1 >= argc)
+			{
+				std::cerr << "--json expects a file path\n";
+				return 1;
+			}
+			jsonFilePath = argv[++i];
+		}
+		else
+		{
+			selected.push_back(arg);
+		}
+	}
+
+	std::cout << "\n --- ONION VOXEL BENCH ---" << std::endl;
+
+	int ran = 0;
+	nlohmann::ordered_json jsonResults = nlohmann::ordered_json::array();
+
+	for (const Benchmark& benchmark : GetBenchmarks())
+	{
+		if (!selected.empty() && std::find(selected.begin(), selected.end(), benchmark.Name) == selected.end())
+			continue;
+
+		std::cout << "\n[" << benchmark.Name << "]\n";
+
+		for (const BenchmarkResult& result : benchmark.Run())
+		{
+			PrintResult(result);
+
+			jsonResults.push_back({
+				{"benchmark", benchmark.Name},
+				{"name", result.Name},
+				{"items", result.Items},
+				{"unit", result.ItemUnit},
+				{"seconds", result.Seconds},
+				{"items_per_second", result.GetItemsPerSecond()},
+			});
+		}
+
+		ran++;
+	}
+
+	if (ran == 0)
+	{
+		std::cerr << "No benchmark matches the given names. Available:";
+		for (const Benchmark& benchmark : GetBenchmarks())
+			std::cerr << " " << benchmark.Name;
+		std::cerr << "\n";
+		return 1;
+	}
+
+	if (!jsonFilePath.empty())
+	{
+		if (!WriteJson(jsonFilePath, jsonResults))
+			return 1;
+		std::cout << "\nResults written to " << jsonFilePath << std::endl;
+	}
+
+	return 0;
+}
@@ -93,33 +93,26 @@ namespace onion::voxel
 
 	void Client::Handle_StartSingleplayerRequest(const WorldInfos& worldInfos)
 	{
-		std::string host = "127.0.0.1";
-		uint16_t port = 7777;
-
-		m_NetworkClient.SetRemoteHost(host);
-		m_NetworkClient.SetRemotePort(port);
-
-		// Starts a Server on Localhost
+		// Starts a local Server, reached in-process (no socket)
 		if (m_LocalhostServer == nullptr)
 		{
 			ServerConfiguration cfg;
-			cfg.serverData.ServerName = host;
+			cfg.serverData.ServerName = "127.0.0.1";
 			cfg.serverData.UUID = Utils::GenerateUUID();
-			cfg.serverData.Port = port;
 			cfg.serverData.SimulationDistance = m_Renderer.GetRenderDistance();
 			cfg.serverData.WorldDirectory = worldInfos.SaveDirectory;
 			m_LocalhostServer = std::make_unique<Server>(cfg);
-			m_LocalhostServer->Start();
+			m_LocalhostServer->StartLocal();
 		}
 		else
 		{
 			throw std::runtime_error("Localhost Server is already running");
 		}
 
-		// Connects to Localhost Server
+		// Connects to the local Server
 		if (!m_NetworkClient.IsRunning())
 		{
-			m_NetworkClient.Start();
+			m_NetworkClient.StartLocal(m_LocalhostServer->ConnectLocalClient());
 			m_TimerSendPlayerInfos.Start();
 		}
 		else
@@ -131,13 +124,11 @@ namespace onion::voxel
 		m_Renderer.SetRenderState(Renderer::eRenderState::InGame);
 
 		// Sends a message to Server
-		std::this_thread::sleep_for(std::chrono::milliseconds(100));
-
 		ClientInfoMsg clientInfoMsg;
 		clientInfoMsg.PlayerName = m_Config.clientData.PlayerName;
 		clientInfoMsg.UUID = m_Config.clientData.UUID;
 
-		m_NetworkClient.Send(std::move(clientInfoMsg), true);
+		m_NetworkClient.Send(std::move(clientInfoMsg));
 	}
 
 	void Client::Handle_StartMultiplayerRequest(const ServerInfos& serverInfos)
@@ -165,7 +156,7 @@ namespace onion::voxel
 		clientInfoMsg.PlayerName = m_Config.clientData.PlayerName;
 		clientInfoMsg.UUID = m_Config.clientData.UUID;
 
-		m_NetworkClient.Send(std::move(clientInfoMsg), true);
+		m_NetworkClient.Send(std::move(clientInfoMsg));
 	}
 
 	void Client::Handle_StopPlayingRequest(const std::filesystem::path& worldPath)
@@ -207,7 +198,7 @@ namespace onion::voxel
 
 		//std::cout << "Requesting " << chunkPositions.size() << " missing chunks from server\n";
 
-		m_NetworkClient.Send(std::move(requestChunksMsg), false);
+		m_NetworkClient.Send(std::move(requestChunksMsg));
 	}
 
 	void Client::Handle_BlocksChanged(const WorldManager::BlocksChangedEventArgs& args)
@@ -229,7 +220,7 @@ namespace onion::voxel
 		BlocksChangedMsg blocksChangedMsg;
 		blocksChangedMsg.ChangedBlocks = std::move(changedBlocksDTO);
 
-		m_NetworkClient.Send(std::move(blocksChangedMsg), true);
+		m_NetworkClient.Send(std::move(blocksChangedMsg));
 	}
 
 	void Client::SubscribeToRendererEvents()
@@ -300,6 +291,10 @@ namespace onion::voxel
 				{
 					Handle_BlocksChangedMessageReceived(msg);
 				}
+				else if constexpr (std::is_same_v<T, ChunkDeltaMsg>)
+				{
+					Handle_ChunkDeltaMessageReceived(msg);
+				}
 				else if constexpr (std::is_same_v<T, EntitySnapshotMsg>)
 				{
 					Handle_EntitySnapshotMessageReceived(msg);
@@ -332,7 +327,8 @@ namespace onion::voxel
 
 	void Client::Handle_ChunkDataMessageReceived(const ChunkDataMsg& msg)
 	{
-		std::shared_ptr<Chunk> chunk = SerializerDTO::DeserializeChunk(msg.Chunk);
+		// Chunks received through ENet are already decoded, local ones still carry their DTO
+		std::shared_ptr<Chunk> chunk = msg.DecodedChunk ? msg.DecodedChunk : SerializerDTO::DeserializeChunk(msg.Chunk);
 
 		// Checks if the chunk is in the persistance distance
 		glm::ivec2 chunkPosition = chunk->GetPosition();
@@ -362,6 +358,13 @@ namespace onion::voxel
 		m_WorldManager->SetBlocks(changedBlocks, WorldManager::BlocksChangedEventArgs::eOrigin::ServerRequest, true);
 	}
 
+	void Client::Handle_ChunkDeltaMessageReceived(const ChunkDeltaMsg& msg)
+	{
+		std::vector<Block> changedBlocks = SerializerDTO::DeserializeChunkDelta(msg.Delta);
+
+		m_WorldManager->SetBlocks(changedBlocks, WorldManager::BlocksChangedEventArgs::eOrigin::ServerRequest, true);
+	}
+
 	void Client::Handle_EntitySnapshotMessageReceived(const EntitySnapshotMsg& msg)
 	{
 		//std::cout << "Received EntitySnapshotMsg: " << msg.Entities.size() << " entities\n";
@@ -431,7 +434,7 @@ namespace onion::voxel
 		PlayerInfoMsg playerInfoMsg;
 		playerInfoMsg.player = SerializerDTO::SerializePlayer(*player);
 
-		m_NetworkClient.Send(std::move(playerInfoMsg), false);
+		m_NetworkClient.Send(std::move(playerInfoMsg));
 	}
 
 } // namespace onion::voxel
@@ -64,6 +64,7 @@ namespace onion::voxel
 		void Handle_ServerInfoMessageReceived(const ServerInfoMsg& msg);
 		void Handle_ChunkDataMessageReceived(const ChunkDataMsg& msg);
 		void Handle_BlocksChangedMessageReceived(const BlocksChangedMsg& msg);
+		void Handle_ChunkDeltaMessageReceived(const ChunkDeltaMsg& msg);
 		void Handle_EntitySnapshotMessageReceived(const EntitySnapshotMsg& msg);
 
 		Timer m_TimerSendPlayerInfos;
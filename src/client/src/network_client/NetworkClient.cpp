@@ -3,7 +3,9 @@
 #include <iostream>
 #include <stdexcept>
 
+#include <shared/data_transfer_objects/serializer/SerializerDTO.hpp>
 #include <shared/init_enet_once/InitEnetOnce.hpp>
+#include <shared/profiler/Profiler.hpp>
 
 namespace onion::voxel
 {
@@ -32,9 +34,9 @@ namespace onion::voxel
 	{
 		std::lock_guard<std::mutex> lock(m_Mutex);
 
-		m_Client = enet_host_create(nullptr, // client
-									1,		 // 1 outgoing connection
-									2,		 // channels
+		m_Client = enet_host_create(nullptr,			   // client
+									1,					   // 1 outgoing connection
+									NETWORK_CHANNEL_COUNT, // channels
 									0,
 									0);
 
@@ -45,7 +47,7 @@ namespace onion::voxel
 		enet_address_set_host(&address, m_Host.c_str());
 		address.port = m_Port;
 
-		m_Peer = enet_host_connect(m_Client, &address, 2, 0);
+		m_Peer = enet_host_connect(m_Client, &address, NETWORK_CHANNEL_COUNT, 0);
 
 		if (!m_Peer)
 			throw std::runtime_error("No available peers for connection.");
@@ -57,6 +59,24 @@ namespace onion::voxel
 		m_IsRunning.store(true);
 	}
 
+	void NetworkClient::StartLocal(std::shared_ptr<LocalConnection> connection)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		// Messages are received on the local reception thread, like ENet messages on the event thread
+		connection->BindClient([this](NetworkMessage&& message) { m_LocalIncomingMessages.Push(std::move(message)); },
+							   [this]() { m_LocalIncomingMessages.Push(std::nullopt); });
+
+		m_LocalConnection = std::move(connection);
+
+		std::cout << "Connected to local server.\n";
+
+		m_ReceiveLocalMessagesThread =
+			std::jthread([this](std::stop_token stopToken) { ReceiveLocalMessages(stopToken); });
+
+		m_IsRunning.store(true);
+	}
+
 	void NetworkClient::Stop()
 	{
 		if (m_EventThread.joinable())
@@ -65,6 +85,23 @@ namespace onion::voxel
 			m_EventThread.join();
 		}
 
+		std::shared_ptr<LocalConnection> localConnection;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			localConnection = std::move(m_LocalConnection);
+		}
+
+		if (localConnection)
+		{
+			localConnection->CloseFromClient();
+		}
+
+		if (m_ReceiveLocalMessagesThread.joinable())
+		{
+			m_ReceiveLocalMessagesThread.request_stop();
+			m_ReceiveLocalMessagesThread.join();
+		}
+
 		EvtDisconnected.Trigger(true);
 
 		std::lock_guard<std::mutex> lock(m_Mutex);
@@ -110,12 +147,26 @@ namespace onion::voxel
 		return m_IsRunning.load();
 	}
 
-	void NetworkClient::Send(NetworkMessage message, bool reliable)
+	void NetworkClient::Send(NetworkMessage message)
 	{
+		std::shared_ptr<LocalConnection> localConnection;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			localConnection = m_LocalConnection;
+		}
+
+		// The local server gets the message as is, without serialization
+		if (localConnection)
+		{
+			localConnection->SendToServer(std::move(message));
+			return;
+		}
+
 		OutgoingMessage out;
+		out.Policy = GetChannelPolicy(message);
 		out.Message = std::move(message);
-		out.Reliable = reliable;
 
+		m_ChannelStats.OnQueued(out.Policy.Channel);
 		m_OutgoingMessages.Push(std::move(out));
 	}
 
@@ -151,8 +202,15 @@ namespace onion::voxel
 		}
 	}
 
+	std::array<ChannelStats, NETWORK_CHANNEL_COUNT> NetworkClient::GetChannelStats() const
+	{
+		return m_ChannelStats.Snapshot();
+	}
+
 	void NetworkClient::ListenForEvents(std::stop_token stopToken)
 	{
+		Profiler::SetThreadName("Network");
+
 		ENetEvent event;
 
 		while (!stopToken.stop_requested())
@@ -170,10 +228,15 @@ namespace onion::voxel
 
 					case ENET_EVENT_TYPE_RECEIVE:
 						{
+							ONION_PROFILE_ZONE("NetworkClient::ReceiveMessage");
+
 							const auto* rawData = reinterpret_cast<const char*>(event.packet->data);
 
 							const std::size_t dataSize = static_cast<std::size_t>(event.packet->dataLength);
 
+							m_ChannelStats.OnReceived(event.channelID, dataSize);
+							ONION_PROFILE_COUNT("NetworkClient::BytesReceived", dataSize);
+
 							struct MemoryStreamBuf : std::streambuf
 							{
 								MemoryStreamBuf(const char* data, std::size_t size)
@@ -193,21 +256,22 @@ namespace onion::voxel
 								MessageHeader header;
 								archive(header);
 
-								NetworkMessage msg = DeserializeMessage(archive, header.Type);
-
-								if (header.Type == MessageHeader::eType::ServerInfo)
+								if (header.Type == MessageHeader::eType::ChunkData)
 								{
-									// Extracts ClientHandle from the ServerInfoMessage and updates m_ClientHandle
-									ServerInfoMsg serverInfo = std::get<ServerInfoMsg>(msg);
-
-									m_ClientHandle.store(serverInfo.ClientHandle);
+									// Decoded straight from the packet into the chunk storage, without ChunkDTO
+									ChunkDataMsg chunkData;
+									chunkData.DecodedChunk =
+										SerializerDTO::DecodeChunk(event.packet->data + MessageHeader::BINARY_SIZE,
+																   dataSize - MessageHeader::BINARY_SIZE);
 
-									std::cout << "Assigned ClientHandle: " << m_ClientHandle.load() << "\n";
-
-									EvtConnected.Trigger(serverInfo);
+									OnMessageReceived(std::move(chunkData));
 								}
+								else
+								{
+									NetworkMessage msg = DeserializeMessage(archive, header.Type);
 
-								m_IncomingMessages.Push(std::move(msg));
+									OnMessageReceived(std::move(msg));
+								}
 							}
 							catch (const std::exception& e)
 							{
@@ -262,10 +326,16 @@ namespace onion::voxel
 
 		while (m_OutgoingMessages.TryPop(msg))
 		{
+			m_ChannelStats.OnDequeued(msg.Policy.Channel);
+
+			ONION_PROFILE_ZONE("NetworkClient::SendMessage");
+
 			// Serialize message
 			std::vector<uint8_t> buffer = SerializeNetworkMessage(msg.Message);
 
-			const enet_uint32 flags = msg.Reliable ? ENET_PACKET_FLAG_RELIABLE : 0;
+			// Unreliable packets are sequenced by default in ENet (no ENET_PACKET_FLAG_UNSEQUENCED).
+			const enet_uint32 flags = msg.Policy.Reliable ? ENET_PACKET_FLAG_RELIABLE : 0;
+			const enet_uint8 channelId = static_cast<enet_uint8>(msg.Policy.Channel);
 
 			std::lock_guard<std::mutex> lock(m_Mutex);
 
@@ -274,7 +344,15 @@ namespace onion::voxel
 
 			ENetPacket* packet = enet_packet_create(buffer.data(), buffer.size(), flags);
 
-			enet_peer_send(m_Peer, 0, packet);
+			if (enet_peer_send(m_Peer, channelId, packet) == 0)
+			{
+				m_ChannelStats.OnSent(msg.Policy.Channel, buffer.size());
+				ONION_PROFILE_COUNT("NetworkClient::BytesSent", buffer.size());
+			}
+			else
+			{
+				enet_packet_destroy(packet);
+			}
 		}
 
 		// Flush once after processing all queued messages
@@ -293,4 +371,38 @@ namespace onion::voxel
 			EvtMessageReceived.Trigger(msg);
 		}
 	}
+
+	void NetworkClient::OnMessageReceived(NetworkMessage&& message)
+	{
+		if (const ServerInfoMsg* serverInfo = std::get_if<ServerInfoMsg>(&message))
+		{
+			// Extracts ClientHandle from the ServerInfoMessage and updates m_ClientHandle
+			m_ClientHandle.store(serverInfo->ClientHandle);
+
+			std::cout << "Assigned ClientHandle: " << m_ClientHandle.load() << "\n";
+
+			EvtConnected.Trigger(*serverInfo);
+		}
+
+		m_IncomingMessages.Push(std::move(message));
+	}
+
+	void NetworkClient::ReceiveLocalMessages(std::stop_token stopToken)
+	{
+		std::optional<NetworkMessage> msg;
+
+		while (m_LocalIncomingMessages.WaitPop(msg, stopToken))
+		{
+			if (msg)
+			{
+				OnMessageReceived(std::move(*msg));
+				continue;
+			}
+
+			std::cout << "Disconnected from local server.\n";
+			EvtDisconnected.Trigger(true);
+			m_IsRunning.store(false);
+			return;
+		}
+	}
 } // namespace onion::voxel
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 
@@ -11,6 +13,7 @@
 #include <onion/Event.hpp>
 #include <onion/ThreadSafeQueue.hpp>
 
+#include <shared/local_connection/LocalConnection.hpp>
 #include <shared/network_messages/NetworkMessages.hpp>
 
 namespace onion::voxel
@@ -28,9 +31,15 @@ namespace onion::voxel
 	  public:
 		void Start();
 		void Stop();
+
+		/// @brief Connect to an in-process server (singleplayer). No socket is opened.
+		/// @param connection The connection returned by NetworkServer::ConnectLocalClient.
+		void StartLocal(std::shared_ptr<LocalConnection> connection);
+
 		bool IsRunning() const noexcept;
 
-		void Send(NetworkMessage message, bool reliable = true);
+		// The channel and reliability of a message are given by its type (see GetChannelPolicy).
+		void Send(NetworkMessage message);
 
 		// ----- Getters / Setters -----
 	  public:
@@ -40,6 +49,8 @@ namespace onion::voxel
 		uint16_t GetRemotePort() const;
 		void SetRemotePort(uint16_t port);
 
+		std::array<ChannelStats, NETWORK_CHANNEL_COUNT> GetChannelStats() const;
+
 		// ----- Events -----
 	  public:
 		Event<const NetworkMessage&> EvtMessageReceived;
@@ -51,7 +62,7 @@ namespace onion::voxel
 		struct OutgoingMessage
 		{
 			NetworkMessage Message;
-			bool Reliable = true;
+			ChannelPolicy Policy{};
 		};
 
 		// ------ Private Members ------
@@ -62,6 +73,7 @@ namespace onion::voxel
 	  private:
 		ThreadSafeQueue<NetworkMessage> m_IncomingMessages;
 		ThreadSafeQueue<OutgoingMessage> m_OutgoingMessages;
+		ChannelStatsCounters m_ChannelStats;
 
 		// ----- Enet -----
 	  private:
@@ -78,10 +90,21 @@ namespace onion::voxel
 		std::vector<uint8_t> SerializeNetworkMessage(const NetworkMessage& message);
 		void ProcessOutgoingMessages();
 
+		// ----- Local Connection -----
+	  private:
+		std::shared_ptr<LocalConnection> m_LocalConnection;
+
+		// std::nullopt : the server closed the connection
+		ThreadSafeQueue<std::optional<NetworkMessage>> m_LocalIncomingMessages;
+		std::jthread m_ReceiveLocalMessagesThread;
+		void ReceiveLocalMessages(std::stop_token stopToken);
+
 		// ----- Incoming Message Handling -----
 	  private:
 		std::jthread m_DispatchIncomingMessagesThread;
 		void DispatchIncomingMessages(std::stop_token stopToken);
+
+		void OnMessageReceived(NetworkMessage&& message);
 	};
 
 } // namespace onion::voxel
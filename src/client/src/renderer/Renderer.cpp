@@ -351,6 +351,8 @@ namespace onion::voxel
 		// Load the icon image using stb_image
 		int width, height, channels;
 
+		// GLFW expects the top row first. The flag is per thread, see DecodedImage::Decode
+		stbi_set_flip_vertically_on_load_thread(false);
 		unsigned char* pixels = stbi_load(m_WindowIconPath.string().c_str(), &width, &height, &channels, 4);
 
 		if (!pixels)
@@ -1654,7 +1656,9 @@ namespace onion::voxel
 		{
 			if (!m_IsPaused)
 			{
-				m_WorldManager->RemoveDistantChunks();
+				m_WorldManager->UpdateChunkTickets();
+				constexpr size_t maxBlockUpdates = 4096; // Per frame, large edits spread over several frames
+				m_WorldManager->ProcessBlockUpdates(maxBlockUpdates);
 				constexpr float maxDeltaTime = 1.f / 30.f; // Cap delta time to avoid big jumps
 				float deltaTime = static_cast<float>(m_DeltaTime);
 				m_PhysicsEngine.Update(std::min(deltaTime, maxDeltaTime));
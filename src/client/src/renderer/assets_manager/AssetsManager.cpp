@@ -43,6 +43,7 @@ namespace onion::voxel
 		}
 
 		m_ResourcePackManager.SetResourcePackDirectory(resourcePacksDirectory);
+		m_ResourcePackManager.SetCacheDirectory(GetCacheDirectory());
 
 		const auto textsDir = GetTextsDirectory();
 		if (!std::filesystem::exists(textsDir))
@@ -110,6 +111,18 @@ namespace onion::voxel
 		return m_ResourcePackManager.GetFileBinary(path);
 	}
 
+	std::shared_ptr<const DecodedImage> AssetsManager::GetResourcePackImage(const std::filesystem::path& path,
+																			bool flipVertically,
+																			int channels) const
+	{
+		return m_ResourcePackManager.GetImage(path, flipVertically, channels);
+	}
+
+	std::shared_ptr<const nlohmann::json> AssetsManager::GetResourcePackJson(const std::filesystem::path& path) const
+	{
+		return m_ResourcePackManager.GetJson(path);
+	}
+
 	void AssetsManager::SetCurrentResourcePack(const std::string& resourcePack)
 	{
 		m_ResourcePackManager.SetCurrentResourcePack(resourcePack);
@@ -150,4 +163,9 @@ namespace onion::voxel
 		return s_ExecutableDirectory / ASSETS_FOLDER_NAME / APPICONS_FOLDER_NAME;
 	}
 
+	std::filesystem::path AssetsManager::GetCacheDirectory()
+	{
+		return s_ExecutableDirectory / ASSETS_FOLDER_NAME / CACHE_FOLDER_NAME;
+	}
+
 } // namespace onion::voxel
@@ -31,6 +31,18 @@ namespace onion::voxel
 		/// @param path The relative path to the file within the resource pack.
 		/// @return A vector containing the binary content of the file.
 		std::vector<unsigned char> GetResourcePackFileBinary(const std::filesystem::path& path) const;
+		/// @brief Gets a decoded image from the currently selected resource pack. Decoded images are cached by content.
+		/// @param path The relative path to the image within the resource pack.
+		/// @param flipVertically Whether the rows are stored bottom to top (OpenGL order).
+		/// @param channels Channels of the pixels, 0 to keep the ones of the file.
+		/// @return The decoded image, shared with the cache.
+		std::shared_ptr<const DecodedImage> GetResourcePackImage(const std::filesystem::path& path,
+																 bool flipVertically = false,
+																 int channels = 0) const;
+		/// @brief Gets a parsed JSON file from the currently selected resource pack, cached by content.
+		/// @param path The relative path to the file within the resource pack.
+		/// @return The parsed JSON, shared with the cache.
+		std::shared_ptr<const nlohmann::json> GetResourcePackJson(const std::filesystem::path& path) const;
 
 		/// @brief Sets the current resource pack name to use for asset retrieval
 		/// @param resourcePack The name of the resource pack to set as current.
@@ -45,6 +57,7 @@ namespace onion::voxel
 		static std::filesystem::path GetResourcePacksDirectory();
 		static std::filesystem::path GetTextsDirectory();
 		static std::filesystem::path GetAppIconsDirectory();
+		static std::filesystem::path GetCacheDirectory();
 
 		// ----- Private Methods / Members -----
 	  private:
@@ -56,6 +69,7 @@ namespace onion::voxel
 		static inline const std::string RESOURCE_PACKS_FOLDER_NAME = "resourcepacks";
 		static inline const std::string TEXTS_FOLDER_NAME = "texts";
 		static inline const std::string APPICONS_FOLDER_NAME = "app_icons";
+		static inline const std::string CACHE_FOLDER_NAME = "cache";
 
 		ResourcePackManager m_ResourcePackManager;
 	};
@@ -0,0 +1,392 @@
+#include "AssetCache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/vector.hpp>
+
+#include <shared/utils/Utils.hpp>
+#include <stb_image.h>
+
+namespace onion::voxel
+{
+	// ----- Decoded Image -----
+
+	DecodedImage DecodedImage::Decode(const std::vector<unsigned char>& data,
+									  const std::string& name,
+									  bool flipVertically,
+									  int desiredChannels)
+	{
+		if (data.empty())
+			throw std::runtime_error("Image data is empty: " + name);
+
+		// Decoded by several workers at once, with different flips : stb's global flag would race.
+		// Once set on a thread, stb ignores the global flag there : every stb caller sets the thread flag.
+		stbi_set_flip_vertically_on_load_thread(flipVertically);
+
+		int width, height, channels;
+		unsigned char* pixels = stbi_load_from_memory(
+			data.data(), static_cast<int>(data.size()), &width, &height, &channels, desiredChannels);
+		if (!pixels)
+		{
+			const char* reason = stbi_failure_reason();
+			throw std::runtime_error("Failed to decode image '" + name + "': " + (reason ? reason : "Unknown error"));
+		}
+
+		DecodedImage image;
+		image.Width = width;
+		image.Height = height;
+		image.Channels = desiredChannels != 0 ? desiredChannels : channels;
+		image.Pixels.assign(pixels, pixels + static_cast<size_t>(width) * height * image.Channels);
+
+		stbi_image_free(pixels);
+
+		return image;
+	}
+
+	// ----- Public API -----
+
+	uint64_t AssetCache::MakeKey(
+		uint32_t sourceCrc32, uint64_t sourceSize, AssetKind kind, bool flipVertically, int channels)
+	{
+		constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+		constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+		uint64_t hash = FNV_OFFSET;
+		auto mix = [&hash](uint64_t value, int bytes)
+		{
+			for (int i = 0; i < bytes; i++)
+			{
+				hash ^= (value >> (i * 8)) & 0xFF;
+				hash *= FNV_PRIME;
+			}
+		};
+
+		mix(sourceCrc32, 4);
+		mix(sourceSize, 8);
+		mix(static_cast<uint64_t>(kind), 1);
+		mix(flipVertically ? 1 : 0, 1);
+		mix(static_cast<uint64_t>(channels), 1);
+
+		return hash;
+	}
+
+	std::shared_ptr<const DecodedImage> AssetCache::GetImage(uint64_t key, const std::function<DecodedImage()>& decode)
+	{
+		std::filesystem::path spillDirectory;
+		{
+			std::lock_guard lock(m_Mutex);
+			auto it = m_Images.find(key);
+			if (it != m_Images.end())
+			{
+				it->second.LastUse = ++m_UseCounter;
+				return it->second.Value;
+			}
+			spillDirectory = m_SpillDirectory;
+		}
+
+		// ---- Miss : from the disk, or decoded (without the lock) ----
+		std::shared_ptr<const DecodedImage> image;
+		if (!spillDirectory.empty())
+			image = LoadSpilledImage(spillDirectory, key);
+
+		if (!image)
+		{
+			image = std::make_shared<const DecodedImage>(decode());
+			if (!spillDirectory.empty() && image->Pixels.size() >= SPILL_MIN_BYTES)
+				SpillImage(spillDirectory, key, *image);
+		}
+
+		std::lock_guard lock(m_Mutex);
+		auto [it, inserted] = m_Images.try_emplace(key);
+		if (inserted)
+		{
+			it->second.Value = image;
+			it->second.Bytes = image->Pixels.size();
+			m_MemoryUsage += it->second.Bytes;
+		}
+		it->second.LastUse = ++m_UseCounter;
+
+		std::shared_ptr<const DecodedImage> result = it->second.Value;
+		Trim();
+
+		return result;
+	}
+
+	std::shared_ptr<const nlohmann::json> AssetCache::GetJson(uint64_t key,
+															  size_t sourceSize,
+															  const std::function<nlohmann::json()>& parse)
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			auto it = m_Jsons.find(key);
+			if (it != m_Jsons.end())
+			{
+				it->second.LastUse = ++m_UseCounter;
+				return it->second.Value;
+			}
+		}
+
+		auto json = std::make_shared<const nlohmann::json>(parse());
+
+		std::lock_guard lock(m_Mutex);
+		auto [it, inserted] = m_Jsons.try_emplace(key);
+		if (inserted)
+		{
+			it->second.Value = json;
+			it->second.Bytes = sourceSize;
+			m_MemoryUsage += it->second.Bytes;
+		}
+		it->second.LastUse = ++m_UseCounter;
+
+		std::shared_ptr<const nlohmann::json> result = it->second.Value;
+		Trim();
+
+		return result;
+	}
+
+	void AssetCache::SetSpillDirectory(const std::filesystem::path& directory)
+	{
+		std::error_code error;
+		if (!directory.empty())
+			std::filesystem::create_directories(directory, error);
+
+		std::lock_guard lock(m_Mutex);
+		if (error)
+		{
+			std::cerr << "[AssetCache] Cannot create the spill directory " << directory << ": " << error.message()
+					  << std::endl;
+			m_SpillDirectory.clear();
+			return;
+		}
+
+		m_SpillDirectory = directory;
+
+		std::lock_guard spillLock(m_SpillMutex);
+		m_IsSpillSizeKnown = false;
+	}
+
+	void AssetCache::Clear()
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Images.clear();
+		m_Jsons.clear();
+		m_MemoryUsage = 0;
+	}
+
+	size_t AssetCache::GetMemoryUsage() const
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_MemoryUsage;
+	}
+
+	// ----- Private Methods -----
+
+	void AssetCache::Trim()
+	{
+		if (m_MemoryUsage <= MAX_MEMORY_BYTES)
+			return;
+
+		// Oldest first. Evicted assets still in use stay alive through their shared_ptr.
+		std::vector<std::tuple<uint64_t, bool, uint64_t>> entries; // LastUse, IsImage, Key
+		entries.reserve(m_Images.size() + m_Jsons.size());
+		for (const auto& [key, entry] : m_Images)
+			entries.emplace_back(entry.LastUse, true, key);
+		for (const auto& [key, entry] : m_Jsons)
+			entries.emplace_back(entry.LastUse, false, key);
+		std::sort(entries.begin(), entries.end());
+
+		// Trim below the budget, so the next inserts do not sort again right away
+		const size_t target = MAX_MEMORY_BYTES / 4 * 3;
+		for (const auto& [lastUse, isImage, key] : entries)
+		{
+			if (m_MemoryUsage <= target)
+				break;
+
+			if (isImage)
+			{
+				auto it = m_Images.find(key);
+				m_MemoryUsage -= it->second.Bytes;
+				m_Images.erase(it);
+			}
+			else
+			{
+				auto it = m_Jsons.find(key);
+				m_MemoryUsage -= it->second.Bytes;
+				m_Jsons.erase(it);
+			}
+		}
+	}
+
+	std::shared_ptr<const DecodedImage> AssetCache::LoadSpilledImage(const std::filesystem::path& directory,
+																	 uint64_t key)
+	{
+		const std::filesystem::path spillPath = GetSpillPath(directory, key);
+
+		std::ifstream file(spillPath, std::ios::binary);
+		if (!file.is_open())
+			return nullptr;
+
+		try
+		{
+			cereal::BinaryInputArchive archive(file);
+
+			uint32_t magic = 0;
+			uint32_t version = 0;
+			uint64_t fileKey = 0;
+			archive(magic, version, fileKey);
+			if (magic != SPILL_MAGIC || version != SPILL_FORMAT_VERSION || fileKey != key)
+				return nullptr;
+
+			auto image = std::make_shared<DecodedImage>();
+			archive(image->Width, image->Height, image->Channels, image->Pixels);
+			if (image->Pixels.size() != static_cast<size_t>(image->Width) * image->Height * image->Channels)
+				return nullptr;
+
+			// Used : the last to be deleted by TrimSpillDirectory
+			std::error_code ec;
+			std::filesystem::last_write_time(spillPath, std::filesystem::file_time_type::clock::now(), ec);
+
+			return image;
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "[AssetCache] Ignoring corrupted spilled image: " << e.what() << std::endl;
+			return nullptr;
+		}
+	}
+
+	void AssetCache::SpillImage(const std::filesystem::path& directory, uint64_t key, const DecodedImage& image)
+	{
+		const std::filesystem::path spillPath = GetSpillPath(directory, key);
+
+		// One temp file per writer : threads (or clients sharing the cache) spilling the same key never write to the
+		// same file, and the last atomic replace wins with a complete image
+		static const uint32_t s_ProcessTag = std::random_device{}();
+		static std::atomic_uint64_t s_SpillCounter{0};
+
+		char tempSuffix[48];
+		std::snprintf(tempSuffix,
+					  sizeof(tempSuffix),
+					  ".%08x.%llu.tmp",
+					  s_ProcessTag,
+					  static_cast<unsigned long long>(s_SpillCounter.fetch_add(1)));
+
+		std::filesystem::path tempPath = spillPath;
+		tempPath += tempSuffix;
+
+		try
+		{
+			{
+				std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+				if (!file.is_open())
+					return;
+
+				cereal::BinaryOutputArchive archive(file);
+				archive(SPILL_MAGIC, SPILL_FORMAT_VERSION, key);
+				archive(image.Width, image.Height, image.Channels, image.Pixels);
+
+				file.close();
+				if (!file)
+					throw std::runtime_error("Failed to write " + tempPath.string());
+			}
+
+			const uint64_t fileBytes = std::filesystem::file_size(tempPath);
+			Utils::ReplaceFileAtomic(spillPath, tempPath);
+
+			std::lock_guard lock(m_SpillMutex);
+			m_SpillBytes += fileBytes; // A replaced spill is counted twice until the next trim recounts
+			if (!m_IsSpillSizeKnown || m_SpillBytes > MAX_SPILL_BYTES)
+				TrimSpillDirectory(directory);
+		}
+		catch (const std::exception& e)
+		{
+			std::error_code ec;
+			std::filesystem::remove(tempPath, ec);
+
+			// Only a cache : the image is decoded again next time
+			std::cerr << "[AssetCache] Failed to spill image: " << e.what() << std::endl;
+		}
+	}
+
+	void AssetCache::TrimSpillDirectory(const std::filesystem::path& directory)
+	{
+		struct SpilledFile
+		{
+			std::filesystem::file_time_type LastWrite;
+			uint64_t Bytes = 0;
+			std::filesystem::path Path;
+		};
+
+		// Older temp files were left by a crash, newer ones may be spills being written
+		const auto staleTempTime = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+
+		std::vector<SpilledFile> files;
+		uint64_t totalBytes = 0;
+
+		std::error_code ec;
+		for (const auto& entry : std::filesystem::directory_iterator(directory, ec))
+		{
+			std::error_code entryError;
+			if (!entry.is_regular_file(entryError))
+				continue;
+
+			const std::filesystem::path& path = entry.path();
+			if (path.extension() == ".tmp")
+			{
+				if (entry.last_write_time(entryError) < staleTempTime && !entryError)
+					std::filesystem::remove(path, entryError);
+				continue;
+			}
+			if (path.extension() != ".img")
+				continue;
+
+			SpilledFile file;
+			file.Bytes = entry.file_size(entryError);
+			file.LastWrite = entry.last_write_time(entryError);
+			file.Path = path;
+			if (entryError)
+				continue;
+
+			totalBytes += file.Bytes;
+			files.push_back(std::move(file));
+		}
+
+		m_IsSpillSizeKnown = true;
+		m_SpillBytes = totalBytes;
+
+		if (m_SpillBytes <= MAX_SPILL_BYTES)
+			return;
+
+		// Oldest first, down below the budget so the next spills do not scan again right away
+		std::sort(files.begin(),
+				  files.end(),
+				  [](const SpilledFile& a, const SpilledFile& b) { return a.LastWrite < b.LastWrite; });
+
+		const uint64_t target = MAX_SPILL_BYTES / 4 * 3;
+		for (const SpilledFile& file : files)
+		{
+			if (m_SpillBytes <= target)
+				break;
+
+			std::error_code removeError;
+			if (std::filesystem::remove(file.Path, removeError))
+				m_SpillBytes -= file.Bytes;
+		}
+	}
+
+	std::filesystem::path AssetCache::GetSpillPath(const std::filesystem::path& directory, uint64_t key)
+	{
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.img", static_cast<unsigned long long>(key));
+		return directory / name;
+	}
+} // namespace onion::voxel
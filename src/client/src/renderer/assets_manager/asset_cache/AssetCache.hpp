@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace onion::voxel
+{
+	/// @brief Pixels of a decoded image, rows top to bottom (or bottom to top if decoded flipped).
+	struct DecodedImage
+	{
+		int Width = 0;
+		int Height = 0;
+		int Channels = 0;
+
+		std::vector<unsigned char> Pixels; // Width x Height x Channels
+
+		/// @brief Decode an encoded image (PNG...).
+		/// @param desiredChannels Channels of the result, 0 to keep the ones of the file.
+		static DecodedImage Decode(const std::vector<unsigned char>& data,
+								   const std::string& name,
+								   bool flipVertically,
+								   int desiredChannels);
+	};
+
+	/// @brief Decoded assets, addressed by the content they were decoded from.
+	/// The same file in two resource packs is decoded once, and switching back to a pack finds its assets still
+	/// decoded. Large images are also spilled to disk, so they survive a restart.
+	/// Thread safe. Two threads missing the same key at once may both decode it, the first one is kept.
+	class AssetCache
+	{
+		// ----- Public API -----
+	  public:
+		enum class AssetKind : uint8_t
+		{
+			Image,
+			Json
+		};
+
+		/// @brief Key of a decoded asset, from its source bytes and the way they are decoded.
+		static uint64_t MakeKey(uint32_t sourceCrc32,
+								uint64_t sourceSize,
+								AssetKind kind,
+								bool flipVertically = false,
+								int channels = 0);
+
+		std::shared_ptr<const DecodedImage> GetImage(uint64_t key, const std::function<DecodedImage()>& decode);
+		/// @param sourceSize Size of the JSON text, accounts for the memory of the parsed document.
+		std::shared_ptr<const nlohmann::json> GetJson(uint64_t key,
+													  size_t sourceSize,
+													  const std::function<nlohmann::json()>& parse);
+
+		/// @brief Directory where large images are spilled. Empty to keep everything in memory.
+		void SetSpillDirectory(const std::filesystem::path& directory);
+
+		void Clear();
+
+		size_t GetMemoryUsage() const;
+
+		// ----- Private Structs -----
+	  private:
+		template <typename T> struct CacheEntry
+		{
+			std::shared_ptr<const T> Value;
+			size_t Bytes = 0;
+			uint64_t LastUse = 0;
+		};
+
+		// ----- Private Methods -----
+	  private:
+		/// @brief Drop the least recently used entries until the cache fits in its budget. Lock must be held.
+		void Trim();
+
+		static std::shared_ptr<const DecodedImage> LoadSpilledImage(const std::filesystem::path& directory,
+																	 uint64_t key);
+		void SpillImage(const std::filesystem::path& directory, uint64_t key, const DecodedImage& image);
+
+		/// @brief Delete the least recently used spilled images until the directory fits in its budget.
+		/// Recounts the directory (first spill, or over budget) and removes the temp files left by crashes.
+		/// Spill lock must be held.
+		void TrimSpillDirectory(const std::filesystem::path& directory);
+
+		static std::filesystem::path GetSpillPath(const std::filesystem::path& directory, uint64_t key);
+
+		// ----- Constants -----
+	  private:
+		static constexpr size_t MAX_MEMORY_BYTES = 256ull * 1024 * 1024;
+		// Smaller images decode faster than they load from disk (a block texture is 1 KiB)
+		static constexpr size_t SPILL_MIN_BYTES = 64 * 1024;
+		// Disk budget of the spill directory, least recently used images (by modification time) are deleted first
+		static constexpr uint64_t MAX_SPILL_BYTES = 1024ull * 1024 * 1024;
+
+		static constexpr uint32_t SPILL_MAGIC = 0x4943564F; // "OVCI"
+		static constexpr uint32_t SPILL_FORMAT_VERSION = 1;
+
+		// ----- Private Members -----
+	  private:
+		mutable std::mutex m_Mutex;
+
+		std::unordered_map<uint64_t, CacheEntry<DecodedImage>> m_Images;
+		std::unordered_map<uint64_t, CacheEntry<nlohmann::json>> m_Jsons;
+
+		size_t m_MemoryUsage = 0;
+		uint64_t m_UseCounter = 0;
+
+		std::filesystem::path m_SpillDirectory;
+
+		// Held while counting and trimming the spilled images. m_Mutex is never taken while it is held
+		std::mutex m_SpillMutex;
+		bool m_IsSpillSizeKnown = false; // The directory is counted on the first spill
+		uint64_t m_SpillBytes = 0;
+	};
+} // namespace onion::voxel
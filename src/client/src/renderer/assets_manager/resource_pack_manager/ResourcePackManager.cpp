@@ -8,52 +8,99 @@ namespace onion::voxel
 
 	std::string ResourcePackManager::GetFileText(const std::filesystem::path& path) const
 	{
-		std::lock_guard lock(m_Mutex);
-		if (m_ResourcePackArchive && m_ResourcePackArchive->FileExists(path))
-		{
-			return m_ResourcePackArchive->GetFileText(path);
-		}
-		else if (m_DefaultResourcePackArchive && m_DefaultResourcePackArchive->FileExists(path))
-		{
-			return m_DefaultResourcePackArchive->GetFileText(path);
-		}
-		else
-		{
+		std::shared_ptr<const ZipArchive> archive = FindArchive(path);
+		if (!archive)
 			throw std::runtime_error("ResourcePackManager::GetFileText: File not found: " + path.string());
-		}
+
+		return archive->GetFileText(path);
 	}
 
 	std::vector<unsigned char> ResourcePackManager::GetFileBinary(const std::filesystem::path& path) const
 	{
-		std::lock_guard lock(m_Mutex);
-		if (m_ResourcePackArchive && m_ResourcePackArchive->FileExists(path))
-		{
-			return m_ResourcePackArchive->GetFileBinary(path);
-		}
-		else if (m_DefaultResourcePackArchive && m_DefaultResourcePackArchive->FileExists(path))
-		{
-			return m_DefaultResourcePackArchive->GetFileBinary(path);
-		}
-		else
-		{
+		std::shared_ptr<const ZipArchive> archive = FindArchive(path);
+		if (!archive)
 			throw std::runtime_error("ResourcePackManager::GetFileBinary: File not found: " + path.string());
-		}
+
+		return archive->GetFileBinary(path);
 	}
 
-	void ResourcePackManager::SetResourcePackDirectory(const std::filesystem::path& directory)
+	std::shared_ptr<const DecodedImage> ResourcePackManager::GetImage(const std::filesystem::path& path,
+																	  bool flipVertically,
+																	  int channels) const
+	{
+		std::shared_ptr<const ZipArchive> archive = FindArchive(path);
+		if (!archive)
+			throw std::runtime_error("ResourcePackManager::GetImage: File not found: " + path.string());
+
+		// Keyed by the CRC of the entry, read from the zip index : a hit costs no read at all
+		const ZipArchive::FileInfo info = *archive->GetFileInfo(path);
+		const uint64_t key =
+			AssetCache::MakeKey(info.Crc32, info.Size, AssetCache::AssetKind::Image, flipVertically, channels);
+
+		return m_AssetCache.GetImage(key,
+									 [&]()
+									 {
+										 return DecodedImage::Decode(
+											 archive->GetFileBinary(path), path.string(), flipVertically, channels);
+									 });
+	}
+
+	std::shared_ptr<const nlohmann::json> ResourcePackManager::GetJson(const std::filesystem::path& path) const
+	{
+		std::shared_ptr<const ZipArchive> archive = FindArchive(path);
+		if (!archive)
+			throw std::runtime_error("ResourcePackManager::GetJson: File not found: " + path.string());
+
+		const ZipArchive::FileInfo info = *archive->GetFileInfo(path);
+		const uint64_t key = AssetCache::MakeKey(info.Crc32, info.Size, AssetCache::AssetKind::Json);
+
+		return m_AssetCache.GetJson(
+			key, static_cast<size_t>(info.Size), [&]() { return nlohmann::json::parse(archive->GetFileText(path)); });
+	}
+
+	std::shared_ptr<const ZipArchive> ResourcePackManager::FindArchive(const std::filesystem::path& path) const
 	{
 		std::lock_guard lock(m_Mutex);
-		m_ResourcePackDirectory = directory;
+		if (m_ResourcePackArchive && m_ResourcePackArchive->FileExists(path))
+			return m_ResourcePackArchive;
+		if (m_DefaultResourcePackArchive && m_DefaultResourcePackArchive->FileExists(path))
+			return m_DefaultResourcePackArchive;
+		return nullptr;
+	}
 
-		auto packPath = m_ResourcePackDirectory / m_CurrentResourcePack;
+	std::shared_ptr<const ZipArchive> ResourcePackManager::OpenPack(const std::string& resourcePack)
+	{
+		auto packPath = m_ResourcePackDirectory / resourcePack;
 		packPath += ".zip";
 
-		m_ResourcePackArchive = std::make_unique<ZipArchive>(packPath);
+		const auto writeTime = std::filesystem::last_write_time(packPath);
+		const auto fileSize = std::filesystem::file_size(packPath);
+
+		auto it = m_OpenedPacks.find(resourcePack);
+		if (it != m_OpenedPacks.end() && it->second.WriteTime == writeTime && it->second.FileSize == fileSize)
+			return it->second.Archive;
 
-		auto defaultPackPath = m_ResourcePackDirectory / DEFAULT_RESOURCE_PACK;
-		defaultPackPath += ".zip";
+		OpenedPack& pack = m_OpenedPacks[resourcePack];
+		pack.WriteTime = writeTime;
+		pack.FileSize = fileSize;
+		pack.Archive = std::make_shared<const ZipArchive>(packPath);
 
-		m_DefaultResourcePackArchive = std::make_unique<ZipArchive>(defaultPackPath);
+		return pack.Archive;
+	}
+
+	void ResourcePackManager::SetResourcePackDirectory(const std::filesystem::path& directory)
+	{
+		std::lock_guard lock(m_Mutex);
+		m_ResourcePackDirectory = directory;
+		m_OpenedPacks.clear();
+
+		m_ResourcePackArchive = OpenPack(m_CurrentResourcePack);
+		m_DefaultResourcePackArchive = OpenPack(DEFAULT_RESOURCE_PACK);
+	}
+
+	void ResourcePackManager::SetCacheDirectory(const std::filesystem::path& directory)
+	{
+		m_AssetCache.SetSpillDirectory(directory);
 	}
 
 	std::string ResourcePackManager::GetCurrentResourcePack() const
@@ -70,10 +117,7 @@ namespace onion::voxel
 			if (m_CurrentResourcePack != resourcePack)
 			{
 				m_CurrentResourcePack = resourcePack;
-
-				auto packPath = m_ResourcePackDirectory / m_CurrentResourcePack;
-				packPath += ".zip";
-				m_ResourcePackArchive = std::make_unique<ZipArchive>(packPath);
+				m_ResourcePackArchive = OpenPack(m_CurrentResourcePack);
 
 				changed = true;
 			}
@@ -4,10 +4,13 @@
 
 #include <shared/zip_archive/ZipArchive.hpp>
 
+#include "../asset_cache/AssetCache.hpp"
+
 #include <filesystem>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace onion::voxel
@@ -24,8 +27,19 @@ namespace onion::voxel
 		std::string GetFileText(const std::filesystem::path& path) const;
 		std::vector<unsigned char> GetFileBinary(const std::filesystem::path& path) const;
 
+		/// @brief Decoded image, cached : the same file is only decoded once, whatever the pack it comes from.
+		/// @param channels Channels of the result, 0 to keep the ones of the file.
+		std::shared_ptr<const DecodedImage> GetImage(const std::filesystem::path& path,
+													 bool flipVertically = false,
+													 int channels = 0) const;
+		/// @brief Parsed JSON file, cached like the images.
+		std::shared_ptr<const nlohmann::json> GetJson(const std::filesystem::path& path) const;
+
 		void SetResourcePackDirectory(const std::filesystem::path& directory);
 
+		/// @brief Directory where the asset cache spills large decoded images.
+		void SetCacheDirectory(const std::filesystem::path& directory);
+
 		// ----- Events -----
 	  public:
 		Event<const std::string&> EvtResourcePackChanged;
@@ -37,6 +51,22 @@ namespace onion::voxel
 
 		// ----- Private Methods -----
 	  private:
+		/// @brief Returns the archive holding the file (current pack first, then default), or nullptr.
+		/// The archive is kept alive by the caller, so it can be read without holding the lock.
+		std::shared_ptr<const ZipArchive> FindArchive(const std::filesystem::path& path) const;
+
+		/// @brief Returns the archive of a pack, opened again only if its file changed since. Lock must be held.
+		std::shared_ptr<const ZipArchive> OpenPack(const std::string& resourcePack);
+
+		// ----- Private Structs -----
+	  private:
+		struct OpenedPack
+		{
+			std::filesystem::file_time_type WriteTime;
+			uintmax_t FileSize = 0;
+			std::shared_ptr<const ZipArchive> Archive;
+		};
+
 		// ----- Static Members -----
 	  private:
 		static inline const std::string DEFAULT_RESOURCE_PACK = "Default";
@@ -47,7 +77,12 @@ namespace onion::voxel
 		std::string m_CurrentResourcePack = DEFAULT_RESOURCE_PACK;
 		std::filesystem::path m_ResourcePackDirectory;
 
-		std::unique_ptr<ZipArchive> m_ResourcePackArchive;
-		std::unique_ptr<ZipArchive> m_DefaultResourcePackArchive;
+		std::shared_ptr<const ZipArchive> m_ResourcePackArchive;
+		std::shared_ptr<const ZipArchive> m_DefaultResourcePackArchive;
+
+		// Packs opened so far, by name : switching back to a pack does not index its archive again
+		std::unordered_map<std::string, OpenedPack> m_OpenedPacks;
+
+		mutable AssetCache m_AssetCache;
 	};
 } // namespace onion::voxel
@@ -156,10 +156,14 @@ namespace onion::voxel
 	{
 		m_DefaultPlayerTexture.Delete();
 
-		auto defaultPlayerTextureData =
-			EngineContext::Get().Assets->GetResourcePackFileBinary(m_DefaultPlayerTexturePath);
-
-		m_DefaultPlayerTexture = Texture("DefaultPlayerTexture", defaultPlayerTextureData, true);
+		auto defaultPlayerImage = EngineContext::Get().Assets->GetResourcePackImage(m_DefaultPlayerTexturePath, true);
+
+		m_DefaultPlayerTexture = Texture("DefaultPlayerTexture",
+										 defaultPlayerImage->Pixels,
+										 defaultPlayerImage->Width,
+										 defaultPlayerImage->Height,
+										 defaultPlayerImage->Channels,
+										 true);
 	}
 
 	void EntityRenderer::Unload()
@@ -86,17 +86,17 @@ void onion::voxel::Sprite::ReloadTextures()
 	m_Texture.Delete();
 
 	// Load new texture data from the appropriate source based on the origin
-	std::vector<unsigned char> data;
 	if (m_Origin == eOrigin::Asset)
 	{
-		data = EngineContext::Get().Assets->GetFileBinary(m_SpritePath);
+		std::vector<unsigned char> data = EngineContext::Get().Assets->GetFileBinary(m_SpritePath);
+		m_Texture = Texture(m_SpritePath.string(), data);
 	}
 	else
 	{
-		data = EngineContext::Get().Assets->GetResourcePackFileBinary(m_SpritePath);
+		// Resource pack sprites are cached decoded, reloading after a pack switch does not decode them again
+		std::shared_ptr<const DecodedImage> image = EngineContext::Get().Assets->GetResourcePackImage(m_SpritePath);
+		m_Texture = Texture(m_SpritePath.string(), image->Pixels, image->Width, image->Height, image->Channels);
 	}
-
-	m_Texture = Texture(m_SpritePath.string(), data);
 }
 
 void onion::voxel::Sprite::PullEvents()
@@ -544,9 +544,14 @@ namespace onion::voxel
 
 			std::filesystem::path providerTexturePath =
 				std::filesystem::path("assets") / "minecraft" / "textures" / relativePath;
-			std::vector<uint8_t> textureData =
-				EngineContext::Get().Assets->GetResourcePackFileBinary(providerTexturePath);
-			provider.TextureGlyph = std::move(Texture(providerTexturePath.string(), textureData));
+			// Glyph pages are large : switching back to a pack reuses the decoded pages
+			std::shared_ptr<const DecodedImage> textureImage =
+				EngineContext::Get().Assets->GetResourcePackImage(providerTexturePath);
+			provider.TextureGlyph = std::move(Texture(providerTexturePath.string(),
+													  textureImage->Pixels,
+													  textureImage->Width,
+													  textureImage->Height,
+													  textureImage->Channels));
 			m_GlyphProviders.push_back(std::move(provider));
 			GlyphProvider& providerRef = m_GlyphProviders.back();
 			Texture& providerTexture = providerRef.TextureGlyph;
@@ -39,13 +39,16 @@ namespace onion::voxel
 		DeleteTextures();
 
 		// Loads the texture
-		std::vector<unsigned char> spriteData = EngineContext::Get().Assets->GetResourcePackFileBinary(spritePath);
-		Texture loadedTexture(GetName() + "_Texture", spriteData);
+		std::shared_ptr<const DecodedImage> spriteImage = EngineContext::Get().Assets->GetResourcePackImage(spritePath);
+		Texture loadedTexture(GetName() + "_Texture",
+							  spriteImage->Pixels,
+							  spriteImage->Width,
+							  spriteImage->Height,
+							  spriteImage->Channels);
 
 		// Loads Metadata
 		m_PathSpriteMetadata = spritePath.parent_path() / (spritePath.filename().string() + ".mcmeta");
-		std::string metadataContent = EngineContext::Get().Assets->GetResourcePackFileText(m_PathSpriteMetadata);
-		m_NineSliceMetadata = ReadMetadataFromContent(metadataContent);
+		m_NineSliceMetadata = ReadMetadata(*EngineContext::Get().Assets->GetResourcePackJson(m_PathSpriteMetadata));
 
 		// Get the pixel coordinates of the borders in the original texture
 		int x0 = 0;
@@ -613,8 +616,11 @@ namespace onion::voxel
 
 	inline NineSliceSprite::NineSliceMetadata NineSliceSprite::ReadMetadataFromContent(const std::string& content)
 	{
-		nlohmann::json json = nlohmann::json::parse(content);
+		return ReadMetadata(nlohmann::json::parse(content));
+	}
 
+	inline NineSliceSprite::NineSliceMetadata NineSliceSprite::ReadMetadata(const nlohmann::json& json)
+	{
 		try
 		{
 			const auto& scaling = json.at("gui").at("scaling");
@@ -656,7 +662,7 @@ namespace onion::voxel
 		}
 		catch (const std::exception& e)
 		{
-			throw std::runtime_error("Invalid nine-slice metadata format in file: " + content +
+			throw std::runtime_error("Invalid nine-slice metadata format in file: " + json.dump() +
 									 " | Reason: " + e.what());
 		}
 	}
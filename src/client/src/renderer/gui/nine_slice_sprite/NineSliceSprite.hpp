@@ -7,6 +7,7 @@
 #include <onion/Event.hpp>
 
 #include <glm/glm.hpp>
+#include <nlohmann/json.hpp>
 
 #include <filesystem>
 #include <mutex>
@@ -173,6 +174,7 @@ namespace onion::voxel
 	  private:
 		inline static NineSliceMetadata ReadMetadataFromFile(const std::filesystem::path& pathMetadataFile);
 		inline static NineSliceMetadata ReadMetadataFromContent(const std::string& content);
+		inline static NineSliceMetadata ReadMetadata(const nlohmann::json& json);
 
 		void BuildNineSliceMesh();
 		void BuildVertices();
@@ -76,7 +76,7 @@ namespace onion::voxel
 		glGenTextures(1, &m_TextureID);
 		glBindTexture(GL_TEXTURE_CUBE_MAP, m_TextureID);
 
-		stbi_set_flip_vertically_on_load(false);
+		stbi_set_flip_vertically_on_load_thread(false);
 
 		int width, height, nrChannels;
 
@@ -156,7 +156,7 @@ namespace onion::voxel
 
 		int width, height, nrChannels;
 
-		stbi_set_flip_vertically_on_load(false);
+		stbi_set_flip_vertically_on_load_thread(false);
 
 		for (unsigned int i = 0; i < faces.size(); i++)
 		{
@@ -303,7 +303,7 @@ namespace onion::voxel
 
 		int width, height, nrChannels;
 
-		stbi_set_flip_vertically_on_load(false);
+		stbi_set_flip_vertically_on_load_thread(false);
 
 		for (unsigned int i = 0; i < faces.size(); i++)
 		{
@@ -78,7 +78,7 @@ namespace onion::voxel
 
 		int width, height, channels;
 
-		stbi_set_flip_vertically_on_load(m_FlipVertically);
+		stbi_set_flip_vertically_on_load_thread(m_FlipVertically);
 
 		unsigned char* pixels =
 			stbi_load_from_memory(data.data(), static_cast<int>(data.size()), &width, &height, &channels, 0);
@@ -116,7 +116,7 @@ namespace onion::voxel
 	{
 		m_FilePath = filePath;
 		int width, height, nrChannels;
-		stbi_set_flip_vertically_on_load(m_FlipVertically); // For OpenGL coordinate system
+		stbi_set_flip_vertically_on_load_thread(m_FlipVertically); // For OpenGL coordinate system
 		unsigned char* data = stbi_load(m_FilePath.string().c_str(), &width, &height, &nrChannels, 0);
 
 		if (!data)
@@ -260,7 +260,7 @@ namespace onion::voxel
 		}
 
 		int width, height, nrChannels;
-		stbi_set_flip_vertically_on_load(m_FlipVertically); // For OpenGL coordinate system
+		stbi_set_flip_vertically_on_load_thread(m_FlipVertically); // For OpenGL coordinate system
 		unsigned char* data = stbi_load(m_FilePath.string().c_str(), &width, &height, &nrChannels, 0);
 		if (!data)
 		{
@@ -1,7 +1,5 @@
 #include "TextureAtlas.hpp"
 
-#include <cmath>
-#include <stb_image.h>
 #include <stdexcept>
 
 namespace onion::voxel
@@ -56,77 +54,33 @@ namespace onion::voxel
 	{
 		m_Texture.Delete();
 
-		size_t count = textureNames.size();
+		// Decoded on every core, the resource pack reads are thread safe.
+		// Textures already decoded (by a previous build, or in another pack) come from the asset cache.
+		AtlasImage image = TextureAtlasBuilder::Build(
+			textureNames,
+			[](const std::string& textureName)
+			{ return EngineContext::Get().Assets->GetResourcePackImage(s_TexturesDirectory / textureName, true, 4); });
 
-		int grid = (int) std::ceil(std::sqrt((float) count));
+		m_TextureSize = image.TextureSize;
+		m_AtlasSize = image.AtlasSize;
 
-		// Loads a texture to check the texture size, assumes all textures are the same size
-		{
-			int w, h, channels;
-
-			stbi_set_flip_vertically_on_load(true);
-
-			std::filesystem::path texturePath = s_TexturesDirectory / *textureNames.begin();
-			std::vector<unsigned char> pixels = EngineContext::Get().Assets->GetResourcePackFileBinary(texturePath);
-
-			unsigned char* data = stbi_load_from_memory(pixels.data(), (int) pixels.size(), &w, &h, &channels, 4);
-
-			if (!data)
-				throw std::runtime_error("Failed loading texture");
-
-			stbi_image_free(data);
-
-			m_TextureSize = w;
-		}
-
-		m_AtlasSize = grid * m_TextureSize;
+		m_NameToID.clear();
+		m_NameToTransparency.clear();
+		m_Entries.assign(image.Names.size(), {});
 
-		std::vector<unsigned char> atlasPixels(m_AtlasSize * m_AtlasSize * 4, 0);
-
-		m_Entries.resize(count);
-
-		for (size_t i = 0; i < count; i++)
+		for (size_t i = 0; i < image.Names.size(); i++)
 		{
-			int x = i % grid;
-			int y = static_cast<int>(i / grid);
-
-			int atlasX = x * m_TextureSize;
-			int atlasY = y * m_TextureSize;
-
-			int w, h, channels;
-
-			stbi_set_flip_vertically_on_load(true);
-
-			auto it = textureNames.begin();
-			std::advance(it, i);
-			const std::string& textureName = *it;
-
-			if (textureName.empty())
-			{
+			const std::string& name = image.Names[i];
+			if (name.empty())
 				continue;
-			}
-
-			std::filesystem::path texturePath = s_TexturesDirectory / textureName;
-			std::vector<unsigned char> data = EngineContext::Get().Assets->GetResourcePackFileBinary(texturePath);
 
-			unsigned char* pixels = stbi_load_from_memory(data.data(), (int) data.size(), &w, &h, &channels, 4);
-
-			if (!pixels)
-				throw std::runtime_error("Failed loading texture");
-
-			for (int row = 0; row < m_TextureSize; row++)
-			{
-				memcpy(&atlasPixels[((atlasY + row) * m_AtlasSize + atlasX) * 4],
-					   &pixels[row * m_TextureSize * 4],
-					   m_TextureSize * 4);
-			}
+			const int atlasX = static_cast<int>(i % image.Grid) * m_TextureSize;
+			const int atlasY = static_cast<int>(i / image.Grid) * m_TextureSize;
 
 			TextureID id = (TextureID) i;
 
-			std::string name = *it;
-
 			m_NameToID[name] = id;
-			m_NameToTransparency[name] = GetTextureTransparency(pixels, w, h, 4);
+			m_NameToTransparency[name] = image.Transparencies[i];
 
 			float u0 = (float) atlasX / (float) m_AtlasSize;
 			float v0 = (float) atlasY / (float) m_AtlasSize;
@@ -135,44 +89,9 @@ namespace onion::voxel
 			float v1 = (float) (atlasY + m_TextureSize) / (float) m_AtlasSize;
 
 			m_Entries[id] = {{u0, v0}, {u1, v1}};
-
-			stbi_image_free(pixels);
-		}
-
-		m_Texture = Texture("TextureAtlas", atlasPixels, m_AtlasSize, m_AtlasSize, 4);
-	}
-
-	Transparency TextureAtlas::GetTextureTransparency(const unsigned char* pixels, int width, int height, int channels)
-	{
-		if (pixels == nullptr || width <= 0 || height <= 0)
-			return Transparency::Opaque;
-
-		// Supported common layouts:
-		// 1 = Gray
-		// 2 = Gray + Alpha
-		// 3 = RGB
-		// 4 = RGBA
-
-		const bool hasAlpha = (channels == 2 || channels == 4);
-		if (!hasAlpha)
-			return Transparency::Opaque;
-
-		const int alphaIndex = channels - 1;
-
-		bool hasZeroAlpha = false;
-
-		for (size_t i = 0; i + alphaIndex < static_cast<size_t>(width * height * channels); i += channels)
-		{
-			const unsigned char alpha = pixels[i + alphaIndex];
-
-			if (alpha > 0 && alpha < 255)
-				return Transparency::Transparent;
-
-			if (alpha == 0)
-				hasZeroAlpha = true;
 		}
 
-		return hasZeroAlpha ? Transparency::Cutout : Transparency::Opaque;
+		m_Texture = Texture("TextureAtlas", image.Pixels, m_AtlasSize, m_AtlasSize, 4);
 	}
 
 } // namespace onion::voxel
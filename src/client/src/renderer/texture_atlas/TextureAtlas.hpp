@@ -10,15 +10,10 @@
 #include <renderer/EngineContext.hpp>
 #include <renderer/texture/texture.hpp>
 
+#include "TextureAtlasBuilder.hpp"
+
 namespace onion::voxel
 {
-	enum class Transparency : uint8_t
-	{
-		Opaque,
-		Cutout,
-		Transparent
-	};
-
 	class TextureAtlas
 	{
 		// ----- Structs -----
@@ -53,10 +48,6 @@ namespace onion::voxel
 	  private:
 		void BuildAtlas(const std::unordered_set<std::string>& textureNames);
 
-		// ----- Private Helpers -----
-	  private:
-		static Transparency GetTextureTransparency(const unsigned char* pixels, int width, int height, int channels);
-
 		// ----- Private Members -----
 	  private:
 		std::unordered_map<std::string, TextureID> m_NameToID;
@@ -0,0 +1,173 @@
+#include "TextureAtlasBuilder.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <latch>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include <onion/ThreadPool.hpp>
+
+namespace onion::voxel
+{
+	AtlasImage TextureAtlasBuilder::Build(const std::unordered_set<std::string>& textureNames,
+										  const FileReader& readFile,
+										  size_t threadCount)
+	{
+		return Build(
+			textureNames,
+			[&readFile](const std::string& textureName)
+			{
+				return std::make_shared<const DecodedImage>(
+					DecodedImage::Decode(readFile(textureName), textureName, true, 4));
+			},
+			threadCount);
+	}
+
+	AtlasImage TextureAtlasBuilder::Build(const std::unordered_set<std::string>& textureNames,
+										  const ImageReader& readImage,
+										  size_t threadCount)
+	{
+		AtlasImage image;
+
+		image.Names.assign(textureNames.begin(), textureNames.end());
+		std::sort(image.Names.begin(), image.Names.end());
+
+		const size_t count = image.Names.size();
+		if (count == 0)
+			return image;
+
+		image.Grid = (int) std::ceil(std::sqrt((float) count));
+		image.Transparencies.assign(count, Transparency::Opaque);
+
+		// Loads a texture to check the texture size, assumes all textures are the same size
+		{
+			auto firstIt = std::find_if(
+				image.Names.begin(), image.Names.end(), [](const std::string& name) { return !name.empty(); });
+			if (firstIt == image.Names.end())
+				throw std::runtime_error("Failed loading texture");
+
+			image.TextureSize = readImage(*firstIt)->Width;
+		}
+
+		image.AtlasSize = image.Grid * image.TextureSize;
+		image.Pixels.assign(static_cast<size_t>(image.AtlasSize) * image.AtlasSize * 4, 0);
+
+		// ---- Decode each texture straight into its tile ----
+		std::atomic<size_t> nextTexture = 0;
+		std::mutex errorMutex;
+		std::exception_ptr error;
+
+		auto decodeTextures = [&]()
+		{
+			for (size_t i = nextTexture++; i < count; i = nextTexture++)
+			{
+				const std::string& textureName = image.Names[i];
+				if (textureName.empty())
+					continue;
+
+				try
+				{
+					std::shared_ptr<const DecodedImage> texture = readImage(textureName);
+					if (!texture || texture->Channels != 4)
+						throw std::runtime_error("Failed loading texture: " + textureName);
+
+					const unsigned char* pixels = texture->Pixels.data();
+					const int w = texture->Width;
+					const int h = texture->Height;
+
+					const int atlasX = static_cast<int>(i % image.Grid) * image.TextureSize;
+					const int atlasY = static_cast<int>(i / image.Grid) * image.TextureSize;
+
+					// Animated textures are strips : only the first frame fits the tile
+					const int rows = std::min(h, image.TextureSize);
+					const int rowBytes = std::min(w, image.TextureSize) * 4;
+					for (int row = 0; row < rows; row++)
+					{
+						std::memcpy(&image.Pixels[(static_cast<size_t>(atlasY + row) * image.AtlasSize + atlasX) * 4],
+									&pixels[static_cast<size_t>(row) * w * 4],
+									rowBytes);
+					}
+
+					image.Transparencies[i] = GetTextureTransparency(pixels, w, h, 4);
+				}
+				catch (...)
+				{
+					std::lock_guard lock(errorMutex);
+					if (!error)
+						error = std::current_exception();
+				}
+			}
+		};
+
+		if (threadCount == 0)
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+		threadCount = std::min(threadCount, count);
+
+		if (threadCount == 1)
+		{
+			decodeTextures();
+		}
+		else
+		{
+			ThreadPool threadPool(threadCount);
+			std::latch done(static_cast<std::ptrdiff_t>(threadCount));
+			for (size_t t = 0; t < threadCount; t++)
+			{
+				threadPool.Dispatch(
+					[&decodeTextures, &done]()
+					{
+						decodeTextures();
+						done.count_down();
+					});
+			}
+			done.wait();
+			threadPool.Close();
+		}
+
+		if (error)
+			std::rethrow_exception(error);
+
+		return image;
+	}
+
+	Transparency TextureAtlasBuilder::GetTextureTransparency(const unsigned char* pixels,
+															 int width,
+															 int height,
+															 int channels)
+	{
+		if (pixels == nullptr || width <= 0 || height <= 0)
+			return Transparency::Opaque;
+
+		// Supported common layouts:
+		// 1 = Gray
+		// 2 = Gray + Alpha
+		// 3 = RGB
+		// 4 = RGBA
+
+		const bool hasAlpha = (channels == 2 || channels == 4);
+		if (!hasAlpha)
+			return Transparency::Opaque;
+
+		const int alphaIndex = channels - 1;
+
+		bool hasZeroAlpha = false;
+
+		for (size_t i = 0; i + alphaIndex < static_cast<size_t>(width * height * channels); i += channels)
+		{
+			const unsigned char alpha = pixels[i + alphaIndex];
+
+			if (alpha > 0 && alpha < 255)
+				return Transparency::Transparent;
+
+			if (alpha == 0)
+				hasZeroAlpha = true;
+		}
+
+		return hasZeroAlpha ? Transparency::Cutout : Transparency::Opaque;
+	}
+} // namespace onion::voxel
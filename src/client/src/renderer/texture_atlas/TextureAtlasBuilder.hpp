@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <renderer/assets_manager/asset_cache/AssetCache.hpp>
+
+namespace onion::voxel
+{
+	enum class Transparency : uint8_t
+	{
+		Opaque,
+		Cutout,
+		Transparent
+	};
+
+	/// @brief CPU side of the texture atlas : the pixels of every texture packed in a square grid of tiles.
+	struct AtlasImage
+	{
+		int TextureSize = 16; // Size of a tile, in pixels
+		int Grid = 0;		  // Tiles per row / column
+		int AtlasSize = 0;	  // Size of the atlas, in pixels
+
+		std::vector<unsigned char> Pixels; // RGBA, AtlasSize x AtlasSize
+
+		// Tile i holds Names[i] (sorted, so the layout does not depend on hashing). Empty names get an empty tile.
+		std::vector<std::string> Names;
+		std::vector<Transparency> Transparencies;
+	};
+
+	/// @brief Builds the atlas pixels without any GL call (used by TextureAtlas and the benchmarks).
+	/// Textures are decoded on several threads, each one writing its own tiles.
+	class TextureAtlasBuilder
+	{
+		// ----- Public API -----
+	  public:
+		/// @brief Returns the encoded (PNG) file of a texture. Called from several threads at once.
+		using FileReader = std::function<std::vector<unsigned char>(const std::string& textureName)>;
+
+		/// @brief Returns the decoded texture : RGBA, flipped vertically. Called from several threads at once.
+		using ImageReader = std::function<std::shared_ptr<const DecodedImage>(const std::string& textureName)>;
+
+		/// @brief Decode and pack the textures. Assumes all textures are the size of the first one.
+		/// @param threadCount Number of decoding threads, 0 for the number of cores.
+		static AtlasImage Build(const std::unordered_set<std::string>& textureNames,
+								const FileReader& readFile,
+								size_t threadCount = 0);
+
+		/// @brief Pack already decoded textures (e.g. from the asset cache). Decoding misses still runs on every core.
+		static AtlasImage Build(const std::unordered_set<std::string>& textureNames,
+								const ImageReader& readImage,
+								size_t threadCount = 0);
+
+		static Transparency GetTextureTransparency(const unsigned char* pixels, int width, int height, int channels);
+	};
+} // namespace onion::voxel
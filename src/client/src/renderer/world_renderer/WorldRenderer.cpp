@@ -4,6 +4,7 @@
 
 #include <iostream>
 
+#include <shared/profiler/Profiler.hpp>
 #include <shared/utils/Utils.hpp>
 
 #include <renderer/debug_draws/DebugDraws.hpp>
@@ -666,6 +667,16 @@ namespace onion::voxel
 			m_MeshBuilder.SetMeshBuilderThreadCount(meshBuilderThreadCount);
 		}
 
+		// ----- Profiler -----
+		ImGui::Separator();
+		if (ImGui::Button("Write Profiler Trace"))
+		{
+			// Open with chrome://tracing or ui.perfetto.dev
+			const std::filesystem::path tracePath = Utils::GetExecutableDirectory() / "profiler_trace.json";
+			if (Profiler::WriteChromeTrace(tracePath))
+				std::cout << "[WorldRenderer] Profiler trace written to " << tracePath << std::endl;
+		}
+
 		// ---- SubChunk Shader Configuration ----
 		ImGui::Separator();
 		bool useFaceShading = SubChunkMesh::GetUseFaceShading();
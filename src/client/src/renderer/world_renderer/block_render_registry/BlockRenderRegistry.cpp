@@ -4,6 +4,10 @@
 #include <cmath>
 #include <functional>
 #include <iostream>
+#include <type_traits>
+
+// TextureInfo stores the atlas ID without including the (GL) atlas header
+static_assert(std::is_same_v<onion::voxel::TextureAtlas::TextureID, decltype(onion::voxel::TextureInfo::texture)>);
 
 // ---------------------------------------------------------------------------
 // Anonymous namespace — file-local helpers
@@ -291,9 +295,9 @@ namespace onion::voxel
 		for (const auto& staged : m_StagedOverlayTextures)
 			CommitOverlayTextures(staged.id, staged.variantIndex, staged.textures);
 
-		// Build the per-variant full-block lookup now that all variants are committed
+		// Build and publish the block flags now that all variants are committed
 		// and the registry is fully populated.
-		BlockState::BuildFullBlockLookup();
+		BlockState::BuildFlagTable();
 	}
 
 	const std::unordered_set<std::string>& BlockRenderRegistry::GetAllTextureNames() const
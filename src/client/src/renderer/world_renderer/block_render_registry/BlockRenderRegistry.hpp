@@ -15,47 +15,10 @@
 #include <shared/world/block/BlockModel.hpp>
 #include <shared/world/block/BlockstateRegistry.hpp>
 
+#include "BlockTextures.hpp"
+
 namespace onion::voxel
 {
-	enum class Face : uint8_t
-	{
-		Up,
-		Down,
-		South,
-		North,
-		West,
-		East,
-		Count
-	};
-
-	enum class Tint : uint8_t
-	{
-		None,
-		Grass,
-		Water
-	};
-
-	struct TextureInfo
-	{
-		TextureAtlas::TextureID texture = UINT16_MAX;
-		std::string name;
-		Face face;
-		Tint tintType = Tint::None;
-		Transparency textureType = Transparency::Opaque;
-		glm::vec3 from = {0, 0, 0};
-		glm::vec3 to = {16, 16, 16};
-		std::array<float, 4> uv = {0, 0, 16, 16}; // per-face UV override [u1,v1,u2,v2] in MC units (0-16)
-		int uvRotation = 0;						  // per-face UV rotation in degrees (0, 90, 180, 270)
-		BlockModel::ElementRotation elemRotation; // element-level 3D rotation (axis/angle/origin)
-		bool shade = true;
-	};
-
-	struct BlockTextures
-	{
-		std::vector<TextureInfo> faces;
-		std::vector<TextureInfo> overlay;
-	};
-
 	class BlockRenderRegistry
 	{
 		// ----- Constructor / Destructor -----
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <renderer/texture_atlas/TextureAtlasBuilder.hpp>
+
+#include <shared/world/block/BlockModel.hpp>
+
+namespace onion::voxel
+{
+	enum class Face : uint8_t
+	{
+		Up,
+		Down,
+		South,
+		North,
+		West,
+		East,
+		Count
+	};
+
+	enum class Tint : uint8_t
+	{
+		None,
+		Grass,
+		Water
+	};
+
+	/// @brief How one face of a block is textured. No GL type, so the meshing can run without a context.
+	struct TextureInfo
+	{
+		uint16_t texture = UINT16_MAX; // TextureAtlas::TextureID
+		std::string name;
+		Face face;
+		Tint tintType = Tint::None;
+		Transparency textureType = Transparency::Opaque;
+		glm::vec3 from = {0, 0, 0};
+		glm::vec3 to = {16, 16, 16};
+		std::array<float, 4> uv = {0, 0, 16, 16}; // per-face UV override [u1,v1,u2,v2] in MC units (0-16)
+		int uvRotation = 0;						  // per-face UV rotation in degrees (0, 90, 180, 270)
+		BlockModel::ElementRotation elemRotation; // element-level 3D rotation (axis/angle/origin)
+		bool shade = true;
+	};
+
+	struct BlockTextures
+	{
+		std::vector<TextureInfo> faces;
+		std::vector<TextureInfo> overlay;
+	};
+} // namespace onion::voxel
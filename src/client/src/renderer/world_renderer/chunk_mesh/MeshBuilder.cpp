@@ -1,8 +1,7 @@
 #include "MeshBuilder.hpp"
 
-#include <numeric>
-
 #include <glm/gtc/matrix_transform.hpp>
+#include <shared/profiler/Profiler.hpp>
 #include <shared/utils/Stopwatch.hpp>
 
 namespace onion::voxel
@@ -17,48 +16,6 @@ namespace onion::voxel
 		m_ThreadPool.Close();
 	}
 
-	std::array<bool, 6> GetFaceVisibility(const BlockState& block, const std::array<BlockState, 6>& neighbors)
-	{
-		std::array<bool, 6> visibility{true};
-
-		for (int i = 0; i < 6; i++)
-		{
-			// Water is only visible when next to air
-			if (block.ID == BlockId::Water && neighbors[i].ID != BlockId::Air)
-			{
-				visibility[i] = false;
-				continue;
-			}
-			else if (block.ID == BlockId::Ice && neighbors[i].ID != BlockId::Air && neighbors[i].ID != BlockId::Water)
-			{
-				visibility[i] = false;
-				continue;
-			}
-
-			//if (block.ID == BlockId::OakLeaves && neighbors[i].ID == BlockId::OakLeaves)
-			//{
-			//	if (i == (int) Face::Up || i == (int) Face::West || i == (int) Face::North)
-			//	{
-			//		visibility[i] = true;
-			//		continue;
-			//	}
-			//	visibility[i] = false;
-			//	continue;
-			//}
-
-			// A face is visible if the neighbor does not fully occlude it.
-			// Transparency alone is insufficient — a non-full block (slab, stair, fence, etc.)
-			// is opaque but does not fill its cell, so adjacent faces must remain visible.
-			bool currentIsFullBlock = BlockState::IsFullBlock(block.ID, block.VariantIndex);
-			bool neighborOccludesFace = currentIsFullBlock && !BlockState::IsTransparent(neighbors[i].ID) &&
-				BlockState::IsFullBlock(neighbors[i].ID, neighbors[i].VariantIndex);
-
-			visibility[i] = !neighborOccludesFace;
-		}
-
-		return visibility;
-	}
-
 	void MeshBuilder::UpdateChunkMesh(const std::shared_ptr<ChunkMesh> chunkMesh)
 	{
 		// First, we need to get a shared pointer to the chunk from the weak pointer in the chunk mesh
@@ -66,6 +23,8 @@ namespace onion::voxel
 		if (!chunk)
 			return;
 
+		ONION_PROFILE_ZONE("MeshBuilder::UpdateChunkMesh");
+
 		Stopwatch stopwatch;
 		stopwatch.Start();
 
@@ -102,7 +61,14 @@ namespace onion::voxel
 			newSubChunkMeshes.emplace_back(std::make_shared<SubChunkMesh>());
 		}
 
-		constexpr int SIZE = WorldConstants::CHUNK_SIZE;
+		// Block textures and atlas regions, for the meshing
+		const MeshGeometry::TexturesGetter getTextures = [this](const BlockState& block) -> const BlockTextures&
+		{ return m_BlockRenderRegistry.Get(block.ID, block.VariantIndex); };
+		const MeshGeometry::UvGetter getUv = [this](uint16_t texture)
+		{
+			const TextureAtlas::AtlasEntry& entry = m_TextureAtlas->GetAtlasEntry(texture);
+			return MeshGeometry::UvRect{entry.uvMin, entry.uvMax};
+		};
 
 		// Gets the adjacent chunks.
 		std::shared_ptr<Chunk> adjacentPosX = m_WorldManager->GetChunk(glm::ivec2(chunkPos.x + 1, chunkPos.y));
@@ -129,131 +95,20 @@ namespace onion::voxel
 			}
 
 			// Build Occlusion Map
-			BuildOcclusionMap(mesh, sub, chunk, adjacentPosX, adjacentNegX, adjacentPosZ, adjacentNegZ);
-
-			for (int z = 0; z < SIZE; z++)
-				for (int y = 0; y < SIZE; y++)
-					for (int x = 0; x < SIZE; x++)
-					{
-						const glm::ivec3 localPos(x, SIZE * sub + y, z);
-						BlockState block = chunk->GetBlock(localPos);
-
-						if (block.ID == BlockId::Air)
-							continue;
-
-						// ------ Calculate World Position -----
-						//int wx = chunkPos.x * SIZE + x;
-						int wy = SIZE * sub + y;
-						//int wz = chunkPos.y * SIZE + z;
-
-						// ------ Get Neighboring Blocks ------
-						std::array<BlockState, 6> neighbors;
-
-						// Up (+y)
-						if (localPos.y + 1 < subChunkCount * SIZE)
-							neighbors[(int) Face::Up] = chunk->GetBlock(glm::ivec3(x, localPos.y + 1, z));
-						else
-							neighbors[(int) Face::Up] = BlockState(BlockId::Air); // Air block if above the world
-
-						// Down (-y)
-						if (localPos.y - 1 >= 0)
-							neighbors[(int) Face::Down] = chunk->GetBlock(glm::ivec3(x, localPos.y - 1, z));
-						else
-							neighbors[(int) Face::Down] = BlockState(BlockId::Air); // Air block if below the world
-
-						// South (+z)
-						if (z + 1 < SIZE)
-							neighbors[(int) Face::South] = chunk->GetBlock(glm::ivec3(x, localPos.y, z + 1));
-						else
-						{
-							neighbors[(int) Face::South] = adjacentPosZ
-								? adjacentPosZ->GetBlock(glm::ivec3(x, localPos.y, 0))
-								: BlockState(BlockId::Stone);
-						}
-
-						// North (-z)
-						if (z - 1 >= 0)
-							neighbors[(int) Face::North] = chunk->GetBlock(glm::ivec3(x, localPos.y, z - 1));
-						else
-						{
-							neighbors[(int) Face::North] = adjacentNegZ
-								? adjacentNegZ->GetBlock(glm::ivec3(x, localPos.y, SIZE - 1))
-								: BlockState(BlockId::Stone);
-						}
-
-						// East (+x)
-						if (x + 1 < SIZE)
-							neighbors[(int) Face::East] = chunk->GetBlock(glm::ivec3(x + 1, localPos.y, z));
-						else
-						{
-							neighbors[(int) Face::East] = adjacentPosX
-								? adjacentPosX->GetBlock(glm::ivec3(0, localPos.y, z))
-								: BlockState(BlockId::Stone);
-						}
-
-						// West (-x)
-						if (x - 1 >= 0)
-							neighbors[(int) Face::West] = chunk->GetBlock(glm::ivec3(x - 1, localPos.y, z));
-						else
-						{
-							neighbors[(int) Face::West] = adjacentNegX
-								? adjacentNegX->GetBlock(glm::ivec3(SIZE - 1, localPos.y, z))
-								: BlockState(BlockId::Stone);
-						}
-
-						// ------ Determine Face Visibility ------
-						const std::array<bool, 6> faceVisible = GetFaceVisibility(block, neighbors);
-
-						// If no faces are visible, skip this block
-						if (!std::any_of(faceVisible.begin(), faceVisible.end(), [](bool v) { return v; }))
-							continue;
-
-						// ------ Get Block Textures ------
-						const BlockTextures& blockTextures = m_BlockRenderRegistry.Get(block.ID, block.VariantIndex);
-
-						// ------ Build Mesh ------
-						// Build each face individually using its own element geometry (from/to)
-						for (size_t i = 0; i < blockTextures.faces.size(); i++)
-						{
-							const int& faceIdx = (int) blockTextures.faces[i].face;
-
-							if (!faceVisible[faceIdx])
-								continue;
-
-							const TextureInfo& faceTexture = blockTextures.faces[i];
-
-							if (faceTexture.texture == UINT16_MAX)
-							{
-								continue;
-							}
-
-							PointsAndOcclusion pao = GetPointsAndOcclusion(mesh.get(), x, wy, z, faceTexture);
-
-							std::vector<FaceBuildDesc> faceDescs = GetBlockFaceBuildDescs(pao);
-							// Only emit the descriptor matching this face index, and only
-							// draw the specific face entry [i] that owns this pao — not all
-							// entries sharing the same face direction (which would mix UVs
-							// from different elements onto the wrong geometry).
-							for (const auto& f : faceDescs)
-							{
-								if ((int) f.face != faceIdx)
-									continue;
-
-								// Normal pass: this entry only
-								auto atlasEntry = m_TextureAtlas->GetAtlasEntry(faceTexture.texture);
-								AddFace(*mesh, f, faceTexture, atlasEntry);
-
-								// Overlay pass: all overlay entries for this face direction
-								for (const auto& overlayTex : blockTextures.overlay)
-								{
-									if (overlayTex.face != faceTexture.face)
-										continue;
-									auto overlayAtlas = m_TextureAtlas->GetAtlasEntry(overlayTex.texture);
-									AddFace(*mesh, f, overlayTex, overlayAtlas);
-								}
-							}
-						}
-					}
+			mesh->m_OcclusionMap =
+				MeshGeometry::BuildOcclusionMap(sub, chunk, adjacentPosX, adjacentNegX, adjacentPosZ, adjacentNegZ);
+
+			// Build Mesh
+			MeshGeometry::BuildSubChunk(GetMeshOutput(*mesh),
+										mesh->m_OcclusionMap,
+										sub,
+										chunk,
+										adjacentPosX,
+										adjacentNegX,
+										adjacentPosZ,
+										adjacentNegZ,
+										getTextures,
+										getUv);
 
 			mesh->SetDirty(false);
 			mesh->BuffersUpdated();
@@ -268,221 +123,6 @@ namespace onion::voxel
 		chunkMesh->FinishRebuilding();
 
 		AddChunkMeshUpdateTime(stopwatch.ElapsedMs());
-		RecordExecution();
-	}
-
-	void MeshBuilder::BuildOcclusionMap(const std::shared_ptr<SubChunkMesh> subMesh,
-										const int subChunkIndex,
-										const std::shared_ptr<Chunk>& chunk,
-										const std::shared_ptr<Chunk>& adjacentPosX,
-										const std::shared_ptr<Chunk>& adjacentNegX,
-										const std::shared_ptr<Chunk>& adjacentPosZ,
-										const std::shared_ptr<Chunk>& adjacentNegZ)
-	{
-
-		// No Occlusion map on air chunks
-		bool isMonoBlock = chunk->IsSubchunkMonoBlock(subChunkIndex);
-		if (isMonoBlock && chunk->GetBlock({0, subChunkIndex * WorldConstants::CHUNK_SIZE + 1, 0}).ID == BlockId::Air)
-			return;
-
-		constexpr int SX = WorldConstants::CHUNK_SIZE;
-		constexpr int SY = WorldConstants::CHUNK_SIZE;
-		constexpr int SZ = WorldConstants::CHUNK_SIZE;
-
-		const int yMini = subChunkIndex * SY;
-
-		// 1) Build solid masks from subchunk (fast local reads, no locks)
-		using Row = uint64_t;	 // bits along X or Z or Y (16 wide)
-		Row solidX[SY][SZ] = {}; // [y][z] bits along x
-		Row solidZ[SY][SX] = {}; // [y][x] bits along z
-		Row solidY[SZ][SX] = {}; // [z][x] bits along y
-
-		if (isMonoBlock)
-		{
-			const auto mono = chunk->GetBlock({0, yMini, 0});
-			const bool countsInAO = BlockstateRegistry::CountsInAO(mono.ID, mono.VariantIndex);
-			if (countsInAO)
-			{
-				const Row FULL_X = ~Row(0);
-				const Row FULL_Z = ~Row(0);
-				const Row FULL_Y = ~Row(0);
-
-				for (int y = 0; y < SY; y++)
-				{
-					for (int z = 0; z < SZ; z++)
-						solidX[y][z] = FULL_X;
-					for (int x = 0; x < SX; x++)
-						solidZ[y][x] = FULL_Z;
-				}
-				for (int z = 0; z < SZ; z++)
-					for (int x = 0; x < SX; x++)
-						solidY[z][x] = FULL_Y;
-			}
-		}
-		else
-		{
-			for (int y = 0; y < SY; y++)
-			{
-				for (int z = 0; z < SZ; z++)
-				{
-					Row rowX = 0;
-					for (int x = 0; x < SX; x++)
-					{
-						const BlockState blockstate =
-							chunk->GetBlock({static_cast<int>(x), static_cast<int>(y) + yMini, static_cast<int>(z)});
-						const bool countsInAO = BlockstateRegistry::CountsInAO(blockstate.ID, blockstate.VariantIndex);
-						rowX |= Row(countsInAO) << x;		  // along X in [y][z]
-						solidZ[y][x] |= Row(countsInAO) << z; // along Z in [y][x]
-						solidY[z][x] |= Row(countsInAO) << y; // along Y in [z][x]
-					}
-					solidX[y][z] = rowX;
-				}
-			}
-		}
-
-		// 2) Load neighbor borders once
-		uint8_t nbrXneg[SY][SZ] = {}, nbrXpos[SY][SZ] = {};
-		uint8_t nbrZneg[SY][SX] = {}, nbrZpos[SY][SX] = {};
-		uint8_t nbrYneg[SZ][SX] = {}, nbrYpos[SZ][SX] = {};
-
-		const glm::ivec2 chunkPos = chunk->GetPosition();
-
-		// X- (x = -1) and X+ (x = SX)
-		for (int ly = 0; ly < SY; ly++)
-		{
-			for (int lz = 0; lz < SZ; lz++)
-			{
-
-				// X-
-				{
-					BlockState block =
-						adjacentNegX ? adjacentNegX->GetBlock({SX - 1, ly + yMini, lz}) : BlockState(BlockId::Air);
-					nbrXneg[ly][lz] = BlockstateRegistry::CountsInAO(block.ID, block.VariantIndex) ? 1 : 0;
-				}
-				// X+
-				{
-					BlockState block =
-						adjacentPosX ? adjacentPosX->GetBlock({0, ly + yMini, lz}) : BlockState(BlockId::Air);
-					nbrXpos[ly][lz] = BlockstateRegistry::CountsInAO(block.ID, block.VariantIndex) ? 1 : 0;
-				}
-			}
-		}
-
-		// Z- (z = -1) and Z+ (z = SZ)
-		for (int ly = 0; ly < SY; ly++)
-		{
-			for (int lx = 0; lx < SX; lx++)
-			{
-
-				// Z-
-				{
-					BlockState block =
-						adjacentNegZ ? adjacentNegZ->GetBlock({lx, ly + yMini, SZ - 1}) : BlockState(BlockId::Air);
-					nbrZneg[ly][lx] = BlockstateRegistry::CountsInAO(block.ID, block.VariantIndex) ? 1 : 0;
-				}
-				// Z+
-				{
-					BlockState block =
-						adjacentPosZ ? adjacentPosZ->GetBlock({lx, ly + yMini, 0}) : BlockState(BlockId::Air);
-					nbrZpos[ly][lx] = BlockstateRegistry::CountsInAO(block.ID, block.VariantIndex) ? 1 : 0;
-				}
-			}
-		}
-
-		// Y- (y = -1) and Y+ (y = SY)
-		for (int lz = 0; lz < SZ; lz++)
-		{
-			for (int lx = 0; lx < SX; lx++)
-			{
-				// Y-
-				{
-					BlockState block = chunk->GetBlock({lx, yMini - 1, lz});
-					nbrYneg[lz][lx] = BlockstateRegistry::CountsInAO(block.ID, block.VariantIndex) ? 1 : 0;
-				}
-				// Y+
-				{
-					BlockState block = chunk->GetBlock({lx, yMini + SY, lz});
-					nbrYpos[lz][lx] = BlockstateRegistry::CountsInAO(block.ID, block.VariantIndex) ? 1 : 0;
-				}
-			}
-		}
-
-		// 3) Helper
-		auto solidCell = [&](int x, int y, int z) noexcept -> bool
-		{
-			if ((unsigned) x < SX && (unsigned) y < SY && (unsigned) z < SZ)
-			{
-				return (solidX[y][z] >> x) & 1;
-			}
-			if (x == -1 && (unsigned) y < SY && (unsigned) z < SZ)
-				return nbrXneg[y][z];
-			if (x == SX && (unsigned) y < SY && (unsigned) z < SZ)
-				return nbrXpos[y][z];
-			if (z == -1 && (unsigned) y < SY && (unsigned) x < SX)
-				return nbrZneg[y][x];
-			if (z == SZ && (unsigned) y < SY && (unsigned) x < SX)
-				return nbrZpos[y][x];
-			if (y == -1 && (unsigned) z < SZ && (unsigned) x < SX)
-				return nbrYneg[z][x];
-			if (y == SY && (unsigned) z < SZ && (unsigned) x < SX)
-				return nbrYpos[z][x];
-			return false;
-		};
-		auto c4 = [](bool a, bool b, bool c, bool d) { return int(a) + int(b) + int(c) + int(d); };
-
-		// 4) Build occlusion bytes
-		const int NX = SX + 1, NY = SY + 1, NZ = SZ + 1;
-		std::vector<uint8_t> occMap(NX * NY * NZ, 0);
-
-		for (int z = 0; z < NZ; z++)
-		{
-			for (int y = 0; y < NY; y++)
-			{
-				for (int x = 0; x < NX; x++)
-				{
-					const int cx0 = x - 1, cx1 = x;
-					const int cy0 = y - 1, cy1 = y;
-					const int cz0 = z - 1, cz1 = z;
-
-					const int pY = c4(solidCell(cx0, cy1, cz0),
-									  solidCell(cx1, cy1, cz0),
-									  solidCell(cx0, cy1, cz1),
-									  solidCell(cx1, cy1, cz1));
-					const int mY = c4(solidCell(cx0, cy0, cz0),
-									  solidCell(cx1, cy0, cz0),
-									  solidCell(cx0, cy0, cz1),
-									  solidCell(cx1, cy0, cz1));
-					const int pX = c4(solidCell(cx1, cy0, cz0),
-									  solidCell(cx1, cy1, cz0),
-									  solidCell(cx1, cy0, cz1),
-									  solidCell(cx1, cy1, cz1));
-					const int mX = c4(solidCell(cx0, cy0, cz0),
-									  solidCell(cx0, cy1, cz0),
-									  solidCell(cx0, cy0, cz1),
-									  solidCell(cx0, cy1, cz1));
-					const int pZ = c4(solidCell(cx0, cy0, cz1),
-									  solidCell(cx1, cy0, cz1),
-									  solidCell(cx0, cy1, cz1),
-									  solidCell(cx1, cy1, cz1));
-					const int mZ = c4(solidCell(cx0, cy0, cz0),
-									  solidCell(cx1, cy0, cz0),
-									  solidCell(cx0, cy1, cz0),
-									  solidCell(cx1, cy1, cz0));
-
-					const int minCnt = std::min(std::min(pY, mY), std::min(std::min(pX, mX), std::min(pZ, mZ)));
-					occMap[x + NX * (y + NY * z)] = static_cast<uint8_t>(minCnt); // 0..4
-				}
-			}
-		}
-
-		static constexpr uint8_t AO_LUT[5] = {0, 64, 128, 192, 255};
-		std::vector<uint8_t> occlusionMap(occMap.size());
-		for (size_t i = 0; i < occMap.size(); i++)
-		{
-			occlusionMap[i] = AO_LUT[occMap[i]]; // 0, 64, 128, 192, 255
-		}
-
-		subMesh->m_OcclusionMap = std::move(occlusionMap);
 	}
 
 	void MeshBuilder::BuildFace(TextureAtlas& textureAtlas,
@@ -497,7 +137,7 @@ namespace onion::voxel
 			{
 				const TextureInfo& faceTex = blockTextures.faces[i];
 				auto uv = textureAtlas.GetAtlasEntry(faceTex.texture);
-				AddFace(mesh, f, faceTex, uv);
+				MeshGeometry::AddFace(GetMeshOutput(mesh), f, faceTex, {uv.uvMin, uv.uvMax});
 			}
 		}
 
@@ -508,23 +148,21 @@ namespace onion::voxel
 			{
 				const TextureInfo& faceTex = blockTextures.overlay[i];
 				auto uv = textureAtlas.GetAtlasEntry(faceTex.texture);
-				AddFace(mesh, f, faceTex, uv);
+				MeshGeometry::AddFace(GetMeshOutput(mesh), f, faceTex, {uv.uvMin, uv.uvMax});
 			}
 		}
 	}
 
 	void MeshBuilder::AddChunkMeshUpdateTime(double timeMs)
 	{
-		std::lock_guard lock(m_ChunkMeshUpdateTimesMutex);
-		m_ChunkMeshUpdateTimes_ms.push_back(timeMs);
+		m_ChunkMeshUpdateCount.fetch_add(1, std::memory_order_relaxed);
 
-		if (m_ChunkMeshUpdateTimes_ms.size() > m_MaxDurationsToStore)
+		double average = m_AverageChunkMeshUpdateTime.load(std::memory_order_relaxed);
+		double newAverage;
+		do
 		{
-			m_ChunkMeshUpdateTimes_ms.pop_front();
-		}
-
-		double total = std::accumulate(m_ChunkMeshUpdateTimes_ms.begin(), m_ChunkMeshUpdateTimes_ms.end(), 0.0);
-		m_AverageChunkMeshUpdateTime.store(total / m_ChunkMeshUpdateTimes_ms.size());
+			newAverage = average == 0.0 ? timeMs : average + (timeMs - average) * AVERAGE_WEIGHT;
+		} while (!m_AverageChunkMeshUpdateTime.compare_exchange_weak(average, newAverage, std::memory_order_relaxed));
 	}
 
 	void MeshBuilder::Initialize()
@@ -549,19 +187,28 @@ namespace onion::voxel
 
 	size_t MeshBuilder::GetChunkMeshUpdatesLastSeconds() const
 	{
-		std::lock_guard lock(m_ExecutionTimesMutex);
-		return m_ExecutionTimes.size();
+		const double updatesPerSecond = GetChunkMeshUpdatesPerSecond();
+		return static_cast<size_t>(updatesPerSecond * std::chrono::duration<double>(m_Window).count() + 0.5);
 	}
 
 	double MeshBuilder::GetChunkMeshUpdatesPerSecond() const
 	{
-		std::lock_guard lock(m_ExecutionTimesMutex);
+		std::lock_guard lock(m_RateMutex);
+
+		// Measured again once per window, from the update count
+		const auto now = std::chrono::steady_clock::now();
+		const double elapsedSeconds = std::chrono::duration<double>(now - m_RateSampleTime).count();
+		if (elapsedSeconds >= std::chrono::duration<double>(m_Window).count())
+		{
+			const uint64_t count = m_ChunkMeshUpdateCount.load(std::memory_order_relaxed);
+			if (m_RateSampleTime != std::chrono::steady_clock::time_point{})
+				m_ChunkMeshUpdatesPerSecond = static_cast<double>(count - m_RateSampleCount) / elapsedSeconds;
 
-		if (m_ExecutionTimes.empty())
-			return 0.0;
+			m_RateSampleTime = now;
+			m_RateSampleCount = count;
+		}
 
-		auto duration = std::chrono::duration<double>(m_Window).count();
-		return m_ExecutionTimes.size() / duration;
+		return m_ChunkMeshUpdatesPerSecond;
 	}
 
 	void MeshBuilder::UpdateUiBlockMesh(const std::shared_ptr<UiBlockMesh> uiBlockMesh) const
@@ -630,7 +277,7 @@ namespace onion::voxel
 				transform = glm::scale(transform, gui.Scale * (-blockScreenSize));
 
 				// Compute the 8 corners of the unit cube through the transform.
-				// Convention matches GetPointsAndOcclusion: pXYZ where X=+x,Y=+y,Z=+z (1=max, 0=min)
+				// Convention matches MeshGeometry::GetPointsAndOcclusion: pXYZ where X=+x,Y=+y,Z=+z (1=max, 0=min)
 				auto tfm = [&](float x, float y, float z) -> glm::vec3
 				{ return glm::vec3(transform * glm::vec4(x, y, z, 1.0f)); };
 
@@ -638,7 +285,7 @@ namespace onion::voxel
 				const BlockTextures& blockTextures =
 					m_BlockRenderRegistry.Get(blockId, static_cast<uint8_t>(bestVariantIdx));
 
-				for (const FaceBuildDesc& f : GetBlockFaceBuildDescs(
+				for (const FaceBuildDesc& f : MeshGeometry::GetBlockFaceBuildDescs(
 						 // Dummy full-cube PAO just to enumerate all 6 face directions;
 						 // actual per-element PAO is computed below per TextureInfo
 						 [&]()
@@ -680,7 +327,7 @@ namespace onion::voxel
 							return p;
 						}();
 
-						const std::vector<FaceBuildDesc> elemDescs = GetBlockFaceBuildDescs(elemPao);
+						const std::vector<FaceBuildDesc> elemDescs = MeshGeometry::GetBlockFaceBuildDescs(elemPao);
 						for (const FaceBuildDesc& ef : elemDescs)
 						{
 							if (static_cast<int>(ef.face) != faceIdx)
@@ -712,7 +359,7 @@ namespace onion::voxel
 							return p;
 						}();
 
-						const std::vector<FaceBuildDesc> elemDescs = GetBlockFaceBuildDescs(elemPao);
+						const std::vector<FaceBuildDesc> elemDescs = MeshGeometry::GetBlockFaceBuildDescs(elemPao);
 						for (const FaceBuildDesc& ef : elemDescs)
 						{
 							if (static_cast<int>(ef.face) != faceIdx)
@@ -744,144 +391,16 @@ namespace onion::voxel
 		return m_BlockRenderRegistry.GetAllTextureNames();
 	}
 
-	void MeshBuilder::RecordExecution()
-	{
-		auto now = std::chrono::steady_clock::now();
-
-		std::lock_guard lock(m_ExecutionTimesMutex);
-
-		m_ExecutionTimes.push_back(now);
-
-		auto cutoff = now - m_Window;
-
-		while (!m_ExecutionTimes.empty() && m_ExecutionTimes.front() < cutoff)
-			m_ExecutionTimes.pop_front();
-	}
-
-	void MeshBuilder::AddFace(SubChunkMesh& mesh,
-							  const FaceBuildDesc& f,
-							  const TextureInfo& faceTexture,
-							  const TextureAtlas::AtlasEntry& uv)
+	MeshGeometry::MeshOutput MeshBuilder::GetMeshOutput(SubChunkMesh& mesh)
 	{
-		std::vector<SubChunkMesh::Vertex>* vertices = nullptr;
-		std::vector<uint32_t>* indices = nullptr;
-
-		switch (faceTexture.textureType)
-		{
-			case Transparency::Opaque:
-				vertices = &mesh.m_VerticesOpaque;
-				indices = &mesh.m_IndicesOpaque;
-				break;
-
-			case Transparency::Cutout:
-				vertices = &mesh.m_VerticesCutout;
-				indices = &mesh.m_IndicesCutout;
-				break;
-
-			case Transparency::Transparent:
-				vertices = &mesh.m_VerticesTransparent;
-				indices = &mesh.m_IndicesTransparent;
-				break;
-		}
-
-		// ------ COMPUTE UV SUB-REGION ------
-
-		// Determine the [s0,t0,s1,t1] sub-region within the atlas tile (0..1 range).
-		// Priority: explicit per-face UV override wins; fall back to from/to-derived UVs.
-
-		float s0 = faceTexture.uv[0] / 16.0f;
-		float s1 = faceTexture.uv[2] / 16.0f;
-		float t0 = 1.0f - faceTexture.uv[3] / 16.0f; // MC v2, flipped to OpenGL
-		float t1 = 1.0f - faceTexture.uv[1] / 16.0f; // MC v1, flipped to OpenGL
-
-		// Remap [s0,t0,s1,t1] into the atlas tile's UV space
-		glm::vec2 tileSize = uv.uvMax - uv.uvMin;
-		glm::vec2 uv0 = uv.uvMin + tileSize * glm::vec2(s0, t0);
-		glm::vec2 uv1 = uv.uvMin + tileSize * glm::vec2(s1, t0);
-		glm::vec2 uv2 = uv.uvMin + tileSize * glm::vec2(s1, t1);
-		glm::vec2 uv3 = uv.uvMin + tileSize * glm::vec2(s0, t1);
-
-		// Apply per-face UV rotation (0, 90, 180, 270 degrees CW).
-		// A cyclic permutation of the four corners rotates the texture on the quad.
-		const int uvSteps = ((faceTexture.uvRotation / 90) % 4 + 4) % 4;
-		if (uvSteps != 0)
-		{
-			// Rotate the corner array by `uvSteps` positions (each step = 90° CW)
-			std::array<glm::vec2, 4> corners{uv0, uv1, uv2, uv3};
-			uv0 = corners[(0 + uvSteps) % 4];
-			uv1 = corners[(1 + uvSteps) % 4];
-			uv2 = corners[(2 + uvSteps) % 4];
-			uv3 = corners[(3 + uvSteps) % 4];
-		}
-
-		// ------ TINT HANDLING ------
-		glm::ivec3 tint(255);
-
-		switch (faceTexture.tintType)
-		{
-			case Tint::Grass:
-				tint = glm::ivec3(95, 190, 60);
-				break;
-
-			case Tint::Water:
-				tint = glm::ivec3(77, 128, 255);
-				break;
-
-			default:
-				break;
-		}
-
-		// ------ VERTEX CREATION ------
-		uint32_t startIndex = static_cast<uint32_t>(vertices->size());
-
-		auto makeVertex = [&](const glm::vec3& p, const glm::vec2& uv, uint8_t occlusion)
-		{
-			SubChunkMesh::Vertex vert;
-
-			vert.x = static_cast<int16_t>(std::round(p.x));
-			vert.y = static_cast<int16_t>(std::round(p.y));
-			vert.z = static_cast<int16_t>(std::round(p.z));
-
-			vert.texX = uv.x;
-			vert.texY = uv.y;
-
-			vert.facing = vert.facing = static_cast<uint8_t>(faceTexture.shade ? f.face : Face::Up);
-			vert.occlusion = occlusion;
-
-			vert.tintR = static_cast<uint8_t>(tint.r);
-			vert.tintG = static_cast<uint8_t>(tint.g);
-			vert.tintB = static_cast<uint8_t>(tint.b);
-
-			return vert;
-		};
-
-		// ------ Add vertices -----
-		vertices->push_back(makeVertex(*f.v[0], uv0, *f.o[0]));
-		vertices->push_back(makeVertex(*f.v[1], uv1, *f.o[1]));
-		vertices->push_back(makeVertex(*f.v[2], uv2, *f.o[2]));
-		vertices->push_back(makeVertex(*f.v[3], uv3, *f.o[3]));
-
-		// ------ Add indices -----
-		if (!f.reverseWinding)
-		{
-			indices->push_back(startIndex + 0);
-			indices->push_back(startIndex + 1);
-			indices->push_back(startIndex + 2);
-
-			indices->push_back(startIndex + 2);
-			indices->push_back(startIndex + 3);
-			indices->push_back(startIndex + 0);
-		}
-		else
-		{
-			indices->push_back(startIndex + 0);
-			indices->push_back(startIndex + 3);
-			indices->push_back(startIndex + 2);
-
-			indices->push_back(startIndex + 2);
-			indices->push_back(startIndex + 1);
-			indices->push_back(startIndex + 0);
-		}
+		MeshGeometry::MeshOutput output;
+		output.VerticesOpaque = &mesh.m_VerticesOpaque;
+		output.IndicesOpaque = &mesh.m_IndicesOpaque;
+		output.VerticesCutout = &mesh.m_VerticesCutout;
+		output.IndicesCutout = &mesh.m_IndicesCutout;
+		output.VerticesTransparent = &mesh.m_VerticesTransparent;
+		output.IndicesTransparent = &mesh.m_IndicesTransparent;
+		return output;
 	}
 
 	void MeshBuilder::AddUiFace(UiBlockMesh& mesh,
@@ -1090,140 +609,4 @@ namespace onion::voxel
 		return result;
 	}
 
-	MeshBuilder::PointsAndOcclusion MeshBuilder::GetPointsAndOcclusion(
-		SubChunkMesh* mesh, const int lx, const int wy, const int lz, const TextureInfo& textureInfo)
-	{
-		PointsAndOcclusion result;
-
-		constexpr int subBlockSize = 32; // 2 sub-units per MC unit; supports 0.5-step precision and negative offsets
-
-		float ofnx = textureInfo.from.x * 2.0f;
-		float ofpx = textureInfo.to.x * 2.0f;
-
-		float ofny = textureInfo.from.y * 2.0f;
-		float ofpy = textureInfo.to.y * 2.0f;
-
-		float ofnz = textureInfo.from.z * 2.0f;
-		float ofpz = textureInfo.to.z * 2.0f;
-
-		result.p000 = glm::vec3(lx * subBlockSize + ofnx, wy * subBlockSize + ofny, lz * subBlockSize + ofnz);
-		result.p001 = glm::vec3(lx * subBlockSize + ofnx, wy * subBlockSize + ofny, lz * subBlockSize + ofpz);
-		result.p010 = glm::vec3(lx * subBlockSize + ofnx, wy * subBlockSize + ofpy, lz * subBlockSize + ofnz);
-		result.p011 = glm::vec3(lx * subBlockSize + ofnx, wy * subBlockSize + ofpy, lz * subBlockSize + ofpz);
-
-		result.p100 = glm::vec3(lx * subBlockSize + ofpx, wy * subBlockSize + ofny, lz * subBlockSize + ofnz);
-		result.p101 = glm::vec3(lx * subBlockSize + ofpx, wy * subBlockSize + ofny, lz * subBlockSize + ofpz);
-		result.p110 = glm::vec3(lx * subBlockSize + ofpx, wy * subBlockSize + ofpy, lz * subBlockSize + ofnz);
-		result.p111 = glm::vec3(lx * subBlockSize + ofpx, wy * subBlockSize + ofpy, lz * subBlockSize + ofpz);
-
-		// Apply element rotation if present
-		const auto& rotation = textureInfo.elemRotation;
-		if (rotation.Angle != 0.0f && !rotation.Axis.empty())
-		{
-			// Convert origin from MC units (0-16) to sub-block units, relative to this block's world position
-			glm::vec3 origin(lx * subBlockSize + rotation.Origin.x * 2.0f,
-							 wy * subBlockSize + rotation.Origin.y * 2.0f,
-							 lz * subBlockSize + rotation.Origin.z * 2.0f);
-
-			glm::vec3 axis(0.0f);
-			if (rotation.Axis == "x")
-				axis = {1, 0, 0};
-			else if (rotation.Axis == "y")
-				axis = {0, 1, 0};
-			else if (rotation.Axis == "z")
-				axis = {0, 0, 1};
-
-			float radians = glm::radians(rotation.Angle);
-			glm::mat4 rot = glm::rotate(glm::mat4(1.0f), radians, axis);
-
-			auto rotatePoint = [&](glm::vec3& p)
-			{
-				glm::vec3 local = p - origin;
-				local = glm::vec3(rot * glm::vec4(local, 0.0f));
-				p = local + origin;
-			};
-
-			rotatePoint(result.p000);
-			rotatePoint(result.p001);
-			rotatePoint(result.p010);
-			rotatePoint(result.p011);
-			rotatePoint(result.p100);
-			rotatePoint(result.p101);
-			rotatePoint(result.p110);
-			rotatePoint(result.p111);
-
-			// Apply rescale: expand the two axes perpendicular to the rotation axis so
-			// the rotated element still fills the full block boundary (scale = 1/cos(angle)).
-			if (rotation.Rescale)
-			{
-				float scale = 1.0f / std::cos(radians);
-
-				glm::vec3 scaleAxes(1.0f);
-				if (rotation.Axis == "x")
-					scaleAxes = {1.0f, scale, scale};
-				else if (rotation.Axis == "y")
-					scaleAxes = {scale, 1.0f, scale};
-				else if (rotation.Axis == "z")
-					scaleAxes = {scale, scale, 1.0f};
-
-				auto scalePoint = [&](glm::vec3& p)
-				{
-					glm::vec3 local = p - origin;
-					local *= scaleAxes;
-					p = local + origin;
-				};
-
-				scalePoint(result.p000);
-				scalePoint(result.p001);
-				scalePoint(result.p010);
-				scalePoint(result.p011);
-				scalePoint(result.p100);
-				scalePoint(result.p101);
-				scalePoint(result.p110);
-				scalePoint(result.p111);
-			}
-		}
-
-		// Fetch occlusion values from the mesh's occlusion map if this texture requires shading
-		if (textureInfo.shade)
-		{
-			constexpr int SIZE = WorldConstants::CHUNK_SIZE;
-			const int ly = wy % SIZE;
-
-			const int NX = SIZE + 1;
-			const int NY = SIZE + 1;
-			auto AO = [&](int dx, int dy, int dz) -> uint8_t
-			{
-				int ax = lx + dx;
-				int ay = ly + dy;
-				int az = lz + dz;
-				return mesh->m_OcclusionMap[ax + NX * (ay + NY * az)];
-			};
-
-			result.o000 = AO(0, 0, 0);
-			result.o001 = AO(0, 0, 1);
-			result.o010 = AO(0, 1, 0);
-			result.o011 = AO(0, 1, 1);
-
-			result.o100 = AO(1, 0, 0);
-			result.o101 = AO(1, 0, 1);
-			result.o110 = AO(1, 1, 0);
-			result.o111 = AO(1, 1, 1);
-		}
-
-		return result;
-	}
-
-	std::vector<MeshBuilder::FaceBuildDesc> MeshBuilder::GetBlockFaceBuildDescs(const PointsAndOcclusion& pao)
-	{
-		return {
-			{Face::Up, {&pao.p011, &pao.p111, &pao.p110, &pao.p010}, {&pao.o011, &pao.o111, &pao.o110, &pao.o010}},
-			{Face::Down, {&pao.p000, &pao.p100, &pao.p101, &pao.p001}, {&pao.o000, &pao.o100, &pao.o101, &pao.o001}},
-			{Face::South, {&pao.p001, &pao.p101, &pao.p111, &pao.p011}, {&pao.o001, &pao.o101, &pao.o111, &pao.o011}},
-			{Face::North, {&pao.p100, &pao.p000, &pao.p010, &pao.p110}, {&pao.o100, &pao.o000, &pao.o010, &pao.o110}},
-			{Face::East, {&pao.p101, &pao.p100, &pao.p110, &pao.p111}, {&pao.o101, &pao.o100, &pao.o110, &pao.o111}},
-			{Face::West, {&pao.p000, &pao.p001, &pao.p011, &pao.p010}, {&pao.o000, &pao.o001, &pao.o011, &pao.o010}},
-		};
-	}
-
 } // namespace onion::voxel
@@ -2,9 +2,10 @@
 
 #include <glm/glm.hpp>
 
+#include <atomic>
 #include <chrono>
-#include <deque>
 #include <memory>
+#include <mutex>
 
 #include <onion/ThreadPool.hpp>
 
@@ -15,6 +16,7 @@
 #include <renderer/world_renderer/block_render_registry/BlockRenderRegistry.hpp>
 
 #include "ChunkMesh.hpp"
+#include "MeshGeometry.hpp"
 
 namespace onion::voxel
 {
@@ -52,72 +54,46 @@ namespace onion::voxel
 
 		// ----- Latency Metrics -----
 	  private:
-		size_t m_MaxDurationsToStore = 1000;		  // Maximum number of durations to store for averaging
-		std::mutex m_ChunkMeshUpdateTimesMutex;		  // Mutex to protect access to the chunk mesh update times
-		std::deque<double> m_ChunkMeshUpdateTimes_ms; // Stores the time taken for each chunk mesh update
-		void AddChunkMeshUpdateTime(double timeMs);	  // Adds a new chunk mesh update time and updates the average
-		std::atomic<double> m_AverageChunkMeshUpdateTime{0.0}; // The average time taken for chunk mesh updates
+		// Recorded by the builder threads without any lock, the distribution is in the profiler
+		void AddChunkMeshUpdateTime(double timeMs);
+		std::atomic<double> m_AverageChunkMeshUpdateTime{0.0}; // Exponential moving average, in ms
+		static constexpr double AVERAGE_WEIGHT = 0.01;		   // Weight of the last update in the average
 
 		// ----- Execution Frequency Metrics -----
 	  private:
-		std::chrono::seconds m_Window{1}; // window size (last X seconds)
-		mutable std::mutex m_ExecutionTimesMutex;
-		std::deque<std::chrono::steady_clock::time_point> m_ExecutionTimes;
-		void RecordExecution();
+		std::chrono::seconds m_Window{1}; // Rate measured over this window
+		std::atomic<uint64_t> m_ChunkMeshUpdateCount{0};
+
+		// Last rate measure, only touched by the readers
+		mutable std::mutex m_RateMutex;
+		mutable std::chrono::steady_clock::time_point m_RateSampleTime{};
+		mutable uint64_t m_RateSampleCount = 0;
+		mutable double m_ChunkMeshUpdatesPerSecond = 0.0;
 
 		// ----- Private Structs -----
 	  private:
-		struct FaceBuildDesc
-		{
-			Face face;
-
-			const glm::vec3* v[4];
-			const uint8_t* o[4];
-
-			bool reverseWinding = false; // vertices should be added in reverse order (for correct backface culling)
-			bool isCutout = false;		 // whether this face should be rendered in the cutout pass
-		};
-
-		struct PointsAndOcclusion
-		{
-			glm::vec3 p000{0.0f}, p001{0.0f}, p010{0.0f}, p011{0.0f}, p100{0.0f}, p101{0.0f}, p110{0.0f}, p111{0.0f};
-			uint8_t o000 = 0, o001 = 0, o010 = 0, o011 = 0, o100 = 0, o101 = 0, o110 = 0, o111 = 0;
-		};
+		using FaceBuildDesc = MeshGeometry::FaceBuildDesc;
+		using PointsAndOcclusion = MeshGeometry::PointsAndOcclusion;
 
 		// ----- Private Methods -----
 	  private:
 		void UpdateChunkMesh(const std::shared_ptr<ChunkMesh> chunkMesh);
 
-		void BuildOcclusionMap(const std::shared_ptr<SubChunkMesh> subMesh,
-							   const int subChunkIndex,
-							   const std::shared_ptr<Chunk>& chunk,
-							   const std::shared_ptr<Chunk>& adjacentPosX,
-							   const std::shared_ptr<Chunk>& adjacentNegX,
-							   const std::shared_ptr<Chunk>& adjacentPosZ,
-							   const std::shared_ptr<Chunk>& adjacentNegZ);
-
 		static void BuildFace(TextureAtlas& textureAtlas,
 							  SubChunkMesh& mesh,
 							  const BlockTextures& blockTextures,
 							  const FaceBuildDesc& faceDesc);
 
-		static void AddFace(SubChunkMesh& mesh,
-							const FaceBuildDesc& f,
-							const TextureInfo& faceTexture,
-							const TextureAtlas::AtlasEntry& uv);
+		// Vertex / index lists of the subchunk mesh, filled by the MeshGeometry
+		static MeshGeometry::MeshOutput GetMeshOutput(SubChunkMesh& mesh);
 
 		static void AddUiFace(UiBlockMesh& mesh,
 							  const FaceBuildDesc& f,
 							  const TextureInfo& faceTexture,
 							  const TextureAtlas::AtlasEntry& uv);
 
-		PointsAndOcclusion GetPointsAndOcclusion(
-			SubChunkMesh* mesh, const int lx, const int wy, const int lz, const TextureInfo& textureInfo);
-
 		// Compute the 8 corners of a model element in local [-0.5 .. +0.5] space,
 		// including element rotation, for use in inventory (UI) rendering.
 		static PointsAndOcclusion GetElementLocalPao(const TextureInfo& textureInfo);
-
-		static std::vector<FaceBuildDesc> GetBlockFaceBuildDescs(const PointsAndOcclusion& pao);
 	};
 } // namespace onion::voxel
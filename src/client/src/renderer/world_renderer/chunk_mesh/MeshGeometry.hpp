@@ -0,0 +1,122 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <shared/world/block/BlockState.hpp>
+#include <shared/world/chunk/Chunk.hpp>
+
+#include <renderer/world_renderer/block_render_registry/BlockTextures.hpp>
+
+namespace onion::voxel
+{
+	/// @brief CPU side of the chunk meshing : face visibility, ambient occlusion and vertex generation,
+	/// without any GL call (used by MeshBuilder and the benchmarks).
+	class MeshGeometry
+	{
+		// ----- Structs -----
+	  public:
+		struct Vertex
+		{
+			int16_t x;
+			int16_t y;
+			int16_t z;
+
+			float texX, texY; // Texture coordinates
+
+			uint8_t tintR, tintG, tintB; // RGB tint color
+			uint8_t facing;				 // Facing direction (0-5 for the 6 faces of a cube)
+			uint8_t occlusion;			 // Ambient occlusion factor (0-255)
+		};
+
+		/// @brief Region of a texture in the atlas
+		struct UvRect
+		{
+			glm::vec2 uvMin;
+			glm::vec2 uvMax;
+		};
+
+		/// @brief Where the faces are appended, one vertex / index list per render pass
+		struct MeshOutput
+		{
+			std::vector<Vertex>* VerticesOpaque = nullptr;
+			std::vector<uint32_t>* IndicesOpaque = nullptr;
+
+			std::vector<Vertex>* VerticesCutout = nullptr;
+			std::vector<uint32_t>* IndicesCutout = nullptr;
+
+			std::vector<Vertex>* VerticesTransparent = nullptr;
+			std::vector<uint32_t>* IndicesTransparent = nullptr;
+		};
+
+		struct FaceBuildDesc
+		{
+			Face face;
+
+			const glm::vec3* v[4];
+			const uint8_t* o[4];
+
+			bool reverseWinding = false; // vertices should be added in reverse order (for correct backface culling)
+			bool isCutout = false;		 // whether this face should be rendered in the cutout pass
+		};
+
+		struct PointsAndOcclusion
+		{
+			glm::vec3 p000{0.0f}, p001{0.0f}, p010{0.0f}, p011{0.0f}, p100{0.0f}, p101{0.0f}, p110{0.0f}, p111{0.0f};
+			uint8_t o000 = 0, o001 = 0, o010 = 0, o011 = 0, o100 = 0, o101 = 0, o110 = 0, o111 = 0;
+		};
+
+		/// @brief Returns the textures of a block state
+		using TexturesGetter = std::function<const BlockTextures&(const BlockState& block)>;
+
+		/// @brief Returns the atlas region of a texture
+		using UvGetter = std::function<UvRect(uint16_t texture)>;
+
+		// ----- Public API -----
+	  public:
+		/// @brief Append the visible faces of a subchunk to the output.
+		/// @param occlusionMap Map built by BuildOcclusionMap for this subchunk.
+		/// @param adjacentPosX Neighbor chunks, may be null (not loaded yet).
+		static void BuildSubChunk(const MeshOutput& output,
+								  const std::vector<uint8_t>& occlusionMap,
+								  const int subChunkIndex,
+								  const std::shared_ptr<Chunk>& chunk,
+								  const std::shared_ptr<Chunk>& adjacentPosX,
+								  const std::shared_ptr<Chunk>& adjacentNegX,
+								  const std::shared_ptr<Chunk>& adjacentPosZ,
+								  const std::shared_ptr<Chunk>& adjacentNegZ,
+								  const TexturesGetter& getTextures,
+								  const UvGetter& getUv);
+
+		/// @brief Occlusion of each block corner of the subchunk, (CHUNK_SIZE + 1)^3 values from 0 (open) to 255.
+		/// Empty for air subchunks, which have no face to shade.
+		static std::vector<uint8_t> BuildOcclusionMap(const int subChunkIndex,
+													  const std::shared_ptr<Chunk>& chunk,
+													  const std::shared_ptr<Chunk>& adjacentPosX,
+													  const std::shared_ptr<Chunk>& adjacentNegX,
+													  const std::shared_ptr<Chunk>& adjacentPosZ,
+													  const std::shared_ptr<Chunk>& adjacentNegZ);
+
+		/// @brief Which of the 6 faces of a block are not hidden by its neighbors (indexed by Face)
+		static std::array<bool, 6> GetFaceVisibility(const BlockState& block,
+													 const std::array<BlockState, 6>& neighbors);
+
+		static void AddFace(const MeshOutput& output,
+							const FaceBuildDesc& f,
+							const TextureInfo& faceTexture,
+							const UvRect& uv);
+
+		static PointsAndOcclusion GetPointsAndOcclusion(const std::vector<uint8_t>& occlusionMap,
+														const int lx,
+														const int wy,
+														const int lz,
+														const TextureInfo& textureInfo);
+
+		static std::vector<FaceBuildDesc> GetBlockFaceBuildDescs(const PointsAndOcclusion& pao);
+	};
+} // namespace onion::voxel
@@ -10,6 +10,8 @@
 #include <renderer/shader/shader.hpp>
 #include <renderer/texture/texture.hpp>
 
+#include "MeshGeometry.hpp"
+
 namespace onion::voxel
 {
 	class MeshBuilder;
@@ -19,7 +21,7 @@ namespace onion::voxel
 		friend class MeshBuilder;
 
 	  public:
-		struct Vertex;
+		using Vertex = MeshGeometry::Vertex;
 
 		// ----- Constructor / Destructor -----
 	  public:
@@ -101,20 +103,5 @@ namespace onion::voxel
 		static inline glm::vec3 s_LightColor{1.0f, 1.0f, 1.0f};
 		static inline bool s_UseFaceShading = true;
 		static inline bool s_UseOcclusion = true;
-
-		// ----- Structs -----
-	  public:
-		struct Vertex
-		{
-			int16_t x;
-			int16_t y;
-			int16_t z;
-
-			float texX, texY; // Texture coordinates
-
-			uint8_t tintR, tintG, tintB; // RGB tint color
-			uint8_t facing;				 // Facing direction (0-5 for the 6 faces of a cube)
-			uint8_t occlusion;			 // Ambient occlusion factor (0-255)
-		};
 	};
 } // namespace onion::voxel
@@ -0,0 +1,308 @@
+#include "BotClient.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <shared/data_transfer_objects/serializer/SerializerDTO.hpp>
+#include <shared/utils/Utils.hpp>
+#include <shared/world/block/Block.hpp>
+#include <shared/world/chunk/Chunk.hpp>
+
+namespace onion::voxel::loadtest
+{
+	BotClient::BotClient(uint32_t index, const std::string& host, uint16_t port, const BotSettings& settings)
+		: m_Index(index), m_Settings(settings), m_UUID(Utils::GenerateUUID()), m_Name("Bot_" + std::to_string(index)),
+		  m_NetworkClient(host, port), m_Player(m_UUID), m_Rng(index)
+	{
+		m_Player.SetName(m_Name);
+
+		m_NetworkClientEventHandles.push_back(m_NetworkClient.EvtConnected.Subscribe(
+			[this](const ServerInfoMsg& msg) { Handle_Connected(msg); }));
+
+		m_NetworkClientEventHandles.push_back(m_NetworkClient.EvtMessageReceived.Subscribe(
+			[this](const NetworkMessage& message) { Handle_MessageReceived(message); }));
+	}
+
+	BotClient::~BotClient()
+	{
+		m_NetworkClientEventHandles.clear();
+
+		Stop();
+	}
+
+	void BotClient::Start()
+	{
+		m_NetworkClient.Start();
+	}
+
+	void BotClient::Stop()
+	{
+		if (m_NetworkClient.IsRunning())
+		{
+			m_NetworkClient.Stop();
+		}
+	}
+
+	void BotClient::Update(Clock::time_point now)
+	{
+		std::unique_lock lock(m_Mutex);
+
+		const float deltaSeconds = m_LastUpdateTime == Clock::time_point{}
+									   ? 0.f
+									   : std::chrono::duration<float>(now - m_LastUpdateTime).count();
+		m_LastUpdateTime = now;
+
+		// The ClientInfoMsg is lost when sent before ENet is connected : sent again until the server answers
+		if (!m_IsConnected)
+		{
+			if (now - m_LastClientInfoTime < CLIENT_INFO_RETRY_PERIOD)
+				return;
+
+			m_LastClientInfoTime = now;
+			lock.unlock();
+
+			ClientInfoMsg clientInfoMsg;
+			clientInfoMsg.PlayerName = m_Name;
+			clientInfoMsg.UUID = m_UUID;
+
+			m_NetworkClient.Send(std::move(clientInfoMsg));
+			return;
+		}
+
+		// Like the game client, nothing is sent before the player is known
+		if (!m_SpawnPosition)
+			return;
+
+		const glm::vec3 position = MoveAlongPath(deltaSeconds);
+		const glm::vec3 facing = position - m_Position;
+		m_Position = position;
+
+		m_Player.SetPosition(position);
+		if (glm::dot(facing, facing) > 0.f)
+			m_Player.SetFacing(glm::normalize(facing));
+
+		RequestChunksAround(Utils::WorldToChunkPosition(glm::ivec3(glm::floor(position))), now);
+
+		const bool editDue = m_Settings.EditPeriod.count() > 0 && now - m_LastEditTime >= m_Settings.EditPeriod;
+		if (editDue)
+			m_LastEditTime = now;
+
+		lock.unlock();
+
+		PlayerInfoMsg playerInfoMsg;
+		playerInfoMsg.player = SerializerDTO::SerializePlayer(m_Player);
+		m_NetworkClient.Send(std::move(playerInfoMsg));
+
+		if (editDue)
+			EditBlock(position);
+	}
+
+	bool BotClient::IsSpawned() const
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_IsConnected && m_SpawnPosition.has_value();
+	}
+
+	BotClient::Stats BotClient::TakeStats()
+	{
+		std::lock_guard lock(m_Mutex);
+		return std::exchange(m_Stats, Stats{});
+	}
+
+	size_t BotClient::GetPendingChunkCount() const
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_RequestedChunks.size();
+	}
+
+	std::array<ChannelStats, NETWORK_CHANNEL_COUNT> BotClient::GetChannelStats() const
+	{
+		return m_NetworkClient.GetChannelStats();
+	}
+
+	void BotClient::Handle_Connected(const ServerInfoMsg& msg)
+	{
+		std::lock_guard lock(m_Mutex);
+		m_IsConnected = true;
+		m_ChunkDistance = msg.SimulationDistance;
+	}
+
+	void BotClient::Handle_MessageReceived(const NetworkMessage& message)
+	{
+		if (const ChunkDataMsg* chunkData = std::get_if<ChunkDataMsg>(&message))
+		{
+			// Chunks received through ENet are already decoded
+			if (chunkData->DecodedChunk)
+				Handle_ChunkReceived(chunkData->DecodedChunk->GetPosition());
+		}
+		else if (const EntitySnapshotMsg* entitySnapshot = std::get_if<EntitySnapshotMsg>(&message))
+		{
+			Handle_EntitySnapshot(*entitySnapshot);
+		}
+		else if (const ServerInfoMsg* serverInfo = std::get_if<ServerInfoMsg>(&message))
+		{
+			// Also broadcast when the simulation distance changes
+			std::lock_guard lock(m_Mutex);
+			m_ChunkDistance = serverInfo->SimulationDistance;
+		}
+	}
+
+	void BotClient::Handle_ChunkReceived(const glm::ivec2& chunkPosition)
+	{
+		std::lock_guard lock(m_Mutex);
+
+		auto it = m_RequestedChunks.find(chunkPosition);
+		if (it == m_RequestedChunks.end())
+			return; // Not requested, or already left behind
+
+		m_Stats.ChunkLatenciesMs.push_back(
+			std::chrono::duration<double, std::milli>(Clock::now() - it->second).count());
+
+		m_RequestedChunks.erase(it);
+		m_LoadedChunks.insert(chunkPosition);
+	}
+
+	void BotClient::Handle_EntitySnapshot(const EntitySnapshotMsg& msg)
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			if (m_SpawnPosition)
+				return;
+		}
+
+		for (const PlayerDTO& player : msg.Players)
+		{
+			if (player.UUID != m_UUID || !player.Transform)
+				continue;
+
+			std::lock_guard lock(m_Mutex);
+			m_SpawnPosition = player.Transform->Position + glm::vec3(0.f, m_Settings.Height, 0.f);
+			m_Position = *m_SpawnPosition;
+			m_WanderTarget = *m_SpawnPosition;
+			return;
+		}
+	}
+
+	glm::vec3 BotClient::MoveAlongPath(float deltaSeconds)
+	{
+		const glm::vec3 spawn = *m_SpawnPosition;
+		const float radius = std::max(m_Settings.Radius, 1.f);
+		const float step = m_Settings.Speed * deltaSeconds;
+
+		// Golden angle : the bots spread evenly whatever their count
+		const float startAngle = static_cast<float>(m_Index) * 2.39996323f;
+
+		m_PathDistance += step;
+
+		switch (m_Settings.Path)
+		{
+			case eBotPath::Circle:
+				{
+					const float angle = startAngle + m_PathDistance / radius;
+					return spawn + glm::vec3(std::cos(angle), 0.f, std::sin(angle)) * radius;
+				}
+
+			case eBotPath::Line:
+				{
+					// Triangle wave : out to the radius, then back to the spawn
+					float distance = std::fmod(m_PathDistance, 2.f * radius);
+					if (distance > radius)
+						distance = 2.f * radius - distance;
+
+					return spawn + glm::vec3(std::cos(startAngle), 0.f, std::sin(startAngle)) * distance;
+				}
+
+			case eBotPath::Wander:
+				{
+					const glm::vec3 toTarget = m_WanderTarget - m_Position;
+					const float distance = glm::length(toTarget);
+
+					if (distance <= step)
+					{
+						// Stop on the waypoint, the next one is walked to from the following Update
+						std::uniform_real_distribution<float> offset(-radius, radius);
+						m_WanderTarget = spawn + glm::vec3(offset(m_Rng), 0.f, offset(m_Rng));
+						return m_Position + toTarget;
+					}
+
+					return m_Position + toTarget / distance * step;
+				}
+		}
+
+		return m_Position;
+	}
+
+	void BotClient::RequestChunksAround(const glm::ivec2& center, Clock::time_point now)
+	{
+		if (m_HasCenter && center == m_Center)
+			return;
+
+		m_HasCenter = true;
+		m_Center = center;
+
+		const int distance = m_ChunkDistance;
+		auto isOutside = [&](const glm::ivec2& chunkPosition)
+		{ return std::abs(chunkPosition.x - center.x) > distance || std::abs(chunkPosition.y - center.y) > distance; };
+
+		// Left behind, like the game client unloads them. The server cancels the chunks not sent yet.
+		for (auto it = m_RequestedChunks.begin(); it != m_RequestedChunks.end();)
+		{
+			if (isOutside(it->first))
+			{
+				m_Stats.ChunksCancelled++;
+				it = m_RequestedChunks.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+		std::erase_if(m_LoadedChunks, isOutside);
+
+		RequestChunksMsg requestChunksMsg;
+		for (int z = center.y - distance; z <= center.y + distance; z++)
+		{
+			for (int x = center.x - distance; x <= center.x + distance; x++)
+			{
+				const glm::ivec2 chunkPosition(x, z);
+				if (m_LoadedChunks.contains(chunkPosition) || m_RequestedChunks.contains(chunkPosition))
+					continue;
+
+				m_RequestedChunks.emplace(chunkPosition, now);
+				requestChunksMsg.requestedChunks.push_back(chunkPosition);
+			}
+		}
+
+		if (!requestChunksMsg.requestedChunks.empty())
+			m_NetworkClient.Send(std::move(requestChunksMsg));
+	}
+
+	void BotClient::EditBlock(const glm::vec3& position)
+	{
+		Block block;
+		{
+			std::lock_guard lock(m_Mutex);
+
+			// Placed above the head, where it is out of the way, then broken : the world is left as it was
+			if (m_PlacedBlock)
+			{
+				block = Block(*m_PlacedBlock, BlockState(BlockId::Air));
+				m_PlacedBlock.reset();
+			}
+			else
+			{
+				const glm::ivec3 blockPosition = glm::ivec3(glm::floor(position)) + glm::ivec3(0, 3, 0);
+				block = Block(blockPosition, BlockState(BlockId::Stone));
+				m_PlacedBlock = blockPosition;
+			}
+
+			m_Stats.BlockEdits++;
+		}
+
+		BlocksChangedMsg blocksChangedMsg;
+		blocksChangedMsg.ChangedBlocks.push_back(SerializerDTO::SerializeBlock(block));
+
+		m_NetworkClient.Send(std::move(blocksChangedMsg));
+	}
+} // namespace onion::voxel::loadtest
@@ -0,0 +1,133 @@
+#pragma once
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <onion/Event.hpp>
+
+#include <network_client/NetworkClient.hpp>
+#include <shared/entities/entity/player/Player.hpp>
+
+namespace onion::voxel::loadtest
+{
+	enum class eBotPath
+	{
+		Circle, // Around the spawn, each bot starting at a different angle
+		Line,	// Out from the spawn and back, each bot in a different direction
+		Wander	// Random waypoints around the spawn
+	};
+
+	struct BotSettings
+	{
+		eBotPath Path = eBotPath::Circle;
+		float Speed = 4.3f;	  // Blocks per second (4.3 walking, 10.9 flying)
+		float Radius = 48.f;  // Size of the path around the spawn, in blocks
+		float Height = 0.f;	  // Height above the spawn. Bots have no physics : they fly along their path
+		std::chrono::milliseconds EditPeriod{1000}; // Time between two block edits (place, then break), 0 to disable
+	};
+
+	/// @brief Headless player : a NetworkClient that plays like the game client does, without a world or renderer.
+	/// Connects with a ClientInfoMsg, sends its PlayerInfoMsg at each Update, requests the chunks around it as it
+	/// moves along its path and places then breaks a block above its head. Keeps the time each chunk took to arrive.
+	class BotClient
+	{
+		using Clock = std::chrono::steady_clock;
+
+		// ----- Structs -----
+	  public:
+		struct Stats
+		{
+			uint64_t ChunksCancelled = 0; // Requested, then left behind before being received
+			uint64_t BlockEdits = 0;
+			std::vector<double> ChunkLatenciesMs; // One per chunk received
+		};
+
+		// ----- Constructor / Destructor -----
+	  public:
+		BotClient(uint32_t index, const std::string& host, uint16_t port, const BotSettings& settings);
+		~BotClient();
+
+		BotClient(const BotClient&) = delete;
+		BotClient& operator=(const BotClient&) = delete;
+
+		// ----- Public API -----
+	  public:
+		void Start();
+		void Stop();
+
+		/// @brief Move along the path and send the player infos. Called at the game client's rate (20 Hz).
+		void Update(Clock::time_point now);
+
+		/// @brief Connected and spawned (its player was in an entity snapshot).
+		bool IsSpawned() const;
+
+		/// @brief Stats since the last call.
+		Stats TakeStats();
+		/// @brief Chunks requested and not received yet.
+		size_t GetPendingChunkCount() const;
+
+		std::array<ChannelStats, NETWORK_CHANNEL_COUNT> GetChannelStats() const;
+
+		// ----- Private Methods -----
+	  private:
+		void Handle_Connected(const ServerInfoMsg& msg);
+		void Handle_MessageReceived(const NetworkMessage& message);
+		void Handle_ChunkReceived(const glm::ivec2& chunkPosition);
+		void Handle_EntitySnapshot(const EntitySnapshotMsg& msg);
+
+		glm::vec3 MoveAlongPath(float deltaSeconds);
+		void RequestChunksAround(const glm::ivec2& center, Clock::time_point now);
+		void EditBlock(const glm::vec3& position);
+
+		// ----- Private Members -----
+	  private:
+		static constexpr auto CLIENT_INFO_RETRY_PERIOD = std::chrono::seconds(1);
+
+		const uint32_t m_Index;
+		const BotSettings m_Settings;
+		const std::string m_UUID;
+		const std::string m_Name;
+
+		NetworkClient m_NetworkClient;
+		std::vector<EventHandle> m_NetworkClientEventHandles;
+
+		Player m_Player;
+		std::mt19937 m_Rng;
+
+		mutable std::mutex m_Mutex;
+		bool m_IsConnected = false;
+		uint8_t m_ChunkDistance = 0;
+		std::optional<glm::vec3> m_SpawnPosition;
+		Clock::time_point m_LastClientInfoTime{};
+		Clock::time_point m_LastUpdateTime{};
+		Clock::time_point m_LastEditTime{};
+
+		// Path
+		float m_PathDistance = 0.f; // Blocks travelled since the spawn
+		glm::vec3 m_Position{0.f};
+		glm::vec3 m_WanderTarget{0.f};
+
+		// Chunks
+		bool m_HasCenter = false;
+		glm::ivec2 m_Center{0, 0};
+		std::unordered_map<glm::ivec2, Clock::time_point> m_RequestedChunks;
+		std::unordered_set<glm::ivec2> m_LoadedChunks;
+
+		// Block edits : the block placed last, broken at the next edit
+		std::optional<glm::ivec3> m_PlacedBlock;
+
+		Stats m_Stats;
+	};
+} // namespace onion::voxel::loadtest
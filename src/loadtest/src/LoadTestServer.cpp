@@ -0,0 +1,65 @@
+#include "LoadTestServer.hpp"
+
+#include <cstdio>
+#include <filesystem>
+
+#include <shared/world/world_save/WorldSave.hpp>
+
+namespace onion::voxel::loadtest
+{
+	std::unique_ptr<Server> CreateFreshServer(ServerConfiguration config)
+	{
+		config.serverData.MetricsPeriod = 0;
+
+		std::filesystem::remove_all(config.serverData.WorldDirectory);
+
+		WorldInfos infos;
+		infos.Seed = config.serverData.Seed;
+		infos.Name = config.serverData.ServerName;
+		infos.CreationDate = DateTime::UtcNow();
+		infos.WorldGenerationType =
+			static_cast<WorldGenerator::eWorldGenerationType>(config.serverData.WorldGenerationType);
+		WorldSave::CreateWorld(config.serverData.WorldDirectory, infos);
+
+		return std::make_unique<Server>(config);
+	}
+
+	nlohmann::ordered_json ReportTickTimes(Server& server, const TickScheduler::TickStats& start)
+	{
+		const ProfileHistogram::Snapshot tickTimesUs = server.TakeTickTimeSnapshot();
+		const TickScheduler::TickStats tickStats = server.GetTickStats();
+		const uint64_t ticks = tickStats.TickCount - start.TickCount;
+		const uint64_t overruns = tickStats.OverrunCount - start.OverrunCount;
+		const uint64_t skipped = tickStats.SkippedTicks - start.SkippedTicks;
+
+		// Percentiles are upper bounds of power of two buckets
+		auto toMs = [](uint64_t us) { return static_cast<double>(us) / 1000.0; };
+		const double averageMs = tickTimesUs.GetAverage() / 1000.0;
+		const double p50Ms = toMs(tickTimesUs.GetPercentile(0.5));
+		const double p90Ms = toMs(tickTimesUs.GetPercentile(0.9));
+		const double p99Ms = toMs(tickTimesUs.GetPercentile(0.99));
+		const double maxMs = toMs(tickTimesUs.Max);
+
+		std::printf("  %-16s avg %.2f ms, p50 <= %.2f ms, p90 <= %.2f ms, p99 <= %.2f ms, max %.2f ms\n",
+					"Server tick",
+					averageMs,
+					p50Ms,
+					p90Ms,
+					p99Ms,
+					maxMs);
+		std::printf("  %-16s %llu ticks, %llu overruns, %llu skipped\n",
+					"",
+					static_cast<unsigned long long>(ticks),
+					static_cast<unsigned long long>(overruns),
+					static_cast<unsigned long long>(skipped));
+
+		return {{"ticks", ticks},
+				{"overruns", overruns},
+				{"skipped", skipped},
+				{"avg_ms", averageMs},
+				{"p50_ms", p50Ms},
+				{"p90_ms", p90Ms},
+				{"p99_ms", p99Ms},
+				{"max_ms", maxMs}};
+	}
+} // namespace onion::voxel::loadtest
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <memory>
+
+#include <nlohmann/json.hpp>
+
+#include <Server.hpp>
+
+namespace onion::voxel::loadtest
+{
+	/// @brief Server on a new world created from the configuration (seed, generation type), so runs with the same
+	/// configuration load the same chunks. The world directory is deleted first. The server is not started.
+	/// Metrics are disabled : they would take the tick times the report is made of.
+	std::unique_ptr<Server> CreateFreshServer(ServerConfiguration config);
+
+	/// @brief Print the ticks since the last call of Server::TakeTickTimeSnapshot.
+	/// @param start Tick stats at the start of the measure, to count the ticks and overruns since.
+	/// @return The same values, for the JSON report.
+	nlohmann::ordered_json ReportTickTimes(Server& server, const TickScheduler::TickStats& start);
+} // namespace onion::voxel::loadtest
@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <nlohmann/json.hpp>
+
+#include <network_recorder/NetworkRecorder.hpp>
+#include <shared/utils/Utils.hpp>
+
+#include "LoadTestServer.hpp"
+
+using namespace onion::voxel;
+using namespace onion::voxel::loadtest;
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	std::atomic_bool g_stopRequested{false};
+
+	void SignalHandler(int)
+	{
+		g_stopRequested.store(true);
+	}
+
+	struct Options
+	{
+		std::string RecordingFilePath;
+		double Speed = 1.0; // 1 : recorded pace, 0 : as fast as possible
+		std::optional<uint32_t> Seed;
+		double DrainSeconds = 5.0;
+		std::string JsonFilePath;
+	};
+
+	void PrintUsage()
+	{
+		std::cout << "Usage : onion_voxel_replay <recording> [options]\n"
+				  << "  --speed <factor>   Replay speed, 1 for the recorded pace, 0 for as fast as possible (1)\n"
+				  << "  --seed <seed>      World seed, instead of the one of the recorded world\n"
+				  << "  --drain <s>        Time left to the server after the last message, in the report (5)\n"
+				  << "  --json <file>      Write the report as JSON\n";
+	}
+
+	std::optional<Options> ParseOptions(int argc, char** argv)
+	{
+		Options options;
+
+		for (int i = 1; i < argc; i++)
+		{
+			const std::string arg = argv[i];
+
+			if (arg == "--help" || arg == "-h")
+			{
+				PrintUsage();
+				return std::nullopt;
+			}
+
+			if (arg.rfind("--", 0) != 0)
+			{
+				options.RecordingFilePath = arg;
+				continue;
+			}
+
+			if (i + 1 >= argc)
+			{
+				std::cerr << arg << " expects a value\n";
+				return std::nullopt;
+			}
+			const std::string value = argv[++i];
+
+			try
+			{
+				if (arg == "--speed")
+					options.Speed = std::max(0.0, std::stod(value));
+				else if (arg == "--seed")
+					options.Seed = static_cast<uint32_t>(std::stoul(value));
+				else if (arg == "--drain")
+					options.DrainSeconds = std::stod(value);
+				else if (arg == "--json")
+					options.JsonFilePath = value;
+				else
+				{
+					std::cerr << "Unknown option " << arg << "\n";
+					PrintUsage();
+					return std::nullopt;
+				}
+			}
+			catch (const std::exception&)
+			{
+				std::cerr << "Invalid value for " << arg << ": " << value << "\n";
+				return std::nullopt;
+			}
+		}
+
+		if (options.RecordingFilePath.empty())
+		{
+			PrintUsage();
+			return std::nullopt;
+		}
+
+		return options;
+	}
+} // namespace
+
+// Usage : onion_voxel_replay <recording> [options] (see --help)
+// Replays a recording written by a server with RecordNetworkSession : each recorded client becomes an in-process
+// client of a new server, on a new world with the recorded seed, and sends the recorded messages at their time.
+int main(int argc, char** argv)
+{
+	const std::optional<Options> parsedOptions = ParseOptions(argc, argv);
+	if (!parsedOptions)
+		return 1;
+	const Options& options = *parsedOptions;
+
+	NetworkRecordingReader reader;
+	if (!reader.Open(options.RecordingFilePath))
+		return 1;
+
+	const NetworkRecordingInfo& info = reader.GetInfo();
+
+	std::cout << "\n --- ONION VOXEL REPLAY ---" << std::endl;
+
+	std::signal(SIGINT, SignalHandler);
+
+	ServerConfiguration cfg;
+	cfg.serverData.ServerName = "Replay";
+	cfg.serverData.UUID = Utils::GenerateUUID();
+	cfg.serverData.Seed = options.Seed.value_or(info.Seed);
+	cfg.serverData.WorldGenerationType = info.WorldGenerationType;
+	cfg.serverData.SimulationDistance = info.SimulationDistance;
+	if (info.TickRate > 0)
+		cfg.serverData.TickRate = info.TickRate;
+	cfg.serverData.WorldDirectory = Utils::GetExecutableDirectory() / "replay_world";
+
+	std::unique_ptr<Server> server = CreateFreshServer(cfg);
+	server->StartLocal();
+
+	std::cout << "\n[Replay] " << options.RecordingFilePath << " : seed " << cfg.serverData.Seed << ", speed ";
+	if (options.Speed > 0.0)
+		std::cout << options.Speed << "x" << std::endl;
+	else
+		std::cout << "max" << std::endl;
+
+	// ---- Replay ----
+	server->TakeTickTimeSnapshot();
+	const TickScheduler::TickStats tickStatsStart = server->GetTickStats();
+
+	std::unordered_map<uint32_t, std::shared_ptr<LocalConnection>> connections;
+	std::atomic_uint64_t messagesToClients{0};
+	uint64_t messages = 0;
+	uint64_t disconnections = 0;
+	uint64_t recordedUs = 0;
+
+	const Clock::time_point replayStart = Clock::now();
+
+	NetworkRecord record;
+	while (!g_stopRequested.load() && reader.Next(record))
+	{
+		recordedUs = record.TimeUs;
+
+		if (options.Speed > 0.0)
+		{
+			std::this_thread::sleep_until(
+				replayStart + std::chrono::duration_cast<Clock::duration>(
+								  std::chrono::duration<double, std::micro>(record.TimeUs / options.Speed)));
+		}
+
+		auto it = connections.find(record.Client);
+
+		if (record.Kind == NetworkRecord::eKind::Disconnect)
+		{
+			if (it != connections.end())
+			{
+				it->second->CloseFromClient();
+				connections.erase(it);
+				disconnections++;
+			}
+			continue;
+		}
+
+		// A recorded client connects with its first message
+		if (it == connections.end())
+		{
+			std::shared_ptr<LocalConnection> connection = server->ConnectLocalClient();
+			connection->BindClient([&messagesToClients](NetworkMessage&&) { messagesToClients.fetch_add(1); },
+								   []() {});
+			it = connections.emplace(record.Client, std::move(connection)).first;
+		}
+
+		it->second->SendToServer(std::move(record.Message));
+		messages++;
+	}
+
+	const double replaySeconds = std::chrono::duration<double>(Clock::now() - replayStart).count();
+
+	// The server is still working on the last messages (chunk generation, block updates)
+	const Clock::time_point drainEnd =
+		Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.DrainSeconds));
+	while (Clock::now() < drainEnd && !g_stopRequested.load())
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	}
+
+	// ---- Report ----
+	const double recordedSeconds = static_cast<double>(recordedUs) / 1e6;
+
+	std::printf("\n  %-16s %llu messages, %llu disconnections, %zu clients still connected\n",
+				"Replayed",
+				static_cast<unsigned long long>(messages),
+				static_cast<unsigned long long>(disconnections),
+				connections.size());
+	std::printf("  %-16s %.1f s recorded, replayed in %.1f s (+ %.1f s drain)\n",
+				"Time",
+				recordedSeconds,
+				replaySeconds,
+				options.DrainSeconds);
+	std::printf("  %-16s %llu messages\n",
+				"Sent to clients",
+				static_cast<unsigned long long>(messagesToClients.load()));
+
+	nlohmann::ordered_json json;
+	json["recording"] = options.RecordingFilePath;
+	json["seed"] = cfg.serverData.Seed;
+	json["speed"] = options.Speed;
+	json["messages"] = messages;
+	json["disconnections"] = disconnections;
+	json["recorded_seconds"] = recordedSeconds;
+	json["replay_seconds"] = replaySeconds;
+	json["messages_to_clients"] = messagesToClients.load();
+	json["tick"] = ReportTickTimes(*server, tickStatsStart);
+
+	// ---- Stop ----
+	for (const auto& [client, connection] : connections)
+	{
+		connection->CloseFromClient();
+	}
+	connections.clear();
+	server->Stop();
+
+	if (!options.JsonFilePath.empty())
+	{
+		std::ofstream file(options.JsonFilePath);
+		if (!file.is_open())
+		{
+			std::cerr << "Failed to open " << options.JsonFilePath << " for writing\n";
+			return 1;
+		}
+
+		file << json.dump(4) << "\n";
+		std::cout << "\nReport written to " << options.JsonFilePath << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,355 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <shared/utils/Utils.hpp>
+
+#include "BotClient.hpp"
+#include "LoadTestServer.hpp"
+
+using namespace onion::voxel;
+using namespace onion::voxel::loadtest;
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// Rate at which the game client sends its player infos
+	constexpr auto UPDATE_PERIOD = std::chrono::milliseconds(50);
+	constexpr auto SPAWN_TIMEOUT = std::chrono::seconds(30);
+
+	std::atomic_bool g_stopRequested{false};
+
+	void SignalHandler(int)
+	{
+		g_stopRequested.store(true);
+	}
+
+	struct Options
+	{
+		uint32_t Bots = 10;
+		double DurationSeconds = 60.0;
+		std::chrono::milliseconds SpawnInterval{100};
+
+		std::string Host; // Empty : start a server in the process, reached through loopback
+		uint16_t Port = 7777;
+
+		// In-process server
+		uint32_t Seed = 1;
+		uint8_t SimulationDistance = 4;
+
+		BotSettings Bot;
+
+		std::string JsonFilePath;
+	};
+
+	void PrintUsage()
+	{
+		std::cout << "Usage : onion_voxel_loadtest [options]\n"
+				  << "  --bots <n>              Bots to spawn (10)\n"
+				  << "  --duration <s>          Measured time, once every bot has spawned (60)\n"
+				  << "  --spawn-interval <ms>   Time between two bot connections (100)\n"
+				  << "  --host <address>        Server to load. Without it, a server is started in the process\n"
+				  << "  --port <port>           Server port (7777)\n"
+				  << "  --seed <seed>           World seed of the in-process server (1)\n"
+				  << "  --distance <chunks>     Simulation distance of the in-process server (4)\n"
+				  << "  --path <circle|line|wander>\n"
+				  << "  --speed <blocks/s>      Bot speed (4.3)\n"
+				  << "  --radius <blocks>       Size of the paths around the spawn (48)\n"
+				  << "  --height <blocks>       Flying height above the spawn (0)\n"
+				  << "  --edit-period <ms>      Time between two block edits of a bot, 0 to disable (1000)\n"
+				  << "  --json <file>           Write the report as JSON\n";
+	}
+
+	std::optional<Options> ParseOptions(int argc, char** argv)
+	{
+		Options options;
+
+		for (int i = 1; i < argc; i++)
+		{
+			const std::string arg = argv[i];
+
+			if (arg == "--help" || arg == "-h")
+			{
+				PrintUsage();
+				return std::nullopt;
+			}
+
+			if (i + 1 >= argc)
+			{
+				std::cerr << arg << " expects a value\n";
+				return std::nullopt;
+			}
+			const std::string value = argv[++i];
+
+			try
+			{
+				if (arg == "--bots")
+					options.Bots = static_cast<uint32_t>(std::stoul(value));
+				else if (arg == "--duration")
+					options.DurationSeconds = std::stod(value);
+				else if (arg == "--spawn-interval")
+					options.SpawnInterval = std::chrono::milliseconds(std::stoul(value));
+				else if (arg == "--host")
+					options.Host = value;
+				else if (arg == "--port")
+					options.Port = static_cast<uint16_t>(std::stoul(value));
+				else if (arg == "--seed")
+					options.Seed = static_cast<uint32_t>(std::stoul(value));
+				else if (arg == "--distance")
+					options.SimulationDistance = static_cast<uint8_t>(std::stoul(value));
+				else if (arg == "--speed")
+					options.Bot.Speed = std::stof(value);
+				else if (arg == "--radius")
+					options.Bot.Radius = std::stof(value);
+				else if (arg == "--height")
+					options.Bot.Height = std::stof(value);
+				else if (arg == "--edit-period")
+					options.Bot.EditPeriod = std::chrono::milliseconds(std::stoul(value));
+				else if (arg == "--json")
+					options.JsonFilePath = value;
+				else if (arg == "--path")
+				{
+					if (value == "circle")
+						options.Bot.Path = eBotPath::Circle;
+					else if (value == "line")
+						options.Bot.Path = eBotPath::Line;
+					else if (value == "wander")
+						options.Bot.Path = eBotPath::Wander;
+					else
+						throw std::invalid_argument("unknown path");
+				}
+				else
+				{
+					std::cerr << "Unknown option " << arg << "\n";
+					PrintUsage();
+					return std::nullopt;
+				}
+			}
+			catch (const std::exception&)
+			{
+				std::cerr << "Invalid value for " << arg << ": " << value << "\n";
+				return std::nullopt;
+			}
+		}
+
+		return options;
+	}
+
+	std::unique_ptr<Server> StartLocalServer(const Options& options)
+	{
+		ServerConfiguration cfg;
+		cfg.serverData.ServerName = "LoadTest";
+		cfg.serverData.UUID = Utils::GenerateUUID();
+		cfg.serverData.Port = options.Port;
+		cfg.serverData.Seed = options.Seed;
+		cfg.serverData.SimulationDistance = options.SimulationDistance;
+		cfg.serverData.WorldDirectory = Utils::GetExecutableDirectory() / "loadtest_world";
+
+		std::unique_ptr<Server> server = CreateFreshServer(cfg);
+		server->Start();
+		return server;
+	}
+
+	void UpdateBots(const std::vector<std::unique_ptr<BotClient>>& bots, Clock::time_point& nextUpdate)
+	{
+		std::this_thread::sleep_until(nextUpdate);
+		nextUpdate += UPDATE_PERIOD;
+
+		const Clock::time_point now = Clock::now();
+		for (const auto& bot : bots)
+		{
+			bot->Update(now);
+		}
+	}
+
+	size_t CountSpawnedBots(const std::vector<std::unique_ptr<BotClient>>& bots)
+	{
+		return static_cast<size_t>(
+			std::count_if(bots.begin(), bots.end(), [](const auto& bot) { return bot->IsSpawned(); }));
+	}
+
+	uint64_t SumBytes(const std::vector<std::unique_ptr<BotClient>>& bots, bool received)
+	{
+		uint64_t bytes = 0;
+		for (const auto& bot : bots)
+		{
+			for (const ChannelStats& stats : bot->GetChannelStats())
+				bytes += received ? stats.BytesReceived : stats.BytesSent;
+		}
+		return bytes;
+	}
+
+	double GetPercentile(const std::vector<double>& sortedValues, double percentile)
+	{
+		if (sortedValues.empty())
+			return 0.0;
+
+		const size_t index = static_cast<size_t>(percentile * static_cast<double>(sortedValues.size() - 1) + 0.5);
+		return sortedValues[std::min(index, sortedValues.size() - 1)];
+	}
+} // namespace
+
+// Usage : onion_voxel_loadtest [options] (see --help)
+int main(int argc, char** argv)
+{
+	const std::optional<Options> parsedOptions = ParseOptions(argc, argv);
+	if (!parsedOptions)
+		return 1;
+	const Options& options = *parsedOptions;
+
+	std::cout << "\n --- ONION VOXEL LOAD TEST ---" << std::endl;
+
+	std::signal(SIGINT, SignalHandler);
+
+	std::unique_ptr<Server> server;
+	if (options.Host.empty())
+		server = StartLocalServer(options);
+
+	const std::string host = options.Host.empty() ? "127.0.0.1" : options.Host;
+
+	// ---- Spawn ----
+	std::vector<std::unique_ptr<BotClient>> bots;
+	bots.reserve(options.Bots);
+
+	Clock::time_point nextUpdate = Clock::now();
+	Clock::time_point nextSpawn = nextUpdate;
+
+	while (bots.size() < options.Bots && !g_stopRequested.load())
+	{
+		if (Clock::now() >= nextSpawn)
+		{
+			auto bot = std::make_unique<BotClient>(static_cast<uint32_t>(bots.size()), host, options.Port, options.Bot);
+			bot->Start();
+			bots.push_back(std::move(bot));
+			nextSpawn += options.SpawnInterval;
+		}
+
+		UpdateBots(bots, nextUpdate);
+	}
+
+	const Clock::time_point spawnDeadline = Clock::now() + SPAWN_TIMEOUT;
+	while (CountSpawnedBots(bots) < bots.size() && Clock::now() < spawnDeadline && !g_stopRequested.load())
+	{
+		UpdateBots(bots, nextUpdate);
+	}
+
+	const size_t spawnedBots = CountSpawnedBots(bots);
+	std::cout << "\n[LoadTest] " << spawnedBots << "/" << bots.size() << " bots spawned, measuring for "
+			  << options.DurationSeconds << " s" << std::endl;
+
+	// ---- Measure ----
+	for (const auto& bot : bots)
+		bot->TakeStats();
+
+	std::optional<TickScheduler::TickStats> tickStatsStart;
+	if (server)
+	{
+		server->TakeTickTimeSnapshot();
+		tickStatsStart = server->GetTickStats();
+	}
+
+	const uint64_t bytesReceivedStart = SumBytes(bots, true);
+	const uint64_t bytesSentStart = SumBytes(bots, false);
+	const Clock::time_point measureStart = Clock::now();
+	const Clock::time_point measureEnd =
+		measureStart +
+		std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.DurationSeconds));
+
+	while (Clock::now() < measureEnd && !g_stopRequested.load())
+	{
+		UpdateBots(bots, nextUpdate);
+	}
+
+	const double seconds = std::chrono::duration<double>(Clock::now() - measureStart).count();
+
+	// ---- Report ----
+	std::vector<double> chunkLatenciesMs;
+	uint64_t chunksCancelled = 0;
+	uint64_t blockEdits = 0;
+	size_t chunksPending = 0;
+	for (const auto& bot : bots)
+	{
+		BotClient::Stats stats = bot->TakeStats();
+		chunkLatenciesMs.insert(chunkLatenciesMs.end(), stats.ChunkLatenciesMs.begin(), stats.ChunkLatenciesMs.end());
+		chunksCancelled += stats.ChunksCancelled;
+		blockEdits += stats.BlockEdits;
+		chunksPending += bot->GetPendingChunkCount();
+	}
+	std::sort(chunkLatenciesMs.begin(), chunkLatenciesMs.end());
+
+	const double downKBps = static_cast<double>(SumBytes(bots, true) - bytesReceivedStart) / 1024.0 / seconds;
+	const double upKBps = static_cast<double>(SumBytes(bots, false) - bytesSentStart) / 1024.0 / seconds;
+	const double botCount = static_cast<double>(std::max<size_t>(spawnedBots, 1));
+
+	nlohmann::ordered_json json;
+	json["bots"] = options.Bots;
+	json["spawned_bots"] = spawnedBots;
+	json["seconds"] = seconds;
+
+	std::printf("\n  %-16s %zu/%u spawned, %.1f s\n", "Bots", spawnedBots, options.Bots, seconds);
+
+	if (server)
+		json["tick"] = ReportTickTimes(*server, *tickStatsStart);
+
+	std::printf("  %-16s down %.1f KB/s (%.1f KB/s per bot), up %.1f KB/s (%.1f KB/s per bot)\n",
+				"Bandwidth",
+				downKBps,
+				downKBps / botCount,
+				upKBps,
+				upKBps / botCount);
+	std::printf("  %-16s %zu received, p50 %.1f ms, p90 %.1f ms, p99 %.1f ms, max %.1f ms\n",
+				"Chunk latency",
+				chunkLatenciesMs.size(),
+				GetPercentile(chunkLatenciesMs, 0.5),
+				GetPercentile(chunkLatenciesMs, 0.9),
+				GetPercentile(chunkLatenciesMs, 0.99),
+				chunkLatenciesMs.empty() ? 0.0 : chunkLatenciesMs.back());
+	std::printf("  %-16s %llu cancelled, %zu still pending\n",
+				"",
+				static_cast<unsigned long long>(chunksCancelled),
+				chunksPending);
+	std::printf("  %-16s %llu\n", "Block edits", static_cast<unsigned long long>(blockEdits));
+
+	json["bandwidth"] = {{"down_kbps", downKBps}, {"up_kbps", upKBps}};
+	json["chunks"] = {{"received", chunkLatenciesMs.size()},
+					  {"cancelled", chunksCancelled},
+					  {"pending", chunksPending},
+					  {"p50_ms", GetPercentile(chunkLatenciesMs, 0.5)},
+					  {"p90_ms", GetPercentile(chunkLatenciesMs, 0.9)},
+					  {"p99_ms", GetPercentile(chunkLatenciesMs, 0.99)},
+					  {"max_ms", chunkLatenciesMs.empty() ? 0.0 : chunkLatenciesMs.back()}};
+	json["block_edits"] = blockEdits;
+
+	// ---- Stop ----
+	bots.clear();
+	if (server)
+		server->Stop();
+
+	if (!options.JsonFilePath.empty())
+	{
+		std::ofstream file(options.JsonFilePath);
+		if (!file.is_open())
+		{
+			std::cerr << "Failed to open " << options.JsonFilePath << " for writing\n";
+			return 1;
+		}
+
+		file << json.dump(4) << "\n";
+		std::cout << "\nReport written to " << options.JsonFilePath << std::endl;
+	}
+
+	return 0;
+}
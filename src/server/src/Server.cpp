@@ -1,8 +1,11 @@
 #include "Server.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 
 #include <shared/data_transfer_objects/serializer/SerializerDTO.hpp>
+#include <shared/profiler/Profiler.hpp>
 #include <shared/utils/Utils.hpp>
 
 namespace onion::voxel
@@ -38,7 +41,11 @@ namespace onion::voxel
 
 	Server::~Server()
 	{
+		m_TimerMetrics.Stop();
+		m_TickScheduler.Stop();
+
 		m_NetworkServerEventHandles.clear();
+		m_TickSchedulerEventHandles.clear();
 		m_WorldManagerEventHandles.clear();
 
 		m_NetworkServer.Stop();
@@ -50,16 +57,48 @@ namespace onion::voxel
 
 	void Server::Start()
 	{
-		m_TimerSendEvents.Start();
+		m_TickScheduler.Start();
 		m_NetworkServer.Start();
 		m_IsRunning.store(true);
+
+		if (m_Config.serverData.MetricsPeriod > 0)
+		{
+			m_TimerMetrics.setTimeoutFunction([this]() { WriteMetrics(); });
+			m_TimerMetrics.setElapsedPeriod(std::chrono::seconds(m_Config.serverData.MetricsPeriod));
+			m_TimerMetrics.Start();
+		}
+
+		if (m_Config.serverData.RecordNetworkSession)
+		{
+			StartNetworkRecording();
+		}
+	}
+
+	void Server::StartLocal()
+	{
+		m_TickScheduler.Start();
+		m_NetworkServer.StartLocal();
+		m_IsRunning.store(true);
+	}
+
+	std::shared_ptr<LocalConnection> Server::ConnectLocalClient()
+	{
+		return m_NetworkServer.ConnectLocalClient();
 	}
 
 	void Server::Stop()
 	{
-		m_TimerSendEvents.Stop();
+		m_TimerMetrics.Stop();
+		m_TickScheduler.Stop();
 		m_NetworkServer.Stop();
-		m_IsRunning.store(false);
+		StopNetworkRecording();
+
+		if (m_IsRunning.exchange(false) && m_Config.serverData.WriteProfilerTrace)
+		{
+			const std::filesystem::path tracePath = Utils::GetExecutableDirectory() / PROFILER_TRACE_FILE_NAME;
+			if (Profiler::WriteChromeTrace(tracePath))
+				std::cout << "Profiler trace written to " << tracePath << "\n";
+		}
 	}
 
 	bool Server::IsRunning() const noexcept
@@ -73,6 +112,7 @@ namespace onion::voxel
 
 		m_WorldManager->SetChunkLoadingDistance(distance);
 		m_WorldManager->SetChunkPersistanceDistance(distance);
+		m_ChunkStreamer->SetStreamingDistance(distance);
 
 		// Broadcast new simulation distance to all clients
 		ServerInfoMsg srvInfoMsg;
@@ -93,13 +133,380 @@ namespace onion::voxel
 		m_WorldManager->SetChunkPersistanceDistance(m_Config.serverData.SimulationDistance);
 		m_WorldManager->SetChunkLoadingDistance(m_Config.serverData.SimulationDistance);
 
+		m_ChunkStreamer = std::make_unique<ChunkStreamer>(m_NetworkServer, m_WorldManager);
+		m_ChunkStreamer->SetStreamingDistance(m_Config.serverData.SimulationDistance);
+		m_ChunkStreamer->SetMaxBytesPerSecond(m_Config.serverData.ChunkStreamRateKBps * 1024);
+
+		m_PhysicsSimulation = std::make_unique<PhysicsSimulation>(*m_WorldManager);
+
 		SubscribeToNetworkServerEvents();
 		SubscribeToWorldManagerEvents();
 
-		// Setup Timer
-		m_TimerSendEvents.setTimeoutFunction([this]() { Handle_TimerSendEvents(); });
-		std::chrono::milliseconds defaultElapsedPeriod(100);
-		m_TimerSendEvents.setElapsedPeriod(defaultElapsedPeriod);
+		// Missing chunks are requested by the tick (World phase)
+		m_WorldManager->SetTriggeringEventMissingChunks(false);
+
+		// Setup Tick
+		m_TickScheduler.SetTicksPerSecond(m_Config.serverData.TickRate);
+		SetupTickPhases();
+	}
+
+	TickScheduler::TickStats Server::GetTickStats() const
+	{
+		return m_TickScheduler.GetStats();
+	}
+
+	ProfileHistogram::Snapshot Server::TakeTickTimeSnapshot()
+	{
+		return m_TickScheduler.TakeTickTimeSnapshot();
+	}
+
+	void Server::SetupTickPhases()
+	{
+		m_TickScheduler.AddPhase("Inbound", [this](uint64_t tick) { Tick_Inbound(tick); });
+		m_TickScheduler.AddPhase("World", [this](uint64_t tick) { Tick_World(tick); });
+		m_TickScheduler.AddPhase("Outbound", [this](uint64_t tick) { Tick_Outbound(tick); });
+
+		m_TickSchedulerEventHandles.push_back(m_TickScheduler.EvtTickOverrun.Subscribe(
+			[this](const TickScheduler::TickOverrunEventArgs& args) { Handle_TickOverrun(args); }));
+	}
+
+	void Server::Tick_Inbound(uint64_t tick)
+	{
+		(void) tick;
+
+		// Connections, disconnections and client messages, in the order they were received
+		InboundEvent inboundEvent;
+		for (size_t i = 0; i < MAX_INBOUND_EVENTS_PER_TICK && m_InboundEvents.TryPop(inboundEvent); i++)
+		{
+			std::visit(
+				[this](const auto& args)
+				{
+					using T = std::decay_t<decltype(args)>;
+					if constexpr (std::is_same_v<T, NetworkServer::ClientConnectedEventArgs>)
+					{
+						Handle_ClientConnected(args);
+					}
+					else if constexpr (std::is_same_v<T, NetworkServer::ClientDisconnectedEventArgs>)
+					{
+						Handle_ClientDisconnected(args);
+					}
+					else
+					{
+						Handle_NetworkMessageReceived(args);
+					}
+				},
+				inboundEvent);
+		}
+	}
+
+	void Server::Tick_World(uint64_t tick)
+	{
+		// Once per second, like the WorldManager timer it replaces
+		if (tick % m_TickScheduler.GetTicksPerSecond() == 0)
+		{
+			m_WorldManager->RequestAllMissingChunks();
+		}
+
+		// Players leaving free their chunk tickets without moving, unloads are driven from here
+		m_WorldManager->UpdateChunkTickets();
+
+		m_WorldManager->ProcessBlockUpdates(MAX_BLOCK_UPDATES_PER_TICK);
+
+		m_PhysicsSimulation->Step(1.0f / static_cast<float>(m_TickScheduler.GetTicksPerSecond()));
+	}
+
+	void Server::Tick_Outbound(uint64_t tick)
+	{
+		BroadcastPendingBlockChanges();
+
+		m_ChunkStreamer->Update();
+
+		const uint64_t snapshotPeriodTicks =
+			std::max<uint64_t>(1, ENTITY_SNAPSHOT_PERIOD.count() * m_TickScheduler.GetTicksPerSecond() / 1000);
+		if (tick % snapshotPeriodTicks == 0)
+		{
+			SendEntitySnapshot();
+		}
+
+		LogProfilerSummary(tick);
+	}
+
+	void Server::Handle_TickOverrun(const TickScheduler::TickOverrunEventArgs& args)
+	{
+		// At most one warning per second
+		const auto now = std::chrono::steady_clock::now();
+		if (now - m_LastOverrunLog < std::chrono::seconds(1))
+			return;
+
+		m_LastOverrunLog = now;
+
+		std::cout << "Can't keep up! Tick " << args.Tick << " took " << args.TickMs << " ms (budget " << args.BudgetMs
+				  << " ms), slowest phase: " << args.SlowestPhase << "\n";
+	}
+
+	void Server::LogProfilerSummary(uint64_t tick)
+	{
+		const uint64_t periodTicks =
+			static_cast<uint64_t>(m_Config.serverData.ProfilerSummaryPeriod) * m_TickScheduler.GetTicksPerSecond();
+		if (periodTicks == 0 || tick == 0 || tick % periodTicks != 0)
+			return;
+
+		const TickScheduler::TickStats stats = m_TickScheduler.GetStats();
+		std::cout << Profiler::GetSummary(true) << "  Ticks: " << stats.TickCount
+				  << ", overruns: " << stats.OverrunCount << ", skipped: " << stats.SkippedTicks << "\n";
+	}
+
+	void Server::CollectMetrics()
+	{
+		using eType = MetricsRegistry::eType;
+
+		const auto now = std::chrono::steady_clock::now();
+		const double elapsedSeconds = m_LastMetricsTime == std::chrono::steady_clock::time_point{}
+										  ? 0.0
+										  : std::chrono::duration<double>(now - m_LastMetricsTime).count();
+		m_LastMetricsTime = now;
+
+		auto perSecond = [elapsedSeconds](uint64_t current, uint64_t previous)
+		{ return elapsedSeconds > 0.0 && current >= previous ? (current - previous) / elapsedSeconds : 0.0; };
+
+		m_Metrics.Clear();
+
+		// ---- World ----
+		m_Metrics.Set("onion_voxel_loaded_chunks",
+					  eType::Gauge,
+					  "Chunks loaded in the world.",
+					  static_cast<double>(m_WorldManager->GetLoadedChunkCount()));
+		m_Metrics.Set("onion_voxel_generation_queue_chunks",
+					  eType::Gauge,
+					  "Chunks requested to the world generator and not generated yet.",
+					  static_cast<double>(m_WorldManager->GetPendingGenerationCount()));
+		m_Metrics.Set("onion_voxel_save_queue_chunks",
+					  eType::Gauge,
+					  "Chunks waiting for the next world save.",
+					  static_cast<double>(m_WorldManager->GetPendingChunkSaveCount()));
+		m_Metrics.Set("onion_voxel_block_update_queue",
+					  eType::Gauge,
+					  "Scheduled block updates not run yet.",
+					  static_cast<double>(m_WorldManager->GetPendingBlockUpdateCount()));
+
+		std::unordered_map<uint32_t, std::string> playerNames;
+		{
+			std::shared_lock lock(m_MutexPlayers);
+			for (const auto& [clientHandle, playerInfo] : m_ClientHandleToPlayerInfo)
+				playerNames[clientHandle] = playerInfo.PlayerName;
+		}
+		m_Metrics.Set(
+			"onion_voxel_players", eType::Gauge, "Players connected.", static_cast<double>(playerNames.size()));
+
+		// ---- Tick ----
+		const TickScheduler::TickStats tickStats = m_TickScheduler.GetStats();
+		m_Metrics.Set(
+			"onion_voxel_ticks_total", eType::Counter, "Ticks run.", static_cast<double>(tickStats.TickCount));
+		m_Metrics.Set("onion_voxel_tick_overruns_total",
+					  eType::Counter,
+					  "Ticks longer than the tick period.",
+					  static_cast<double>(tickStats.OverrunCount));
+		m_Metrics.Set("onion_voxel_skipped_ticks_total",
+					  eType::Counter,
+					  "Ticks not run because of overruns.",
+					  static_cast<double>(tickStats.SkippedTicks));
+
+		const ProfileHistogram::Snapshot tickTimes = m_TickScheduler.TakeTickTimeSnapshot();
+		for (const auto& [quantile, label] : {std::pair{0.5, "0.5"}, std::pair{0.9, "0.9"}, std::pair{0.99, "0.99"}})
+		{
+			m_Metrics.Set("onion_voxel_tick_duration_ms",
+						  eType::Gauge,
+						  "Tick duration quantiles since the last collection (power of two buckets).",
+						  static_cast<double>(tickTimes.GetPercentile(quantile)) / 1000.0,
+						  {{"quantile", label}});
+		}
+		m_Metrics.Set("onion_voxel_tick_duration_max_ms",
+					  eType::Gauge,
+					  "Longest tick since the last collection.",
+					  static_cast<double>(tickTimes.Max) / 1000.0);
+
+		// ---- Network ----
+		const auto channelStats = m_NetworkServer.GetChannelStats();
+		for (size_t i = 0; i < NETWORK_CHANNEL_COUNT; i++)
+		{
+			const MetricsRegistry::Labels labels = {{"channel", GetChannelName(static_cast<eNetworkChannel>(i))}};
+			m_Metrics.Set("onion_voxel_network_sent_bytes_total",
+						  eType::Counter,
+						  "Payload bytes sent, by channel.",
+						  static_cast<double>(channelStats[i].BytesSent),
+						  labels);
+			m_Metrics.Set("onion_voxel_network_received_bytes_total",
+						  eType::Counter,
+						  "Payload bytes received, by channel.",
+						  static_cast<double>(channelStats[i].BytesReceived),
+						  labels);
+			m_Metrics.Set("onion_voxel_network_queued_messages",
+						  eType::Gauge,
+						  "Messages waiting in the outgoing queue, by channel.",
+						  static_cast<double>(channelStats[i].QueuedMessages),
+						  labels);
+		}
+
+		const NetworkServer::MessageTypeStats messageStats = m_NetworkServer.GetMessageTypeStats();
+		for (size_t i = 1; i < MessageHeader::TYPE_COUNT; i++)
+		{
+			const MetricsRegistry::Labels labels = {{"type", GetMessageTypeName(static_cast<MessageHeader::eType>(i))}};
+			m_Metrics.Set("onion_voxel_messages_received_total",
+						  eType::Counter,
+						  "Messages received, by type.",
+						  static_cast<double>(messageStats.Received[i]),
+						  labels);
+			m_Metrics.Set("onion_voxel_messages_sent_total",
+						  eType::Counter,
+						  "Messages sent, by type (one per target client).",
+						  static_cast<double>(messageStats.Sent[i]),
+						  labels);
+			m_Metrics.Set("onion_voxel_messages_received_per_second",
+						  eType::Gauge,
+						  "Messages received per second since the last collection, by type.",
+						  perSecond(messageStats.Received[i], m_LastMessageTypeStats.Received[i]),
+						  labels);
+			m_Metrics.Set("onion_voxel_messages_sent_per_second",
+						  eType::Gauge,
+						  "Messages sent per second since the last collection, by type.",
+						  perSecond(messageStats.Sent[i], m_LastMessageTypeStats.Sent[i]),
+						  labels);
+		}
+		m_LastMessageTypeStats = messageStats;
+
+		// ---- Clients (remote only, in-process clients have no link) ----
+		std::unordered_map<uint32_t, NetworkServer::ClientLinkStats> clientLinkStats;
+		for (NetworkServer::ClientHandle client : m_NetworkServer.GetConnectedClients())
+		{
+			const std::optional<NetworkServer::ClientLinkStats> link = m_NetworkServer.GetClientLinkStats(client);
+			if (!link)
+				continue;
+
+			auto itName = playerNames.find(client);
+			const MetricsRegistry::Labels labels = {{"client", std::to_string(client)},
+													{"player", itName != playerNames.end() ? itName->second : ""}};
+
+			auto itLast = m_LastClientLinkStats.find(client);
+			const uint64_t lastSent = itLast != m_LastClientLinkStats.end() ? itLast->second.BytesSent : 0;
+			const uint64_t lastReceived = itLast != m_LastClientLinkStats.end() ? itLast->second.BytesReceived : 0;
+
+			uint64_t pendingBytes = 0;
+			for (uint64_t bytes : link->PendingBytes)
+				pendingBytes += bytes;
+
+			m_Metrics.Set("onion_voxel_client_rtt_ms",
+						  eType::Gauge,
+						  "Round trip time of the client link.",
+						  link->RoundTripTimeMs,
+						  labels);
+			m_Metrics.Set("onion_voxel_client_packet_loss",
+						  eType::Gauge,
+						  "Ratio of packets lost on the client link.",
+						  link->PacketLoss,
+						  labels);
+			m_Metrics.Set("onion_voxel_client_sent_bytes_per_second",
+						  eType::Gauge,
+						  "Payload bytes sent to the client per second since the last collection.",
+						  perSecond(link->BytesSent, lastSent),
+						  labels);
+			m_Metrics.Set("onion_voxel_client_received_bytes_per_second",
+						  eType::Gauge,
+						  "Payload bytes received from the client per second since the last collection.",
+						  perSecond(link->BytesReceived, lastReceived),
+						  labels);
+			m_Metrics.Set("onion_voxel_client_pending_bytes",
+						  eType::Gauge,
+						  "Bytes sent to the client and not released by ENet yet.",
+						  static_cast<double>(pendingBytes),
+						  labels);
+
+			clientLinkStats[client] = *link;
+		}
+		m_LastClientLinkStats = std::move(clientLinkStats);
+
+		// ---- Memory ----
+		const Utils::MemoryUsage memory = Utils::GetMemoryUsage();
+		m_Metrics.Set("onion_voxel_resident_bytes",
+					  eType::Gauge,
+					  "Physical memory used by the process.",
+					  static_cast<double>(memory.ResidentBytes));
+		m_Metrics.Set("onion_voxel_heap_bytes",
+					  eType::Gauge,
+					  "Bytes allocated on the heap and not freed (private bytes on Windows).",
+					  static_cast<double>(memory.HeapBytes));
+	}
+
+	void Server::WriteMetrics()
+	{
+		try
+		{
+			CollectMetrics();
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "Failed to collect the metrics: " << e.what() << "\n";
+			return;
+		}
+
+		const MetricsRegistry::Labels serverLabels = {{"server", m_Config.serverData.ServerName},
+													  {"server_uuid", m_Config.serverData.UUID}};
+
+		nlohmann::ordered_json json;
+		json["server"] = m_Config.serverData.ServerName;
+		json["server_uuid"] = m_Config.serverData.UUID;
+		json["timestamp"] = std::chrono::duration_cast<std::chrono::seconds>(
+								std::chrono::system_clock::now().time_since_epoch())
+								.count();
+		json["metrics"] = m_Metrics.ToJson();
+
+		const std::filesystem::path directory = Utils::GetExecutableDirectory();
+		MetricsRegistry::WriteFileAtomic(directory / METRICS_PROMETHEUS_FILE_NAME,
+										 m_Metrics.ToPrometheusText(serverLabels));
+		MetricsRegistry::WriteFileAtomic(directory / METRICS_JSON_FILE_NAME, json.dump(4));
+	}
+
+	void Server::StartNetworkRecording()
+	{
+		// The world actually loaded, which may predate the seed in the configuration
+		WorldInfos worldInfos;
+		worldInfos.Seed = m_Config.serverData.Seed;
+		worldInfos.WorldGenerationType =
+			static_cast<WorldGenerator::eWorldGenerationType>(m_Config.serverData.WorldGenerationType);
+		WorldSave::GetWorldInfos(m_Config.serverData.WorldDirectory, worldInfos);
+
+		NetworkRecordingInfo info;
+		info.Seed = worldInfos.Seed;
+		info.WorldGenerationType = static_cast<uint8_t>(worldInfos.WorldGenerationType);
+		info.SimulationDistance = m_Config.serverData.SimulationDistance;
+		info.TickRate = m_Config.serverData.TickRate;
+		info.StartTime =
+			std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch())
+				.count();
+
+		const std::filesystem::path directory = Utils::GetExecutableDirectory() / RECORDINGS_DIRECTORY_NAME;
+		const std::filesystem::path filePath = directory / ("session_" + std::to_string(info.StartTime) + ".netrec");
+
+		std::error_code error;
+		std::filesystem::create_directories(directory, error);
+
+		auto recorder = std::make_shared<NetworkRecorder>();
+		if (!recorder->Open(filePath, info))
+			return;
+
+		m_NetworkRecorder = recorder;
+		m_NetworkServer.SetRecorder(std::move(recorder));
+
+		std::cout << "Recording the network session to " << filePath << "\n";
+	}
+
+	void Server::StopNetworkRecording()
+	{
+		if (!m_NetworkRecorder)
+			return;
+
+		m_NetworkServer.SetRecorder(nullptr);
+		m_NetworkRecorder->Close();
+		m_NetworkRecorder.reset();
 	}
 
 	void Server::LoadConfiguration()
@@ -146,14 +553,15 @@ namespace onion::voxel
 
 	void Server::SubscribeToNetworkServerEvents()
 	{
+		// Handled by the tick (Inbound phase)
 		m_NetworkServerEventHandles.push_back(m_NetworkServer.EvtClientConnected.Subscribe(
-			[this](const NetworkServer::ClientConnectedEventArgs& args) { Handle_ClientConnected(args); }));
+			[this](const NetworkServer::ClientConnectedEventArgs& args) { m_InboundEvents.Push(args); }));
 
 		m_NetworkServerEventHandles.push_back(m_NetworkServer.EvtClientDisconnected.Subscribe(
-			[this](const NetworkServer::ClientDisconnectedEventArgs& args) { Handle_ClientDisconnected(args); }));
+			[this](const NetworkServer::ClientDisconnectedEventArgs& args) { m_InboundEvents.Push(args); }));
 
 		m_NetworkServerEventHandles.push_back(m_NetworkServer.EvtMessageReceived.Subscribe(
-			[this](const NetworkServer::MessageReceivedEventArgs& args) { Handle_NetworkMessageReceived(args); }));
+			[this](const NetworkServer::MessageReceivedEventArgs& args) { m_InboundEvents.Push(args); }));
 	}
 
 	void Server::Handle_NetworkMessageReceived(const NetworkServer::MessageReceivedEventArgs& args)
@@ -204,8 +612,6 @@ namespace onion::voxel
 	void Server::Handle_PlayerInfoMsgReceived(const NetworkServer::MessageReceivedEventArgs& args,
 											  const PlayerInfoMsg& msg)
 	{
-		(void) args; // Unused parameter
-
 		//std::cout << "Received PlayerInfoMsg from client " << args.Sender << ": Username=" << msg.Username
 		//		  << ", UUID=" << msg.UUID << ", Position=" << msg.Position.x << "," << msg.Position.y << ","
 		//		  << msg.Position.z << "\n";
@@ -214,9 +620,11 @@ namespace onion::voxel
 		std::shared_ptr<Player> deserializedPlayer = SerializerDTO::DeserializePlayer(msg.player);
 
 		m_WorldManager->UpdatePlayer(deserializedPlayer);
+
+		m_ChunkStreamer->SetClientCenter(args.Sender, Utils::WorldToChunkPosition(deserializedPlayer->GetPosition()));
 	}
 
-	void Server::Handle_TimerSendEvents()
+	void Server::SendEntitySnapshot()
 	{
 		// Sends Entity Snapshot to all clients
 		std::unordered_map<std::string, std::shared_ptr<Player>> players = m_WorldManager->GetAllPlayers();
@@ -233,12 +641,8 @@ namespace onion::voxel
 			entitySnapshotMsg.Players.push_back(std::move(playerDTO));
 		}
 
-		auto entities = m_WorldManager->GetAllEntities();
-		for (const auto& entity : entities)
-		{
-			EntityDTO entityDTO = SerializerDTO::SerializeEntity(*entity);
-			entitySnapshotMsg.Entities.push_back(std::move(entityDTO));
-		}
+		// Other entities straight from the store's arrays
+		entitySnapshotMsg.Entities = SerializerDTO::SerializeEntities(*m_WorldManager->GetEntityStore());
 
 		m_NetworkServer.Broadcast(entitySnapshotMsg);
 	}
@@ -249,18 +653,8 @@ namespace onion::voxel
 		std::cout << "Received RequestChunksMsg from client " << args.Sender << ": Requested "
 				  << msg.requestedChunks.size() << " chunks\n";
 
-		for (const auto& chunkPos : msg.requestedChunks)
-		{
-			auto chunk = m_WorldManager->GetChunk(chunkPos);
-			if (chunk)
-			{
-				ChunkDTO chunkDto = SerializerDTO::SerializeChunk(chunk);
-				ChunkDataMsg chunkDataMsg;
-				chunkDataMsg.Chunk = std::move(chunkDto);
-				//std::cout << "(" << chunkPos.x << ", " << chunkPos.y << ")" << std::endl;
-				m_NetworkServer.Send(args.Sender, chunkDataMsg);
-			}
-		}
+		// Chunks are sent progressively by the chunk streamer, nearest first.
+		m_ChunkStreamer->EnqueueChunks(args.Sender, msg.requestedChunks);
 	}
 
 	void Server::Handle_BlocksChangedMsgReceived(const NetworkServer::MessageReceivedEventArgs& args,
@@ -295,6 +689,12 @@ namespace onion::voxel
 		AddPlayer(playerInfo);
 		m_WorldManager->RequestAllMissingChunks();
 
+		m_ChunkStreamer->AddClient(args.Client);
+		if (std::shared_ptr<Player> player = m_WorldManager->GetPlayer(args.UUID))
+		{
+			m_ChunkStreamer->SetClientCenter(args.Client, Utils::WorldToChunkPosition(player->GetPosition()));
+		}
+
 		ServerInfoMsg srvInfoMsg;
 		srvInfoMsg.ServerName = m_Config.serverData.ServerName;
 		srvInfoMsg.ClientHandle = args.Client;
@@ -304,7 +704,7 @@ namespace onion::voxel
 		m_NetworkServer.Send(args.Client, srvInfoMsg);
 
 		// Sends the Entity snapshot to all clients
-		Handle_TimerSendEvents();
+		SendEntitySnapshot();
 
 		UpdateMOTD();
 	}
@@ -314,6 +714,7 @@ namespace onion::voxel
 		std::cout << "Client disconnected: " << args.Client << " ( " << args.UUID << ", " << args.IpAddress << ")\n";
 
 		RemovePlayer(args.UUID);
+		m_ChunkStreamer->RemoveClient(args.Client);
 
 		UpdateMOTD();
 	}
@@ -323,45 +724,25 @@ namespace onion::voxel
 		// Send the chunk to all nearby players.
 		uint8_t chunkLoadingDistance = m_Config.serverData.SimulationDistance;
 		glm::ivec2 chunkPosition = chunk->GetPosition();
-		std::unordered_map<std::string, glm::vec3> playersPosition = m_WorldManager->GetPlayersPosition();
-
-		std::vector<std::string> nearbyPlayers;
-		for (const auto& [playerUUID, playerPosition] : playersPosition)
-		{
-			glm::ivec2 playerChunkPos = Utils::WorldToChunkPosition(playerPosition);
-			if (std::abs(playerChunkPos.x - chunkPosition.x) <= chunkLoadingDistance &&
-				std::abs(playerChunkPos.y - chunkPosition.y) <= chunkLoadingDistance)
-			{
-				nearbyPlayers.push_back(playerUUID);
-			}
-		}
+		std::vector<std::string> nearbyPlayers = m_WorldManager->GetPlayersNearChunk(chunkPosition, chunkLoadingDistance);
 
-		if (!nearbyPlayers.empty())
+		// Queue the chunk for the nearby players, the chunk streamer sends it within their budget.
+		for (const auto& playerUUID : nearbyPlayers)
 		{
-			ChunkDTO chunkDto = SerializerDTO::SerializeChunk(chunk);
-			ChunkDataMsg chunkDataMsg;
-			chunkDataMsg.Chunk = std::move(chunkDto);
-
-			//std::cout << "Sending chunk at position: (" << chunkPosition.x << ", " << chunkPosition.y << ") to "
-			//		  << nearbyPlayers.size() << " nearby players\n";
-
-			for (const auto& playerUUID : nearbyPlayers)
+			uint32_t clientHandle;
 			{
-				uint32_t clientHandle;
+				std::shared_lock lock(m_MutexPlayers);
+				auto it = m_UUIDToPlayerInfo.find(playerUUID);
+				if (it != m_UUIDToPlayerInfo.end())
 				{
-					std::shared_lock lock(m_MutexPlayers);
-					auto it = m_UUIDToPlayerInfo.find(playerUUID);
-					if (it != m_UUIDToPlayerInfo.end())
-					{
-						clientHandle = it->second.ClientHandle;
-					}
-					else
-					{
-						continue; // Player not found, skip sending chunk
-					}
+					clientHandle = it->second.ClientHandle;
+				}
+				else
+				{
+					continue; // Player not found, skip sending chunk
 				}
-				m_NetworkServer.Send(clientHandle, chunkDataMsg);
 			}
+			m_ChunkStreamer->EnqueueChunk(clientHandle, chunkPosition);
 		}
 	}
 
@@ -373,13 +754,51 @@ namespace onion::voxel
 
 	void Server::Handle_BlocksChanged(const WorldManager::BlocksChangedEventArgs& args)
 	{
-		BlocksChangedMsg blocksChangedMsg;
+		// Coalesced until the next broadcast : cascades of updates in the same tick are sent once
+		std::lock_guard lock(m_MutexPendingBlockChanges);
+
 		for (const auto& block : args.ChangedBlocks)
 		{
-			blocksChangedMsg.ChangedBlocks.emplace_back(SerializerDTO::SerializeBlock(block));
+			m_PendingBlockChanges[Utils::WorldToChunkPosition(block.Position)][block.Position] = block.State;
 		}
+	}
+
+	void Server::BroadcastPendingBlockChanges()
+	{
+		std::unordered_map<glm::ivec2, std::unordered_map<glm::ivec3, BlockState>> pendingBlockChanges;
+		{
+			std::lock_guard lock(m_MutexPendingBlockChanges);
+			pendingBlockChanges.swap(m_PendingBlockChanges);
+		}
+
+		for (const auto& [chunkPosition, changes] : pendingBlockChanges)
+		{
+			const ChunkStreamer::ClientsWithChunk clients = m_ChunkStreamer->GetClientsWithChunk(chunkPosition);
+			if (clients.Received.empty() && clients.InFlight.empty())
+				continue;
 
-		m_NetworkServer.Broadcast(blocksChangedMsg);
+			std::vector<Block> blocks;
+			blocks.reserve(changes.size());
+			for (const auto& [position, state] : changes)
+			{
+				blocks.emplace_back(position, state);
+			}
+
+			// Split so the palette of a delta cannot overflow
+			for (size_t begin = 0; begin < blocks.size(); begin += SubChunkDeltaDTO::MAX_PALETTE_SIZE)
+			{
+				const size_t end = std::min(blocks.size(), begin + SubChunkDeltaDTO::MAX_PALETTE_SIZE);
+
+				ChunkDeltaMsg chunkDeltaMsg;
+				chunkDeltaMsg.Delta = SerializerDTO::SerializeChunkDelta(
+					chunkPosition, std::vector<Block>(blocks.begin() + begin, blocks.begin() + end));
+
+				if (!clients.InFlight.empty())
+					m_NetworkServer.Send(clients.InFlight, chunkDeltaMsg, eNetworkChannel::ChunkStream);
+				if (!clients.Received.empty())
+					m_NetworkServer.Send(clients.Received, std::move(chunkDeltaMsg));
+			}
+		}
 	}
 
 	void Server::AddPlayer(const PlayerInfo& playerInfo)
@@ -1,16 +1,24 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <mutex>
 #include <shared_mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <variant>
 
+#include <onion/ThreadSafeQueue.hpp>
 #include <onion/Timer.hpp>
 
 #include "ServerConfiguration.hpp"
+#include "chunk_streamer/ChunkStreamer.hpp"
+#include "metrics_registry/MetricsRegistry.hpp"
 #include "network_server/NetworkServer.hpp"
+#include "tick_scheduler/TickScheduler.hpp"
 
+#include <shared/physics/PhysicsSimulation.hpp>
 #include <shared/world/world_manager/WorldManager.hpp>
 
 namespace onion::voxel
@@ -28,12 +36,21 @@ namespace onion::voxel
 		void Start();
 		void Stop();
 
+		/// @brief Start without opening a socket, for an in-process client (singleplayer).
+		void StartLocal();
+		/// @brief Connect an in-process client. See NetworkServer::ConnectLocalClient.
+		std::shared_ptr<LocalConnection> ConnectLocalClient();
+
 		bool IsRunning() const noexcept;
 
 		// ----- Getters / Setters -----
 	  public:
 		void SetChunkLoadingDistance(uint8_t distance);
 
+		TickScheduler::TickStats GetTickStats() const;
+		/// @brief Tick durations (microseconds) since the last call. Also taken by the metrics collection.
+		ProfileHistogram::Snapshot TakeTickTimeSnapshot();
+
 		// ----- Configuration (Server) -----
 	  private:
 		static inline const std::string SERVER_VERSION = "0.1.0";
@@ -47,6 +64,56 @@ namespace onion::voxel
 	  private:
 		std::atomic_bool m_IsRunning{false};
 
+		// ----- Tick -----
+	  private:
+		TickScheduler m_TickScheduler;
+		std::vector<EventHandle> m_TickSchedulerEventHandles;
+		void SetupTickPhases();
+
+		void Tick_Inbound(uint64_t tick);
+		void Tick_World(uint64_t tick);
+		void Tick_Outbound(uint64_t tick);
+
+		// Block updates run per tick, the others are carried over (large edits spread over several ticks)
+		static constexpr size_t MAX_BLOCK_UPDATES_PER_TICK = 8192;
+
+		void Handle_TickOverrun(const TickScheduler::TickOverrunEventArgs& args);
+		std::chrono::steady_clock::time_point m_LastOverrunLog{};
+
+		// ----- Profiler -----
+	  private:
+		static inline const std::string PROFILER_TRACE_FILE_NAME = "profiler_trace.json";
+
+		/// @brief Print the profiler summary every ProfilerSummaryPeriod seconds.
+		void LogProfilerSummary(uint64_t tick);
+
+		// ----- Metrics -----
+	  private:
+		// Written next to the executable every MetricsPeriod seconds, by the metrics timer thread
+		static inline const std::string METRICS_PROMETHEUS_FILE_NAME = "metrics.prom";
+		static inline const std::string METRICS_JSON_FILE_NAME = "metrics.json";
+
+		Timer m_TimerMetrics;
+		MetricsRegistry m_Metrics;
+
+		// Previous collection, the rates are computed from the difference
+		std::chrono::steady_clock::time_point m_LastMetricsTime{};
+		NetworkServer::MessageTypeStats m_LastMessageTypeStats;
+		std::unordered_map<uint32_t, NetworkServer::ClientLinkStats> m_LastClientLinkStats;
+
+		void CollectMetrics();
+		void WriteMetrics();
+
+		// ----- Network Recording -----
+	  private:
+		// Recordings of the inbound messages, next to the executable, replayed by onion_voxel_replay
+		static inline const std::string RECORDINGS_DIRECTORY_NAME = "recordings";
+
+		std::shared_ptr<NetworkRecorder> m_NetworkRecorder;
+
+		void StartNetworkRecording();
+		void StopNetworkRecording();
+
 		// ----- Network Server -----
 	  private:
 		NetworkServer m_NetworkServer;
@@ -54,6 +121,13 @@ namespace onion::voxel
 		std::vector<EventHandle> m_NetworkServerEventHandles;
 		void SubscribeToNetworkServerEvents();
 
+		// Network events are queued by the network threads and handled by the tick (Inbound phase)
+		using InboundEvent = std::variant<NetworkServer::ClientConnectedEventArgs,
+										  NetworkServer::ClientDisconnectedEventArgs,
+										  NetworkServer::MessageReceivedEventArgs>;
+		ThreadSafeQueue<InboundEvent> m_InboundEvents;
+		static constexpr size_t MAX_INBOUND_EVENTS_PER_TICK = 4096;
+
 		void Handle_ClientConnected(const NetworkServer::ClientConnectedEventArgs& args);
 		void Handle_ClientDisconnected(const NetworkServer::ClientDisconnectedEventArgs& args);
 		void Handle_NetworkMessageReceived(const NetworkServer::MessageReceivedEventArgs& args);
@@ -77,11 +151,28 @@ namespace onion::voxel
 		void Handle_ChunkRemoved(const std::shared_ptr<Chunk>& chunk);
 		void Handle_BlocksChanged(const WorldManager::BlocksChangedEventArgs& args);
 
-		// ----- Timer Send Events -----
+		// ----- Block Changes Broadcast -----
 	  private:
-		Timer m_TimerSendEvents;
+		// Block changes of the current tick, by chunk then world position (last change wins)
+		std::mutex m_MutexPendingBlockChanges;
+		std::unordered_map<glm::ivec2, std::unordered_map<glm::ivec3, BlockState>> m_PendingBlockChanges;
+
+		/// @brief Send the block changes of the tick as one ChunkDeltaMsg per chunk, to the clients that have it.
+		void BroadcastPendingBlockChanges();
 
-		void Handle_TimerSendEvents();
+		// ----- Entity Snapshots -----
+	  private:
+		static constexpr std::chrono::milliseconds ENTITY_SNAPSHOT_PERIOD{100};
+
+		void SendEntitySnapshot();
+
+		// ----- Chunk Streaming -----
+	  private:
+		std::unique_ptr<ChunkStreamer> m_ChunkStreamer;
+
+		// ----- Physics -----
+	  private:
+		std::unique_ptr<PhysicsSimulation> m_PhysicsSimulation;
 
 		// ----- Players -----
 	  private:
@@ -20,6 +20,12 @@ namespace onion::voxel
 		uint32_t Seed = 1;
 		uint8_t WorldGenerationType = 1;
 		std::string MOTD = "Welcome to the server!";
+		uint32_t ChunkStreamRateKBps = 8192; // Maximum chunk upload rate per client (KB/s)
+		uint32_t TickRate = 20;				 // Server ticks per second
+		uint32_t ProfilerSummaryPeriod = 60; // Seconds between two profiler summaries in the log, 0 to disable
+		bool WriteProfilerTrace = false;	 // Write the last profiled zones as a Chrome trace when stopping
+		uint32_t MetricsPeriod = 10;		 // Seconds between two writes of metrics.prom / metrics.json, 0 to disable
+		bool RecordNetworkSession = false;	 // Record the messages received to recordings/, to replay them
 	};
 
 	struct ServerConfiguration
@@ -74,6 +80,12 @@ namespace onion::voxel
 			serverData.Seed = json.value("Seed", serverData.Seed);
 			serverData.SimulationDistance = json.value("SimulationDistance", serverData.SimulationDistance);
 			serverData.WorldGenerationType = json.value("WorldGenerationType", serverData.WorldGenerationType);
+			serverData.ChunkStreamRateKBps = json.value("ChunkStreamRateKBps", serverData.ChunkStreamRateKBps);
+			serverData.TickRate = json.value("TickRate", serverData.TickRate);
+			serverData.ProfilerSummaryPeriod = json.value("ProfilerSummaryPeriod", serverData.ProfilerSummaryPeriod);
+			serverData.WriteProfilerTrace = json.value("WriteProfilerTrace", serverData.WriteProfilerTrace);
+			serverData.MetricsPeriod = json.value("MetricsPeriod", serverData.MetricsPeriod);
+			serverData.RecordNetworkSession = json.value("RecordNetworkSession", serverData.RecordNetworkSession);
 
 			// Save the configuration to ensure that any missing fields are added to the file
 			Save(filePath);
@@ -90,6 +102,12 @@ namespace onion::voxel
 			json["Seed"] = serverData.Seed;
 			json["SimulationDistance"] = serverData.SimulationDistance;
 			json["WorldGenerationType"] = serverData.WorldGenerationType;
+			json["ChunkStreamRateKBps"] = serverData.ChunkStreamRateKBps;
+			json["TickRate"] = serverData.TickRate;
+			json["ProfilerSummaryPeriod"] = serverData.ProfilerSummaryPeriod;
+			json["WriteProfilerTrace"] = serverData.WriteProfilerTrace;
+			json["MetricsPeriod"] = serverData.MetricsPeriod;
+			json["RecordNetworkSession"] = serverData.RecordNetworkSession;
 
 			std::ofstream file(filePath);
 			if (!file.is_open())
@@ -0,0 +1,308 @@
+#include "ChunkStreamer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+#include <shared/data_transfer_objects/serializer/SerializerDTO.hpp>
+
+namespace onion::voxel
+{
+	ChunkStreamer::ChunkStreamer(NetworkServer& networkServer, std::shared_ptr<WorldManager> worldManager)
+		: m_NetworkServer(networkServer), m_WorldManager(std::move(worldManager))
+	{
+	}
+
+	ChunkStreamer::~ChunkStreamer() {}
+
+	void ChunkStreamer::AddClient(ClientHandle client)
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Clients.try_emplace(client);
+	}
+
+	void ChunkStreamer::RemoveClient(ClientHandle client)
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Clients.erase(client);
+	}
+
+	void ChunkStreamer::SetClientCenter(ClientHandle client, const glm::ivec2& chunkPosition)
+	{
+		std::lock_guard lock(m_Mutex);
+
+		auto it = m_Clients.find(client);
+		if (it == m_Clients.end())
+			return;
+
+		ClientStream& stream = it->second;
+		if (stream.HasCenter && stream.Center == chunkPosition)
+			return;
+
+		stream.HasCenter = true;
+		stream.Center = chunkPosition;
+
+		CancelOutOfAreaChunks(stream);
+	}
+
+	void ChunkStreamer::EnqueueChunk(ClientHandle client, const glm::ivec2& chunkPosition)
+	{
+		EnqueueChunks(client, {chunkPosition});
+	}
+
+	void ChunkStreamer::EnqueueChunks(ClientHandle client, const std::vector<glm::ivec2>& chunkPositions)
+	{
+		std::lock_guard lock(m_Mutex);
+
+		auto it = m_Clients.find(client);
+		if (it == m_Clients.end())
+			return;
+
+		ClientStream& stream = it->second;
+		for (const auto& chunkPosition : chunkPositions)
+		{
+			if (IsInStreamingArea(stream, chunkPosition))
+			{
+				stream.Pending.insert(chunkPosition);
+			}
+		}
+	}
+
+	void ChunkStreamer::Update()
+	{
+		const size_t averageChunkBytes = GetAverageChunkBytes();
+
+		// Pick the chunks to send for each client
+		std::vector<std::pair<ClientHandle, std::vector<glm::ivec2>>> work;
+
+		{
+			std::lock_guard lock(m_Mutex);
+
+			for (auto& [client, stream] : m_Clients)
+			{
+				if (stream.Pending.empty())
+					continue;
+
+				std::optional<NetworkServer::ClientLinkStats> linkStats = m_NetworkServer.GetClientLinkStats(client);
+				if (!linkStats)
+					continue;
+
+				const size_t budget = ComputeChunkBudget(*linkStats, averageChunkBytes);
+				if (budget == 0)
+					continue;
+
+				// Nearest chunks first
+				std::vector<glm::ivec2> candidates(stream.Pending.begin(), stream.Pending.end());
+				const glm::ivec2 center = stream.Center;
+				auto distance = [&center](const glm::ivec2& chunkPosition)
+				{
+					const glm::ivec2 d = chunkPosition - center;
+					return d.x * d.x + d.y * d.y;
+				};
+
+				const size_t count = std::min(budget, candidates.size());
+				std::partial_sort(candidates.begin(),
+								  candidates.begin() + count,
+								  candidates.end(),
+								  [&distance](const glm::ivec2& a, const glm::ivec2& b)
+								  { return distance(a) < distance(b); });
+				candidates.resize(count);
+
+				for (const auto& chunkPosition : candidates)
+				{
+					stream.Pending.erase(chunkPosition);
+				}
+
+				work.emplace_back(client, std::move(candidates));
+			}
+		}
+
+		// ---- No locks held here ----
+
+		for (auto& [client, chunkPositions] : work)
+		{
+			std::vector<glm::ivec2> sent;
+			sent.reserve(chunkPositions.size());
+
+			for (const auto& chunkPosition : chunkPositions)
+			{
+				// Chunks not loaded yet are sent when added to the world (see Server::Handle_ChunkAdded)
+				std::shared_ptr<Chunk> chunk = m_WorldManager->GetChunk(chunkPosition);
+				if (!chunk)
+					continue;
+
+				ChunkDataMsg chunkDataMsg;
+				chunkDataMsg.Chunk = SerializerDTO::SerializeChunk(chunk);
+				m_NetworkServer.Send(client, std::move(chunkDataMsg));
+
+				sent.push_back(chunkPosition);
+			}
+
+			chunkPositions = std::move(sent);
+		}
+
+		// Remember what each client has, so block changes are only sent to the clients concerned
+		std::lock_guard lock(m_Mutex);
+
+		for (const auto& [client, chunkPositions] : work)
+		{
+			auto it = m_Clients.find(client);
+			if (it == m_Clients.end())
+				continue;
+
+			for (const auto& chunkPosition : chunkPositions)
+			{
+				if (IsInStreamingArea(it->second, chunkPosition))
+				{
+					it->second.Sent.insert(chunkPosition);
+					it->second.InFlight.insert(chunkPosition);
+				}
+			}
+		}
+	}
+
+	uint8_t ChunkStreamer::GetStreamingDistance() const
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_StreamingDistance;
+	}
+
+	void ChunkStreamer::SetStreamingDistance(uint8_t distance)
+	{
+		std::lock_guard lock(m_Mutex);
+		m_StreamingDistance = distance;
+
+		for (auto& [client, stream] : m_Clients)
+		{
+			CancelOutOfAreaChunks(stream);
+		}
+	}
+
+	uint32_t ChunkStreamer::GetMaxBytesPerSecond() const
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_MaxBytesPerSecond;
+	}
+
+	void ChunkStreamer::SetMaxBytesPerSecond(uint32_t bytesPerSecond)
+	{
+		std::lock_guard lock(m_Mutex);
+		m_MaxBytesPerSecond = bytesPerSecond;
+	}
+
+	size_t ChunkStreamer::GetPendingChunkCount(ClientHandle client) const
+	{
+		std::lock_guard lock(m_Mutex);
+
+		auto it = m_Clients.find(client);
+		if (it == m_Clients.end())
+			return 0;
+
+		return it->second.Pending.size();
+	}
+
+	ChunkStreamer::ClientsWithChunk ChunkStreamer::GetClientsWithChunk(const glm::ivec2& chunkPosition)
+	{
+		std::lock_guard lock(m_Mutex);
+
+		ClientsWithChunk clients;
+		for (auto& [client, stream] : m_Clients)
+		{
+			if (!stream.Sent.contains(chunkPosition))
+				continue;
+
+			if (stream.InFlight.contains(chunkPosition))
+			{
+				// Reliable packets are released once acknowledged : nothing pending on ChunkStream means the client
+				// received every chunk, and every change sent after them. Local clients get everything in order.
+				const std::optional<NetworkServer::ClientLinkStats> linkStats =
+					m_NetworkServer.GetClientLinkStats(client);
+				const size_t channel = static_cast<size_t>(eNetworkChannel::ChunkStream);
+
+				if (!linkStats || linkStats->IsLocal || linkStats->PendingMessages[channel] == 0)
+					stream.InFlight.clear();
+			}
+
+			if (stream.InFlight.contains(chunkPosition))
+				clients.InFlight.push_back(client);
+			else
+				clients.Received.push_back(client);
+		}
+
+		return clients;
+	}
+
+	size_t ChunkStreamer::GetAverageChunkBytes() const
+	{
+		const ChannelStats stats =
+			m_NetworkServer.GetChannelStats()[static_cast<size_t>(eNetworkChannel::ChunkStream)];
+
+		if (stats.MessagesSent == 0)
+			return DEFAULT_CHUNK_BYTES;
+
+		return std::max<size_t>(1, static_cast<size_t>(stats.BytesSent / stats.MessagesSent));
+	}
+
+	size_t ChunkStreamer::ComputeChunkBudget(const NetworkServer::ClientLinkStats& stats,
+											 size_t averageChunkBytes) const
+	{
+		// In-process client : no link to protect, the serialization work is the only bound
+		if (stats.IsLocal)
+			return MAX_CHUNKS_PER_UPDATE;
+
+		// Sending rate allowed by ENet's throttle (lowered by ENet on packet loss and RTT spikes)
+		const double throttle =
+			static_cast<double>(stats.PacketThrottle) / static_cast<double>(ENET_PEER_PACKET_THROTTLE_SCALE);
+		const double rate = static_cast<double>(m_MaxBytesPerSecond) * std::max(throttle, 0.1);
+
+		// Bytes allowed in flight : rate x (RTT + variance), at least one update period worth of data
+		const double rttSeconds =
+			static_cast<double>(stats.RoundTripTimeMs + 2 * stats.RoundTripTimeVarianceMs) / 1000.0;
+		const size_t window =
+			std::max(MIN_WINDOW_BYTES, static_cast<size_t>(rate * std::max(rttSeconds, UPDATE_PERIOD_SECONDS)));
+
+		// Chunks already queued or not acknowledged by the client
+		const size_t channel = static_cast<size_t>(eNetworkChannel::ChunkStream);
+		const size_t outstanding = std::max(static_cast<size_t>(stats.PendingBytes[channel]),
+											static_cast<size_t>(stats.PendingMessages[channel]) * averageChunkBytes);
+
+		if (outstanding >= window)
+			return 0;
+
+		const size_t budget = (window - outstanding) / averageChunkBytes;
+		return std::clamp<size_t>(budget, outstanding == 0 ? 1 : 0, MAX_CHUNKS_PER_UPDATE);
+	}
+
+	bool ChunkStreamer::IsInStreamingArea(const ClientStream& stream, const glm::ivec2& chunkPosition) const
+	{
+		if (!stream.HasCenter)
+			return true;
+
+		return std::abs(chunkPosition.x - stream.Center.x) <= m_StreamingDistance &&
+			std::abs(chunkPosition.y - stream.Center.y) <= m_StreamingDistance;
+	}
+
+	void ChunkStreamer::CancelOutOfAreaChunks(ClientStream& stream) const
+	{
+		auto eraseOutOfArea = [this, &stream](std::unordered_set<glm::ivec2>& chunkPositions)
+		{
+			for (auto it = chunkPositions.begin(); it != chunkPositions.end();)
+			{
+				if (IsInStreamingArea(stream, *it))
+				{
+					++it;
+				}
+				else
+				{
+					it = chunkPositions.erase(it);
+				}
+			}
+		};
+
+		eraseOutOfArea(stream.Pending);
+
+		// The client unloads the chunks out of its persistance distance (the streaming distance) as well
+		eraseOutOfArea(stream.Sent);
+		eraseOutOfArea(stream.InFlight);
+	}
+} // namespace onion::voxel
@@ -0,0 +1,104 @@
+#pragma once
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "network_server/NetworkServer.hpp"
+
+#include <shared/world/world_manager/WorldManager.hpp>
+
+namespace onion::voxel
+{
+	/// @brief Schedules the chunks sent to each client.
+	/// Requested chunks are queued per client and sent nearest-first, within a budget derived from the client's
+	/// round trip time, ENet packet throttle and the chunk data it has not acknowledged yet.
+	/// Chunks that left the client's streaming area before being sent are cancelled.
+	class ChunkStreamer
+	{
+		using ClientHandle = NetworkServer::ClientHandle;
+
+		// ----- Constructor / Destructor -----
+	  public:
+		ChunkStreamer(NetworkServer& networkServer, std::shared_ptr<WorldManager> worldManager);
+		~ChunkStreamer();
+
+		// ----- Public API -----
+	  public:
+		void AddClient(ClientHandle client);
+		void RemoveClient(ClientHandle client);
+
+		/// @brief Set the chunk the client's player is in. Used for nearest-first ordering and cancellation.
+		void SetClientCenter(ClientHandle client, const glm::ivec2& chunkPosition);
+
+		void EnqueueChunk(ClientHandle client, const glm::ivec2& chunkPosition);
+		void EnqueueChunks(ClientHandle client, const std::vector<glm::ivec2>& chunkPositions);
+
+		/// @brief Send the next chunks of each client, within their budget. Called periodically.
+		void Update();
+
+		// ----- Getters / Setters -----
+	  public:
+		uint8_t GetStreamingDistance() const;
+		void SetStreamingDistance(uint8_t distance);
+
+		uint32_t GetMaxBytesPerSecond() const;
+		void SetMaxBytesPerSecond(uint32_t bytesPerSecond);
+
+		size_t GetPendingChunkCount(ClientHandle client) const;
+
+		struct ClientsWithChunk
+		{
+			std::vector<ClientHandle> Received; // The chunk was acknowledged : its changes go on their own channel
+			std::vector<ClientHandle> InFlight; // The chunk may still be on its way : its changes must follow it
+		};
+
+		/// @brief Get the clients that have been sent the chunk and still have it loaded.
+		/// Chunks leaving a client's streaming area are forgotten, like the client unloads them.
+		/// ENet does not order packets across channels : a change sent on BlockEdits could reach the client before
+		/// its chunk and be lost. Until the client acknowledged everything sent on ChunkStream, its chunks are in
+		/// flight and their changes are sent on ChunkStream, after them.
+		ClientsWithChunk GetClientsWithChunk(const glm::ivec2& chunkPosition);
+
+		// ----- Private Structs -----
+	  private:
+		struct ClientStream
+		{
+			bool HasCenter = false;
+			glm::ivec2 Center{0, 0};
+			std::unordered_set<glm::ivec2> Pending;
+			std::unordered_set<glm::ivec2> Sent;
+			std::unordered_set<glm::ivec2> InFlight; // Sent, and ChunkStream not drained since
+		};
+
+		// ----- Private Members -----
+	  private:
+		NetworkServer& m_NetworkServer;
+		std::shared_ptr<WorldManager> m_WorldManager;
+
+		mutable std::mutex m_Mutex;
+		std::unordered_map<ClientHandle, ClientStream> m_Clients;
+
+		uint8_t m_StreamingDistance = 4;
+		uint32_t m_MaxBytesPerSecond = 8 * 1024 * 1024;
+
+		// ----- Budget -----
+	  private:
+		static constexpr double UPDATE_PERIOD_SECONDS = 0.05;	 // Expected period between two Update() calls
+		static constexpr size_t DEFAULT_CHUNK_BYTES = 32 * 1024; // Used until a chunk has been sent
+		static constexpr size_t MIN_WINDOW_BYTES = 64 * 1024;	 // Always allow a couple of chunks in flight
+		static constexpr size_t MAX_CHUNKS_PER_UPDATE = 64;		 // Bounds the serialization work of one Update()
+
+		size_t GetAverageChunkBytes() const;
+		size_t ComputeChunkBudget(const NetworkServer::ClientLinkStats& stats, size_t averageChunkBytes) const;
+
+		bool IsInStreamingArea(const ClientStream& stream, const glm::ivec2& chunkPosition) const;
+		void CancelOutOfAreaChunks(ClientStream& stream) const;
+	};
+} // namespace onion::voxel
@@ -0,0 +1,170 @@
+#include "MetricsRegistry.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#include <shared/utils/Utils.hpp>
+
+namespace onion::voxel
+{
+	void MetricsRegistry::Set(
+		const std::string& name, eType type, const std::string& help, double value, const Labels& labels)
+	{
+		auto [it, inserted] = m_FamilyIndices.try_emplace(name, m_Families.size());
+		if (inserted)
+		{
+			Family family;
+			family.Name = name;
+			family.Help = help;
+			family.Type = type;
+			m_Families.push_back(std::move(family));
+		}
+
+		Family& family = m_Families[it->second];
+		for (Sample& sample : family.Samples)
+		{
+			if (sample.SampleLabels == labels)
+			{
+				sample.Value = value;
+				return;
+			}
+		}
+
+		family.Samples.push_back({labels, value});
+	}
+
+	void MetricsRegistry::Clear()
+	{
+		m_Families.clear();
+		m_FamilyIndices.clear();
+	}
+
+	std::string MetricsRegistry::ToPrometheusText(const Labels& commonLabels) const
+	{
+		std::string text;
+
+		for (const Family& family : m_Families)
+		{
+			text += "# HELP " + family.Name + " " + family.Help + "\n";
+			text += "# TYPE " + family.Name + (family.Type == eType::Counter ? " counter\n" : " gauge\n");
+
+			for (const Sample& sample : family.Samples)
+			{
+				text += family.Name;
+
+				if (!commonLabels.empty() || !sample.SampleLabels.empty())
+				{
+					text += "{";
+					bool first = true;
+					for (const Labels* labels : {&commonLabels, &sample.SampleLabels})
+					{
+						for (const auto& [key, value] : *labels)
+						{
+							if (!first)
+								text += ",";
+							first = false;
+							text += key + "=\"" + EscapeLabelValue(value) + "\"";
+						}
+					}
+					text += "}";
+				}
+
+				text += " " + FormatValue(sample.Value) + "\n";
+			}
+		}
+
+		return text;
+	}
+
+	nlohmann::ordered_json MetricsRegistry::ToJson() const
+	{
+		nlohmann::ordered_json json = nlohmann::ordered_json::object();
+
+		for (const Family& family : m_Families)
+		{
+			nlohmann::ordered_json samples = nlohmann::ordered_json::array();
+			for (const Sample& sample : family.Samples)
+			{
+				nlohmann::ordered_json labels = nlohmann::ordered_json::object();
+				for (const auto& [key, value] : sample.SampleLabels)
+					labels[key] = value;
+
+				samples.push_back({{"labels", labels}, {"value", sample.Value}});
+			}
+
+			json[family.Name] = {{"type", family.Type == eType::Counter ? "counter" : "gauge"},
+								 {"help", family.Help},
+								 {"samples", samples}};
+		}
+
+		return json;
+	}
+
+	bool MetricsRegistry::WriteFileAtomic(const std::filesystem::path& filePath, const std::string& content)
+	{
+		std::filesystem::path tempFilePath = filePath;
+		tempFilePath += ".tmp";
+
+		try
+		{
+			{
+				std::ofstream file(tempFilePath, std::ios::binary | std::ios::trunc);
+				if (!file.is_open())
+				{
+					std::cerr << "[MetricsRegistry] Failed to open " << tempFilePath << " for writing\n";
+					return false;
+				}
+				file << content;
+			}
+
+			Utils::ReplaceFileAtomic(filePath, tempFilePath);
+			return true;
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "[MetricsRegistry] Failed to write " << filePath << ": " << e.what() << "\n";
+			return false;
+		}
+	}
+
+	std::string MetricsRegistry::FormatValue(double value)
+	{
+		if (std::isnan(value))
+			return "NaN";
+		if (std::isinf(value))
+			return value > 0 ? "+Inf" : "-Inf";
+
+		char text[32];
+		std::snprintf(text, sizeof(text), "%.10g", value);
+		return text;
+	}
+
+	std::string MetricsRegistry::EscapeLabelValue(const std::string& value)
+	{
+		std::string escaped;
+		escaped.reserve(value.size());
+
+		for (char c : value)
+		{
+			switch (c)
+			{
+				case '\\':
+					escaped += "\\\\";
+					break;
+				case '"':
+					escaped += "\\\"";
+					break;
+				case '\n':
+					escaped += "\\n";
+					break;
+				default:
+					escaped += c;
+					break;
+			}
+		}
+
+		return escaped;
+	}
+} // namespace onion::voxel
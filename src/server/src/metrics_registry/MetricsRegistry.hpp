@@ -0,0 +1,70 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace onion::voxel
+{
+	/// @brief Named values of the server, with labels, exported in the Prometheus text format and as JSON.
+	/// Filled again from scratch at each collection, then written to files read by the monitoring
+	/// (node_exporter textfile collector, or any tool reading the JSON file).
+	/// Not thread safe : filled and exported by the same thread.
+	class MetricsRegistry
+	{
+		// ----- Structs -----
+	  public:
+		enum class eType
+		{
+			Gauge,	// Value that goes up and down
+			Counter // Total since the start, only goes up
+		};
+
+		using Labels = std::vector<std::pair<std::string, std::string>>;
+
+		// ----- Public API -----
+	  public:
+		/// @brief Set the value of a metric. The first call for a name declares its type and help text.
+		void Set(const std::string& name, eType type, const std::string& help, double value, const Labels& labels = {});
+
+		void Clear();
+
+		/// @brief Prometheus text exposition format (0.0.4).
+		/// @param commonLabels Added to every sample, to tell apart several servers.
+		std::string ToPrometheusText(const Labels& commonLabels = {}) const;
+		nlohmann::ordered_json ToJson() const;
+
+		/// @brief Write a temporary file then replace the file, so readers never see a partial file.
+		static bool WriteFileAtomic(const std::filesystem::path& filePath, const std::string& content);
+
+		// ----- Private Structs -----
+	  private:
+		struct Sample
+		{
+			Labels SampleLabels;
+			double Value = 0.0;
+		};
+
+		struct Family
+		{
+			std::string Name;
+			std::string Help;
+			eType Type = eType::Gauge;
+			std::vector<Sample> Samples;
+		};
+
+		// ----- Private Methods -----
+	  private:
+		static std::string FormatValue(double value);
+		static std::string EscapeLabelValue(const std::string& value);
+
+		// ----- Private Members -----
+	  private:
+		std::vector<Family> m_Families; // In the order they were declared
+		std::unordered_map<std::string, size_t> m_FamilyIndices;
+	};
+} // namespace onion::voxel
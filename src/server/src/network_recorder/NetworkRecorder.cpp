@@ -0,0 +1,307 @@
+#include "NetworkRecorder.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include <cereal/archives/binary.hpp>
+
+namespace onion::voxel
+{
+	namespace
+	{
+		// LEB128 : 7 bits per byte, high bit set when more bytes follow. Most deltas and handles fit in 1 or 2 bytes.
+		void WriteVarint(std::ostream& stream, uint64_t value)
+		{
+			while (value >= 0x80)
+			{
+				stream.put(static_cast<char>((value & 0x7F) | 0x80));
+				value >>= 7;
+			}
+			stream.put(static_cast<char>(value));
+		}
+
+		bool ReadVarint(std::istream& stream, uint64_t& outValue)
+		{
+			outValue = 0;
+
+			for (int shift = 0; shift < 64; shift += 7)
+			{
+				const int byte = stream.get();
+				if (byte == std::char_traits<char>::eof())
+					return false;
+
+				outValue |= static_cast<uint64_t>(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0)
+					return true;
+			}
+
+			return false;
+		}
+
+		// A larger size is a corrupted file, not a message
+		constexpr uint64_t MAX_MESSAGE_SIZE = 64 * 1024 * 1024;
+	} // namespace
+
+	// -------- NetworkRecorder --------
+
+	NetworkRecorder::~NetworkRecorder()
+	{
+		Close();
+	}
+
+	bool NetworkRecorder::Open(const std::filesystem::path& filePath, const NetworkRecordingInfo& info)
+	{
+		Close();
+
+		m_File.open(filePath, std::ios::binary | std::ios::trunc);
+		if (!m_File.is_open())
+		{
+			std::cerr << "[NetworkRecorder] Failed to open " << filePath << " for writing\n";
+			return false;
+		}
+
+		m_File.write(MAGIC, sizeof(MAGIC));
+		{
+			cereal::BinaryOutputArchive archive(m_File);
+			archive(VERSION, info);
+		}
+
+		m_LastTimeUs = 0;
+		m_RecordCount.store(0);
+
+		{
+			std::lock_guard lock(m_Mutex);
+			m_StartTime = Clock::now();
+			m_IsOpen = true;
+		}
+
+		m_WriterThread = std::jthread([this](std::stop_token stopToken) { WriteRecords(stopToken); });
+
+		return true;
+	}
+
+	void NetworkRecorder::Close()
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			if (!m_IsOpen)
+				return;
+			m_IsOpen = false;
+		}
+
+		if (m_WriterThread.joinable())
+		{
+			m_WriterThread.request_stop();
+			m_WriterThread.join();
+		}
+
+		// Records queued while the writer was stopping
+		PendingRecord record;
+		while (m_PendingRecords.TryPop(record))
+		{
+			WriteRecord(record);
+		}
+
+		m_File.close();
+
+		std::cout << "[NetworkRecorder] " << m_RecordCount.load() << " records written\n";
+	}
+
+	bool NetworkRecorder::IsOpen() const
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_IsOpen;
+	}
+
+	void NetworkRecorder::RecordMessage(uint32_t client, const NetworkMessage& message)
+	{
+		std::ostringstream stream(std::ios::binary);
+		{
+			cereal::BinaryOutputArchive archive(stream);
+
+			std::visit(
+				[&](auto&& msg)
+				{
+					using T = std::decay_t<decltype(msg)>;
+
+					MessageHeader header;
+					header.Type = T::StaticType;
+					header.ClientHandle = client;
+
+					archive(header);
+					archive(msg);
+				},
+				message);
+		}
+
+		const std::string bytes = stream.str();
+
+		PendingRecord record;
+		record.Kind = NetworkRecord::eKind::Message;
+		record.Client = client;
+		record.Payload.assign(bytes.begin(), bytes.end());
+
+		Push(std::move(record));
+	}
+
+	void NetworkRecorder::RecordDisconnect(uint32_t client)
+	{
+		PendingRecord record;
+		record.Kind = NetworkRecord::eKind::Disconnect;
+		record.Client = client;
+
+		Push(std::move(record));
+	}
+
+	uint64_t NetworkRecorder::GetRecordCount() const
+	{
+		return m_RecordCount.load(std::memory_order_relaxed);
+	}
+
+	void NetworkRecorder::Push(PendingRecord&& record)
+	{
+		std::lock_guard lock(m_Mutex);
+
+		if (!m_IsOpen)
+			return;
+
+		record.TimeUs = static_cast<uint64_t>(
+			std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - m_StartTime).count());
+
+		m_PendingRecords.Push(std::move(record));
+	}
+
+	void NetworkRecorder::WriteRecords(std::stop_token stopToken)
+	{
+		PendingRecord record;
+
+		while (m_PendingRecords.WaitPop(record, stopToken))
+		{
+			WriteRecord(record);
+		}
+	}
+
+	void NetworkRecorder::WriteRecord(const PendingRecord& record)
+	{
+		const uint64_t deltaUs = record.TimeUs >= m_LastTimeUs ? record.TimeUs - m_LastTimeUs : 0;
+		m_LastTimeUs = std::max(m_LastTimeUs, record.TimeUs);
+
+		m_File.put(static_cast<char>(record.Kind));
+		WriteVarint(m_File, deltaUs);
+		WriteVarint(m_File, record.Client);
+
+		if (record.Kind == NetworkRecord::eKind::Message)
+		{
+			WriteVarint(m_File, record.Payload.size());
+			m_File.write(reinterpret_cast<const char*>(record.Payload.data()),
+						 static_cast<std::streamsize>(record.Payload.size()));
+		}
+
+		m_RecordCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// -------- NetworkRecordingReader --------
+
+	bool NetworkRecordingReader::Open(const std::filesystem::path& filePath)
+	{
+		m_File.open(filePath, std::ios::binary);
+		if (!m_File.is_open())
+		{
+			std::cerr << "[NetworkRecordingReader] Failed to open " << filePath << "\n";
+			return false;
+		}
+
+		char magic[sizeof(NetworkRecorder::MAGIC)] = {};
+		m_File.read(magic, sizeof(magic));
+		if (!m_File || std::memcmp(magic, NetworkRecorder::MAGIC, sizeof(magic)) != 0)
+		{
+			std::cerr << "[NetworkRecordingReader] " << filePath << " is not a network recording\n";
+			return false;
+		}
+
+		try
+		{
+			uint16_t version = 0;
+			cereal::BinaryInputArchive archive(m_File);
+			archive(version);
+
+			if (version != NetworkRecorder::VERSION)
+			{
+				std::cerr << "[NetworkRecordingReader] Unsupported recording version " << version << "\n";
+				return false;
+			}
+
+			archive(m_Info);
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "[NetworkRecordingReader] Invalid header: " << e.what() << "\n";
+			return false;
+		}
+
+		m_TimeUs = 0;
+		return true;
+	}
+
+	const NetworkRecordingInfo& NetworkRecordingReader::GetInfo() const
+	{
+		return m_Info;
+	}
+
+	bool NetworkRecordingReader::Next(NetworkRecord& outRecord)
+	{
+		while (true)
+		{
+			const int kind = m_File.get();
+			if (kind == std::char_traits<char>::eof())
+				return false;
+
+			uint64_t deltaUs = 0;
+			uint64_t client = 0;
+			if (!ReadVarint(m_File, deltaUs) || !ReadVarint(m_File, client))
+				return false;
+
+			m_TimeUs += deltaUs;
+
+			outRecord.Kind = static_cast<NetworkRecord::eKind>(kind);
+			outRecord.TimeUs = m_TimeUs;
+			outRecord.Client = static_cast<uint32_t>(client);
+
+			if (outRecord.Kind == NetworkRecord::eKind::Disconnect)
+				return true;
+
+			if (outRecord.Kind != NetworkRecord::eKind::Message)
+			{
+				std::cerr << "[NetworkRecordingReader] Unknown record kind " << kind << "\n";
+				return false;
+			}
+
+			uint64_t size = 0;
+			if (!ReadVarint(m_File, size) || size > MAX_MESSAGE_SIZE)
+				return false;
+
+			std::string bytes(size, '\0');
+			m_File.read(bytes.data(), static_cast<std::streamsize>(size));
+			if (!m_File)
+				return false;
+
+			try
+			{
+				std::istringstream stream(bytes, std::ios::binary);
+				cereal::BinaryInputArchive archive(stream);
+
+				MessageHeader header;
+				archive(header);
+
+				outRecord.Message = DeserializeMessage(archive, header.Type);
+				return true;
+			}
+			catch (const std::exception& e)
+			{
+				std::cerr << "[NetworkRecordingReader] Skipped invalid message: " << e.what() << "\n";
+			}
+		}
+	}
+} // namespace onion::voxel
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <onion/ThreadSafeQueue.hpp>
+
+#include <shared/network_messages/NetworkMessages.hpp>
+
+namespace onion::voxel
+{
+	/// @brief Written at the start of a recording : what is needed to replay it on the same world.
+	struct NetworkRecordingInfo
+	{
+		uint32_t Seed = 0;
+		uint8_t WorldGenerationType = 0;
+		uint8_t SimulationDistance = 0;
+		uint32_t TickRate = 0;
+		int64_t StartTime = 0; // Unix time, in seconds
+
+		template <class Archive> void serialize(Archive& ar)
+		{
+			ar(Seed, WorldGenerationType, SimulationDistance, TickRate, StartTime);
+		}
+	};
+
+	struct NetworkRecord
+	{
+		enum class eKind : uint8_t
+		{
+			Message = 0,   // Message received from the client
+			Disconnect = 1 // The client disconnected
+		};
+
+		eKind Kind = eKind::Message;
+		uint64_t TimeUs = 0; // Since the start of the recording
+		uint32_t Client = 0; // Client handle on the recorded server
+		NetworkMessage Message{};
+	};
+
+	/// @brief Writes the messages received by a NetworkServer to a binary file, to replay them later.
+	///
+	/// File : magic, version and NetworkRecordingInfo, then one record after the other :
+	/// kind (1 byte), time since the previous record (varint, microseconds), client handle (varint)
+	/// and for messages, the size (varint) and bytes of the message as sent on the wire (MessageHeader + payload).
+	/// Records are queued by the receiving threads and written by a thread of the recorder : recording a message
+	/// costs its serialization, never a disk write.
+	class NetworkRecorder
+	{
+		using Clock = std::chrono::steady_clock;
+
+		// ----- Constructor / Destructor -----
+	  public:
+		NetworkRecorder() = default;
+		~NetworkRecorder();
+
+		NetworkRecorder(const NetworkRecorder&) = delete;
+		NetworkRecorder& operator=(const NetworkRecorder&) = delete;
+
+		// ----- Public API -----
+	  public:
+		bool Open(const std::filesystem::path& filePath, const NetworkRecordingInfo& info);
+		/// @brief Write the queued records and close the file.
+		void Close();
+		bool IsOpen() const;
+
+		void RecordMessage(uint32_t client, const NetworkMessage& message);
+		void RecordDisconnect(uint32_t client);
+
+		uint64_t GetRecordCount() const;
+
+		// ----- Constants -----
+	  public:
+		static constexpr char MAGIC[4] = {'O', 'V', 'N', 'R'};
+		static constexpr uint16_t VERSION = 1;
+
+		// ----- Private Structs -----
+	  private:
+		struct PendingRecord
+		{
+			NetworkRecord::eKind Kind = NetworkRecord::eKind::Message;
+			uint64_t TimeUs = 0;
+			uint32_t Client = 0;
+			std::vector<uint8_t> Payload;
+		};
+
+		// ----- Private Methods -----
+	  private:
+		void Push(PendingRecord&& record);
+		void WriteRecords(std::stop_token stopToken);
+		void WriteRecord(const PendingRecord& record);
+
+		// ----- Private Members -----
+	  private:
+		std::ofstream m_File;
+		uint64_t m_LastTimeUs = 0; // Writer thread only
+
+		// Held while a record is timed and queued, so the records are queued in time order
+		mutable std::mutex m_Mutex;
+		bool m_IsOpen = false;
+		Clock::time_point m_StartTime{};
+
+		ThreadSafeQueue<PendingRecord> m_PendingRecords;
+		std::jthread m_WriterThread;
+		std::atomic_uint64_t m_RecordCount{0};
+	};
+
+	/// @brief Reads a file written by NetworkRecorder, one record at a time.
+	class NetworkRecordingReader
+	{
+		// ----- Public API -----
+	  public:
+		bool Open(const std::filesystem::path& filePath);
+
+		const NetworkRecordingInfo& GetInfo() const;
+
+		/// @brief Read the next record. Records whose message cannot be decoded are skipped.
+		/// @return false at the end of the file, or at a truncated record (the server was killed while recording).
+		bool Next(NetworkRecord& outRecord);
+
+		// ----- Private Members -----
+	  private:
+		std::ifstream m_File;
+		NetworkRecordingInfo m_Info;
+		uint64_t m_TimeUs = 0;
+	};
+} // namespace onion::voxel
@@ -4,6 +4,7 @@
 #include <stdexcept>
 
 #include <shared/init_enet_once/InitEnetOnce.hpp>
+#include <shared/profiler/Profiler.hpp>
 
 namespace onion::voxel
 {
@@ -13,12 +14,21 @@ namespace onion::voxel
 
 		m_DispatchIncomingMessagesThread =
 			std::jthread([this](std::stop_token stopToken) { DispatchIncomingMessages(stopToken); });
+
+		m_ReceiveLocalMessagesThread =
+			std::jthread([this](std::stop_token stopToken) { ReceiveLocalMessages(stopToken); });
 	}
 
 	NetworkServer::~NetworkServer()
 	{
 		Stop();
 
+		if (m_ReceiveLocalMessagesThread.joinable())
+		{
+			m_ReceiveLocalMessagesThread.request_stop();
+			m_ReceiveLocalMessagesThread.join();
+		}
+
 		if (m_DispatchIncomingMessagesThread.joinable())
 		{
 			m_DispatchIncomingMessagesThread.request_stop();
@@ -36,11 +46,11 @@ namespace onion::voxel
 		address.host = ENET_HOST_ANY; // Bind to all interfaces
 		address.port = static_cast<enet_uint16>(m_Port);
 
-		m_EnetServer = enet_host_create(&address, // Address
-										32,		  // Max clients
-										2,		  // Channels
-										0,		  // Incoming bandwidth (0 = unlimited)
-										0		  // Outgoing bandwidth
+		m_EnetServer = enet_host_create(&address,			   // Address
+										32,					   // Max clients
+										NETWORK_CHANNEL_COUNT, // Channels
+										0,					   // Incoming bandwidth (0 = unlimited)
+										0					   // Outgoing bandwidth
 		);
 
 		if (!m_EnetServer)
@@ -57,6 +67,41 @@ namespace onion::voxel
 		m_IsRunning.store(true);
 	}
 
+	void NetworkServer::StartLocal()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		std::cout << "Server started for local clients only...\n";
+
+		m_IsRunning.store(true);
+	}
+
+	std::shared_ptr<LocalConnection> NetworkServer::ConnectLocalClient()
+	{
+		auto connection = std::make_shared<LocalConnection>();
+
+		ClientSession session;
+		session.handle = GenerateClientHandle();
+		session.ipAddress = "local";
+		session.localConnection = connection;
+
+		const ClientHandle handle = session.handle;
+
+		// Messages are received on the local reception thread, like ENet messages on the event thread
+		connection->BindServer([this, handle](NetworkMessage&& message)
+							   { m_LocalIncomingMessages.Push({handle, std::move(message)}); },
+							   [this, handle]() { m_LocalIncomingMessages.Push({handle, std::nullopt}); });
+
+		{
+			std::lock_guard<std::mutex> lock(m_ClientMutex);
+			m_LocalSessions[handle] = std::move(session);
+		}
+
+		std::cout << "Local client connected.\n";
+
+		return connection;
+	}
+
 	void NetworkServer::Stop()
 	{
 		// Signal the event thread to stop and wait for it to finish
@@ -66,6 +111,20 @@ namespace onion::voxel
 			m_EventThread.join();
 		}
 
+		// Close the local connections
+		std::vector<std::shared_ptr<LocalConnection>> localConnections;
+		{
+			std::lock_guard<std::mutex> lock(m_ClientMutex);
+			for (const auto& [handle, session] : m_LocalSessions)
+				localConnections.push_back(session.localConnection);
+			m_LocalSessions.clear();
+		}
+
+		for (const auto& connection : localConnections)
+		{
+			connection->CloseFromServer();
+		}
+
 		std::lock_guard<std::mutex> lock(m_Mutex);
 
 		// Destroy the ENet server
@@ -85,37 +144,98 @@ namespace onion::voxel
 		return m_IsRunning.load();
 	}
 
-	void NetworkServer::Send(ClientHandle client, NetworkMessage message, bool reliable)
+	void NetworkServer::Send(ClientHandle client, NetworkMessage message)
+	{
+		Send(std::vector<ClientHandle>{client}, std::move(message));
+	}
+
+	void NetworkServer::Send(const std::vector<ClientHandle>& clients, NetworkMessage message)
 	{
-		Send(std::vector<ClientHandle>{client}, std::move(message), reliable);
+		const eNetworkChannel channel = GetChannelPolicy(message).Channel;
+		Send(clients, std::move(message), channel);
 	}
 
-	void NetworkServer::Send(const std::vector<ClientHandle>& clients, NetworkMessage message, bool reliable)
+	void NetworkServer::Send(const std::vector<ClientHandle>& clients, NetworkMessage message, eNetworkChannel channel)
 	{
 		if (!m_IsRunning)
 			return;
 
 		OutgoingMessage out;
-		out.Targets = clients;
+		out.Policy = GetChannelPolicy(message);
+		out.Policy.Channel = channel;
+
+		std::vector<std::shared_ptr<LocalConnection>> localTargets;
+
+		{
+			std::lock_guard<std::mutex> lock(m_ClientMutex);
+
+			const size_t channel = static_cast<size_t>(out.Policy.Channel);
+			for (ClientHandle handle : clients)
+			{
+				auto itLocal = m_LocalSessions.find(handle);
+				if (itLocal != m_LocalSessions.end())
+				{
+					localTargets.push_back(itLocal->second.localConnection);
+					continue;
+				}
+
+				auto it = m_HandleToPeer.find(handle);
+				if (it == m_HandleToPeer.end())
+					continue;
+
+				m_PeerToSession[it->second].traffic->PendingMessages[channel].fetch_add(1, std::memory_order_relaxed);
+				out.Targets.push_back(handle);
+			}
+		}
+
+		const size_t messageType = static_cast<size_t>(GetMessageType(message));
+		if (messageType < MessageHeader::TYPE_COUNT)
+			m_MessagesSentByType[messageType].fetch_add(out.Targets.size() + localTargets.size(),
+														std::memory_order_relaxed);
+
+		// Local clients get the message as is, without serialization
+		for (const auto& connection : localTargets)
+		{
+			connection->SendToClient(message);
+		}
+
+		if (out.Targets.empty())
+			return;
+
 		out.Message = std::move(message);
-		out.Reliable = reliable;
 
+		m_ChannelStats.OnQueued(out.Policy.Channel);
 		m_OutgoingMessages.Push(std::move(out));
 	}
 
-	void NetworkServer::Broadcast(NetworkMessage message, bool reliable)
+	void NetworkServer::Broadcast(NetworkMessage message)
 	{
+		Send(GetConnectedClients(), std::move(message));
+	}
+
+	std::vector<NetworkServer::ClientHandle> NetworkServer::GetConnectedClients() const
+	{
+		std::lock_guard<std::mutex> lock(m_ClientMutex);
+
 		std::vector<ClientHandle> clients;
+		clients.reserve(m_HandleToPeer.size() + m_LocalSessions.size());
+		for (const auto& [handle, _] : m_HandleToPeer)
+			clients.push_back(handle);
+		for (const auto& [handle, _] : m_LocalSessions)
+			clients.push_back(handle);
 
-		{
-			std::lock_guard<std::mutex> lock(m_ClientMutex);
+		return clients;
+	}
 
-			clients.reserve(m_HandleToPeer.size());
-			for (const auto& [handle, _] : m_HandleToPeer)
-				clients.push_back(handle);
+	NetworkServer::MessageTypeStats NetworkServer::GetMessageTypeStats() const
+	{
+		MessageTypeStats stats;
+		for (size_t i = 0; i < MessageHeader::TYPE_COUNT; i++)
+		{
+			stats.Received[i] = m_MessagesReceivedByType[i].load(std::memory_order_relaxed);
+			stats.Sent[i] = m_MessagesSentByType[i].load(std::memory_order_relaxed);
 		}
-
-		Send(clients, std::move(message), reliable);
+		return stats;
 	}
 
 	uint16_t NetworkServer::GetServerPort() const
@@ -142,14 +262,56 @@ namespace onion::voxel
 		m_MOTD = motd;
 	}
 
+	std::array<ChannelStats, NETWORK_CHANNEL_COUNT> NetworkServer::GetChannelStats() const
+	{
+		return m_ChannelStats.Snapshot();
+	}
+
+	std::optional<NetworkServer::ClientLinkStats> NetworkServer::GetClientLinkStats(ClientHandle client) const
+	{
+		std::lock_guard<std::mutex> lock(m_ClientMutex);
+
+		if (m_LocalSessions.find(client) != m_LocalSessions.end())
+		{
+			ClientLinkStats stats;
+			stats.IsLocal = true;
+			return stats;
+		}
+
+		auto itStats = m_LinkStats.find(client);
+		auto itPeer = m_HandleToPeer.find(client);
+		if (itStats == m_LinkStats.end() || itPeer == m_HandleToPeer.end())
+			return std::nullopt;
+
+		ClientLinkStats stats = itStats->second;
+
+		auto itSession = m_PeerToSession.find(itPeer->second);
+		if (itSession != m_PeerToSession.end())
+		{
+			const ClientTraffic& traffic = *itSession->second.traffic;
+			for (size_t i = 0; i < NETWORK_CHANNEL_COUNT; i++)
+			{
+				stats.PendingMessages[i] = traffic.PendingMessages[i].load(std::memory_order_relaxed);
+				stats.PendingBytes[i] = traffic.PendingBytes[i].load(std::memory_order_relaxed);
+			}
+			stats.BytesSent = traffic.BytesSent.load(std::memory_order_relaxed);
+			stats.BytesReceived = traffic.BytesReceived.load(std::memory_order_relaxed);
+		}
+
+		return stats;
+	}
+
 	void NetworkServer::ListenForEvents(std::stop_token stopToken)
 	{
+		Profiler::SetThreadName("Network");
+
 		ENetEvent event;
 		ClientSession session;
 
 		while (!stopToken.stop_requested())
 		{
 			ProcessOutgoingMessages();
+			SampleLinkStats();
 
 			while (enet_host_service(m_EnetServer, &event, 1) > 0)
 			{
@@ -163,19 +325,32 @@ namespace onion::voxel
 						session.handle = GenerateClientHandle();
 						session.peer = event.peer;
 
+						{
+							char ip[64];
+							enet_address_get_host_ip(&event.peer->address, ip, sizeof(ip));
+							session.ipAddress = ip;
+						}
+
 						{
 							std::lock_guard<std::mutex> lock(m_ClientMutex);
 							m_PeerToSession[event.peer] = session;
 							m_HandleToPeer[session.handle] = event.peer;
+							m_LinkStats[session.handle] = ClientLinkStats();
 						}
 
 						break;
 
 					case ENET_EVENT_TYPE_RECEIVE:
 						{
+							ONION_PROFILE_ZONE("NetworkServer::ReceiveMessage");
+
 							const auto* rawData = reinterpret_cast<const char*>(event.packet->data);
 							const auto dataSize = static_cast<std::size_t>(event.packet->dataLength);
 
+							m_ChannelStats.OnReceived(event.channelID, dataSize);
+							ONION_PROFILE_COUNT("NetworkServer::BytesReceived", dataSize);
+							ONION_PROFILE_RECORD("NetworkServer::ReceivedMessageBytes", dataSize);
+
 							struct MemoryStream : std::streambuf
 							{
 								MemoryStream(const char* data, std::size_t size)
@@ -197,55 +372,22 @@ namespace onion::voxel
 
 								NetworkMessage msg = DeserializeMessage(archive, header.Type);
 
-								ClientHandle handle;
-
+								std::optional<ClientHandle> handle;
 								{
-									std::unique_lock<std::mutex> lock(m_ClientMutex);
+									std::lock_guard<std::mutex> lock(m_ClientMutex);
 									auto it = m_PeerToSession.find(event.peer);
-									if (it == m_PeerToSession.end())
-										break;
-
-									handle = it->second.handle;
-
-									if (!it->second.authenticated && header.Type != MessageHeader::eType::ClientInfo &&
-										header.Type != MessageHeader::eType::RequestMotd)
-										break;
-
-									if (header.Type == MessageHeader::eType::ClientInfo)
-									{
-										// Extracts ClientInfoMessage
-										ClientInfoMsg clientInfo = std::get<ClientInfoMsg>(msg);
-
-										// Get client's IP address
-										char ip[64];
-										enet_address_get_host_ip(&event.peer->address, ip, sizeof(ip));
-
-										// Update session with authenticated client info
-										it->second.authenticated = true;
-										it->second.uuid = clientInfo.UUID;
-										it->second.ipAddress = ip;
-
-										// Trigger ClientConnected event
-										ClientConnectedEventArgs args;
-										args.Client = handle;
-										args.UUID = clientInfo.UUID;
-										args.IpAddress = ip;
-										args.PlayerName = clientInfo.PlayerName;
-
-										// Unlock before triggering event to avoid potential deadlocks if event handlers interact with NetworkServer
-										lock.unlock();
-										EvtClientConnected.Trigger(args);
-										lock.lock();
-									}
-
-									if (header.Type == MessageHeader::eType::RequestMotd)
+									if (it != m_PeerToSession.end())
 									{
-										// Send MOTD to the client
-										Send(handle, m_MOTD);
+										handle = it->second.handle;
+										it->second.traffic->BytesReceived.fetch_add(dataSize,
+																					std::memory_order_relaxed);
 									}
 								}
 
-								m_IncomingMessages.Push({handle, std::move(msg)});
+								if (handle)
+								{
+									OnMessageReceived(*handle, std::move(msg));
+								}
 							}
 							catch (const std::exception& e)
 							{
@@ -272,10 +414,13 @@ namespace onion::voxel
 
 							// Clean up session data
 							m_HandleToPeer.erase(retrevedSession.handle);
+							m_LinkStats.erase(retrevedSession.handle);
 							m_PeerToSession.erase(event.peer);
 
 							lock.unlock();
 
+							RecordDisconnect(disconnectArgs.Client);
+
 							// Trigger ClientDisconnected event
 							EvtClientDisconnected.Trigger(disconnectArgs);
 						}
@@ -319,9 +464,16 @@ namespace onion::voxel
 
 		while (m_OutgoingMessages.TryPop(msg))
 		{
+			ONION_PROFILE_ZONE("NetworkServer::SendMessage");
+
+			m_ChannelStats.OnDequeued(msg.Policy.Channel);
+
 			std::vector<uint8_t> buffer = SerializeNetworkMessage(msg.Message);
+			ONION_PROFILE_RECORD("NetworkServer::SentMessageBytes", buffer.size());
 
-			const enet_uint32 flags = msg.Reliable ? ENET_PACKET_FLAG_RELIABLE : 0;
+			// Unreliable packets are sequenced by default in ENet (no ENET_PACKET_FLAG_UNSEQUENCED).
+			const enet_uint32 flags = msg.Policy.Reliable ? ENET_PACKET_FLAG_RELIABLE : 0;
+			const enet_uint8 channelId = static_cast<enet_uint8>(msg.Policy.Channel);
 
 			std::lock_guard<std::mutex> lock(m_ClientMutex);
 
@@ -333,13 +485,69 @@ namespace onion::voxel
 
 				ENetPacket* packet = enet_packet_create(buffer.data(), buffer.size(), flags);
 
-				enet_peer_send(it->second, 0, packet);
+				// Track the packet until ENet frees it, so pending traffic per client can be measured
+				auto itSession = m_PeerToSession.find(it->second);
+				if (itSession != m_PeerToSession.end())
+				{
+					PacketTracking* tracking = new PacketTracking();
+					tracking->Traffic = itSession->second.traffic;
+					tracking->Channel = channelId;
+					tracking->Bytes = buffer.size();
+					tracking->Traffic->PendingBytes[channelId].fetch_add(buffer.size(), std::memory_order_relaxed);
+
+					packet->userData = tracking;
+					packet->freeCallback = &NetworkServer::OnPacketFreed;
+				}
+
+				if (enet_peer_send(it->second, channelId, packet) == 0)
+				{
+					m_ChannelStats.OnSent(msg.Policy.Channel, buffer.size());
+					ONION_PROFILE_COUNT("NetworkServer::BytesSent", buffer.size());
+
+					if (itSession != m_PeerToSession.end())
+						itSession->second.traffic->BytesSent.fetch_add(buffer.size(), std::memory_order_relaxed);
+				}
+				else
+				{
+					enet_packet_destroy(packet);
+				}
 			}
 		}
 
 		enet_host_flush(m_EnetServer);
 	}
 
+	void NetworkServer::SampleLinkStats()
+	{
+		std::lock_guard<std::mutex> lock(m_ClientMutex);
+
+		for (const auto& [peer, session] : m_PeerToSession)
+		{
+			auto it = m_LinkStats.find(session.handle);
+			if (it == m_LinkStats.end())
+				continue;
+
+			ClientLinkStats& stats = it->second;
+			stats.RoundTripTimeMs = peer->roundTripTime;
+			stats.RoundTripTimeVarianceMs = peer->roundTripTimeVariance;
+			stats.PacketThrottle = peer->packetThrottle;
+			stats.PacketLoss = static_cast<float>(peer->packetLoss) / static_cast<float>(ENET_PEER_PACKET_LOSS_SCALE);
+		}
+	}
+
+	void NetworkServer::OnPacketFreed(ENetPacket* packet)
+	{
+		PacketTracking* tracking = static_cast<PacketTracking*>(packet->userData);
+		if (!tracking)
+			return;
+
+		tracking->Traffic->PendingMessages[tracking->Channel].fetch_sub(1, std::memory_order_relaxed);
+		tracking->Traffic->PendingBytes[tracking->Channel].fetch_sub(tracking->Bytes, std::memory_order_relaxed);
+
+		packet->userData = nullptr;
+		delete tracking;
+	}
+
 	NetworkServer::ClientHandle NetworkServer::GenerateClientHandle()
 	{
 		std::lock_guard<std::mutex> lock(m_ClientMutex);
@@ -348,6 +556,7 @@ namespace onion::voxel
 
 	void NetworkServer::DispatchIncomingMessages(std::stop_token stopToken)
 	{
+		Profiler::SetThreadName("Network Dispatch");
 
 		IncommingMessage msg;
 		MessageReceivedEventArgs args;
@@ -359,4 +568,133 @@ namespace onion::voxel
 			EvtMessageReceived.Trigger(args);
 		}
 	}
+
+	NetworkServer::ClientSession* NetworkServer::FindSession_Unsafe(ClientHandle handle)
+	{
+		auto itLocal = m_LocalSessions.find(handle);
+		if (itLocal != m_LocalSessions.end())
+			return &itLocal->second;
+
+		auto itPeer = m_HandleToPeer.find(handle);
+		if (itPeer == m_HandleToPeer.end())
+			return nullptr;
+
+		auto itSession = m_PeerToSession.find(itPeer->second);
+		if (itSession == m_PeerToSession.end())
+			return nullptr;
+
+		return &itSession->second;
+	}
+
+	void NetworkServer::SetRecorder(std::shared_ptr<NetworkRecorder> recorder)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Recorder = std::move(recorder);
+	}
+
+	std::shared_ptr<NetworkRecorder> NetworkServer::GetRecorder() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		return m_Recorder;
+	}
+
+	void NetworkServer::RecordDisconnect(ClientHandle client)
+	{
+		if (std::shared_ptr<NetworkRecorder> recorder = GetRecorder())
+			recorder->RecordDisconnect(client);
+	}
+
+	void NetworkServer::OnMessageReceived(ClientHandle sender, NetworkMessage&& message)
+	{
+		// Before any check : the replay goes through the same checks
+		if (std::shared_ptr<NetworkRecorder> recorder = GetRecorder())
+			recorder->RecordMessage(sender, message);
+
+		const MessageHeader::eType type = GetMessageType(message);
+		if (static_cast<size_t>(type) < MessageHeader::TYPE_COUNT)
+			m_MessagesReceivedByType[static_cast<size_t>(type)].fetch_add(1, std::memory_order_relaxed);
+
+		std::optional<ClientConnectedEventArgs> connectedArgs;
+
+		{
+			std::lock_guard<std::mutex> lock(m_ClientMutex);
+
+			ClientSession* session = FindSession_Unsafe(sender);
+			if (!session)
+				return;
+
+			if (!session->authenticated && type != MessageHeader::eType::ClientInfo &&
+				type != MessageHeader::eType::RequestMotd)
+				return;
+
+			if (type == MessageHeader::eType::ClientInfo)
+			{
+				const ClientInfoMsg& clientInfo = std::get<ClientInfoMsg>(message);
+
+				// Update session with authenticated client info
+				session->authenticated = true;
+				session->uuid = clientInfo.UUID;
+
+				ClientConnectedEventArgs args;
+				args.Client = sender;
+				args.UUID = clientInfo.UUID;
+				args.IpAddress = session->ipAddress;
+				args.PlayerName = clientInfo.PlayerName;
+				connectedArgs = std::move(args);
+			}
+		}
+
+		// No lock held : event handlers and Send may interact with NetworkServer
+		if (connectedArgs)
+		{
+			EvtClientConnected.Trigger(*connectedArgs);
+		}
+
+		if (type == MessageHeader::eType::RequestMotd)
+		{
+			ServerMotdMsg motd;
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				motd = m_MOTD;
+			}
+			Send(sender, std::move(motd));
+		}
+
+		m_IncomingMessages.Push({sender, std::move(message)});
+	}
+
+	void NetworkServer::ReceiveLocalMessages(std::stop_token stopToken)
+	{
+		LocalIncomingMessage msg;
+
+		while (m_LocalIncomingMessages.WaitPop(msg, stopToken))
+		{
+			if (msg.Message)
+			{
+				OnMessageReceived(msg.Sender, std::move(*msg.Message));
+				continue;
+			}
+
+			// The local client closed the connection
+			ClientDisconnectedEventArgs disconnectArgs;
+
+			{
+				std::lock_guard<std::mutex> lock(m_ClientMutex);
+
+				auto it = m_LocalSessions.find(msg.Sender);
+				if (it == m_LocalSessions.end())
+					continue;
+
+				disconnectArgs.Client = it->second.handle;
+				disconnectArgs.UUID = it->second.uuid;
+				disconnectArgs.IpAddress = it->second.ipAddress;
+
+				m_LocalSessions.erase(it);
+			}
+
+			std::cout << "Local client disconnected.\n";
+			RecordDisconnect(disconnectArgs.Client);
+			EvtClientDisconnected.Trigger(disconnectArgs);
+		}
+	}
 } // namespace onion::voxel
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
 
 #include <enet/enet.h>
@@ -9,8 +12,11 @@
 #include <onion/Event.hpp>
 #include <onion/ThreadSafeQueue.hpp>
 
+#include <shared/local_connection/LocalConnection.hpp>
 #include <shared/network_messages/NetworkMessages.hpp>
 
+#include "network_recorder/NetworkRecorder.hpp"
+
 namespace onion::voxel
 {
 	class NetworkServer
@@ -20,6 +26,16 @@ namespace onion::voxel
 
 		// ----- Structs -----
 	  private:
+		// Messages and bytes queued for a client and not yet released by ENet (acknowledged for reliable packets).
+		struct ClientTraffic
+		{
+			std::array<std::atomic_uint64_t, NETWORK_CHANNEL_COUNT> PendingMessages{};
+			std::array<std::atomic_uint64_t, NETWORK_CHANNEL_COUNT> PendingBytes{};
+
+			std::atomic_uint64_t BytesSent{0};
+			std::atomic_uint64_t BytesReceived{0};
+		};
+
 		struct ClientSession
 		{
 			ClientHandle handle = 0;
@@ -27,6 +43,16 @@ namespace onion::voxel
 			std::string uuid;
 			std::string ipAddress;
 			bool authenticated = false;
+			std::shared_ptr<ClientTraffic> traffic = std::make_shared<ClientTraffic>();
+			std::shared_ptr<LocalConnection> localConnection; // Set for in-process clients only
+		};
+
+		// Attached to each ENet packet (userData) to release the client traffic when ENet frees the packet.
+		struct PacketTracking
+		{
+			std::shared_ptr<ClientTraffic> Traffic;
+			size_t Channel = 0;
+			size_t Bytes = 0;
 		};
 
 	  public:
@@ -40,7 +66,7 @@ namespace onion::voxel
 		{
 			std::vector<ClientHandle> Targets;
 			NetworkMessage Message{};
-			bool Reliable{true};
+			ChannelPolicy Policy{};
 		};
 
 		struct ClientConnectedEventArgs
@@ -64,6 +90,29 @@ namespace onion::voxel
 			NetworkMessage Message{};
 		};
 
+		struct ClientLinkStats
+		{
+			bool IsLocal = false; // In-process client, not limited by a network link
+			uint32_t RoundTripTimeMs = 0;
+			uint32_t RoundTripTimeVarianceMs = 0;
+			uint32_t PacketThrottle = ENET_PEER_PACKET_THROTTLE_SCALE; // 0 (fully throttled) to ENET_PEER_PACKET_THROTTLE_SCALE
+			float PacketLoss = 0.f;									   // Ratio of lost packets (0 to 1)
+
+			std::array<uint64_t, NETWORK_CHANNEL_COUNT> PendingMessages{};
+			std::array<uint64_t, NETWORK_CHANNEL_COUNT> PendingBytes{};
+
+			// Payload bytes since the client connected
+			uint64_t BytesSent = 0;
+			uint64_t BytesReceived = 0;
+		};
+
+		/// @brief Messages since the start, by message type (index : MessageHeader::eType).
+		struct MessageTypeStats
+		{
+			std::array<uint64_t, MessageHeader::TYPE_COUNT> Received{};
+			std::array<uint64_t, MessageHeader::TYPE_COUNT> Sent{}; // One per target client
+		};
+
 		// ----- Constructor / Destructor -----
 	  public:
 		NetworkServer(uint16_t port = 7777);
@@ -75,9 +124,23 @@ namespace onion::voxel
 		void Stop();
 		bool IsRunning() const noexcept;
 
-		void Send(ClientHandle client, NetworkMessage message, bool reliable = true);
-		void Send(const std::vector<ClientHandle>& clients, NetworkMessage message, bool reliable = true);
-		void Broadcast(NetworkMessage message, bool reliable = true);
+		/// @brief Start the server without opening a socket. Only in-process clients can connect (singleplayer).
+		void StartLocal();
+
+		/// @brief Connect an in-process client. Messages are exchanged without serialization nor socket.
+		/// @return The connection to give to NetworkClient::StartLocal.
+		std::shared_ptr<LocalConnection> ConnectLocalClient();
+
+		// The channel and reliability of a message are given by its type (see GetChannelPolicy).
+		void Send(ClientHandle client, NetworkMessage message);
+		void Send(const std::vector<ClientHandle>& clients, NetworkMessage message);
+		/// @brief Send on another channel than the message type's : ENet only orders the packets of a channel, so a
+		/// message that must arrive after some other message is sent on that message's channel.
+		void Send(const std::vector<ClientHandle>& clients, NetworkMessage message, eNetworkChannel channel);
+		void Broadcast(NetworkMessage message);
+
+		/// @brief Record every message received, and the client disconnections, until set to nullptr.
+		void SetRecorder(std::shared_ptr<NetworkRecorder> recorder);
 
 		// ----- Getters / Setters -----
 	  public:
@@ -86,6 +149,17 @@ namespace onion::voxel
 
 		void SetMOTD(const ServerMotdMsg& motd);
 
+		std::array<ChannelStats, NETWORK_CHANNEL_COUNT> GetChannelStats() const;
+
+		/// @brief Get the round trip time, throttle and pending traffic of a connected client.
+		/// @return The link stats, or std::nullopt if the client is not connected.
+		std::optional<ClientLinkStats> GetClientLinkStats(ClientHandle client) const;
+
+		/// @brief Handles of the connected clients, remote and in-process.
+		std::vector<ClientHandle> GetConnectedClients() const;
+
+		MessageTypeStats GetMessageTypeStats() const;
+
 		// ----- Events -----
 	  public:
 		Event<const ClientConnectedEventArgs&> EvtClientConnected;
@@ -101,30 +175,60 @@ namespace onion::voxel
 
 		static std::vector<uint8_t> SerializeNetworkMessage(const NetworkMessage& message);
 		void ProcessOutgoingMessages();
+		void SampleLinkStats();
+
+		static void OnPacketFreed(ENetPacket* packet);
 
 		// ----- Private Members -----
 	  private:
 		ThreadSafeQueue<IncommingMessage> m_IncomingMessages;
 		ThreadSafeQueue<OutgoingMessage> m_OutgoingMessages;
+		ChannelStatsCounters m_ChannelStats;
+
+		std::array<std::atomic_uint64_t, MessageHeader::TYPE_COUNT> m_MessagesReceivedByType{};
+		std::array<std::atomic_uint64_t, MessageHeader::TYPE_COUNT> m_MessagesSentByType{};
 
 		// ----- Client Management -----
 	  private:
-		std::mutex m_ClientMutex;
+		mutable std::mutex m_ClientMutex;
 		ClientHandle m_NextClientHandle{1};
 		ClientHandle GenerateClientHandle();
 		std::unordered_map<ENetPeer*, ClientSession> m_PeerToSession;
 		std::unordered_map<ClientHandle, ENetPeer*> m_HandleToPeer;
+		std::unordered_map<ClientHandle, ClientSession> m_LocalSessions;
+		// Sampled on the ENet thread, since ENet peers must not be read from other threads.
+		std::unordered_map<ClientHandle, ClientLinkStats> m_LinkStats;
+
+		ClientSession* FindSession_Unsafe(ClientHandle handle);
 
 		// ----- Message Reception and Dispatching -----
 	  private:
 		std::jthread m_DispatchIncomingMessagesThread;
 		void DispatchIncomingMessages(std::stop_token stopToken);
 
+		void OnMessageReceived(ClientHandle sender, NetworkMessage&& message);
+		void RecordDisconnect(ClientHandle client);
+
+		std::shared_ptr<NetworkRecorder> GetRecorder() const;
+
+		// ----- Local Clients Reception -----
+	  private:
+		struct LocalIncomingMessage
+		{
+			ClientHandle Sender{0};
+			std::optional<NetworkMessage> Message; // std::nullopt : the client closed the connection
+		};
+
+		ThreadSafeQueue<LocalIncomingMessage> m_LocalIncomingMessages;
+		std::jthread m_ReceiveLocalMessagesThread;
+		void ReceiveLocalMessages(std::stop_token stopToken);
+
 		// ----- States -----
 	  private:
 		mutable std::mutex m_Mutex;
 		uint16_t m_Port{7777};
 		std::atomic_bool m_IsRunning{false};
 		ServerMotdMsg m_MOTD;
+		std::shared_ptr<NetworkRecorder> m_Recorder;
 	};
 } // namespace onion::voxel
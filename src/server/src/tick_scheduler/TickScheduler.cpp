@@ -0,0 +1,184 @@
+#include "TickScheduler.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace onion::voxel
+{
+	TickScheduler::TickScheduler(uint32_t ticksPerSecond)
+	{
+		SetTicksPerSecond(ticksPerSecond);
+	}
+
+	TickScheduler::~TickScheduler()
+	{
+		Stop();
+	}
+
+	void TickScheduler::AddPhase(const std::string& name, PhaseFunction function)
+	{
+		if (IsRunning())
+			throw std::logic_error("Cannot add a tick phase while the tick scheduler is running.");
+
+		m_Phases.push_back({name, std::move(function), &Profiler::GetZoneSite(("Tick::" + name).c_str())});
+
+		std::lock_guard lock(m_MutexStats);
+		PhaseStats phaseStats;
+		phaseStats.Name = name;
+		m_Stats.Phases.push_back(phaseStats);
+	}
+
+	void TickScheduler::Start()
+	{
+		if (m_IsRunning.exchange(true))
+			return;
+
+		m_Thread = std::jthread([this](std::stop_token stopToken) { Run(stopToken); });
+	}
+
+	void TickScheduler::Stop()
+	{
+		if (m_Thread.joinable())
+		{
+			m_Thread.request_stop();
+			m_Thread.join();
+		}
+
+		m_IsRunning.store(false);
+	}
+
+	bool TickScheduler::IsRunning() const noexcept
+	{
+		return m_IsRunning.load();
+	}
+
+	uint32_t TickScheduler::GetTicksPerSecond() const
+	{
+		return m_TicksPerSecond;
+	}
+
+	void TickScheduler::SetTicksPerSecond(uint32_t ticksPerSecond)
+	{
+		if (IsRunning())
+			throw std::logic_error("Cannot change the tick rate while the tick scheduler is running.");
+
+		m_TicksPerSecond = std::max<uint32_t>(1, ticksPerSecond);
+
+		std::lock_guard lock(m_MutexStats);
+		m_Stats.TicksPerSecond = m_TicksPerSecond;
+	}
+
+	TickScheduler::TickStats TickScheduler::GetStats() const
+	{
+		std::lock_guard lock(m_MutexStats);
+		return m_Stats;
+	}
+
+	ProfileHistogram::Snapshot TickScheduler::TakeTickTimeSnapshot()
+	{
+		return m_TickTimesUs.TakeSnapshot();
+	}
+
+	void TickScheduler::Run(std::stop_token stopToken)
+	{
+		Profiler::SetThreadName("Tick");
+
+		const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / m_TicksPerSecond;
+
+		uint64_t tick = 0;
+		Clock::time_point nextTick = Clock::now();
+
+		while (!stopToken.stop_requested())
+		{
+			RunTick(tick++);
+
+			nextTick += period;
+
+			const Clock::time_point now = Clock::now();
+			if (now > nextTick)
+			{
+				// Late : skip the ticks we missed instead of running them back to back.
+				// The tick number is not advanced : periodic tasks (tick % n) must not jump over their multiple.
+				const uint64_t missed = static_cast<uint64_t>((now - nextTick) / period);
+				if (missed > 0)
+				{
+					nextTick += period * missed;
+
+					std::lock_guard lock(m_MutexStats);
+					m_Stats.SkippedTicks += missed;
+				}
+			}
+
+			std::this_thread::sleep_until(nextTick);
+		}
+	}
+
+	void TickScheduler::RunTick(uint64_t tick)
+	{
+		ONION_PROFILE_ZONE("Tick");
+
+		const Clock::time_point tickStart = Clock::now();
+
+		std::vector<double> phasesMs(m_Phases.size(), 0.0);
+
+		for (size_t i = 0; i < m_Phases.size(); i++)
+		{
+			const Clock::time_point phaseStart = Clock::now();
+
+			try
+			{
+				ProfileZone zone(*m_Phases[i].ZoneSite);
+				m_Phases[i].Function(tick);
+			}
+			catch (const std::exception& e)
+			{
+				std::cerr << "Tick phase " << m_Phases[i].Name << " failed: " << e.what() << "\n";
+			}
+
+			phasesMs[i] = std::chrono::duration<double, std::milli>(Clock::now() - phaseStart).count();
+		}
+
+		const double tickMs = std::chrono::duration<double, std::milli>(Clock::now() - tickStart).count();
+		const double budgetMs = 1000.0 / static_cast<double>(m_TicksPerSecond);
+		const bool overrun = tickMs > budgetMs;
+
+		m_TickTimesUs.Record(static_cast<uint64_t>(tickMs * 1000.0));
+
+		{
+			std::lock_guard lock(m_MutexStats);
+
+			m_Stats.TickCount++;
+			AddSample(m_Stats.Tick, tickMs);
+
+			for (size_t i = 0; i < phasesMs.size(); i++)
+			{
+				AddSample(m_Stats.Phases[i].Timing, phasesMs[i]);
+			}
+
+			if (overrun)
+				m_Stats.OverrunCount++;
+		}
+
+		if (overrun)
+		{
+			TickOverrunEventArgs args;
+			args.Tick = tick;
+			args.TickMs = tickMs;
+			args.BudgetMs = budgetMs;
+
+			auto slowest = std::max_element(phasesMs.begin(), phasesMs.end());
+			if (slowest != phasesMs.end())
+				args.SlowestPhase = m_Phases[static_cast<size_t>(slowest - phasesMs.begin())].Name;
+
+			EvtTickOverrun.Trigger(args);
+		}
+	}
+
+	void TickScheduler::AddSample(TimingStats& stats, double ms)
+	{
+		stats.LastMs = ms;
+		stats.MaxMs = std::max(stats.MaxMs, ms);
+		stats.AverageMs = stats.AverageMs == 0.0 ? ms : stats.AverageMs + (ms - stats.AverageMs) * AVERAGE_WEIGHT;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <onion/Event.hpp>
+
+#include <shared/profiler/Profiler.hpp>
+
+namespace onion::voxel
+{
+	/// @brief Runs the server tick at a fixed rate on its own thread.
+	/// A tick runs its phases one after the other, always in the order they were added.
+	/// Each phase is timed; a tick longer than the tick period is an overrun, and the ticks it made late are skipped
+	/// rather than run back to back.
+	class TickScheduler
+	{
+		// ----- Structs -----
+	  public:
+		/// tick : number of ticks run before this one. Skipped ticks are only counted in the stats, so a task run
+		/// when tick % n == 0 runs every n ticks, even when the server is overloaded.
+		using PhaseFunction = std::function<void(uint64_t tick)>;
+
+		struct TimingStats
+		{
+			double LastMs = 0.0;
+			double AverageMs = 0.0; // Exponential moving average
+			double MaxMs = 0.0;
+		};
+
+		struct PhaseStats
+		{
+			std::string Name;
+			TimingStats Timing;
+		};
+
+		struct TickStats
+		{
+			uint32_t TicksPerSecond = 0;
+			uint64_t TickCount = 0;
+			uint64_t OverrunCount = 0; // Ticks that took longer than the tick period
+			uint64_t SkippedTicks = 0; // Ticks not run because of overruns
+			TimingStats Tick;
+			std::vector<PhaseStats> Phases;
+		};
+
+		struct TickOverrunEventArgs
+		{
+			uint64_t Tick = 0;
+			double TickMs = 0.0;
+			double BudgetMs = 0.0;
+			std::string SlowestPhase;
+		};
+
+		// ----- Constructor / Destructor -----
+	  public:
+		TickScheduler(uint32_t ticksPerSecond = 20);
+		~TickScheduler();
+
+		// ----- Public API -----
+	  public:
+		/// @brief Add a phase, run after the phases already added. Must be called before Start.
+		void AddPhase(const std::string& name, PhaseFunction function);
+
+		void Start();
+		void Stop();
+		bool IsRunning() const noexcept;
+
+		// ----- Getters / Setters -----
+	  public:
+		uint32_t GetTicksPerSecond() const;
+		/// @brief Must be called while stopped.
+		void SetTicksPerSecond(uint32_t ticksPerSecond);
+
+		TickStats GetStats() const;
+
+		/// @brief Distribution of the tick durations (microseconds) since the last call, for percentiles.
+		ProfileHistogram::Snapshot TakeTickTimeSnapshot();
+
+		// ----- Events -----
+	  public:
+		Event<const TickOverrunEventArgs&> EvtTickOverrun;
+
+		// ----- Private Members -----
+	  private:
+		using Clock = std::chrono::steady_clock;
+
+		struct Phase
+		{
+			std::string Name;
+			PhaseFunction Function;
+			ProfileZoneSite* ZoneSite = nullptr;
+		};
+
+		std::vector<Phase> m_Phases;
+		uint32_t m_TicksPerSecond = 20;
+
+		std::jthread m_Thread;
+		std::atomic_bool m_IsRunning{false};
+
+		mutable std::mutex m_MutexStats;
+		TickStats m_Stats;
+
+		ProfileHistogram m_TickTimesUs;
+
+		// Weight of the last sample in the moving averages
+		static constexpr double AVERAGE_WEIGHT = 0.05;
+
+		// ----- Private Methods -----
+	  private:
+		void Run(std::stop_token stopToken);
+		void RunTick(uint64_t tick);
+
+		static void AddSample(TimingStats& stats, double ms);
+	};
+} // namespace onion::voxel
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/cereal.hpp>
+#include <cereal/types/vector.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <shared/data_transfer_objects/serializer/GlmSerialization.hpp>
+
+#include "BlockStateDTO.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Blocks changed in one subchunk.
+	struct SubChunkDeltaDTO
+	{
+		// Bits of a packed change : local index in the subchunk (x + y * CHUNK_SIZE + z * CHUNK_SIZE^2),
+		// then index of the new block state in the ChunkDeltaDTO palette.
+		static constexpr uint32_t LOCAL_INDEX_BITS = 18;
+		static constexpr uint32_t LOCAL_INDEX_MASK = (1u << LOCAL_INDEX_BITS) - 1;
+		static constexpr uint32_t MAX_PALETTE_SIZE = 1u << (32 - LOCAL_INDEX_BITS);
+
+		uint16_t SubChunkIndex{0};
+		std::vector<uint32_t> Changes;
+
+		static uint32_t PackChange(uint32_t localIndex, uint32_t paletteIndex)
+		{
+			return (localIndex & LOCAL_INDEX_MASK) | (paletteIndex << LOCAL_INDEX_BITS);
+		}
+		static uint32_t GetLocalIndex(uint32_t change) { return change & LOCAL_INDEX_MASK; }
+		static uint32_t GetPaletteIndex(uint32_t change) { return change >> LOCAL_INDEX_BITS; }
+
+		template <class Archive> void serialize(Archive& ar) { ar(SubChunkIndex, Changes); }
+	};
+
+	/// @brief Blocks changed in one chunk, grouped by subchunk, with a palette of the new block states.
+	struct ChunkDeltaDTO
+	{
+		glm::ivec2 Position{};
+
+		std::vector<BlockStateDTO> Palette; // At most SubChunkDeltaDTO::MAX_PALETTE_SIZE states
+		std::vector<SubChunkDeltaDTO> SubChunks;
+
+		template <class Archive> void serialize(Archive& ar) { ar(Position, Palette, SubChunks); }
+	};
+} // namespace onion::voxel
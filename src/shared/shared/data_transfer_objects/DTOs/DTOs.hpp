@@ -2,6 +2,7 @@
 
 #include "BlockDTO.hpp"
 #include "BlockStateDTO.hpp"
+#include "ChunkDeltaDTO.hpp"
 #include "ChunkDTO.hpp"
 #include "EntityDTO.hpp"
 #include "ExperienceDTO.hpp"
@@ -1,7 +1,61 @@
 #include "SerializerDTO.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+
+#include <shared/profiler/Profiler.hpp>
+#include <shared/utils/Utils.hpp>
+
 namespace onion::voxel
 {
+	namespace
+	{
+		/// @brief Reads the values of a cereal binary archive from a memory buffer (native endianness, no padding).
+		class BinaryReader
+		{
+		  public:
+			BinaryReader(const uint8_t* data, size_t size) : m_Data(data), m_Size(size) {}
+
+			template <typename T> T Read()
+			{
+				T value;
+				std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+				return value;
+			}
+
+			// Cereal writes container sizes as uint64_t
+			size_t ReadSize() { return static_cast<size_t>(Read<uint64_t>()); }
+
+			/// @brief Get a pointer to the next bytes and skip them.
+			const uint8_t* Take(size_t bytes)
+			{
+				if (bytes > m_Size - m_Offset)
+					throw std::runtime_error("Chunk data is truncated");
+
+				const uint8_t* ptr = m_Data + m_Offset;
+				m_Offset += bytes;
+				return ptr;
+			}
+
+			size_t GetRemaining() const { return m_Size - m_Offset; }
+
+		  private:
+			const uint8_t* m_Data;
+			size_t m_Size;
+			size_t m_Offset = 0;
+		};
+
+		constexpr size_t SUBCHUNK_VOLUME =
+			WorldConstants::CHUNK_SIZE * WorldConstants::CHUNK_SIZE * WorldConstants::CHUNK_SIZE;
+
+		// compressionType + monoIndex + indices size + rleData size
+		constexpr size_t MIN_SUBCHUNK_BYTES = sizeof(uint8_t) + sizeof(uint16_t) + 2 * sizeof(uint64_t);
+		// id + variantIndex
+		constexpr size_t BLOCKSTATE_BYTES = sizeof(uint16_t) + sizeof(uint8_t);
+	} // namespace
+
 	SubChunkDTO SerializerDTO::SerializeSubChunk(const SubChunk& sc)
 	{
 		SubChunkDTO dto;
@@ -101,6 +155,8 @@ namespace onion::voxel
 
 	ChunkDTO SerializerDTO::SerializeChunk(std::shared_ptr<Chunk> chunk)
 	{
+		ONION_PROFILE_ZONE("SerializerDTO::SerializeChunk");
+
 		std::shared_lock lock(chunk->m_Mutex);
 
 		ChunkDTO dto;
@@ -125,6 +181,8 @@ namespace onion::voxel
 
 	std::shared_ptr<Chunk> SerializerDTO::DeserializeChunk(const ChunkDTO& dto)
 	{
+		ONION_PROFILE_ZONE("SerializerDTO::DeserializeChunk");
+
 		auto chunk = std::make_shared<Chunk>(dto.Position);
 
 		{
@@ -148,6 +206,89 @@ namespace onion::voxel
 		return chunk;
 	};
 
+	std::shared_ptr<Chunk> SerializerDTO::DecodeChunk(const uint8_t* data, size_t size)
+	{
+		ONION_PROFILE_ZONE("SerializerDTO::DecodeChunk");
+
+		BinaryReader reader(data, size);
+
+		glm::ivec2 position;
+		position.x = reader.Read<int32_t>();
+		position.y = reader.Read<int32_t>();
+
+		const size_t subChunkCount = reader.ReadSize();
+		if (subChunkCount > reader.GetRemaining() / MIN_SUBCHUNK_BYTES)
+			throw std::runtime_error("Invalid subchunk count in chunk data");
+
+		auto chunk = std::make_shared<Chunk>(position, subChunkCount);
+
+		std::unique_lock lock(chunk->m_Mutex);
+
+		for (SubChunk& sc : chunk->m_SubChunks)
+		{
+			const auto compressionType = static_cast<SubChunkDTO::eCompressionType>(reader.Read<uint8_t>());
+			sc.m_MonoBlockIndexInPalette = reader.Read<uint16_t>();
+			sc.m_IsMonoBlock = compressionType == SubChunkDTO::MonoIndex;
+
+			const size_t indicesCount = reader.ReadSize();
+			if (indicesCount > reader.GetRemaining() / sizeof(uint16_t))
+				throw std::runtime_error("Chunk data is truncated");
+			const uint8_t* indices = reader.Take(indicesCount * sizeof(uint16_t));
+
+			const size_t rleCount = reader.ReadSize();
+			if (rleCount > reader.GetRemaining() / sizeof(uint16_t))
+				throw std::runtime_error("Chunk data is truncated");
+			const uint8_t* rleData = reader.Take(rleCount * sizeof(uint16_t));
+
+			if (sc.m_IsMonoBlock)
+				continue;
+
+			sc.m_BlockIndexInPalette = std::make_shared<std::array<uint16_t, SUBCHUNK_VOLUME>>();
+			uint16_t* arr = sc.m_BlockIndexInPalette->data();
+
+			if (compressionType == SubChunkDTO::None)
+			{
+				if (indicesCount != SUBCHUNK_VOLUME)
+					throw std::runtime_error("Invalid subchunk size in chunk data");
+
+				std::memcpy(arr, indices, SUBCHUNK_VOLUME * sizeof(uint16_t));
+			}
+			else if (compressionType == SubChunkDTO::RLE)
+			{
+				size_t writeIndex = 0;
+
+				for (size_t i = 0; i + 1 < rleCount; i += 2)
+				{
+					uint16_t run[2]; // [count, indexInPalette]
+					std::memcpy(run, rleData + i * sizeof(uint16_t), sizeof(run));
+
+					if (run[0] > SUBCHUNK_VOLUME - writeIndex)
+						throw std::runtime_error("Invalid run length in chunk data");
+
+					std::fill_n(arr + writeIndex, run[0], run[1]);
+					writeIndex += run[0];
+				}
+			}
+		}
+
+		const size_t paletteSize = reader.ReadSize();
+		if (paletteSize > reader.GetRemaining() / BLOCKSTATE_BYTES)
+			throw std::runtime_error("Invalid palette size in chunk data");
+
+		chunk->m_BlocksPalette.clear();
+		chunk->m_BlocksPalette.reserve(paletteSize);
+
+		for (size_t i = 0; i < paletteSize; i++)
+		{
+			BlockState block;
+			block.ID = (BlockId) reader.Read<uint16_t>();
+			block.VariantIndex = reader.Read<uint8_t>();
+			chunk->m_BlocksPalette.emplace_back(block);
+		}
+
+		return chunk;
+	}
+
 	BlockStateDTO SerializerDTO::SerializeBlockState(const BlockState& block)
 	{
 		BlockStateDTO dto;
@@ -184,6 +325,78 @@ namespace onion::voxel
 		return block;
 	}
 
+	ChunkDeltaDTO SerializerDTO::SerializeChunkDelta(const glm::ivec2& chunkPosition, const std::vector<Block>& blocks)
+	{
+		constexpr uint32_t CS = WorldConstants::CHUNK_SIZE;
+
+		ChunkDeltaDTO dto;
+		dto.Position = chunkPosition;
+
+		// Key : (id << 8) | variantIndex
+		std::unordered_map<uint32_t, uint32_t> paletteIndices;
+		// Ordered by subchunk index
+		std::map<uint16_t, SubChunkDeltaDTO> subChunks;
+
+		for (const Block& block : blocks)
+		{
+			if (block.Position.y < 0 || Utils::WorldToChunkPosition(block.Position) != chunkPosition)
+				continue;
+
+			const uint32_t key = (static_cast<uint32_t>(block.State.ID) << 8) | block.State.VariantIndex;
+			auto [itPalette, inserted] = paletteIndices.try_emplace(key, static_cast<uint32_t>(dto.Palette.size()));
+			if (inserted)
+			{
+				dto.Palette.emplace_back(SerializeBlockState(block.State));
+			}
+
+			const glm::ivec3 localPosition = Utils::WorldToLocalPosition(block.Position);
+			const uint16_t subChunkIndex = static_cast<uint16_t>(localPosition.y / CS);
+			const uint32_t localIndex = static_cast<uint32_t>(localPosition.x) +
+				static_cast<uint32_t>(localPosition.y % CS) * CS + static_cast<uint32_t>(localPosition.z) * CS * CS;
+
+			SubChunkDeltaDTO& subChunk = subChunks[subChunkIndex];
+			subChunk.SubChunkIndex = subChunkIndex;
+			subChunk.Changes.push_back(SubChunkDeltaDTO::PackChange(localIndex, itPalette->second));
+		}
+
+		dto.SubChunks.reserve(subChunks.size());
+		for (auto& [index, subChunk] : subChunks)
+		{
+			dto.SubChunks.emplace_back(std::move(subChunk));
+		}
+
+		return dto;
+	}
+
+	std::vector<Block> SerializerDTO::DeserializeChunkDelta(const ChunkDeltaDTO& dto)
+	{
+		constexpr uint32_t CS = WorldConstants::CHUNK_SIZE;
+
+		std::vector<Block> blocks;
+
+		for (const SubChunkDeltaDTO& subChunk : dto.SubChunks)
+		{
+			for (uint32_t change : subChunk.Changes)
+			{
+				const uint32_t paletteIndex = SubChunkDeltaDTO::GetPaletteIndex(change);
+				const uint32_t localIndex = SubChunkDeltaDTO::GetLocalIndex(change);
+				if (paletteIndex >= dto.Palette.size() || localIndex >= CS * CS * CS)
+					continue;
+
+				const glm::ivec3 localPosition(static_cast<int>(localIndex % CS),
+											   static_cast<int>(subChunk.SubChunkIndex * CS + (localIndex / CS) % CS),
+											   static_cast<int>(localIndex / (CS * CS)));
+
+				Block block;
+				block.Position = Utils::LocalToWorldPosition(localPosition, dto.Position);
+				block.State = DeserializeBlockState(dto.Palette[paletteIndex]);
+				blocks.emplace_back(block);
+			}
+		}
+
+		return blocks;
+	}
+
 	OutOfBoundsBlocksDTO SerializerDTO::SerializeOutOfBoundsBlocks(
 		const std::unordered_map<glm::ivec2, std::vector<Block>>& outOfBoundsBlocks)
 	{
@@ -371,6 +584,54 @@ namespace onion::voxel
 		return dto;
 	}
 
+	std::vector<EntityDTO> SerializerDTO::SerializeEntities(const EntityStore& store)
+	{
+		std::shared_lock lock(store.GetMutex());
+
+		std::vector<EntityDTO> dtos;
+		dtos.reserve(store.GetEntityCount());
+
+		// Entity index -> position in dtos, to fill the components array by array
+		std::vector<uint32_t> dtoOfEntity(store.GetIndexCount(), UINT32_MAX);
+
+		for (uint32_t index = 0; index < store.GetIndexCount(); index++)
+		{
+			const EntityStore::EntityRecord& record = store.GetRecord(index);
+			if (!record.Alive || record.Type == EntityType::Player)
+				continue;
+
+			dtoOfEntity[index] = static_cast<uint32_t>(dtos.size());
+
+			EntityDTO& dto = dtos.emplace_back();
+			dto.Type = static_cast<int>(record.Type);
+			dto.UUID = record.UUID;
+			dto.State = record.State;
+		}
+
+		auto serializeArray = [&dtos, &dtoOfEntity](const auto& array, auto member, auto serialize)
+		{
+			const auto& components = array.GetComponents();
+			const std::vector<uint32_t>& owners = array.GetOwners();
+
+			for (size_t slot = 0; slot < components.size(); slot++)
+			{
+				const uint32_t dto = dtoOfEntity[owners[slot]];
+				if (dto != UINT32_MAX)
+					dtos[dto].*member = serialize(components[slot]);
+			}
+		};
+
+		serializeArray(store.PhysicsBodies(), &EntityDTO::PhysicsBody, &SerializePhysicsBody);
+		serializeArray(store.Transforms(), &EntityDTO::Transform, &SerializeTransform);
+		serializeArray(store.Healths(), &EntityDTO::Health, &SerializeHealth);
+		serializeArray(store.Hungers(), &EntityDTO::Hunger, &SerializeHunger);
+		serializeArray(store.Experiences(), &EntityDTO::Experience, &SerializeExperience);
+		serializeArray(store.Hotbars(), &EntityDTO::Hotbar, &SerializeInventory);
+		serializeArray(store.PlayerInventories(), &EntityDTO::Inventory, &SerializeInventory);
+
+		return dtos;
+	}
+
 	std::shared_ptr<Entity> SerializerDTO::DeserializeEntity(const EntityDTO& dto)
 	{
 		auto entity = std::make_shared<Entity>(static_cast<EntityType>(dto.Type), dto.UUID);
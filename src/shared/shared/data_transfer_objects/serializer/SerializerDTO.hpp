@@ -17,6 +17,13 @@ namespace onion::voxel
 		static ChunkDTO SerializeChunk(std::shared_ptr<Chunk> chunk);
 		static std::shared_ptr<Chunk> DeserializeChunk(const ChunkDTO& dto);
 
+		/// @brief Decode a ChunkDTO written by a cereal binary archive straight into a Chunk, without building the
+		/// intermediate ChunkDTO (no SubChunkDTO vectors, no stream). The layout must match ChunkDTO::serialize.
+		/// @param data The serialized ChunkDTO (e.g. a ChunkData packet, after its MessageHeader)
+		/// @param size The size of data in bytes
+		/// @return The decoded chunk. Throws std::runtime_error if the data is truncated or malformed.
+		static std::shared_ptr<Chunk> DecodeChunk(const uint8_t* data, size_t size);
+
 		// ----- SUB CHUNK -----
 	  public:
 		static SubChunkDTO SerializeSubChunk(const SubChunk& sc);
@@ -32,6 +39,14 @@ namespace onion::voxel
 		static BlockDTO SerializeBlock(const Block& block);
 		static Block DeserializeBlock(const BlockDTO& dto);
 
+		// ----- CHUNK DELTA -----
+	  public:
+		/// @brief Pack blocks changed in one chunk, grouped by subchunk.
+		/// @param chunkPosition The chunk containing every block (blocks outside of it or below y = 0 are skipped)
+		/// @param blocks The changed blocks. At most SubChunkDeltaDTO::MAX_PALETTE_SIZE, so the palette cannot overflow.
+		static ChunkDeltaDTO SerializeChunkDelta(const glm::ivec2& chunkPosition, const std::vector<Block>& blocks);
+		static std::vector<Block> DeserializeChunkDelta(const ChunkDeltaDTO& dto);
+
 		// ----- OUT OF BOUNDS BLOCKS -----
 	  public:
 		static OutOfBoundsBlocksDTO
@@ -59,6 +74,8 @@ namespace onion::voxel
 
 		static void ApplyEntityDTO(const EntityDTO& dto, std::shared_ptr<Entity> entity);
 		static EntityDTO SerializeEntity(const Entity& entity);
+		/// @brief Serialize the non-player entities of a store, iterating its arrays under one shared lock.
+		static std::vector<EntityDTO> SerializeEntities(const EntityStore& store);
 		static std::shared_ptr<Entity> DeserializeEntity(const EntityDTO& dto);
 		static PlayerDTO SerializePlayer(const Player& player);
 		static std::shared_ptr<Player> DeserializePlayer(const PlayerDTO& dto);
@@ -5,204 +5,313 @@
 
 namespace onion::voxel
 {
-	Entity::Entity(EntityType type, const std::string& uuid) : Type(type), UUID(uuid) {}
-
-	Entity::~Entity() {}
+	Entity::Entity(EntityType type, const std::string& uuid)
+		: Type(type), UUID(uuid), m_Store(std::make_shared<EntityStore>())
+	{
+		m_Handle = m_Store->Create(type, uuid);
+	}
 
-	PhysicsBody Entity::GetPhysicsBody() const
+	Entity::~Entity()
 	{
-		std::shared_lock lock(m_MutexPhysicsBody);
-		assert(m_PhysicsBody.has_value() && "Entity must have a PhysicsBody component to get it.");
-		return *m_PhysicsBody;
+		std::unique_lock lock(m_Store->GetMutex());
+		m_Store->Destroy(m_Handle);
 	}
 
-	Transform Entity::GetTransform() const
+	template <typename Function> auto Entity::ReadStore(Function&& function) const
 	{
-		std::shared_lock lock(m_MutexTransform);
-		assert(m_Transform.has_value() && "Entity must have a Transform component to get it.");
-		return *m_Transform;
+		std::shared_lock lockBinding(m_MutexBinding);
+		std::shared_lock lockStore(m_Store->GetMutex());
+		return function(static_cast<const EntityStore&>(*m_Store), m_Handle.Index);
 	}
 
-	glm::vec3 Entity::GetPosition() const
+	template <typename Function> auto Entity::WriteStore(Function&& function) const
 	{
-		std::shared_lock lock(m_MutexTransform);
-		assert(m_Transform.has_value() && "Entity must have a Transform component to get its position.");
-		return m_Transform->Position;
+		std::shared_lock lockBinding(m_MutexBinding);
+		std::unique_lock lockStore(m_Store->GetMutex());
+		return function(*m_Store, m_Handle.Index);
 	}
 
-	glm::vec3 Entity::GetFacing() const
+	// ----- Store -----
+
+	void Entity::BindToStore(const std::shared_ptr<EntityStore>& store)
 	{
-		std::shared_lock lock(m_MutexTransform);
-		assert(m_Transform.has_value() && "Entity must have a Transform component to get its facing direction.");
+		std::unique_lock lockBinding(m_MutexBinding);
 
-		float yaw = m_Transform->Rotation.y;
-		float pitch = m_Transform->Rotation.x;
+		if (!store || store == m_Store)
+			return;
 
-		glm::vec3 facing;
-		facing.x = cos(glm::radians(yaw)) * cos(glm::radians(pitch));
-		facing.y = sin(glm::radians(pitch));
-		facing.z = sin(glm::radians(yaw)) * cos(glm::radians(pitch));
-		return glm::normalize(facing);
+		std::scoped_lock lockStores(m_Store->GetMutex(), store->GetMutex());
+
+		const uint32_t from = m_Handle.Index;
+		const EntityHandle handle = store->Create(Type, UUID);
+		store->SetState(handle.Index, m_Store->GetRecord(from).State);
+
+		auto moveComponent = [from, to = handle.Index](auto& source, auto& destination)
+		{
+			if (const auto* component = source.Find(from))
+				destination.Set(to, *component);
+		};
+
+		moveComponent(m_Store->Transforms(), store->Transforms());
+		moveComponent(m_Store->PhysicsBodies(), store->PhysicsBodies());
+		moveComponent(m_Store->Healths(), store->Healths());
+		moveComponent(m_Store->Hungers(), store->Hungers());
+		moveComponent(m_Store->Experiences(), store->Experiences());
+		moveComponent(m_Store->PlayerInventories(), store->PlayerInventories());
+		moveComponent(m_Store->Hotbars(), store->Hotbars());
+
+		m_Store->Destroy(m_Handle);
+
+		m_Store = store;
+		m_Handle = handle;
 	}
 
-	bool Entity::HasPhysicsBody() const
+	std::shared_ptr<EntityStore> Entity::GetStore() const
 	{
-		std::shared_lock lock(m_MutexPhysicsBody);
-		return m_PhysicsBody.has_value();
+		std::shared_lock lock(m_MutexBinding);
+		return m_Store;
 	}
 
-	void Entity::SetPhysicsBody(const PhysicsBody& physicsBody)
+	EntityHandle Entity::GetHandle() const
 	{
-		std::unique_lock lock(m_MutexPhysicsBody);
-		m_PhysicsBody = physicsBody;
+		std::shared_lock lock(m_MutexBinding);
+		return m_Handle;
 	}
 
+	// ----- Transform -----
+
 	bool Entity::HasTransform() const
 	{
-		std::shared_lock lock(m_MutexTransform);
-		return m_Transform.has_value();
+		return ReadStore([](const EntityStore& store, uint32_t index) { return store.Transforms().Has(index); });
+	}
+
+	Transform Entity::GetTransform() const
+	{
+		return ReadStore(
+			[](const EntityStore& store, uint32_t index)
+			{
+				const Transform* transform = store.Transforms().Find(index);
+				assert(transform && "Entity must have a Transform component to get it.");
+				return *transform;
+			});
 	}
 
 	void Entity::SetTransform(const Transform& transform)
 	{
-		std::unique_lock lock(m_MutexTransform);
-		m_Transform = transform;
+		WriteStore([&transform](EntityStore& store, uint32_t index) { store.Transforms().Set(index, transform); });
+	}
+
+	glm::vec3 Entity::GetPosition() const
+	{
+		return ReadStore(
+			[](const EntityStore& store, uint32_t index)
+			{
+				const Transform* transform = store.Transforms().Find(index);
+				assert(transform && "Entity must have a Transform component to get its position.");
+				return transform->Position;
+			});
 	}
 
 	void Entity::SetPosition(const glm::vec3& position)
 	{
-		std::unique_lock lock(m_MutexTransform);
-		assert(m_Transform.has_value() && "Entity must have a Transform component to set its position.");
-		m_Transform->Position = position;
+		WriteStore(
+			[&position](EntityStore& store, uint32_t index)
+			{
+				Transform* transform = store.Transforms().Find(index);
+				assert(transform && "Entity must have a Transform component to set its position.");
+				transform->Position = position;
+			});
 	}
 
-	void Entity::SetFacing(const glm::vec3& facing)
+	glm::vec3 Entity::GetFacing() const
 	{
-		std::unique_lock lock(m_MutexTransform);
-		assert(m_Transform.has_value() && "Entity must have a Transform component to set its facing direction.");
+		const glm::vec3 rotation = ReadStore(
+			[](const EntityStore& store, uint32_t index)
+			{
+				const Transform* transform = store.Transforms().Find(index);
+				assert(transform && "Entity must have a Transform component to get its facing direction.");
+				return transform->Rotation;
+			});
+
+		float yaw = rotation.y;
+		float pitch = rotation.x;
+
+		glm::vec3 facing;
+		facing.x = cos(glm::radians(yaw)) * cos(glm::radians(pitch));
+		facing.y = sin(glm::radians(pitch));
+		facing.z = sin(glm::radians(yaw)) * cos(glm::radians(pitch));
+		return glm::normalize(facing);
+	}
 
+	void Entity::SetFacing(const glm::vec3& facing)
+	{
 		// Calculate yaw and pitch from facing direction
 		float yaw = glm::degrees(atan2(facing.z, facing.x));
 		float pitch = glm::degrees(asin(facing.y));
-		m_Transform->Rotation.y = yaw;
-		m_Transform->Rotation.x = pitch;
+
+		WriteStore(
+			[yaw, pitch](EntityStore& store, uint32_t index)
+			{
+				Transform* transform = store.Transforms().Find(index);
+				assert(transform && "Entity must have a Transform component to set its facing direction.");
+				transform->Rotation.y = yaw;
+				transform->Rotation.x = pitch;
+			});
 	}
 
+	// ----- State -----
+
 	Entity::State Entity::GetState() const
 	{
-		std::shared_lock lock(m_Mutex);
-		return m_State;
+		return ReadStore([](const EntityStore& store, uint32_t index)
+						 { return static_cast<State>(store.GetRecord(index).State); });
 	}
 
 	void Entity::SetState(const State state)
 	{
-		std::unique_lock lock(m_Mutex);
-		m_State = state;
+		WriteStore([state](EntityStore& store, uint32_t index)
+				   { store.SetState(index, static_cast<uint8_t>(state)); });
+	}
+
+	// ----- PhysicsBody -----
+
+	bool Entity::HasPhysicsBody() const
+	{
+		return ReadStore([](const EntityStore& store, uint32_t index) { return store.PhysicsBodies().Has(index); });
+	}
+
+	PhysicsBody Entity::GetPhysicsBody() const
+	{
+		return ReadStore(
+			[](const EntityStore& store, uint32_t index)
+			{
+				const PhysicsBody* physicsBody = store.PhysicsBodies().Find(index);
+				assert(physicsBody && "Entity must have a PhysicsBody component to get it.");
+				return *physicsBody;
+			});
+	}
+
+	void Entity::SetPhysicsBody(const PhysicsBody& physicsBody)
+	{
+		WriteStore([&physicsBody](EntityStore& store, uint32_t index)
+				   { store.PhysicsBodies().Set(index, physicsBody); });
 	}
 
 	// ----- Health -----
 
 	bool Entity::HasHealth() const
 	{
-		std::shared_lock lock(m_MutexHealth);
-		return m_Health.has_value();
+		return ReadStore([](const EntityStore& store, uint32_t index) { return store.Healths().Has(index); });
 	}
 
 	Health Entity::GetHealth() const
 	{
-		std::shared_lock lock(m_MutexHealth);
-		assert(m_Health.has_value() && "Entity must have a Health component to get it.");
-		return *m_Health;
+		return ReadStore(
+			[](const EntityStore& store, uint32_t index)
+			{
+				const Health* health = store.Healths().Find(index);
+				assert(health && "Entity must have a Health component to get it.");
+				return *health;
+			});
 	}
 
 	void Entity::SetHealth(const Health& health)
 	{
-		std::unique_lock lock(m_MutexHealth);
-		m_Health = health;
+		WriteStore([&health](EntityStore& store, uint32_t index) { store.Healths().Set(index, health); });
 	}
 
 	// ----- Hunger -----
 
 	bool Entity::HasHunger() const
 	{
-		std::shared_lock lock(m_MutexHunger);
-		return m_Hunger.has_value();
+		return ReadStore([](const EntityStore& store, uint32_t index) { return store.Hungers().Has(index); });
 	}
 
 	Hunger Entity::GetHunger() const
 	{
-		std::shared_lock lock(m_MutexHunger);
-		assert(m_Hunger.has_value() && "Entity must have a Hunger component to get it.");
-		return *m_Hunger;
+		return ReadStore(
+			[](const EntityStore& store, uint32_t index)
+			{
+				const Hunger* hunger = store.Hungers().Find(index);
+				assert(hunger && "Entity must have a Hunger component to get it.");
+				return *hunger;
+			});
 	}
 
 	void Entity::SetHunger(const Hunger& hunger)
 	{
-		std::unique_lock lock(m_MutexHunger);
-		m_Hunger = hunger;
+		WriteStore([&hunger](EntityStore& store, uint32_t index) { store.Hungers().Set(index, hunger); });
 	}
 
 	// ----- Experience -----
 
 	bool Entity::HasExperience() const
 	{
-		std::shared_lock lock(m_MutexExperience);
-		return m_Experience.has_value();
+		return ReadStore([](const EntityStore& store, uint32_t index) { return store.Experiences().Has(index); });
 	}
 
 	Experience Entity::GetExperience() const
 	{
-		std::shared_lock lock(m_MutexExperience);
-		assert(m_Experience.has_value() && "Entity must have an Experience component to get it.");
-		return *m_Experience;
+		return ReadStore(
+			[](const EntityStore& store, uint32_t index)
+			{
+				const Experience* experience = store.Experiences().Find(index);
+				assert(experience && "Entity must have an Experience component to get it.");
+				return *experience;
+			});
 	}
 
 	void Entity::SetExperience(const Experience& experience)
 	{
-		std::unique_lock lock(m_MutexExperience);
-		m_Experience = experience;
+		WriteStore([&experience](EntityStore& store, uint32_t index) { store.Experiences().Set(index, experience); });
 	}
 
 	// ----- Inventory -----
 
 	bool Entity::HasPlayerInventory() const
 	{
-		std::shared_lock lock(m_MutexPlayerInventory);
-		return m_PlayerInventory.has_value();
+		return ReadStore([](const EntityStore& store, uint32_t index)
+						 { return store.PlayerInventories().Has(index); });
 	}
 
 	Inventory Entity::GetPlayerInventory() const
 	{
-		std::shared_lock lock(m_MutexPlayerInventory);
-		assert(m_PlayerInventory.has_value() && "Entity must have a PlayerInventory component to get it.");
-		return *m_PlayerInventory;
+		return ReadStore(
+			[](const EntityStore& store, uint32_t index)
+			{
+				const Inventory* inventory = store.PlayerInventories().Find(index);
+				assert(inventory && "Entity must have a PlayerInventory component to get it.");
+				return *inventory;
+			});
 	}
 
 	void Entity::SetPlayerInventory(const Inventory& inventory)
 	{
-		std::unique_lock lock(m_MutexPlayerInventory);
-		m_PlayerInventory = inventory;
+		WriteStore([&inventory](EntityStore& store, uint32_t index)
+				   { store.PlayerInventories().Set(index, inventory); });
 	}
 
 	// ----- Hotbar -----
 
 	bool Entity::HasHotbar() const
 	{
-		std::shared_lock lock(m_MutexHotbar);
-		return m_Hotbar.has_value();
+		return ReadStore([](const EntityStore& store, uint32_t index) { return store.Hotbars().Has(index); });
 	}
 
 	Inventory Entity::GetHotbar() const
 	{
-		std::shared_lock lock(m_MutexHotbar);
-		assert(m_Hotbar.has_value() && "Entity must have a Hotbar component to get it.");
-		return *m_Hotbar;
+		return ReadStore(
+			[](const EntityStore& store, uint32_t index)
+			{
+				const Inventory* hotbar = store.Hotbars().Find(index);
+				assert(hotbar && "Entity must have a Hotbar component to get it.");
+				return *hotbar;
+			});
 	}
 
 	void Entity::SetHotbar(const Inventory& hotbar)
 	{
-		std::unique_lock lock(m_MutexHotbar);
-		m_Hotbar = hotbar;
+		WriteStore([&hotbar](EntityStore& store, uint32_t index) { store.Hotbars().Set(index, hotbar); });
 	}
 
 } // namespace onion::voxel
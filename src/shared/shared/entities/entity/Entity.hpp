@@ -2,7 +2,7 @@
 
 #include <glm/glm.hpp>
 
-#include <optional>
+#include <memory>
 #include <shared_mutex>
 #include <string>
 
@@ -14,9 +14,12 @@
 #include <shared/entities/components/Inventory.hpp>
 #include <shared/entities/components/PhysicsBody.hpp>
 #include <shared/entities/components/Transform.hpp>
+#include <shared/entities/entity_store/EntityStore.hpp>
 
 namespace onion::voxel
 {
+	/// @brief Façade over an entity record of an EntityStore.
+	/// Each call locks the store : systems processing many entities iterate the store's arrays instead.
 	class Entity
 	{
 		// ----- Enums -----
@@ -81,30 +84,25 @@ namespace onion::voxel
 		State GetState() const;
 		void SetState(const State state);
 
-		// ----- Private Members -----
-	  private:
-		mutable std::shared_mutex m_Mutex;
-		State m_State = State::Idle;
-
-		mutable std::shared_mutex m_MutexPhysicsBody;
-		std::optional<PhysicsBody> m_PhysicsBody;
-
-		mutable std::shared_mutex m_MutexTransform;
-		std::optional<Transform> m_Transform;
-
-		mutable std::shared_mutex m_MutexHealth;
-		std::optional<Health> m_Health;
-
-		mutable std::shared_mutex m_MutexHunger;
-		std::optional<Hunger> m_Hunger;
+		// ----- Store -----
+	  public:
+		/// @brief Move the entity's components into another store (e.g. the EntityManager's one).
+		/// A new entity is created in its own store until it is bound to another one.
+		void BindToStore(const std::shared_ptr<EntityStore>& store);
 
-		mutable std::shared_mutex m_MutexExperience;
-		std::optional<Experience> m_Experience;
+		std::shared_ptr<EntityStore> GetStore() const;
+		EntityHandle GetHandle() const;
 
-		mutable std::shared_mutex m_MutexPlayerInventory;
-		std::optional<Inventory> m_PlayerInventory;
+		// ----- Private Members -----
+	  private:
+		// Guards the binding (m_Store, m_Handle), taken before the store mutex
+		mutable std::shared_mutex m_MutexBinding;
+		std::shared_ptr<EntityStore> m_Store;
+		EntityHandle m_Handle;
 
-		mutable std::shared_mutex m_MutexHotbar;
-		std::optional<Inventory> m_Hotbar;
+		// ----- Private Methods -----
+	  private:
+		template <typename Function> auto ReadStore(Function&& function) const;
+		template <typename Function> auto WriteStore(Function&& function) const;
 	};
 } // namespace onion::voxel
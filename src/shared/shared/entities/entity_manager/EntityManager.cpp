@@ -1,9 +1,41 @@
 #include "EntityManager.hpp"
 
+#include <algorithm>
+#include <cstdlib>
 #include <stdexcept>
 
+#include <shared/utils/Utils.hpp>
+
 namespace onion::voxel
 {
+	namespace
+	{
+		glm::ivec2 ToChunkPosition(const glm::vec3& position)
+		{
+			return Utils::WorldToChunkPosition(glm::ivec3(glm::floor(position)));
+		}
+
+		void EraseFromBucket(std::unordered_map<glm::ivec2, std::vector<std::string>>& buckets,
+							 const glm::ivec2& chunkPosition,
+							 const std::string& uuid)
+		{
+			auto it = buckets.find(chunkPosition);
+			if (it == buckets.end())
+				return;
+
+			std::vector<std::string>& bucket = it->second;
+			auto uuidIt = std::find(bucket.begin(), bucket.end(), uuid);
+			if (uuidIt != bucket.end())
+			{
+				*uuidIt = std::move(bucket.back());
+				bucket.pop_back();
+			}
+
+			if (bucket.empty())
+				buckets.erase(it);
+		}
+	} // namespace
+
 	EntityManager::EntityManager() = default;
 	EntityManager::~EntityManager() = default;
 
@@ -34,6 +66,14 @@ namespace onion::voxel
 			m_Players[player->UUID] = player;
 		}
 
+		player->BindToStore(m_EntityStore);
+
+		const glm::ivec2 chunkPosition = ToChunkPosition(player->GetPosition());
+		{
+			std::unique_lock lock(m_MutexSpatialIndex);
+			IndexPlayer_Unsafe(player->UUID, chunkPosition);
+		}
+
 		EvtPlayerAdded.Trigger(player);
 	}
 
@@ -45,6 +85,10 @@ namespace onion::voxel
 		{
 			auto player = it->second; // Store player before erasing to trigger event after unlocking
 			m_Players.erase(it);
+			{
+				std::unique_lock lockIndex(m_MutexSpatialIndex);
+				UnindexPlayer_Unsafe(uuid);
+			}
 			lock.unlock(); // Unlock before triggering event to avoid potential deadlocks
 			EvtPlayerRemoved.Trigger(player);
 			return true;
@@ -84,6 +128,9 @@ namespace onion::voxel
 		if (it != m_Players.end())
 		{
 			it->second->SetPosition(newPosition);
+
+			std::unique_lock lockIndex(m_MutexSpatialIndex);
+			IndexPlayer_Unsafe(uuid, ToChunkPosition(newPosition));
 		}
 		else
 		{
@@ -98,6 +145,8 @@ namespace onion::voxel
 
 		for (const auto& entity : entities)
 		{
+			entity->BindToStore(m_EntityStore);
+
 			if (entity->Type == EntityType::Player)
 			{
 				// Update player information
@@ -105,6 +154,10 @@ namespace onion::voxel
 				if (player)
 				{
 					m_Players[player->UUID] = player;
+
+					const glm::ivec2 chunkPosition = ToChunkPosition(player->GetPosition());
+					std::unique_lock lockIndex(m_MutexSpatialIndex);
+					IndexPlayer_Unsafe(player->UUID, chunkPosition);
 				}
 			}
 			else
@@ -140,6 +193,11 @@ namespace onion::voxel
 		return m_Entities;
 	}
 
+	std::shared_ptr<EntityStore> EntityManager::GetEntityStore() const
+	{
+		return m_EntityStore;
+	}
+
 	void EntityManager::ClearAllEntities()
 	{
 		// Backups entities before clearing so they can be used to trigger events after unlocking
@@ -150,6 +208,16 @@ namespace onion::voxel
 			std::unique_lock lockPlayers(m_MutexPlayers);
 			m_Players.clear();
 			m_Entities.clear();
+
+			std::unique_lock lockIndex(m_MutexSpatialIndex);
+			m_PlayerChunks.clear();
+			m_PlayersByChunk.clear();
+
+			for (const auto& [chunkPosition, count] : m_InterestCoverage)
+			{
+				m_InterestChanges.Left.push_back(chunkPosition);
+			}
+			m_InterestCoverage.clear();
 		}
 
 		for (const auto& [uuid, player] : playersRemoved)
@@ -164,4 +232,235 @@ namespace onion::voxel
 		return m_Players.find(uuid) != m_Players.end();
 	}
 
+	uint8_t EntityManager::GetInterestDistance() const
+	{
+		std::shared_lock lock(m_MutexSpatialIndex);
+		return m_InterestDistance;
+	}
+
+	void EntityManager::SetInterestDistance(uint8_t distance)
+	{
+		std::unique_lock lock(m_MutexSpatialIndex);
+		if (distance == m_InterestDistance)
+			return;
+
+		m_InterestDistance = distance;
+
+		// Rebuild the coverage with the new area size, then report the difference with the previous one
+		const std::unordered_map<glm::ivec2, uint32_t> previousCoverage = std::move(m_InterestCoverage);
+		m_InterestCoverage.clear();
+
+		InterestChanges pendingChanges = std::move(m_InterestChanges);
+		for (const auto& [uuid, chunkPosition] : m_PlayerChunks)
+		{
+			AddInterestCoverage_Unsafe(chunkPosition, nullptr, 1);
+		}
+		m_InterestChanges = std::move(pendingChanges);
+
+		for (const auto& [chunkPosition, count] : m_InterestCoverage)
+		{
+			if (previousCoverage.find(chunkPosition) == previousCoverage.end())
+				m_InterestChanges.Entered.push_back(chunkPosition);
+		}
+
+		for (const auto& [chunkPosition, count] : previousCoverage)
+		{
+			if (m_InterestCoverage.find(chunkPosition) == m_InterestCoverage.end())
+				m_InterestChanges.Left.push_back(chunkPosition);
+		}
+	}
+
+	std::vector<std::string> EntityManager::GetPlayersInChunk(const glm::ivec2& chunkPosition) const
+	{
+		std::shared_lock lock(m_MutexSpatialIndex);
+		auto it = m_PlayersByChunk.find(chunkPosition);
+		if (it == m_PlayersByChunk.end())
+			return {};
+
+		return it->second;
+	}
+
+	std::vector<std::string> EntityManager::GetPlayersNearChunk(const glm::ivec2& chunkPosition, int distance) const
+	{
+		std::vector<std::string> players;
+		if (distance < 0)
+			return players;
+
+		std::shared_lock lock(m_MutexSpatialIndex);
+
+		// Walk whichever is smaller : the chunks of the area, or the occupied chunks
+		const size_t side = 2 * static_cast<size_t>(distance) + 1;
+		if (side * side <= m_PlayersByChunk.size())
+		{
+			for (int x = -distance; x <= distance; x++)
+			{
+				for (int y = -distance; y <= distance; y++)
+				{
+					auto it = m_PlayersByChunk.find(chunkPosition + glm::ivec2(x, y));
+					if (it != m_PlayersByChunk.end())
+						players.insert(players.end(), it->second.begin(), it->second.end());
+				}
+			}
+		}
+		else
+		{
+			for (const auto& [bucketPosition, bucket] : m_PlayersByChunk)
+			{
+				if (std::abs(bucketPosition.x - chunkPosition.x) <= distance &&
+					std::abs(bucketPosition.y - chunkPosition.y) <= distance)
+				{
+					players.insert(players.end(), bucket.begin(), bucket.end());
+				}
+			}
+		}
+
+		return players;
+	}
+
+	bool EntityManager::IsInInterestArea(const glm::ivec2& chunkPosition) const
+	{
+		std::shared_lock lock(m_MutexSpatialIndex);
+		return m_InterestCoverage.find(chunkPosition) != m_InterestCoverage.end();
+	}
+
+	std::vector<glm::ivec2> EntityManager::GetInterestArea() const
+	{
+		std::shared_lock lock(m_MutexSpatialIndex);
+
+		std::vector<glm::ivec2> area;
+		area.reserve(m_InterestCoverage.size());
+		for (const auto& [chunkPosition, count] : m_InterestCoverage)
+		{
+			area.push_back(chunkPosition);
+		}
+
+		return area;
+	}
+
+	EntityManager::InterestChanges EntityManager::TakeInterestChanges()
+	{
+		std::unique_lock lock(m_MutexSpatialIndex);
+
+		InterestChanges changes = std::move(m_InterestChanges);
+		m_InterestChanges = {};
+		return changes;
+	}
+
+	void EntityManager::RefreshPlayerChunk(const std::string& uuid)
+	{
+		std::shared_lock lock(m_MutexPlayers);
+		auto it = m_Players.find(uuid);
+		if (it == m_Players.end())
+			return;
+
+		const glm::ivec2 chunkPosition = ToChunkPosition(it->second->GetPosition());
+
+		std::unique_lock lockIndex(m_MutexSpatialIndex);
+		IndexPlayer_Unsafe(uuid, chunkPosition);
+	}
+
+	void EntityManager::RefreshAllPlayerChunks()
+	{
+		std::shared_lock lock(m_MutexPlayers);
+
+		std::vector<std::pair<std::string, glm::ivec2>> chunkPositions;
+		chunkPositions.reserve(m_Players.size());
+		for (const auto& [uuid, player] : m_Players)
+		{
+			chunkPositions.emplace_back(uuid, ToChunkPosition(player->GetPosition()));
+		}
+
+		std::unique_lock lockIndex(m_MutexSpatialIndex);
+		for (const auto& [uuid, chunkPosition] : chunkPositions)
+		{
+			IndexPlayer_Unsafe(uuid, chunkPosition);
+		}
+	}
+
+	void EntityManager::IndexPlayer_Unsafe(const std::string& uuid, const glm::ivec2& chunkPosition)
+	{
+		auto it = m_PlayerChunks.find(uuid);
+		if (it == m_PlayerChunks.end())
+		{
+			m_PlayerChunks.emplace(uuid, chunkPosition);
+			AddInterestCoverage_Unsafe(chunkPosition, nullptr, 1);
+		}
+		else
+		{
+			if (it->second == chunkPosition)
+				return;
+
+			const glm::ivec2 oldChunkPosition = it->second;
+			it->second = chunkPosition;
+
+			EraseFromBucket(m_PlayersByChunk, oldChunkPosition, uuid);
+			AddInterestCoverage_Unsafe(oldChunkPosition, &chunkPosition, -1);
+			AddInterestCoverage_Unsafe(chunkPosition, &oldChunkPosition, 1);
+		}
+
+		m_PlayersByChunk[chunkPosition].push_back(uuid);
+	}
+
+	void EntityManager::UnindexPlayer_Unsafe(const std::string& uuid)
+	{
+		auto it = m_PlayerChunks.find(uuid);
+		if (it == m_PlayerChunks.end())
+			return;
+
+		EraseFromBucket(m_PlayersByChunk, it->second, uuid);
+		AddInterestCoverage_Unsafe(it->second, nullptr, -1);
+		m_PlayerChunks.erase(it);
+	}
+
+	void EntityManager::AddInterestCoverage_Unsafe(const glm::ivec2& center,
+												   const glm::ivec2* excludedCenter,
+												   int delta)
+	{
+		const int distance = m_InterestDistance;
+
+		auto apply = [this, delta](const glm::ivec2& chunkPosition)
+		{
+			if (delta > 0)
+			{
+				uint32_t& count = m_InterestCoverage[chunkPosition];
+				if (count == 0)
+					m_InterestChanges.Entered.push_back(chunkPosition);
+
+				count += static_cast<uint32_t>(delta);
+				return;
+			}
+
+			auto it = m_InterestCoverage.find(chunkPosition);
+			if (it == m_InterestCoverage.end())
+				return;
+
+			if (it->second <= static_cast<uint32_t>(-delta))
+			{
+				m_InterestCoverage.erase(it);
+				m_InterestChanges.Left.push_back(chunkPosition);
+			}
+			else
+			{
+				it->second -= static_cast<uint32_t>(-delta);
+			}
+		};
+
+		for (int x = center.x - distance; x <= center.x + distance; x++)
+		{
+			const bool columnExcluded = excludedCenter && std::abs(x - excludedCenter->x) <= distance;
+			if (!columnExcluded)
+			{
+				for (int y = center.y - distance; y <= center.y + distance; y++)
+					apply({x, y});
+				continue;
+			}
+
+			// Only the part of the column outside of the excluded area
+			for (int y = center.y - distance; y <= std::min(center.y + distance, excludedCenter->y - distance - 1); y++)
+				apply({x, y});
+			for (int y = std::max(center.y - distance, excludedCenter->y + distance + 1); y <= center.y + distance; y++)
+				apply({x, y});
+		}
+	}
+
 } // namespace onion::voxel
@@ -1,5 +1,9 @@
 #pragma once
 
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+
 #include <memory>
 #include <shared_mutex>
 #include <unordered_map>
@@ -38,6 +42,44 @@ namespace onion::voxel
 
 		std::vector<std::shared_ptr<Entity>> GetAllEntities() const;
 
+		/// @brief Store holding the components of every managed entity and player, for linear iteration.
+		std::shared_ptr<EntityStore> GetEntityStore() const;
+
+		// ----- Spatial Index -----
+	  public:
+		/// @brief Chunks whose ticket count crossed zero since the last TakeInterestChanges().
+		/// A chunk can appear in both lists when it entered and left in between, the current state tells which won.
+		struct InterestChanges
+		{
+			std::vector<glm::ivec2> Entered; // Got their first ticket
+			std::vector<glm::ivec2> Left;	 // Lost their last ticket
+		};
+
+		/// @brief Distance, in chunks, of the area around each player covered by the interest area.
+		/// Each player holds a ticket on every chunk of its area.
+		uint8_t GetInterestDistance() const;
+		void SetInterestDistance(uint8_t distance);
+
+		/// @brief Get the UUIDs of the players standing in the chunk.
+		std::vector<std::string> GetPlayersInChunk(const glm::ivec2& chunkPosition) const;
+
+		/// @brief Get the UUIDs of the players standing within distance chunks of the chunk (square area).
+		std::vector<std::string> GetPlayersNearChunk(const glm::ivec2& chunkPosition, int distance) const;
+
+		/// @brief Whether the chunk is within the interest distance of at least one player.
+		bool IsInInterestArea(const glm::ivec2& chunkPosition) const;
+
+		/// @brief Union of the areas within the interest distance of every player.
+		std::vector<glm::ivec2> GetInterestArea() const;
+
+		/// @brief Get and clear the chunks that entered or left the interest area.
+		InterestChanges TakeInterestChanges();
+
+		/// @brief Re-index a player from its current position.
+		/// Needed when the player was moved without SetPlayerPosition (components copied, client physics).
+		void RefreshPlayerChunk(const std::string& uuid);
+		void RefreshAllPlayerChunks();
+
 		// ----- Events -----
 	  public:
 		Event<const std::shared_ptr<Player>&> EvtPlayerAdded;
@@ -50,5 +92,27 @@ namespace onion::voxel
 
 		mutable std::shared_mutex m_MutexEntities;
 		std::vector<std::shared_ptr<Entity>> m_Entities;
+
+		// Entities and players are bound to it when added
+		const std::shared_ptr<EntityStore> m_EntityStore = std::make_shared<EntityStore>();
+
+		// Always locked after m_MutexPlayers when both are needed
+		mutable std::shared_mutex m_MutexSpatialIndex;
+		uint8_t m_InterestDistance = 5;
+		std::unordered_map<std::string, glm::ivec2> m_PlayerChunks;
+		std::unordered_map<glm::ivec2, std::vector<std::string>> m_PlayersByChunk;
+		// Tickets held on the chunk : number of players whose interest area covers it, chunks covered by nobody are
+		// not stored
+		std::unordered_map<glm::ivec2, uint32_t> m_InterestCoverage;
+		InterestChanges m_InterestChanges;
+
+		// ----- Private Methods -----
+	  private:
+		void IndexPlayer_Unsafe(const std::string& uuid, const glm::ivec2& chunkPosition);
+		void UnindexPlayer_Unsafe(const std::string& uuid);
+
+		/// @brief Add delta to the coverage of the chunks around center, skipping the ones also around excludedCenter.
+		/// Moving a player by one chunk only touches the two strips of chunks entering and leaving its area.
+		void AddInterestCoverage_Unsafe(const glm::ivec2& center, const glm::ivec2* excludedCenter, int delta);
 	};
 } // namespace onion::voxel
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace onion::voxel
+{
+	/// @brief Dense array of one component type, indexed by entity index.
+	/// Components are packed in no particular order : GetOwners()[i] is the entity index of GetComponents()[i].
+	/// Removing a component moves the last one into its slot, so pointers are only stable until the next
+	/// structural change (Set on a new entity, Remove, Clear).
+	template <typename T> class ComponentArray
+	{
+		// ----- Public API -----
+	  public:
+		bool Has(uint32_t entity) const { return entity < m_Sparse.size() && m_Sparse[entity] != NONE; }
+
+		T* Find(uint32_t entity) { return Has(entity) ? &m_Components[m_Sparse[entity]] : nullptr; }
+		const T* Find(uint32_t entity) const { return Has(entity) ? &m_Components[m_Sparse[entity]] : nullptr; }
+
+		void Set(uint32_t entity, const T& component)
+		{
+			if (Has(entity))
+			{
+				m_Components[m_Sparse[entity]] = component;
+				return;
+			}
+
+			if (entity >= m_Sparse.size())
+				m_Sparse.resize(static_cast<size_t>(entity) + 1, NONE);
+
+			m_Sparse[entity] = static_cast<uint32_t>(m_Components.size());
+			m_Components.push_back(component);
+			m_Owners.push_back(entity);
+		}
+
+		void Remove(uint32_t entity)
+		{
+			if (!Has(entity))
+				return;
+
+			const uint32_t slot = m_Sparse[entity];
+			const uint32_t last = static_cast<uint32_t>(m_Components.size() - 1);
+
+			if (slot != last)
+			{
+				m_Components[slot] = std::move(m_Components[last]);
+				m_Owners[slot] = m_Owners[last];
+				m_Sparse[m_Owners[slot]] = slot;
+			}
+
+			m_Components.pop_back();
+			m_Owners.pop_back();
+			m_Sparse[entity] = NONE;
+		}
+
+		void Clear()
+		{
+			m_Sparse.clear();
+			m_Components.clear();
+			m_Owners.clear();
+		}
+
+		// ----- Getters -----
+	  public:
+		size_t Size() const { return m_Components.size(); }
+
+		std::vector<T>& GetComponents() { return m_Components; }
+		const std::vector<T>& GetComponents() const { return m_Components; }
+
+		const std::vector<uint32_t>& GetOwners() const { return m_Owners; }
+
+		// ----- Private Members -----
+	  private:
+		static constexpr uint32_t NONE = UINT32_MAX;
+
+		std::vector<uint32_t> m_Sparse; // Entity index -> slot in m_Components, NONE if absent
+		std::vector<T> m_Components;
+		std::vector<uint32_t> m_Owners; // Slot -> entity index
+	};
+} // namespace onion::voxel
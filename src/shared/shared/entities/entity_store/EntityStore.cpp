@@ -0,0 +1,108 @@
+#include "EntityStore.hpp"
+
+#include <cassert>
+
+namespace onion::voxel
+{
+	EntityHandle EntityStore::Create(EntityType type, const std::string& uuid)
+	{
+		uint32_t index;
+		if (!m_FreeIndices.empty())
+		{
+			index = m_FreeIndices.back();
+			m_FreeIndices.pop_back();
+		}
+		else
+		{
+			index = static_cast<uint32_t>(m_Records.size());
+			m_Records.emplace_back();
+		}
+
+		EntityRecord& record = m_Records[index];
+		record.Type = type;
+		record.UUID = uuid;
+		record.State = 0;
+		record.Alive = true;
+
+		m_EntityCount++;
+
+		return EntityHandle{index, record.Generation};
+	}
+
+	void EntityStore::Destroy(EntityHandle handle)
+	{
+		if (!IsAlive(handle))
+			return;
+
+		RemoveComponents(handle.Index);
+
+		EntityRecord& record = m_Records[handle.Index];
+		record.Alive = false;
+		record.Generation++;
+		record.UUID.clear();
+
+		m_FreeIndices.push_back(handle.Index);
+		m_EntityCount--;
+	}
+
+	bool EntityStore::IsAlive(EntityHandle handle) const
+	{
+		return handle.Index < m_Records.size() && m_Records[handle.Index].Alive &&
+			m_Records[handle.Index].Generation == handle.Generation;
+	}
+
+	void EntityStore::Clear()
+	{
+		for (uint32_t index = 0; index < m_Records.size(); index++)
+		{
+			if (m_Records[index].Alive)
+				Destroy(GetHandle(index));
+		}
+	}
+
+	EntityHandle EntityStore::GetHandle(uint32_t index) const
+	{
+		if (index >= m_Records.size() || !m_Records[index].Alive)
+			return EntityHandle{};
+
+		return EntityHandle{index, m_Records[index].Generation};
+	}
+
+	const EntityStore::EntityRecord& EntityStore::GetRecord(uint32_t index) const
+	{
+		assert(index < m_Records.size());
+		return m_Records[index];
+	}
+
+	void EntityStore::SetState(uint32_t index, uint8_t state)
+	{
+		assert(index < m_Records.size());
+		m_Records[index].State = state;
+	}
+
+	size_t EntityStore::GetEntityCount() const
+	{
+		return m_EntityCount;
+	}
+
+	size_t EntityStore::GetIndexCount() const
+	{
+		return m_Records.size();
+	}
+
+	std::shared_mutex& EntityStore::GetMutex() const
+	{
+		return m_Mutex;
+	}
+
+	void EntityStore::RemoveComponents(uint32_t index)
+	{
+		m_Transforms.Remove(index);
+		m_PhysicsBodies.Remove(index);
+		m_Healths.Remove(index);
+		m_Hungers.Remove(index);
+		m_Experiences.Remove(index);
+		m_PlayerInventories.Remove(index);
+		m_Hotbars.Remove(index);
+	}
+} // namespace onion::voxel
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "ComponentArray.hpp"
+
+#include <shared/entities/components/Experience.hpp>
+#include <shared/entities/components/Health.hpp>
+#include <shared/entities/components/Hunger.hpp>
+#include <shared/entities/components/Inventory.hpp>
+#include <shared/entities/components/PhysicsBody.hpp>
+#include <shared/entities/components/Transform.hpp>
+#include <shared/entities/entity/EntityTypes.hpp>
+
+namespace onion::voxel
+{
+	/// @brief Reference to an entity of an EntityStore. The generation changes when the entity is destroyed,
+	/// so a handle kept after that is detected as stale instead of reaching the entity reusing the index.
+	struct EntityHandle
+	{
+		static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+		uint32_t Index = INVALID_INDEX;
+		uint32_t Generation = 0;
+
+		bool IsValid() const { return Index != INVALID_INDEX; }
+		bool operator==(const EntityHandle& other) const = default;
+	};
+
+	/// @brief Structure-of-arrays storage of the entities : one dense array per component type.
+	/// Systems (physics, snapshots) iterate the arrays linearly instead of going through each Entity.
+	///
+	/// The store does not lock by itself. Whoever owns the current phase holds GetMutex() : exclusive to create
+	/// or destroy entities, add or remove components, or write components ; shared to read. Tasks spawned by the
+	/// owner of the phase may then work on disjoint entities without any lock.
+	class EntityStore
+	{
+		// ----- Structs -----
+	  public:
+		struct EntityRecord
+		{
+			EntityType Type = EntityType::None;
+			std::string UUID;
+			uint8_t State = 0; // Entity::State
+			uint32_t Generation = 0;
+			bool Alive = false;
+		};
+
+		// ----- Public API -----
+	  public:
+		EntityHandle Create(EntityType type, const std::string& uuid);
+		void Destroy(EntityHandle handle);
+		bool IsAlive(EntityHandle handle) const;
+
+		void Clear();
+
+		/// @brief Get the handle of the live entity at this index, or an invalid handle.
+		EntityHandle GetHandle(uint32_t index) const;
+
+		/// @brief Get the record of an entity index. Records of destroyed entities have Alive = false.
+		const EntityRecord& GetRecord(uint32_t index) const;
+		void SetState(uint32_t index, uint8_t state);
+
+		size_t GetEntityCount() const;
+		/// @brief One past the highest entity index in use, to size per-entity scratch arrays.
+		size_t GetIndexCount() const;
+
+		std::shared_mutex& GetMutex() const;
+
+		// ----- Components -----
+	  public:
+		ComponentArray<Transform>& Transforms() { return m_Transforms; }
+		const ComponentArray<Transform>& Transforms() const { return m_Transforms; }
+
+		ComponentArray<PhysicsBody>& PhysicsBodies() { return m_PhysicsBodies; }
+		const ComponentArray<PhysicsBody>& PhysicsBodies() const { return m_PhysicsBodies; }
+
+		ComponentArray<Health>& Healths() { return m_Healths; }
+		const ComponentArray<Health>& Healths() const { return m_Healths; }
+
+		ComponentArray<Hunger>& Hungers() { return m_Hungers; }
+		const ComponentArray<Hunger>& Hungers() const { return m_Hungers; }
+
+		ComponentArray<Experience>& Experiences() { return m_Experiences; }
+		const ComponentArray<Experience>& Experiences() const { return m_Experiences; }
+
+		ComponentArray<Inventory>& PlayerInventories() { return m_PlayerInventories; }
+		const ComponentArray<Inventory>& PlayerInventories() const { return m_PlayerInventories; }
+
+		ComponentArray<Inventory>& Hotbars() { return m_Hotbars; }
+		const ComponentArray<Inventory>& Hotbars() const { return m_Hotbars; }
+
+		// ----- Private Members -----
+	  private:
+		mutable std::shared_mutex m_Mutex;
+
+		std::vector<EntityRecord> m_Records;
+		std::vector<uint32_t> m_FreeIndices;
+		size_t m_EntityCount = 0;
+
+		ComponentArray<Transform> m_Transforms;
+		ComponentArray<PhysicsBody> m_PhysicsBodies;
+		ComponentArray<Health> m_Healths;
+		ComponentArray<Hunger> m_Hungers;
+		ComponentArray<Experience> m_Experiences;
+		ComponentArray<Inventory> m_PlayerInventories;
+		ComponentArray<Inventory> m_Hotbars;
+
+		// ----- Private Methods -----
+	  private:
+		void RemoveComponents(uint32_t index);
+	};
+} // namespace onion::voxel
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+
+#include <shared/network_messages/NetworkMessages.hpp>
+
+namespace onion::voxel
+{
+	/// @brief In-process link between a NetworkServer and a NetworkClient living in the same process (singleplayer).
+	/// Messages are handed over as NetworkMessage variants : no serialization, no socket.
+	/// Each side binds the handlers called when a message is sent to it, or when the other side closes the link.
+	class LocalConnection
+	{
+	  public:
+		using MessageHandler = std::function<void(NetworkMessage&&)>;
+		using ClosedHandler = std::function<void()>;
+
+		// ----- Public API -----
+	  public:
+		void BindServer(MessageHandler onMessage, ClosedHandler onClosed)
+		{
+			Bind(m_ServerSide, std::move(onMessage), std::move(onClosed));
+		}
+
+		void BindClient(MessageHandler onMessage, ClosedHandler onClosed)
+		{
+			Bind(m_ClientSide, std::move(onMessage), std::move(onClosed));
+		}
+
+		bool SendToServer(NetworkMessage message) { return Deliver(m_ServerSide, std::move(message)); }
+		bool SendToClient(NetworkMessage message) { return Deliver(m_ClientSide, std::move(message)); }
+
+		/// @brief Close the link from the client side. The server side is notified.
+		void CloseFromClient() { Close(m_ServerSide, m_ClientSide); }
+
+		/// @brief Close the link from the server side. The client side is notified.
+		void CloseFromServer() { Close(m_ClientSide, m_ServerSide); }
+
+		bool IsOpen() const { return m_IsOpen.load(); }
+
+		// ----- Private Members -----
+	  private:
+		struct Endpoint
+		{
+			std::shared_mutex Mutex;
+			MessageHandler OnMessage;
+			ClosedHandler OnClosed;
+		};
+
+		Endpoint m_ServerSide;
+		Endpoint m_ClientSide;
+		std::atomic_bool m_IsOpen{true};
+
+		// ----- Private Methods -----
+	  private:
+		static void Bind(Endpoint& endpoint, MessageHandler onMessage, ClosedHandler onClosed)
+		{
+			std::unique_lock lock(endpoint.Mutex);
+			endpoint.OnMessage = std::move(onMessage);
+			endpoint.OnClosed = std::move(onClosed);
+		}
+
+		bool Deliver(Endpoint& endpoint, NetworkMessage&& message)
+		{
+			// Shared lock : handlers cannot be unbound while a message is being delivered
+			std::shared_lock lock(endpoint.Mutex);
+
+			if (!m_IsOpen.load() || !endpoint.OnMessage)
+				return false;
+
+			endpoint.OnMessage(std::move(message));
+			return true;
+		}
+
+		void Close(Endpoint& notified, Endpoint& closing)
+		{
+			if (!m_IsOpen.exchange(false))
+				return;
+
+			ClosedHandler onClosed;
+
+			{
+				std::unique_lock lock(notified.Mutex);
+				onClosed = std::move(notified.OnClosed);
+				notified.OnMessage = nullptr;
+				notified.OnClosed = nullptr;
+			}
+
+			{
+				std::unique_lock lock(closing.Mutex);
+				closing.OnMessage = nullptr;
+				closing.OnClosed = nullptr;
+			}
+
+			// Called without lock held, the handler may interact with the connection
+			if (onClosed)
+				onClosed();
+		}
+	};
+} // namespace onion::voxel
@@ -4,6 +4,7 @@
 #include <cereal/types/string.hpp>
 #include <cereal/types/vector.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
@@ -22,9 +23,15 @@ namespace onion::voxel
 			RequestChunks,
 			EntitySnapshot,
 			ServerMOTD,
-			RequestMotd
+			RequestMotd,
+			ChunkDelta
 		};
 
+		static constexpr size_t TYPE_COUNT = static_cast<size_t>(eType::ChunkDelta) + 1;
+
+		// Size of a MessageHeader in a cereal binary archive (type + client handle)
+		static constexpr size_t BINARY_SIZE = sizeof(uint8_t) + sizeof(uint32_t);
+
 		eType Type = eType::None;
 
 		uint32_t ClientHandle = 0;
@@ -38,4 +45,33 @@ namespace onion::voxel
 				Type = static_cast<eType>(type);
 		}
 	};
+
+	inline std::string GetMessageTypeName(MessageHeader::eType type)
+	{
+		switch (type)
+		{
+			case MessageHeader::eType::ServerInfo:
+				return "ServerInfo";
+			case MessageHeader::eType::ClientInfo:
+				return "ClientInfo";
+			case MessageHeader::eType::ChunkData:
+				return "ChunkData";
+			case MessageHeader::eType::PlayerInfos:
+				return "PlayerInfos";
+			case MessageHeader::eType::BlocksChanged:
+				return "BlocksChanged";
+			case MessageHeader::eType::RequestChunks:
+				return "RequestChunks";
+			case MessageHeader::eType::EntitySnapshot:
+				return "EntitySnapshot";
+			case MessageHeader::eType::ServerMOTD:
+				return "ServerMOTD";
+			case MessageHeader::eType::RequestMotd:
+				return "RequestMotd";
+			case MessageHeader::eType::ChunkDelta:
+				return "ChunkDelta";
+			default:
+				return "None";
+		}
+	}
 } // namespace onion::voxel
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "MessageHeader.hpp"
+
+namespace onion::voxel
+{
+	/// @brief ENet channels used by the server and the client.
+	/// Each channel has its own sequencing, so a large reliable transfer on one channel does not delay
+	/// the packets of the other channels (no head-of-line blocking between them).
+	enum class eNetworkChannel : uint8_t
+	{
+		Control = 0, // Handshake, server infos, MOTD and chunk requests
+		ChunkStream, // Chunk data (reliable, large payloads)
+		BlockEdits,	 // Block changes (reliable, ordered)
+		State,		 // Entity snapshots and player movement (unreliable, sequenced)
+
+		Count
+	};
+
+	constexpr size_t NETWORK_CHANNEL_COUNT = static_cast<size_t>(eNetworkChannel::Count);
+
+	struct ChannelPolicy
+	{
+		eNetworkChannel Channel = eNetworkChannel::Control;
+		bool Reliable = true;
+	};
+
+	/// @brief Get the channel and the reliability a message type is sent with.
+	/// Unreliable packets are sequenced by ENet on their channel : an older snapshot arriving after a newer one is dropped.
+	constexpr ChannelPolicy GetChannelPolicy(MessageHeader::eType type)
+	{
+		switch (type)
+		{
+			case MessageHeader::eType::ChunkData:
+				return {eNetworkChannel::ChunkStream, true};
+
+			case MessageHeader::eType::BlocksChanged:
+			case MessageHeader::eType::ChunkDelta:
+				return {eNetworkChannel::BlockEdits, true};
+
+			case MessageHeader::eType::EntitySnapshot:
+			case MessageHeader::eType::PlayerInfos:
+				return {eNetworkChannel::State, false};
+
+			case MessageHeader::eType::RequestChunks:
+				// Missing chunks are requested again periodically, no need to resend lost requests.
+				return {eNetworkChannel::Control, false};
+
+			default:
+				return {eNetworkChannel::Control, true};
+		}
+	}
+
+	inline std::string GetChannelName(eNetworkChannel channel)
+	{
+		switch (channel)
+		{
+			case eNetworkChannel::Control:
+				return "Control";
+			case eNetworkChannel::ChunkStream:
+				return "ChunkStream";
+			case eNetworkChannel::BlockEdits:
+				return "BlockEdits";
+			case eNetworkChannel::State:
+				return "State";
+			default:
+				return "Unknown";
+		}
+	}
+
+	/// @brief Snapshot of the traffic of one channel.
+	struct ChannelStats
+	{
+		uint64_t MessagesSent = 0;	   // Packets handed to ENet (one per target)
+		uint64_t BytesSent = 0;		   // Payload bytes handed to ENet
+		uint64_t MessagesReceived = 0; // Packets received on this channel
+		uint64_t BytesReceived = 0;	   // Payload bytes received on this channel
+		uint64_t QueuedMessages = 0;   // Messages waiting in the outgoing queue (not yet handed to ENet)
+	};
+
+	/// @brief Thread-safe counters backing ChannelStats.
+	class ChannelStatsCounters
+	{
+		// ----- Public API -----
+	  public:
+		void OnQueued(eNetworkChannel channel) { Get(channel).Queued.fetch_add(1, std::memory_order_relaxed); }
+
+		void OnDequeued(eNetworkChannel channel) { Get(channel).Queued.fetch_sub(1, std::memory_order_relaxed); }
+
+		void OnSent(eNetworkChannel channel, size_t bytes)
+		{
+			Counters& counters = Get(channel);
+			counters.MessagesSent.fetch_add(1, std::memory_order_relaxed);
+			counters.BytesSent.fetch_add(bytes, std::memory_order_relaxed);
+		}
+
+		void OnReceived(uint8_t channelId, size_t bytes)
+		{
+			if (channelId >= NETWORK_CHANNEL_COUNT)
+				return;
+
+			Counters& counters = m_Counters[channelId];
+			counters.MessagesReceived.fetch_add(1, std::memory_order_relaxed);
+			counters.BytesReceived.fetch_add(bytes, std::memory_order_relaxed);
+		}
+
+		std::array<ChannelStats, NETWORK_CHANNEL_COUNT> Snapshot() const
+		{
+			std::array<ChannelStats, NETWORK_CHANNEL_COUNT> stats{};
+			for (size_t i = 0; i < NETWORK_CHANNEL_COUNT; i++)
+			{
+				stats[i].MessagesSent = m_Counters[i].MessagesSent.load(std::memory_order_relaxed);
+				stats[i].BytesSent = m_Counters[i].BytesSent.load(std::memory_order_relaxed);
+				stats[i].MessagesReceived = m_Counters[i].MessagesReceived.load(std::memory_order_relaxed);
+				stats[i].BytesReceived = m_Counters[i].BytesReceived.load(std::memory_order_relaxed);
+				stats[i].QueuedMessages = m_Counters[i].Queued.load(std::memory_order_relaxed);
+			}
+			return stats;
+		}
+
+		// ----- Private Members -----
+	  private:
+		struct Counters
+		{
+			std::atomic_uint64_t MessagesSent{0};
+			std::atomic_uint64_t BytesSent{0};
+			std::atomic_uint64_t MessagesReceived{0};
+			std::atomic_uint64_t BytesReceived{0};
+			std::atomic_uint64_t Queued{0};
+		};
+
+		std::array<Counters, NETWORK_CHANNEL_COUNT> m_Counters;
+
+		Counters& Get(eNetworkChannel channel) { return m_Counters[static_cast<size_t>(channel)]; }
+	};
+} // namespace onion::voxel
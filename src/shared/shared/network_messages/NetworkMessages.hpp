@@ -3,8 +3,10 @@
 #include <variant>
 
 #include "MessageHeader.hpp"
+#include "NetworkChannels.hpp"
 
 #include "blocks_changed_msg/BlocksChangedMsg.hpp"
+#include "chunk_delta_msg/ChunkDeltaMsg.hpp"
 #include "chunk_data_msg/ChunkDataMsg.hpp"
 #include "client_info_msg/ClientInfoMsg.hpp"
 #include "entity_snapshot_msg/EntitySnapshotMsg.hpp"
@@ -26,7 +28,18 @@ namespace onion::voxel
 										RequestChunksMsg,
 										EntitySnapshotMsg,
 										ServerMotdMsg,
-										RequestMotdMsg>;
+										RequestMotdMsg,
+										ChunkDeltaMsg>;
+
+	inline MessageHeader::eType GetMessageType(const NetworkMessage& message)
+	{
+		return std::visit([](const auto& msg) { return std::decay_t<decltype(msg)>::StaticType; }, message);
+	}
+
+	inline ChannelPolicy GetChannelPolicy(const NetworkMessage& message)
+	{
+		return GetChannelPolicy(GetMessageType(message));
+	}
 
 	inline NetworkMessage DeserializeMessage(cereal::BinaryInputArchive& archive, MessageHeader::eType type)
 	{
@@ -95,6 +108,13 @@ namespace onion::voxel
 					return msg;
 				}
 
+			case MessageHeader::eType::ChunkDelta:
+				{
+					ChunkDeltaMsg msg;
+					archive(msg);
+					return msg;
+				}
+
 			default:
 				throw std::runtime_error("Unknown message type");
 		}
@@ -2,6 +2,7 @@
 
 #include <cereal/archives/binary.hpp>
 
+#include <memory>
 #include <sstream>
 #include <string>
 
@@ -10,12 +11,18 @@
 
 namespace onion::voxel
 {
+	class Chunk;
+
 	struct ChunkDataMsg
 	{
 		static constexpr MessageHeader::eType StaticType = MessageHeader::eType::ChunkData;
 
 		ChunkDTO Chunk;
 
+		// Not serialized. Set by the receiver when the chunk is decoded straight from the packet (see
+		// SerializerDTO::DecodeChunk); Chunk is then left empty.
+		std::shared_ptr<onion::voxel::Chunk> DecodedChunk;
+
 		template <class Archive> void serialize(Archive& ar) { ar(Chunk); }
 	};
 } // namespace onion::voxel
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cereal/archives/binary.hpp>
+
+#include <sstream>
+#include <string>
+
+#include <shared/data_transfer_objects/DTOs/DTOs.hpp>
+#include <shared/network_messages/MessageHeader.hpp>
+
+namespace onion::voxel
+{
+	/// @brief Blocks changed in one chunk during a server tick. Only sent to the clients that have the chunk loaded.
+	struct ChunkDeltaMsg
+	{
+		static constexpr MessageHeader::eType StaticType = MessageHeader::eType::ChunkDelta;
+
+		ChunkDeltaDTO Delta;
+
+		template <class Archive> void serialize(Archive& ar) { ar(Delta); }
+	};
+} // namespace onion::voxel
@@ -0,0 +1,94 @@
+#include "CollisionShapes.hpp"
+
+#include <shared/world/block/BlockstateRegistry.hpp>
+
+namespace
+{
+	using namespace onion::voxel;
+
+	CollisionShape BuildShape(const std::vector<BlockModel::Element>& elements)
+	{
+		CollisionShape shape;
+
+		// Full cube fallback
+		if (elements.empty())
+		{
+			shape.Count = 1;
+			return shape;
+		}
+
+		// Element rotation is ignored, like the previous per-block query : collision-relevant blocks do not use it
+		for (const auto& element : elements)
+		{
+			// Convert from Minecraft 0–16 units to block-local metres
+			const CollisionBox box{element.From / 16.0f, element.To / 16.0f};
+
+			if (shape.Count < CollisionShape::MAX_BOXES)
+			{
+				shape.Boxes[shape.Count++] = box;
+			}
+			else
+			{
+				CollisionBox& last = shape.Boxes[CollisionShape::MAX_BOXES - 1];
+				last.Min = glm::min(last.Min, box.Min);
+				last.Max = glm::max(last.Max, box.Max);
+			}
+		}
+
+		return shape;
+	}
+} // namespace
+
+namespace onion::voxel
+{
+	CollisionShapeTable::CollisionShapeTable()
+	{
+		const auto& registry = BlockstateRegistry::Get();
+		const size_t blockIdCount = static_cast<size_t>(BlockId::Count);
+
+		m_Offsets.reserve(blockIdCount + 1);
+
+		for (size_t i = 0; i < blockIdCount; i++)
+		{
+			const BlockId id = static_cast<BlockId>(i);
+			m_Offsets.push_back(static_cast<uint32_t>(m_Shapes.size()));
+
+			auto it = registry.find(id);
+			const size_t variantCount = (it != registry.end() && !it->second.empty()) ? it->second.size() : 1;
+
+			for (size_t variant = 0; variant < variantCount; variant++)
+			{
+				if (!BlockState::IsSolid(id))
+				{
+					m_Shapes.emplace_back();
+				}
+				else if (it == registry.end() || it->second.empty())
+				{
+					m_Shapes.push_back(BuildShape({}));
+				}
+				else
+				{
+					m_Shapes.push_back(BuildShape(it->second[variant].Model.Elements));
+				}
+			}
+		}
+
+		m_Offsets.push_back(static_cast<uint32_t>(m_Shapes.size()));
+	}
+
+	const CollisionShapeTable& CollisionShapeTable::Get()
+	{
+		static const CollisionShapeTable table;
+		return table;
+	}
+
+	const CollisionShape& CollisionShapeTable::GetShape(const BlockState& state) const
+	{
+		const size_t id = static_cast<size_t>(state.ID);
+		const uint32_t offset = m_Offsets[id];
+		const uint32_t variantCount = m_Offsets[id + 1] - offset;
+
+		// Unknown variants use the default one
+		return m_Shapes[offset + (state.VariantIndex < variantCount ? state.VariantIndex : 0)];
+	}
+} // namespace onion::voxel
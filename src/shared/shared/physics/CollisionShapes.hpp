@@ -0,0 +1,53 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <shared/world/block/BlockState.hpp>
+
+namespace onion::voxel
+{
+	/// @brief Collision box of a block, in block-local space (0 to 1).
+	struct CollisionBox
+	{
+		glm::vec3 Min{0.f};
+		glm::vec3 Max{1.f};
+	};
+
+	/// @brief Collision boxes of one block variant, stored inline.
+	/// Models with more elements than MAX_BOXES have their last boxes merged (conservative).
+	struct CollisionShape
+	{
+		static constexpr size_t MAX_BOXES = 8;
+
+		std::array<CollisionBox, MAX_BOXES> Boxes{};
+		uint8_t Count = 0; // 0 : not solid
+
+		bool IsEmpty() const { return Count == 0; }
+	};
+
+	/// @brief Collision shapes of every (BlockId, variant), precomputed from the block models.
+	/// Non-solid blocks have an empty shape, solid blocks without model elements a full cube.
+	class CollisionShapeTable
+	{
+		// ----- Public API -----
+	  public:
+		/// @brief Get the table, built on first use from BlockstateRegistry.
+		static const CollisionShapeTable& Get();
+
+		const CollisionShape& GetShape(const BlockState& state) const;
+
+		// ----- Constructor -----
+	  private:
+		CollisionShapeTable();
+
+		// ----- Private Members -----
+	  private:
+		// Shapes of block id N are m_Shapes[m_Offsets[N]] to m_Shapes[m_Offsets[N + 1] - 1]
+		std::vector<uint32_t> m_Offsets;
+		std::vector<CollisionShape> m_Shapes;
+	};
+} // namespace onion::voxel
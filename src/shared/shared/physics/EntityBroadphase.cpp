@@ -0,0 +1,106 @@
+#include "EntityBroadphase.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace onion::voxel
+{
+	EntityBroadphase::EntityBroadphase(float cellSize) : m_CellSize(std::max(cellSize, 0.01f)) {}
+
+	void EntityBroadphase::Build(std::vector<Body> bodies)
+	{
+		m_Cells.clear();
+		m_Bodies = std::move(bodies);
+
+		for (uint32_t i = 0; i < m_Bodies.size(); i++)
+		{
+			const glm::ivec2 minCell = ToCell(m_Bodies[i].Min);
+			const glm::ivec2 maxCell = ToCell(m_Bodies[i].Max);
+
+			for (int x = minCell.x; x <= maxCell.x; x++)
+				for (int z = minCell.y; z <= maxCell.y; z++)
+					m_Cells[glm::ivec2(x, z)].push_back(i);
+		}
+	}
+
+	void EntityBroadphase::Clear()
+	{
+		m_Cells.clear();
+		m_Bodies.clear();
+	}
+
+	void EntityBroadphase::Query(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& outBodies) const
+	{
+		outBodies.clear();
+
+		const Body box{min, max};
+		const glm::ivec2 minCell = ToCell(min);
+		const glm::ivec2 maxCell = ToCell(max);
+
+		for (int x = minCell.x; x <= maxCell.x; x++)
+			for (int z = minCell.y; z <= maxCell.y; z++)
+			{
+				auto it = m_Cells.find(glm::ivec2(x, z));
+				if (it == m_Cells.end())
+					continue;
+
+				for (uint32_t body : it->second)
+				{
+					if (Overlaps(box, m_Bodies[body]))
+						outBodies.push_back(body);
+				}
+			}
+
+		// A body covering several cells is found once per cell
+		std::sort(outBodies.begin(), outBodies.end());
+		outBodies.erase(std::unique(outBodies.begin(), outBodies.end()), outBodies.end());
+	}
+
+	void EntityBroadphase::FindOverlappingPairs(std::vector<std::pair<uint32_t, uint32_t>>& outPairs) const
+	{
+		outPairs.clear();
+
+		for (const auto& [cell, bodies] : m_Cells)
+		{
+			for (size_t i = 0; i < bodies.size(); i++)
+			{
+				for (size_t j = i + 1; j < bodies.size(); j++)
+				{
+					const Body& a = m_Bodies[bodies[i]];
+					const Body& b = m_Bodies[bodies[j]];
+					if (!Overlaps(a, b))
+						continue;
+
+					// Two bodies can share several cells : only report the pair in the cell holding the
+					// minimum corner of their overlap.
+					if (ToCell(glm::max(a.Min, b.Min)) != cell)
+						continue;
+
+					outPairs.emplace_back(std::min(bodies[i], bodies[j]), std::max(bodies[i], bodies[j]));
+				}
+			}
+		}
+	}
+
+	float EntityBroadphase::GetCellSize() const
+	{
+		return m_CellSize;
+	}
+
+	const std::vector<EntityBroadphase::Body>& EntityBroadphase::GetBodies() const
+	{
+		return m_Bodies;
+	}
+
+	glm::ivec2 EntityBroadphase::ToCell(const glm::vec3& position) const
+	{
+		return glm::ivec2(static_cast<int>(std::floor(position.x / m_CellSize)),
+						  static_cast<int>(std::floor(position.z / m_CellSize)));
+	}
+
+	bool EntityBroadphase::Overlaps(const Body& a, const Body& b)
+	{
+		return a.Max.x > b.Min.x && a.Min.x < b.Max.x && a.Max.y > b.Min.y && a.Min.y < b.Max.y &&
+			a.Max.z > b.Min.z && a.Min.z < b.Max.z;
+	}
+} // namespace onion::voxel
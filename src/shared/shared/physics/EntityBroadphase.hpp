@@ -0,0 +1,59 @@
+#pragma once
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace onion::voxel
+{
+	/// @brief Uniform grid over the XZ plane, used to find the entities near each other without testing every pair.
+	/// Bodies are inserted in every cell their AABB covers. Rebuilt from scratch each step.
+	class EntityBroadphase
+	{
+		// ----- Structs -----
+	  public:
+		struct Body
+		{
+			glm::vec3 Min{0.f};
+			glm::vec3 Max{0.f};
+		};
+
+		// ----- Constructor / Destructor -----
+	  public:
+		EntityBroadphase(float cellSize = 2.0f);
+		~EntityBroadphase() = default;
+
+		// ----- Public API -----
+	  public:
+		void Build(std::vector<Body> bodies);
+		void Clear();
+
+		/// @brief Get the bodies overlapping the given box, sorted and without duplicates.
+		void Query(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& outBodies) const;
+
+		/// @brief Get every pair of overlapping bodies, once, as (lower index, higher index).
+		void FindOverlappingPairs(std::vector<std::pair<uint32_t, uint32_t>>& outPairs) const;
+
+		// ----- Getters / Setters -----
+	  public:
+		float GetCellSize() const;
+		const std::vector<Body>& GetBodies() const;
+
+		// ----- Private Members -----
+	  private:
+		float m_CellSize;
+		std::vector<Body> m_Bodies;
+		std::unordered_map<glm::ivec2, std::vector<uint32_t>> m_Cells;
+
+		// ----- Private Methods -----
+	  private:
+		glm::ivec2 ToCell(const glm::vec3& position) const;
+
+		static bool Overlaps(const Body& a, const Body& b);
+	};
+} // namespace onion::voxel
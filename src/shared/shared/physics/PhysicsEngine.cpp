@@ -1,9 +1,9 @@
 #include "PhysicsEngine.hpp"
+#include "TerrainRegion.hpp"
 
 #include <iostream>
 
 #include <shared/utils/Utils.hpp>
-#include <shared/world/block/BlockstateRegistry.hpp>
 
 namespace
 {
@@ -88,50 +88,35 @@ namespace
 	}
 
 	// -------------------------------------------------------------------------
-	// GetBlockElementAABBs
-	//
-	// Returns the world-space AABBs for each BlockModel::Element of a solid block.
-	// Element From/To are in Minecraft 0–16 units; dividing by 16 and offsetting by
-	// the block's integer world position converts them to world-space metres.
-	//
-	// Element rotation (ElementRotation) is intentionally ignored: collision-relevant
-	// blocks (slabs, stairs, fences, snow) never use element rotation. For any element
-	// that does have a non-zero rotation angle we still use its From/To AABB directly —
-	// this is slightly conservative but never under-estimates the actual geometry.
-	//
-	// Falls back to a single full-cube AABB if the block has no model or no elements.
+	// World-space AABB of a block collision box. CollisionShapeTable holds the
+	// boxes in block-local space, precomputed from the block model elements.
 	// -------------------------------------------------------------------------
-	std::vector<AABBWorld> GetBlockElementAABBs(const BlockState& state, const glm::ivec3& blockPos)
+	AABBWorld ToWorldAABB(const CollisionBox& box, const glm::ivec3& blockPos)
 	{
 		const glm::vec3 origin = glm::vec3(blockPos);
+		return {origin + box.Min, origin + box.Max};
+	}
 
-		const auto& registry = BlockstateRegistry::Get();
-		auto it = registry.find(state.ID);
-
-		if (it != registry.end())
-		{
-			const std::vector<BlockModel::Element>& elements = it->second[state.VariantIndex].Model.Elements;
-
-			if (!elements.empty())
-			{
-				std::vector<AABBWorld> result;
-				result.reserve(elements.size());
-
-				for (const auto& element : elements)
-				{
-					// Convert from Minecraft 0–16 units to world-space metres
-					AABBWorld box;
-					box.Min = origin + element.From / 16.0f;
-					box.Max = origin + element.To / 16.0f;
-					result.push_back(box);
-				}
+	glm::ivec3 ToBlockPosition(const glm::vec3& position)
+	{
+		return glm::ivec3(glm::floor(position));
+	}
 
-				return result;
-			}
-		}
+	// -------------------------------------------------------------------------
+	// Terrain region of the calling thread. Reused by every query of the thread,
+	// so the terrain queries do not allocate once it is warmed up.
+	// -------------------------------------------------------------------------
+	TerrainRegion& GetThreadTerrainRegion()
+	{
+		thread_local TerrainRegion region;
+		return region;
+	}
 
-		// Fallback: full unit cube
-		return {AABBWorld{origin, origin + glm::vec3(1.0f)}};
+	void
+	EnsureRegion(TerrainRegion& region, const WorldManager& worldManager, const glm::ivec3& min, const glm::ivec3& max)
+	{
+		if (!region.Contains(min, max))
+			region.Load(worldManager, min, max);
 	}
 
 } // namespace
@@ -166,12 +151,31 @@ namespace onion::voxel
 
 			if (inLoadedChunk)
 			{
-				UpdateEntityPhysics(entity, deltaTime);
-				SweptResolveTerrainCollisions(entity, deltaTime);
+				StepEntity(entity, deltaTime);
 			}
 		}
 	}
 
+	void PhysicsEngine::StepEntity(const std::shared_ptr<Entity>& entity, float deltaTime)
+	{
+		if (!entity->HasPhysicsBody() || !entity->HasTransform())
+			return;
+
+		Transform transform = entity->GetTransform();
+		PhysicsBody physicsBody = entity->GetPhysicsBody();
+
+		StepBody(transform, physicsBody, deltaTime);
+
+		entity->SetTransform(transform);
+		entity->SetPhysicsBody(physicsBody);
+	}
+
+	void PhysicsEngine::StepBody(Transform& transform, PhysicsBody& physicsBody, float deltaTime)
+	{
+		UpdateBodyPhysics(physicsBody, deltaTime);
+		SweptResolveTerrainCollisions(transform, physicsBody, deltaTime);
+	}
+
 	float PhysicsEngine::GetGravity() const
 	{
 		std::shared_lock lock(m_MutexPhysics);
@@ -196,26 +200,18 @@ namespace onion::voxel
 		m_JumpStrength = jumpStrength;
 	}
 
-	void PhysicsEngine::UpdateEntityPhysics(std::shared_ptr<Entity> entity, float deltaTime)
+	void PhysicsEngine::UpdateBodyPhysics(PhysicsBody& physicsBody, float deltaTime)
 	{
-		if (entity->HasPhysicsBody() && entity->HasTransform())
+		// Apply gravity if not flying and not on the ground
+		if (!physicsBody.IsFlying && !physicsBody.OnGround)
 		{
-			PhysicsBody physicsBody = entity->GetPhysicsBody();
-
-			// Apply gravity if not flying and not on the ground
-			if (!physicsBody.IsFlying && !physicsBody.OnGround)
-			{
-				physicsBody.Velocity.y -= GetGravity() * deltaTime;
-			}
-
-			// Apply friction if on the ground and not flying
-			if (!physicsBody.IsFlying && physicsBody.OnGround)
-			{
-				ApplyFriction(physicsBody.Velocity, deltaTime);
-			}
+			physicsBody.Velocity.y -= GetGravity() * deltaTime;
+		}
 
-			// Update the entity's components
-			entity->SetPhysicsBody(physicsBody);
+		// Apply friction if on the ground and not flying
+		if (!physicsBody.IsFlying && physicsBody.OnGround)
+		{
+			ApplyFriction(physicsBody.Velocity, deltaTime);
 		}
 	}
 
@@ -432,14 +428,8 @@ namespace onion::voxel
 	// OnGround is set when a downward Y sweep hits a floor (normal.y > 0).
 	// A ground probe is run when vel.y == 0 so OnGround stays set while standing still.
 	// -------------------------------------------------------------------------
-	void PhysicsEngine::SweptResolveTerrainCollisions(std::shared_ptr<Entity> entity, float dt)
+	void PhysicsEngine::SweptResolveTerrainCollisions(Transform& transform, PhysicsBody& physics, float dt)
 	{
-		if (!entity->HasPhysicsBody() || !entity->HasTransform())
-			return;
-
-		auto physics = entity->GetPhysicsBody();
-		auto transform = entity->GetTransform();
-
 		bool wasOnGround = physics.OnGround;
 
 		physics.OnGround = false;
@@ -452,6 +442,19 @@ namespace onion::voxel
 		glm::vec3 pos = transform.Position;
 		glm::vec3 vel = physics.Velocity;
 
+		// ------------------------------------------------------------------
+		// Copy the terrain around the whole move once. One block of margin
+		// covers the step up, the ground probe and the epsilons.
+		// ------------------------------------------------------------------
+		TerrainRegion& region = GetThreadTerrainRegion();
+		{
+			const glm::vec3 center = pos + offset;
+			const glm::vec3 travel = glm::abs(vel * dt);
+			region.Load(m_WorldManager,
+						ToBlockPosition(center - half - travel) - glm::ivec3(1),
+						ToBlockPosition(center + half + travel) + glm::ivec3(1));
+		}
+
 		// ------------------------------------------------------------------
 		// Per-axis sweep helper: sweeps the entity AABB along `disp` (which
 		// has only one non-zero component), finds the earliest solid block
@@ -472,30 +475,24 @@ namespace onion::voxel
 			swept.Min = glm::min(entityBox.Min, entityBox.Min + disp) - glm::vec3(EPSILON);
 			swept.Max = glm::max(entityBox.Max, entityBox.Max + disp) + glm::vec3(EPSILON);
 
-			int bMinX = static_cast<int>(std::floor(swept.Min.x));
-			int bMaxX = static_cast<int>(std::floor(swept.Max.x));
-			int bMinY = static_cast<int>(std::floor(swept.Min.y));
-			int bMaxY = static_cast<int>(std::floor(swept.Max.y));
-			int bMinZ = static_cast<int>(std::floor(swept.Min.z));
-			int bMaxZ = static_cast<int>(std::floor(swept.Max.z));
+			const glm::ivec3 bMin = ToBlockPosition(swept.Min);
+			const glm::ivec3 bMax = ToBlockPosition(swept.Max);
+			EnsureRegion(region, m_WorldManager, bMin, bMax);
 
 			float tMin = 1.0f;
 			glm::vec3 hitNormal = glm::vec3(0.0f);
 
-			for (int bx = bMinX; bx <= bMaxX; ++bx)
-				for (int by = bMinY; by <= bMaxY; ++by)
-					for (int bz = bMinZ; bz <= bMaxZ; ++bz)
+			for (int bx = bMin.x; bx <= bMax.x; ++bx)
+				for (int by = bMin.y; by <= bMax.y; ++by)
+					for (int bz = bMin.z; bz <= bMax.z; ++bz)
 					{
-						const BlockState& block = m_WorldManager.GetBlock(glm::ivec3{bx, by, bz});
-						if (!BlockState::IsSolid(block.ID))
-							continue;
-
-						// Test each element AABB of the block model individually.
-						// Solid blocks with no model fall back to a full unit cube.
-						for (const AABBWorld& elemBox : GetBlockElementAABBs(block, {bx, by, bz}))
+						// Test each element box of the block model individually.
+						// Solid blocks with no model have a full unit cube, non-solid blocks no box.
+						const CollisionShape& shape = region.GetShape({bx, by, bz});
+						for (uint8_t i = 0; i < shape.Count; ++i)
 						{
 							glm::vec3 normal;
-							float t = SweptAABB(entityBox, disp, elemBox, normal);
+							float t = SweptAABB(entityBox, disp, ToWorldAABB(shape.Boxes[i], {bx, by, bz}), normal);
 							if (t < tMin)
 							{
 								tMin = t;
@@ -543,10 +540,10 @@ namespace onion::voxel
 
 			constexpr float STEP_EPSILON = 0.01f; // Small value to prevent floating-point issues
 
-			if (wasOnGround && IsCollidingWithTerrain(playerPos, half, offset))
+			if (wasOnGround && IsCollidingWithTerrain(region, playerPos, half, offset))
 			{
 				float stepHeight = 0.0f;
-				while (stepHeight < MAX_STEP_HEIGHT && IsCollidingWithTerrain(playerPos, half, offset))
+				while (stepHeight < MAX_STEP_HEIGHT && IsCollidingWithTerrain(region, playerPos, half, offset))
 				{
 					stepHeight += STEP_EPSILON;
 					playerPos.y += STEP_EPSILON;
@@ -603,9 +600,6 @@ namespace onion::voxel
 		// ------------------------------------------------------------------
 		transform.Position = pos;
 		physics.Velocity = vel;
-
-		entity->SetTransform(transform);
-		entity->SetPhysicsBody(physics);
 	}
 
 	bool PhysicsEngine::LegacyIsCollidingWithTerrain(const glm::vec3& position,
@@ -645,31 +639,27 @@ namespace onion::voxel
 		return false;
 	}
 
-	bool
-	PhysicsEngine::IsCollidingWithTerrain(const glm::vec3& position, const glm::vec3& halfSize, const glm::vec3& offset)
+	bool PhysicsEngine::IsCollidingWithTerrain(TerrainRegion& region,
+											   const glm::vec3& position,
+											   const glm::vec3& halfSize,
+											   const glm::vec3& offset)
 	{
 		glm::vec3 center = position + offset;
 		glm::vec3 min = center - halfSize;
 		glm::vec3 max = center + halfSize;
 
-		int minX = static_cast<int>(std::floor(min.x));
-		int maxX = static_cast<int>(std::floor(max.x));
-		int minY = static_cast<int>(std::floor(min.y));
-		int maxY = static_cast<int>(std::floor(max.y));
-		int minZ = static_cast<int>(std::floor(min.z));
-		int maxZ = static_cast<int>(std::floor(max.z));
+		const glm::ivec3 bMin = ToBlockPosition(min);
+		const glm::ivec3 bMax = ToBlockPosition(max);
+		EnsureRegion(region, m_WorldManager, bMin, bMax);
 
-		for (int x = minX; x <= maxX; ++x)
-			for (int y = minY; y <= maxY; ++y)
-				for (int z = minZ; z <= maxZ; ++z)
+		for (int x = bMin.x; x <= bMax.x; ++x)
+			for (int y = bMin.y; y <= bMax.y; ++y)
+				for (int z = bMin.z; z <= bMax.z; ++z)
 				{
-					const BlockState& block = m_WorldManager.GetBlock(glm::ivec3{x, y, z});
-					if (!BlockState::IsSolid(block.ID))
-						continue;
-
-					const auto& boxes = GetBlockElementAABBs(block, {x, y, z});
-					for (const AABBWorld& elemBox : boxes)
+					const CollisionShape& shape = region.GetShape({x, y, z});
+					for (uint8_t i = 0; i < shape.Count; ++i)
 					{
+						const AABBWorld elemBox = ToWorldAABB(shape.Boxes[i], {x, y, z});
 						if (max.x > elemBox.Min.x && min.x < elemBox.Max.x && max.y > elemBox.Min.y &&
 							min.y < elemBox.Max.y && max.z > elemBox.Min.z && min.z < elemBox.Max.z)
 						{
@@ -688,13 +678,15 @@ namespace onion::voxel
 		if (!player->HasTransform() || !player->HasPhysicsBody())
 			return false;
 
-		if (!BlockState::IsSolid(state.ID))
+		const CollisionShape& shape = CollisionShapeTable::Get().GetShape(state);
+		if (shape.IsEmpty())
 			return false;
 
 		const AABBWorld playerBox = ComputeAABB(player->GetTransform(), player->GetPhysicsBody());
 
-		for (const AABBWorld& elemBox : GetBlockElementAABBs(state, blockPos))
+		for (uint8_t i = 0; i < shape.Count; ++i)
 		{
+			const AABBWorld elemBox = ToWorldAABB(shape.Boxes[i], blockPos);
 			if (playerBox.Max.x > elemBox.Min.x && playerBox.Min.x < elemBox.Max.x && playerBox.Max.y > elemBox.Min.y &&
 				playerBox.Min.y < elemBox.Max.y && playerBox.Max.z > elemBox.Min.z && playerBox.Min.z < elemBox.Max.z)
 				return true;
@@ -726,24 +718,20 @@ namespace onion::voxel
 		glm::vec3 feetMin = {center.x - halfSize.x, center.y - halfSize.y - probeEpsilon, center.z - halfSize.z};
 		glm::vec3 feetMax = {center.x + halfSize.x, center.y - halfSize.y, center.z + halfSize.z};
 
-		int minX = static_cast<int>(std::floor(feetMin.x));
-		int maxX = static_cast<int>(std::floor(feetMax.x));
-		int minY = static_cast<int>(std::floor(feetMin.y));
-		int maxY = static_cast<int>(std::floor(feetMax.y));
-		int minZ = static_cast<int>(std::floor(feetMin.z));
-		int maxZ = static_cast<int>(std::floor(feetMax.z));
+		const glm::ivec3 bMin = ToBlockPosition(feetMin);
+		const glm::ivec3 bMax = ToBlockPosition(feetMax);
 
-		for (int x = minX; x <= maxX; ++x)
-			for (int y = minY; y <= maxY; ++y)
-				for (int z = minZ; z <= maxZ; ++z)
-				{
-					const BlockState& block = m_WorldManager.GetBlock(glm::ivec3{x, y, z});
-					if (!BlockState::IsSolid(block.ID))
-						continue;
+		TerrainRegion& region = GetThreadTerrainRegion();
+		region.Load(m_WorldManager, bMin, bMax);
 
-					const auto& boxes = GetBlockElementAABBs(block, {x, y, z});
-					for (const AABBWorld& elemBox : boxes)
+		for (int x = bMin.x; x <= bMax.x; ++x)
+			for (int y = bMin.y; y <= bMax.y; ++y)
+				for (int z = bMin.z; z <= bMax.z; ++z)
+				{
+					const CollisionShape& shape = region.GetShape({x, y, z});
+					for (uint8_t i = 0; i < shape.Count; ++i)
 					{
+						const AABBWorld elemBox = ToWorldAABB(shape.Boxes[i], {x, y, z});
 						if (feetMax.x > elemBox.Min.x && feetMin.x < elemBox.Max.x && feetMax.y > elemBox.Min.y &&
 							feetMin.y < elemBox.Max.y && feetMax.z > elemBox.Min.z && feetMin.z < elemBox.Max.z)
 						{
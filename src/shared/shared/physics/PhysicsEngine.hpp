@@ -7,6 +7,8 @@
 
 namespace onion::voxel
 {
+	class TerrainRegion;
+
 	class PhysicsEngine
 	{
 
@@ -19,6 +21,11 @@ namespace onion::voxel
 	  public:
 		void Update(float deltaTime);
 
+		/// @brief Integrate one entity and resolve its terrain collisions. Thread-safe for distinct entities.
+		void StepEntity(const std::shared_ptr<Entity>& entity, float deltaTime);
+		/// @brief Same as StepEntity, on components read from an EntityStore.
+		void StepBody(Transform& transform, PhysicsBody& physicsBody, float deltaTime);
+
 		bool IsPlayerCollidingWithBlock(const std::shared_ptr<Entity>& player,
 										const BlockState& state,
 										const glm::ivec3& blockPos);
@@ -37,18 +44,21 @@ namespace onion::voxel
 
 		// ----- Internal Methods -----
 	  private:
-		void UpdateEntityPhysics(std::shared_ptr<Entity> entity, float deltaTime);
+		void UpdateBodyPhysics(PhysicsBody& physicsBody, float deltaTime);
 		void ApplyFriction(glm::vec3& velocity, float deltaTime);
 
 		// New swept AABB collision resolution (stable, tunneling-free)
-		void SweptResolveTerrainCollisions(std::shared_ptr<Entity> entity, float deltaTime);
+		void SweptResolveTerrainCollisions(Transform& transform, PhysicsBody& physicsBody, float deltaTime);
 
 		// Legacy axis-separated resolution (kept for reference)
 		void LegacyResolveTerrainCollisions(std::shared_ptr<Entity> entity, float deltaTime);
 
 		bool
 		LegacyIsCollidingWithTerrain(const glm::vec3& position, const glm::vec3& halfSize, const glm::vec3& offset);
-		bool IsCollidingWithTerrain(const glm::vec3& position, const glm::vec3& halfSize, const glm::vec3& offset);
+		bool IsCollidingWithTerrain(TerrainRegion& region,
+									const glm::vec3& position,
+									const glm::vec3& halfSize,
+									const glm::vec3& offset);
 
 		// Returns true if there is at least one solid block directly beneath the
 		// AABB defined by (position, halfSize, offset). Used by sneak edge-prevention.
@@ -0,0 +1,331 @@
+#include "PhysicsSimulation.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <latch>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+
+#include <shared/profiler/Profiler.hpp>
+#include <shared/utils/Stopwatch.hpp>
+#include <shared/utils/Utils.hpp>
+
+namespace
+{
+	using namespace onion::voxel;
+
+	/// @brief Minimal union-find over the chunk buckets.
+	class IslandBuilder
+	{
+	  public:
+		explicit IslandBuilder(size_t count) : m_Parents(count) { std::iota(m_Parents.begin(), m_Parents.end(), 0); }
+
+		size_t Find(size_t i)
+		{
+			while (m_Parents[i] != i)
+			{
+				m_Parents[i] = m_Parents[m_Parents[i]];
+				i = m_Parents[i];
+			}
+			return i;
+		}
+
+		void Union(size_t a, size_t b)
+		{
+			a = Find(a);
+			b = Find(b);
+			if (a != b)
+				m_Parents[std::max(a, b)] = std::min(a, b);
+		}
+
+	  private:
+		std::vector<size_t> m_Parents;
+	};
+
+	struct Island
+	{
+		std::vector<uint32_t> Bodies;
+		std::vector<std::pair<uint32_t, uint32_t>> Pairs;
+	};
+} // namespace
+
+namespace onion::voxel
+{
+	PhysicsSimulation::PhysicsSimulation(WorldManager& worldManager)
+		: m_WorldManager(worldManager), m_PhysicsEngine(worldManager)
+	{
+	}
+
+	PhysicsSimulation::~PhysicsSimulation()
+	{
+		m_ThreadPool.Close();
+	}
+
+	PhysicsSimulation::StepStats PhysicsSimulation::Step(float deltaTime)
+	{
+		return Step(deltaTime, *m_WorldManager.GetEntityStore());
+	}
+
+	PhysicsSimulation::StepStats PhysicsSimulation::Step(float deltaTime, EntityStore& store)
+	{
+		ONION_PROFILE_ZONE("PhysicsSimulation::Step");
+
+		std::lock_guard lock(m_MutexStep);
+
+		// This phase owns the store until the end of the step
+		std::unique_lock lockStore(store.GetMutex());
+
+		StepStats stats;
+		Stopwatch stopwatch;
+		stopwatch.Start();
+
+		// ---- Gather ----
+
+		// Bodies are indexed the same way in bodies, transforms and physicsBodies.
+		// Dynamic bodies first : index < dynamicCount is a dynamic body.
+		std::vector<EntityBroadphase::Body> bodies;
+		std::vector<Transform*> transforms;
+		std::vector<PhysicsBody*> physicsBodies;
+		std::vector<uint32_t> staticBodies;
+
+		std::unordered_map<glm::ivec2, bool> loadedChunks;
+		auto isChunkLoaded = [this, &loadedChunks](const glm::vec3& position)
+		{
+			const glm::ivec2 chunkPosition = Utils::WorldToChunkPosition(glm::ivec3(glm::floor(position)));
+			auto [it, inserted] = loadedChunks.try_emplace(chunkPosition, false);
+			if (inserted)
+				it->second = m_WorldManager.IsChunkLoaded(chunkPosition);
+			return it->second;
+		};
+
+		auto addBody = [&](Transform* transform, PhysicsBody* physicsBody)
+		{
+			const glm::vec3 center = transform->Position + physicsBody->Offset;
+			bodies.push_back({center - physicsBody->HalfSize, center + physicsBody->HalfSize});
+			transforms.push_back(transform);
+			physicsBodies.push_back(physicsBody);
+		};
+
+		ComponentArray<PhysicsBody>& storeBodies = store.PhysicsBodies();
+		for (size_t slot = 0; slot < storeBodies.Size(); slot++)
+		{
+			const uint32_t entity = storeBodies.GetOwners()[slot];
+
+			Transform* transform = store.Transforms().Find(entity);
+			if (!transform)
+				continue;
+
+			if (store.GetRecord(entity).Type == EntityType::Player)
+			{
+				staticBodies.push_back(static_cast<uint32_t>(slot));
+				continue;
+			}
+
+			if (isChunkLoaded(transform->Position))
+				addBody(transform, &storeBodies.GetComponents()[slot]);
+		}
+
+		const size_t dynamicCount = bodies.size();
+
+		for (uint32_t slot : staticBodies)
+		{
+			addBody(store.Transforms().Find(storeBodies.GetOwners()[slot]), &storeBodies.GetComponents()[slot]);
+		}
+
+		// ---- Broadphase ----
+
+		m_Broadphase.Build(std::move(bodies));
+
+		std::vector<std::pair<uint32_t, uint32_t>> pairs;
+		m_Broadphase.FindOverlappingPairs(pairs);
+
+		// Static bodies never touch each other's state
+		std::erase_if(pairs, [dynamicCount](const auto& pair) { return pair.first >= dynamicCount; });
+
+		// ---- Islands ----
+
+		// One bucket per chunk holding dynamic bodies, merged when a contact crosses chunks
+		std::unordered_map<glm::ivec2, size_t> chunkBuckets;
+		std::vector<size_t> bodyBuckets(dynamicCount);
+
+		const std::vector<EntityBroadphase::Body>& boxes = m_Broadphase.GetBodies();
+		for (size_t i = 0; i < dynamicCount; i++)
+		{
+			const glm::ivec3 blockPosition(glm::floor((boxes[i].Min + boxes[i].Max) * 0.5f));
+			const glm::ivec2 chunkPosition = Utils::WorldToChunkPosition(blockPosition);
+
+			auto [it, inserted] = chunkBuckets.try_emplace(chunkPosition, chunkBuckets.size());
+			bodyBuckets[i] = it->second;
+		}
+
+		IslandBuilder islandBuilder(chunkBuckets.size());
+		for (const auto& [a, b] : pairs)
+		{
+			if (b < dynamicCount)
+				islandBuilder.Union(bodyBuckets[a], bodyBuckets[b]);
+		}
+
+		std::vector<Island> islands;
+		std::vector<size_t> islandOfRoot(chunkBuckets.size(), SIZE_MAX);
+
+		auto getIsland = [&](uint32_t body) -> Island&
+		{
+			const size_t root = islandBuilder.Find(bodyBuckets[body]);
+			if (islandOfRoot[root] == SIZE_MAX)
+			{
+				islandOfRoot[root] = islands.size();
+				islands.emplace_back();
+			}
+			return islands[islandOfRoot[root]];
+		};
+
+		for (uint32_t i = 0; i < dynamicCount; i++)
+			getIsland(i).Bodies.push_back(i);
+		for (const auto& pair : pairs)
+			getIsland(pair.first).Pairs.push_back(pair);
+
+		stats.Bodies = dynamicCount;
+		stats.Pairs = pairs.size();
+		stats.Islands = islands.size();
+		stats.BroadphaseMs = stopwatch.ElapsedMs();
+
+		// ---- Solve ----
+
+		stopwatch.Start();
+
+		auto solveIsland = [&](const Island& island)
+		{
+			// Push overlapping bodies apart horizontally, along the axis of least overlap, weighted by mass.
+			// Only the dynamic bodies of this island are written.
+			std::unordered_map<uint32_t, glm::vec3> pushes;
+
+			for (const auto& [a, b] : island.Pairs)
+			{
+				const EntityBroadphase::Body& boxA = boxes[a];
+				const EntityBroadphase::Body& boxB = boxes[b];
+
+				const float overlapX = std::min(boxA.Max.x, boxB.Max.x) - std::max(boxA.Min.x, boxB.Min.x);
+				const float overlapZ = std::min(boxA.Max.z, boxB.Max.z) - std::max(boxA.Min.z, boxB.Min.z);
+				const glm::vec3 delta = (boxA.Min + boxA.Max - boxB.Min - boxB.Max) * 0.5f;
+
+				glm::vec3 push(0.f);
+				if (overlapX < overlapZ)
+					push.x = (delta.x >= 0.f ? 1.f : -1.f) * std::min(overlapX * PUSH_STRENGTH, MAX_PUSH_SPEED);
+				else
+					push.z = (delta.z >= 0.f ? 1.f : -1.f) * std::min(overlapZ * PUSH_STRENGTH, MAX_PUSH_SPEED);
+
+				if (b >= dynamicCount)
+				{
+					pushes[a] += push;
+					continue;
+				}
+
+				const float massA = std::max(physicsBodies[a]->Mass, 0.001f);
+				const float massB = std::max(physicsBodies[b]->Mass, 0.001f);
+				pushes[a] += push * (massB / (massA + massB));
+				pushes[b] -= push * (massA / (massA + massB));
+			}
+
+			for (const auto& [body, push] : pushes)
+			{
+				physicsBodies[body]->Velocity += push;
+			}
+
+			for (uint32_t body : island.Bodies)
+			{
+				m_PhysicsEngine.StepBody(*transforms[body], *physicsBodies[body], deltaTime);
+			}
+		};
+
+		// Spread the islands over the threads, biggest first onto the least loaded thread
+		const size_t threadCount = std::max<size_t>(1, std::min(GetThreadCount(), islands.size()));
+
+		std::vector<size_t> order(islands.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(),
+				  order.end(),
+				  [&islands](size_t a, size_t b) { return islands[a].Bodies.size() > islands[b].Bodies.size(); });
+
+		std::vector<std::vector<size_t>> batches(threadCount);
+		std::vector<size_t> batchLoads(threadCount, 0);
+		for (size_t island : order)
+		{
+			const size_t batch =
+				std::distance(batchLoads.begin(), std::min_element(batchLoads.begin(), batchLoads.end()));
+			batches[batch].push_back(island);
+			batchLoads[batch] += islands[island].Bodies.size() + islands[island].Pairs.size();
+		}
+
+		auto solveBatch = [&](const std::vector<size_t>& batch)
+		{
+			for (size_t island : batch)
+				solveIsland(islands[island]);
+		};
+
+		if (threadCount == 1)
+		{
+			solveBatch(batches[0]);
+		}
+		else
+		{
+			std::mutex errorMutex;
+			std::exception_ptr error;
+
+			std::latch done(static_cast<std::ptrdiff_t>(threadCount));
+			for (const auto& batch : batches)
+			{
+				m_ThreadPool.Dispatch(
+					[&solveBatch, &batch, &done, &errorMutex, &error]()
+					{
+						try
+						{
+							solveBatch(batch);
+						}
+						catch (...)
+						{
+							std::lock_guard lock(errorMutex);
+							if (!error)
+								error = std::current_exception();
+						}
+						done.count_down();
+					});
+			}
+			done.wait();
+
+			if (error)
+				std::rethrow_exception(error);
+		}
+
+		stats.SolveMs = stopwatch.ElapsedMs();
+
+		{
+			std::lock_guard lockStats(m_MutexStats);
+			m_LastStepStats = stats;
+		}
+
+		return stats;
+	}
+
+	PhysicsEngine& PhysicsSimulation::GetPhysicsEngine()
+	{
+		return m_PhysicsEngine;
+	}
+
+	size_t PhysicsSimulation::GetThreadCount() const
+	{
+		return m_ThreadPool.GetPoolsCount();
+	}
+
+	void PhysicsSimulation::SetThreadCount(size_t count)
+	{
+		m_ThreadPool.SetPoolsCount(std::max<size_t>(1, count));
+	}
+
+	PhysicsSimulation::StepStats PhysicsSimulation::GetLastStepStats() const
+	{
+		std::lock_guard lock(m_MutexStats);
+		return m_LastStepStats;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <onion/ThreadPool.hpp>
+
+#include "EntityBroadphase.hpp"
+#include "PhysicsEngine.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Steps the entities of a world, for the server tick.
+	/// Entities touching each other are found with a uniform grid broadphase. Their chunks are merged into islands
+	/// (chunks linked by a contact), and islands are stepped in parallel : an entity is only written by the task
+	/// of its island. Players are driven by their client, they push entities but are not moved.
+	/// Components are read and written in the EntityStore's arrays, not through the Entity façade.
+	class PhysicsSimulation
+	{
+		// ----- Structs -----
+	  public:
+		struct StepStats
+		{
+			size_t Bodies = 0;
+			size_t Pairs = 0;
+			size_t Islands = 0;
+			double BroadphaseMs = 0.0;
+			double SolveMs = 0.0;
+		};
+
+		// ----- Constructor / Destructor -----
+	  public:
+		PhysicsSimulation(WorldManager& worldManager);
+		~PhysicsSimulation();
+
+		// ----- Public API -----
+	  public:
+		/// @brief Step the entities of the world's EntityStore.
+		StepStats Step(float deltaTime);
+
+		/// @brief Step the entities of a store that are in loaded chunks, with the players as static bodies.
+		/// The store is locked exclusively for the whole step : the components are updated in place.
+		StepStats Step(float deltaTime, EntityStore& store);
+
+		// ----- Getters / Setters -----
+	  public:
+		PhysicsEngine& GetPhysicsEngine();
+
+		size_t GetThreadCount() const;
+		void SetThreadCount(size_t count);
+
+		StepStats GetLastStepStats() const;
+
+		// ----- Private Members -----
+	  private:
+		WorldManager& m_WorldManager;
+		PhysicsEngine m_PhysicsEngine;
+
+		ThreadPool m_ThreadPool{4};
+
+		// Serializes the steps, the broadphase is reused between them
+		std::mutex m_MutexStep;
+		EntityBroadphase m_Broadphase{BROADPHASE_CELL_SIZE};
+
+		mutable std::mutex m_MutexStats;
+		StepStats m_LastStepStats;
+
+		// ----- Private Constants -----
+	  private:
+		static constexpr float BROADPHASE_CELL_SIZE = 2.0f; // About two entities wide
+		static constexpr float PUSH_STRENGTH = 20.0f;		// Separation velocity per block of overlap
+		static constexpr float MAX_PUSH_SPEED = 4.0f;		// Bounds the separation velocity of deep overlaps
+	};
+} // namespace onion::voxel
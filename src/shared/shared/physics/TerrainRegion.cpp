@@ -0,0 +1,68 @@
+#include "TerrainRegion.hpp"
+
+#include <algorithm>
+
+#include <shared/utils/Utils.hpp>
+
+namespace onion::voxel
+{
+	void TerrainRegion::Load(const WorldManager& worldManager, const glm::ivec3& min, const glm::ivec3& max)
+	{
+		const CollisionShapeTable& table = CollisionShapeTable::Get();
+		const CollisionShape* empty = &table.GetShape(BlockState(BlockId::Air));
+
+		m_Min = min;
+		m_Max = max;
+		m_Size = max - min + glm::ivec3(1);
+		m_Shapes.assign(static_cast<size_t>(m_Size.x) * m_Size.y * m_Size.z, empty);
+
+		const glm::ivec2 minChunk = Utils::WorldToChunkPosition(min);
+		const glm::ivec2 maxChunk = Utils::WorldToChunkPosition(max);
+
+		for (int cz = minChunk.y; cz <= maxChunk.y; cz++)
+		{
+			for (int cx = minChunk.x; cx <= maxChunk.x; cx++)
+			{
+				std::shared_ptr<Chunk> chunk = worldManager.GetChunk({cx, cz});
+				if (!chunk)
+					continue;
+
+				// Part of the region inside this chunk, in world space
+				const glm::ivec3 chunkOrigin(cx * WorldConstants::CHUNK_SIZE, 0, cz * WorldConstants::CHUNK_SIZE);
+				const glm::ivec3 partMin(std::max(min.x, chunkOrigin.x), min.y, std::max(min.z, chunkOrigin.z));
+				const glm::ivec3 partMax(std::min(max.x, chunkOrigin.x + WorldConstants::CHUNK_SIZE - 1),
+										 max.y,
+										 std::min(max.z, chunkOrigin.z + WorldConstants::CHUNK_SIZE - 1));
+
+				chunk->GetBlocks(partMin - chunkOrigin, partMax - chunkOrigin, m_ChunkBlocks);
+
+				size_t i = 0;
+				for (int z = partMin.z; z <= partMax.z; z++)
+					for (int y = partMin.y; y <= partMax.y; y++)
+					{
+						const glm::ivec3 p = glm::ivec3(partMin.x, y, z) - min;
+						size_t index = p.x + static_cast<size_t>(p.y) * m_Size.x +
+							static_cast<size_t>(p.z) * m_Size.x * m_Size.y;
+						for (int x = partMin.x; x <= partMax.x; x++)
+						{
+							m_Shapes[index++] = &table.GetShape(m_ChunkBlocks[i++]);
+						}
+					}
+			}
+		}
+	}
+
+	bool TerrainRegion::Contains(const glm::ivec3& min, const glm::ivec3& max) const
+	{
+		return glm::all(glm::greaterThanEqual(min, m_Min)) && glm::all(glm::lessThanEqual(max, m_Max));
+	}
+
+	const CollisionShape& TerrainRegion::GetShape(const glm::ivec3& worldPosition) const
+	{
+		if (!Contains(worldPosition, worldPosition))
+			return CollisionShapeTable::Get().GetShape(BlockState(BlockId::Air));
+
+		const glm::ivec3 p = worldPosition - m_Min;
+		return *m_Shapes[p.x + static_cast<size_t>(p.y) * m_Size.x + static_cast<size_t>(p.z) * m_Size.x * m_Size.y];
+	}
+} // namespace onion::voxel
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+#include <shared/world/world_manager/WorldManager.hpp>
+
+#include "CollisionShapes.hpp"
+
+namespace onion::voxel
+{
+	/// @brief Collision shapes of a box of blocks, copied from the world once per query.
+	/// Each chunk overlapped is locked once, instead of once per block. The buffers are kept between loads,
+	/// so a region reused by the same thread does not allocate once warmed up.
+	class TerrainRegion
+	{
+		// ----- Public API -----
+	  public:
+		/// @brief Copy the blocks of the world box [min, max]. Blocks of unloaded chunks are air.
+		void Load(const WorldManager& worldManager, const glm::ivec3& min, const glm::ivec3& max);
+
+		bool Contains(const glm::ivec3& min, const glm::ivec3& max) const;
+
+		/// @brief Get the collision shape of a block in the region. Blocks outside of the region are empty.
+		const CollisionShape& GetShape(const glm::ivec3& worldPosition) const;
+
+		// ----- Private Members -----
+	  private:
+		glm::ivec3 m_Min{0};
+		glm::ivec3 m_Max{-1};
+		glm::ivec3 m_Size{0};
+
+		// x first, then y, then z
+		std::vector<const CollisionShape*> m_Shapes;
+		std::vector<BlockState> m_ChunkBlocks;
+	};
+} // namespace onion::voxel
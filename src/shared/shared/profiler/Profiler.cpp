@@ -0,0 +1,446 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace onion::voxel
+{
+	namespace
+	{
+		struct TraceEvent
+		{
+			std::atomic<const char*> Name{nullptr};
+			std::atomic<int64_t> StartNs{0};
+			std::atomic<int64_t> DurationNs{0};
+		};
+
+		// Events of one thread, overwriting the oldest ones. Written by its thread only, read by the exports.
+		struct ThreadBuffer
+		{
+			static constexpr uint64_t CAPACITY = 8192; // Power of two
+
+			// Written before the event (an export seeing the event sees it), then Head once the event is complete
+			std::atomic<uint64_t> Reserved{0};
+			std::atomic<uint64_t> Head{0};
+			std::array<TraceEvent, CAPACITY> Events;
+
+			std::atomic_bool InUse{false};
+
+			// Guarded by the state mutex
+			uint32_t ThreadId = 0;
+			std::string ThreadName;
+			uint64_t FirstEvent = 0; // Events before belong to a thread that exited
+		};
+
+		struct ProfilerState
+		{
+			std::mutex Mutex;
+
+			std::vector<std::unique_ptr<ThreadBuffer>> ThreadBuffers;
+			uint32_t NextThreadId = 1;
+
+			// Pointers stay valid : nothing is ever removed
+			std::unordered_map<std::string, std::unique_ptr<ProfileZoneSite>> ZoneSites;
+			std::unordered_map<std::string, std::unique_ptr<ProfileCounter>> Counters;
+			std::unordered_map<std::string, std::unique_ptr<ProfileHistogram>> Histograms;
+
+			int64_t LastResetNs = 0;
+		};
+
+		ProfilerState& GetState()
+		{
+			// Never destroyed : threads may still record while the static objects are destroyed
+			static ProfilerState* state = new ProfilerState();
+			return *state;
+		}
+
+		// Gives the buffer back when its thread exits, a new thread reuses it
+		struct ThreadBufferOwner
+		{
+			ThreadBuffer* Buffer = nullptr;
+
+			~ThreadBufferOwner()
+			{
+				if (Buffer)
+					Buffer->InUse.store(false, std::memory_order_release);
+			}
+		};
+
+		thread_local ThreadBufferOwner t_ThreadBufferOwner;
+
+		ThreadBuffer& GetThreadBuffer()
+		{
+			if (t_ThreadBufferOwner.Buffer)
+				return *t_ThreadBufferOwner.Buffer;
+
+			ProfilerState& state = GetState();
+			std::lock_guard lock(state.Mutex);
+
+			ThreadBuffer* buffer = nullptr;
+			for (const auto& candidate : state.ThreadBuffers)
+			{
+				if (!candidate->InUse.load(std::memory_order_acquire))
+				{
+					buffer = candidate.get();
+					break;
+				}
+			}
+
+			if (!buffer)
+			{
+				state.ThreadBuffers.push_back(std::make_unique<ThreadBuffer>());
+				buffer = state.ThreadBuffers.back().get();
+			}
+
+			buffer->InUse.store(true, std::memory_order_relaxed);
+			buffer->ThreadId = state.NextThreadId++;
+			buffer->ThreadName = "Thread " + std::to_string(buffer->ThreadId);
+			buffer->FirstEvent = buffer->Head.load(std::memory_order_relaxed);
+
+			t_ThreadBufferOwner.Buffer = buffer;
+			return *buffer;
+		}
+
+		struct CopiedEvent
+		{
+			const char* Name;
+			int64_t StartNs;
+			int64_t DurationNs;
+		};
+
+		/// @brief Events of the buffer still readable. State mutex must be held.
+		std::vector<CopiedEvent> CopyEvents(const ThreadBuffer& buffer)
+		{
+			const uint64_t head = buffer.Head.load(std::memory_order_acquire);
+			const uint64_t first =
+				std::max(buffer.FirstEvent, head > ThreadBuffer::CAPACITY ? head - ThreadBuffer::CAPACITY : 0);
+
+			std::vector<CopiedEvent> events;
+			events.reserve(static_cast<size_t>(head - first));
+			for (uint64_t i = first; i < head; i++)
+			{
+				const TraceEvent& event = buffer.Events[i & (ThreadBuffer::CAPACITY - 1)];
+				events.push_back({event.Name.load(std::memory_order_relaxed),
+								  event.StartNs.load(std::memory_order_relaxed),
+								  event.DurationNs.load(std::memory_order_relaxed)});
+			}
+
+			// Drop the events the thread overwrote while they were copied
+			std::atomic_thread_fence(std::memory_order_acquire);
+			const uint64_t reserved = buffer.Reserved.load(std::memory_order_relaxed);
+			const uint64_t firstValid = reserved > ThreadBuffer::CAPACITY ? reserved - ThreadBuffer::CAPACITY : 0;
+			if (firstValid > first)
+				events.erase(events.begin(),
+							 events.begin() + static_cast<std::ptrdiff_t>(std::min(firstValid - first, head - first)));
+
+			return events;
+		}
+
+		std::string FormatMs(uint64_t ns)
+		{
+			char text[32];
+			std::snprintf(text, sizeof(text), "%.3f", static_cast<double>(ns) / 1e6);
+			return text;
+		}
+
+		template <typename T>
+		std::vector<std::pair<std::string, T*>> SortedByName(
+			const std::unordered_map<std::string, std::unique_ptr<T>>& map)
+		{
+			std::vector<std::pair<std::string, T*>> sorted;
+			sorted.reserve(map.size());
+			for (const auto& [name, value] : map)
+				sorted.emplace_back(name, value.get());
+			std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+			return sorted;
+		}
+	} // namespace
+
+	// ----- Profile Histogram -----
+
+	void ProfileHistogram::Record(uint64_t value)
+	{
+		const size_t bucket = value == 0 ? 0 : std::min<size_t>(std::bit_width(value), BUCKET_COUNT - 1);
+
+		m_Buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+		m_Count.fetch_add(1, std::memory_order_relaxed);
+		m_Sum.fetch_add(value, std::memory_order_relaxed);
+
+		uint64_t max = m_Max.load(std::memory_order_relaxed);
+		while (value > max && !m_Max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	ProfileHistogram::Snapshot ProfileHistogram::GetSnapshot() const
+	{
+		Snapshot snapshot;
+		snapshot.Count = m_Count.load(std::memory_order_relaxed);
+		snapshot.Sum = m_Sum.load(std::memory_order_relaxed);
+		snapshot.Max = m_Max.load(std::memory_order_relaxed);
+		for (size_t i = 0; i < BUCKET_COUNT; i++)
+			snapshot.Buckets[i] = m_Buckets[i].load(std::memory_order_relaxed);
+		return snapshot;
+	}
+
+	ProfileHistogram::Snapshot ProfileHistogram::TakeSnapshot()
+	{
+		Snapshot snapshot;
+		snapshot.Count = m_Count.exchange(0, std::memory_order_relaxed);
+		snapshot.Sum = m_Sum.exchange(0, std::memory_order_relaxed);
+		snapshot.Max = m_Max.exchange(0, std::memory_order_relaxed);
+		for (size_t i = 0; i < BUCKET_COUNT; i++)
+			snapshot.Buckets[i] = m_Buckets[i].exchange(0, std::memory_order_relaxed);
+		return snapshot;
+	}
+
+	double ProfileHistogram::Snapshot::GetAverage() const
+	{
+		return Count == 0 ? 0.0 : static_cast<double>(Sum) / static_cast<double>(Count);
+	}
+
+	uint64_t ProfileHistogram::Snapshot::GetPercentile(double percentile) const
+	{
+		// From the buckets rather than Count : a snapshot taken while recording may disagree by a few values
+		uint64_t total = 0;
+		for (uint64_t count : Buckets)
+			total += count;
+		if (total == 0)
+			return 0;
+
+		const double rank = std::clamp(percentile, 0.0, 1.0) * static_cast<double>(total);
+		uint64_t cumulated = 0;
+		for (size_t i = 0; i < BUCKET_COUNT; i++)
+		{
+			cumulated += Buckets[i];
+			if (static_cast<double>(cumulated) >= rank && Buckets[i] > 0)
+			{
+				const uint64_t upperBound = i == 0 ? 0 : (uint64_t{1} << i) - 1;
+				return std::min(upperBound, Max);
+			}
+		}
+
+		return Max;
+	}
+
+	// ----- Profiler -----
+
+	ProfileZoneSite& Profiler::GetZoneSite(const char* name)
+	{
+		ProfilerState& state = GetState();
+		std::lock_guard lock(state.Mutex);
+
+		auto [it, inserted] = state.ZoneSites.try_emplace(name);
+		if (inserted)
+		{
+			it->second = std::make_unique<ProfileZoneSite>();
+			it->second->Name = it->first.c_str();
+		}
+		return *it->second;
+	}
+
+	ProfileCounter& Profiler::GetCounter(const char* name)
+	{
+		ProfilerState& state = GetState();
+		std::lock_guard lock(state.Mutex);
+
+		auto [it, inserted] = state.Counters.try_emplace(name);
+		if (inserted)
+			it->second = std::make_unique<ProfileCounter>();
+		return *it->second;
+	}
+
+	ProfileHistogram& Profiler::GetHistogram(const char* name)
+	{
+		ProfilerState& state = GetState();
+		std::lock_guard lock(state.Mutex);
+
+		auto [it, inserted] = state.Histograms.try_emplace(name);
+		if (inserted)
+			it->second = std::make_unique<ProfileHistogram>();
+		return *it->second;
+	}
+
+	void Profiler::SetEnabled(bool enabled)
+	{
+		s_Enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	void Profiler::SetThreadName(const std::string& name)
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+
+		std::lock_guard lock(GetState().Mutex);
+		buffer.ThreadName = name;
+	}
+
+	int64_t Profiler::Now()
+	{
+		static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+	}
+
+	void Profiler::EndZone(ProfileZoneSite& site, int64_t startNs)
+	{
+		const int64_t durationNs = Now() - startNs;
+		site.DurationsNs.Record(static_cast<uint64_t>(durationNs));
+
+		ThreadBuffer& buffer = GetThreadBuffer();
+		const uint64_t head = buffer.Head.load(std::memory_order_relaxed);
+
+		buffer.Reserved.store(head + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		TraceEvent& event = buffer.Events[head & (ThreadBuffer::CAPACITY - 1)];
+		event.Name.store(site.Name, std::memory_order_relaxed);
+		event.StartNs.store(startNs, std::memory_order_relaxed);
+		event.DurationNs.store(durationNs, std::memory_order_relaxed);
+
+		buffer.Head.store(head + 1, std::memory_order_release);
+	}
+
+	bool Profiler::WriteChromeTrace(const std::filesystem::path& filePath)
+	{
+		std::ofstream file(filePath);
+		if (!file.is_open())
+		{
+			std::cerr << "[Profiler] Failed to open " << filePath << " for writing" << std::endl;
+			return false;
+		}
+
+		ProfilerState& state = GetState();
+		std::lock_guard lock(state.Mutex);
+
+		// Written as it goes : a full trace holds hundreds of thousands of events
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+		bool first = true;
+		auto separator = [&]()
+		{
+			if (!first)
+				file << ",\n";
+			first = false;
+		};
+
+		char timing[96];
+		for (const auto& buffer : state.ThreadBuffers)
+		{
+			separator();
+			file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->ThreadId
+				 << ",\"args\":{\"name\":" << nlohmann::json(buffer->ThreadName).dump() << "}}";
+
+			for (const CopiedEvent& event : CopyEvents(*buffer))
+			{
+				// Microseconds, with the nanoseconds as decimals
+				std::snprintf(timing,
+							  sizeof(timing),
+							  "\"ts\":%.3f,\"dur\":%.3f",
+							  static_cast<double>(event.StartNs) / 1e3,
+							  static_cast<double>(event.DurationNs) / 1e3);
+
+				separator();
+				file << "{\"name\":" << nlohmann::json(event.Name).dump() << ",\"ph\":\"X\"," << timing
+					 << ",\"pid\":1,\"tid\":" << buffer->ThreadId << "}";
+			}
+		}
+
+		file << "\n]}\n";
+		return file.good();
+	}
+
+	std::string Profiler::GetSummary(bool reset)
+	{
+		ProfilerState& state = GetState();
+		std::lock_guard lock(state.Mutex);
+
+		const int64_t now = Now();
+		const double intervalSeconds = static_cast<double>(now - state.LastResetNs) / 1e9;
+		if (reset)
+			state.LastResetNs = now;
+
+		std::string summary;
+		char line[256];
+
+		std::snprintf(line, sizeof(line), "[Profiler] Summary of the last %.1f s\n", intervalSeconds);
+		summary += line;
+
+		// ---- Zones, slowest total first ----
+		std::vector<std::pair<const char*, ProfileHistogram::Snapshot>> zones;
+		for (const auto& [name, site] : state.ZoneSites)
+		{
+			ProfileHistogram::Snapshot snapshot =
+				reset ? site->DurationsNs.TakeSnapshot() : site->DurationsNs.GetSnapshot();
+			if (snapshot.Count > 0)
+				zones.emplace_back(site->Name, snapshot);
+		}
+		std::sort(zones.begin(), zones.end(), [](const auto& a, const auto& b) { return a.second.Sum > b.second.Sum; });
+
+		if (!zones.empty())
+		{
+			std::snprintf(line,
+						  sizeof(line),
+						  "  %-44s %10s %12s %10s %10s %10s %10s\n",
+						  "Zone",
+						  "Count",
+						  "Total ms",
+						  "Avg ms",
+						  "p50 ms",
+						  "p99 ms",
+						  "Max ms");
+			summary += line;
+		}
+
+		for (const auto& [name, snapshot] : zones)
+		{
+			std::snprintf(line,
+						  sizeof(line),
+						  "  %-44s %10llu %12s %10s %10s %10s %10s\n",
+						  name,
+						  static_cast<unsigned long long>(snapshot.Count),
+						  FormatMs(snapshot.Sum).c_str(),
+						  FormatMs(static_cast<uint64_t>(snapshot.GetAverage())).c_str(),
+						  FormatMs(snapshot.GetPercentile(0.5)).c_str(),
+						  FormatMs(snapshot.GetPercentile(0.99)).c_str(),
+						  FormatMs(snapshot.Max).c_str());
+			summary += line;
+		}
+
+		// ---- Counters, totals since the start ----
+		for (const auto& [name, counter] : SortedByName(state.Counters))
+		{
+			std::snprintf(line, sizeof(line), "  %-44s %10lld\n", name.c_str(), static_cast<long long>(counter->Get()));
+			summary += line;
+		}
+
+		// ---- Histograms ----
+		for (const auto& [name, histogram] : SortedByName(state.Histograms))
+		{
+			const ProfileHistogram::Snapshot snapshot = reset ? histogram->TakeSnapshot() : histogram->GetSnapshot();
+			if (snapshot.Count == 0)
+				continue;
+
+			std::snprintf(line,
+						  sizeof(line),
+						  "  %-44s %10llu values, avg %.1f, p50 %llu, p99 %llu, max %llu\n",
+						  name.c_str(),
+						  static_cast<unsigned long long>(snapshot.Count),
+						  snapshot.GetAverage(),
+						  static_cast<unsigned long long>(snapshot.GetPercentile(0.5)),
+						  static_cast<unsigned long long>(snapshot.GetPercentile(0.99)),
+						  static_cast<unsigned long long>(snapshot.Max));
+			summary += line;
+		}
+
+		return summary;
+	}
+} // namespace onion::voxel
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace onion::voxel
+{
+	/// @brief Distribution of values (durations, sizes...) in power of two buckets.
+	/// Recording is lock free, a few relaxed atomic adds : it can be called from any hot path.
+	class ProfileHistogram
+	{
+		// ----- Structs -----
+	  public:
+		static constexpr size_t BUCKET_COUNT = 64; // Bucket i holds the values in [2^(i-1), 2^i), bucket 0 holds 0
+
+		struct Snapshot
+		{
+			uint64_t Count = 0;
+			uint64_t Sum = 0;
+			uint64_t Max = 0;
+			std::array<uint64_t, BUCKET_COUNT> Buckets{};
+
+			double GetAverage() const;
+			/// @brief Upper bound of the bucket holding the percentile (at most 2x the real value).
+			/// @param percentile In [0, 1].
+			uint64_t GetPercentile(double percentile) const;
+		};
+
+		// ----- Public API -----
+	  public:
+		void Record(uint64_t value);
+
+		Snapshot GetSnapshot() const;
+		/// @brief Snapshot, then start over. Values recorded meanwhile go to one side or the other.
+		Snapshot TakeSnapshot();
+
+		// ----- Private Members -----
+	  private:
+		std::atomic<uint64_t> m_Count{0};
+		std::atomic<uint64_t> m_Sum{0};
+		std::atomic<uint64_t> m_Max{0};
+		std::array<std::atomic<uint64_t>, BUCKET_COUNT> m_Buckets{};
+	};
+
+	/// @brief Named value, added to from any thread (bytes sent, chunks saved...).
+	class ProfileCounter
+	{
+		// ----- Public API -----
+	  public:
+		void Add(int64_t value = 1) { m_Value.fetch_add(value, std::memory_order_relaxed); }
+		int64_t Get() const { return m_Value.load(std::memory_order_relaxed); }
+
+		// ----- Private Members -----
+	  private:
+		std::atomic<int64_t> m_Value{0};
+	};
+
+	/// @brief A place in the code timed with ONION_PROFILE_ZONE. Its durations are kept in nanoseconds.
+	struct ProfileZoneSite
+	{
+		const char* Name = nullptr;
+		ProfileHistogram DurationsNs;
+	};
+
+	/// @brief Scoped zones, counters and histograms for the whole process.
+	///
+	/// A zone times its scope : the duration goes to the histogram of its site, and a trace event goes to a ring
+	/// buffer owned by the thread, written without any lock. The last events of every thread can be exported as a
+	/// Chrome trace (chrome://tracing, ui.perfetto.dev) and the histograms printed as a text summary.
+	/// Names are looked up once per call site by the macros, recording never touches a map or a lock.
+	class Profiler
+	{
+		// ----- Public API -----
+	  public:
+		static ProfileZoneSite& GetZoneSite(const char* name);
+		static ProfileCounter& GetCounter(const char* name);
+		static ProfileHistogram& GetHistogram(const char* name);
+
+		static bool IsEnabled() { return s_Enabled.load(std::memory_order_relaxed); }
+		/// @brief Zones started while disabled are not recorded. Counters and histograms always are.
+		static void SetEnabled(bool enabled);
+
+		/// @brief Name of the calling thread in the traces.
+		static void SetThreadName(const std::string& name);
+
+		/// @brief Write the events still in the ring buffers as a Chrome trace JSON file.
+		static bool WriteChromeTrace(const std::filesystem::path& filePath);
+
+		/// @brief Zones (slowest total first), counters and histograms, as a text table.
+		/// @param reset Start the zones and histograms over, so the next summary covers the next interval only.
+		static std::string GetSummary(bool reset);
+
+		/// @brief Nanoseconds since the profiler started, on a steady clock.
+		static int64_t Now();
+
+		/// @brief Called by ProfileZone at the end of its scope.
+		static void EndZone(ProfileZoneSite& site, int64_t startNs);
+
+		// ----- Private Members -----
+	  private:
+		static inline std::atomic_bool s_Enabled{true};
+	};
+
+	/// @brief Times its scope. Use through ONION_PROFILE_ZONE.
+	class ProfileZone
+	{
+		// ----- Constructor / Destructor -----
+	  public:
+		explicit ProfileZone(ProfileZoneSite& site)
+			: m_Site(site), m_StartNs(Profiler::IsEnabled() ? Profiler::Now() : -1)
+		{
+		}
+
+		~ProfileZone()
+		{
+			if (m_StartNs >= 0)
+				Profiler::EndZone(m_Site, m_StartNs);
+		}
+
+		ProfileZone(const ProfileZone&) = delete;
+		ProfileZone& operator=(const ProfileZone&) = delete;
+
+		// ----- Private Members -----
+	  private:
+		ProfileZoneSite& m_Site;
+		int64_t m_StartNs;
+	};
+} // namespace onion::voxel
+
+#define ONION_PROFILE_CONCAT_INNER(a, b) a##b
+#define ONION_PROFILE_CONCAT(a, b) ONION_PROFILE_CONCAT_INNER(a, b)
+
+// Times the rest of the scope. The site is looked up once, the first time the line runs.
+#define ONION_PROFILE_ZONE(name)                                                                                       \
+	static ::onion::voxel::ProfileZoneSite& ONION_PROFILE_CONCAT(onionProfileSite_, __LINE__) =                        \
+		::onion::voxel::Profiler::GetZoneSite(name);                                                                   \
+	::onion::voxel::ProfileZone ONION_PROFILE_CONCAT(onionProfileZone_, __LINE__)(                                     \
+		ONION_PROFILE_CONCAT(onionProfileSite_, __LINE__))
+
+// Adds to a counter. The counter is looked up once, the first time the line runs.
+#define ONION_PROFILE_COUNT(name, value)                                                                               \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		static ::onion::voxel::ProfileCounter& onionCounter = ::onion::voxel::Profiler::GetCounter(name);              \
+		onionCounter.Add(static_cast<int64_t>(value));                                                                 \
+	} while (0)
+
+// Records a value in a histogram. The histogram is looked up once, the first time the line runs.
+#define ONION_PROFILE_RECORD(name, value)                                                                              \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		static ::onion::voxel::ProfileHistogram& onionHistogram = ::onion::voxel::Profiler::GetHistogram(name);        \
+		onionHistogram.Record(static_cast<uint64_t>(value));                                                           \
+	} while (0)
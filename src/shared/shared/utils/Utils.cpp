@@ -4,6 +4,7 @@
 #include <cctype>
 #include <cstdlib>
 #include <filesystem>
+#include <fstream>
 #include <random>
 #include <string>
 
@@ -11,11 +12,17 @@
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <Windows.h>
+#include <Psapi.h>
 #else
 #include <limits.h>
 #include <unistd.h>
 #endif
 
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define ONION_VOXEL_HAS_MALLINFO2
+#endif
+
 namespace onion::voxel::Utils
 {
 
@@ -147,4 +154,34 @@ namespace onion::voxel::Utils
 #endif
 	}
 
+	MemoryUsage GetMemoryUsage()
+	{
+		MemoryUsage usage;
+
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS_EX counters{};
+		if (GetProcessMemoryInfo(
+				GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&counters), sizeof(counters)))
+		{
+			usage.ResidentBytes = counters.WorkingSetSize;
+			usage.HeapBytes = counters.PrivateUsage;
+		}
+#elif defined(__linux__)
+		// Pages : total size, then resident
+		std::ifstream statm("/proc/self/statm");
+		uint64_t sizePages = 0;
+		uint64_t residentPages = 0;
+		if (statm >> sizePages >> residentPages)
+			usage.ResidentBytes = residentPages * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+
+#ifdef ONION_VOXEL_HAS_MALLINFO2
+		// Small blocks in use, plus the large ones mapped on their own
+		const struct mallinfo2 info = mallinfo2();
+		usage.HeapBytes = info.uordblks + info.hblkhd;
+#endif
+
+		return usage;
+	}
+
 } // namespace onion::voxel::Utils
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 
 #include <glm/glm.hpp>
@@ -54,4 +55,13 @@ namespace onion::voxel::Utils
 
 	void ReplaceFileAtomic(const std::filesystem::path& targetPath, const std::filesystem::path& tempFilePath);
 
+	/// @brief Memory of the process. Values the platform does not give are 0.
+	struct MemoryUsage
+	{
+		uint64_t ResidentBytes = 0; // Physical memory used by the process
+		uint64_t HeapBytes = 0;		// Allocated through the heap and not freed yet (private bytes on Windows)
+	};
+
+	MemoryUsage GetMemoryUsage();
+
 }; // namespace onion::voxel::Utils
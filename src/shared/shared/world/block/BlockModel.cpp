@@ -263,17 +263,29 @@ namespace onion::voxel
 
 	const BlockModel& BlockModel::GetModel(const std::filesystem::path& path)
 	{
-		std::unique_lock lock(s_CacheMutex);
+		CacheEntry* entry = nullptr;
 
-		auto it = s_ModelCache.find(path);
-		if (it != s_ModelCache.end())
-			return it->second;
+		{
+			std::shared_lock lock(s_CacheMutex);
+			auto it = s_ModelCache.find(path);
+			if (it != s_ModelCache.end())
+				entry = it->second.get();
+		}
 
-		BlockModel model = BlockModel::LoadModelRecursive(path);
+		if (!entry)
+		{
+			std::unique_lock lock(s_CacheMutex);
+			auto [it, inserted] = s_ModelCache.try_emplace(path);
+			if (inserted)
+				it->second = std::make_unique<CacheEntry>();
+			entry = it->second.get();
+		}
 
-		auto [insertedIt, inserted] = s_ModelCache.emplace(path, std::move(model));
+		// Loads the parents through GetModel as well, no lock is held meanwhile.
+		// If the load throws, the next caller tries again.
+		std::call_once(entry->Loaded, [entry, &path]() { entry->Model = BlockModel::LoadModelRecursive(path); });
 
-		return insertedIt->second;
+		return entry->Model;
 	}
 
 	void BlockModel::ClearCache()
@@ -2,8 +2,10 @@
 
 #include <array>
 #include <filesystem>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 
@@ -67,6 +69,7 @@ namespace onion::voxel
 
 		// ----- Public API -----
 	  public:
+		/// Must not be called while models are loading. Reads from the archive are then thread safe.
 		static void SetModelArchive(const std::filesystem::path& archiveFilePath);
 		static BlockModel FromFile(const std::string& filename);
 		static void ClearCache();
@@ -91,9 +94,20 @@ namespace onion::voxel
 
 		// ----- Static Private Members -----
 	  private:
-		static inline std::unique_ptr<ZipArchive> s_ModelArchive;
-		static inline std::unordered_map<std::filesystem::path, BlockModel> s_ModelCache;
-		static inline std::recursive_mutex s_CacheMutex;
+		/// A cached model, loaded once by the first thread asking for it. Threads asking for the same model meanwhile
+		/// wait for that load instead of loading it again, the others are not blocked.
+		struct CacheEntry
+		{
+			std::once_flag Loaded;
+			BlockModel Model;
+		};
+
+		static inline std::unique_ptr<ZipArchive> s_ModelArchive; // Thread safe reads, set before any load
+
+		static inline std::unordered_map<std::filesystem::path, std::unique_ptr<CacheEntry>> s_ModelCache;
+		static inline std::shared_mutex s_CacheMutex; // Only guards the map, not the loads
+
+		/// Thread safe. Must not be called concurrently with ClearCache.
 		static const BlockModel& GetModel(const std::filesystem::path& path);
 	};
 } // namespace onion::voxel
@@ -0,0 +1,268 @@
+#include "BlockPropertyTable.hpp"
+
+#include <shared/world/block/BlockIds.hpp>
+#include <shared/world/block/BlockstateRegistry.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+
+namespace onion::voxel
+{
+	const BlockPropertyTable& BlockPropertyTable::Get()
+	{
+		static const BlockPropertyTable table;
+		return table;
+	}
+
+	BlockPropertyTable::BlockPropertyTable()
+	{
+		const auto& registry = BlockstateRegistry::Get();
+		m_Blocks.resize(static_cast<size_t>(BlockId::Count));
+
+		for (const auto& [id, variants] : registry)
+		{
+			const size_t blockIndex = static_cast<size_t>(id);
+			if (blockIndex >= m_Blocks.size() || variants.empty())
+				continue;
+
+			BlockEntry& entry = m_Blocks[blockIndex];
+
+			// ---- Keys of the block and their values, in first-seen order ----
+			for (const auto& variant : variants)
+			{
+				for (const auto& [key, value] : variant.Properties)
+				{
+					const PropertyId keyId = Intern(m_KeyIds, m_KeyNames, key);
+					const PropertyId valueId = Intern(m_ValueIds, m_ValueNames, value);
+
+					auto fieldIt = std::find_if(entry.Keys.begin(),
+												entry.Keys.end(),
+												[keyId](const KeyField& field) { return field.Key == keyId; });
+					if (fieldIt == entry.Keys.end())
+					{
+						entry.Keys.emplace_back();
+						entry.Keys.back().Key = keyId;
+						fieldIt = entry.Keys.end() - 1;
+					}
+
+					if (std::find(fieldIt->Values.begin(), fieldIt->Values.end(), valueId) == fieldIt->Values.end())
+						fieldIt->Values.push_back(valueId);
+				}
+			}
+
+			// ---- Bitfield layout ----
+			uint32_t shift = 0;
+			uint32_t transitionOffset = 0;
+			for (KeyField& field : entry.Keys)
+			{
+				// Values + "no value"
+				uint8_t bits = 0;
+				while ((size_t(1) << bits) <= field.Values.size())
+					bits++;
+
+				field.Shift = static_cast<uint8_t>(shift);
+				field.Bits = bits;
+				field.TransitionOffset = transitionOffset;
+
+				shift += bits;
+				transitionOffset += static_cast<uint32_t>(field.Values.size() + 1);
+			}
+
+			if (shift > 64)
+			{
+				std::cerr << "[BlockPropertyTable] Too many properties to pack for " << BlockIds::GetName(id)
+						  << ", its properties are not compiled.\n";
+				entry = {};
+				continue;
+			}
+
+			entry.TransitionStride = transitionOffset;
+
+			// ---- Packed variants (first variant of each bitfield wins, like GetVariantIndex) ----
+			std::unordered_map<uint64_t, uint8_t>& variantByPacked = entry.VariantByPacked;
+			const size_t variantCount = std::min<size_t>(variants.size(), UINT8_MAX + 1);
+			entry.PackedVariants.reserve(variantCount);
+
+			for (size_t v = 0; v < variantCount; v++)
+			{
+				uint64_t packed = 0;
+				for (const auto& [key, value] : variants[v].Properties)
+				{
+					const KeyField* field = FindField(entry, m_KeyIds.at(key));
+					const PropertyId valueId = m_ValueIds.at(value);
+					const size_t slot =
+						std::find(field->Values.begin(), field->Values.end(), valueId) - field->Values.begin() + 1;
+
+					packed |= static_cast<uint64_t>(slot) << field->Shift;
+				}
+
+				entry.PackedVariants.push_back(packed);
+				variantByPacked.try_emplace(packed, static_cast<uint8_t>(v));
+			}
+
+			// ---- Transitions : variant x (key = value) -> variant ----
+			entry.Transitions.resize(variantCount * entry.TransitionStride);
+
+			for (size_t v = 0; v < variantCount; v++)
+			{
+				const uint64_t packed = entry.PackedVariants[v];
+				uint8_t* row = entry.Transitions.data() + v * entry.TransitionStride;
+
+				for (const KeyField& field : entry.Keys)
+				{
+					const uint64_t mask = ((uint64_t(1) << field.Bits) - 1) << field.Shift;
+
+					for (size_t slot = 0; slot <= field.Values.size(); slot++)
+					{
+						const uint64_t target = (packed & ~mask) | (static_cast<uint64_t>(slot) << field.Shift);
+
+						auto it = variantByPacked.find(target);
+						if (it != variantByPacked.end())
+						{
+							row[field.TransitionOffset + slot] = it->second;
+							continue;
+						}
+
+						// No variant with exactly these properties (partial multipart domains, gui variants)
+						std::map<std::string, std::string> properties = variants[v].Properties;
+						if (slot == 0)
+							properties.erase(m_KeyNames[field.Key]);
+						else
+							properties[m_KeyNames[field.Key]] = m_ValueNames[field.Values[slot - 1]];
+
+						row[field.TransitionOffset + slot] = BlockstateRegistry::GetVariantIndex(id, properties);
+					}
+				}
+			}
+		}
+	}
+
+	PropertyId BlockPropertyTable::GetKeyId(const std::string& key) const
+	{
+		auto it = m_KeyIds.find(key);
+		return it != m_KeyIds.end() ? it->second : INVALID_PROPERTY;
+	}
+
+	PropertyId BlockPropertyTable::GetValueId(const std::string& value) const
+	{
+		auto it = m_ValueIds.find(value);
+		return it != m_ValueIds.end() ? it->second : INVALID_PROPERTY;
+	}
+
+	const std::string& BlockPropertyTable::GetValueName(PropertyId value) const
+	{
+		static const std::string empty;
+		return value < m_ValueNames.size() ? m_ValueNames[value] : empty;
+	}
+
+	bool BlockPropertyTable::HasProperty(BlockId id, PropertyId key) const
+	{
+		const BlockEntry* entry = GetEntry(id);
+		return entry && FindField(*entry, key) != nullptr;
+	}
+
+	PropertyId BlockPropertyTable::GetValue(const BlockState& state, PropertyId key) const
+	{
+		const BlockEntry* entry = GetEntry(state.ID);
+		if (!entry || state.VariantIndex >= entry->PackedVariants.size())
+			return INVALID_PROPERTY;
+
+		const KeyField* field = FindField(*entry, key);
+		if (!field)
+			return INVALID_PROPERTY;
+
+		const uint64_t slot = (entry->PackedVariants[state.VariantIndex] >> field->Shift) &
+			((uint64_t(1) << field->Bits) - 1);
+
+		return slot == 0 ? INVALID_PROPERTY : field->Values[slot - 1];
+	}
+
+	uint8_t BlockPropertyTable::WithValue(const BlockState& state, PropertyId key, PropertyId value) const
+	{
+		const BlockEntry* entry = GetEntry(state.ID);
+		if (!entry || state.VariantIndex >= entry->PackedVariants.size())
+			return state.VariantIndex;
+
+		const KeyField* field = FindField(*entry, key);
+		if (!field)
+			return state.VariantIndex;
+
+		auto valueIt = std::find(field->Values.begin(), field->Values.end(), value);
+		if (valueIt == field->Values.end())
+			return state.VariantIndex;
+
+		const size_t slot = static_cast<size_t>(valueIt - field->Values.begin()) + 1;
+		return entry->Transitions[state.VariantIndex * entry->TransitionStride + field->TransitionOffset + slot];
+	}
+
+	uint8_t BlockPropertyTable::WithValues(const BlockState& state, std::span<const PropertyValue> values) const
+	{
+		const BlockEntry* entry = GetEntry(state.ID);
+		if (!entry || state.VariantIndex >= entry->PackedVariants.size())
+			return state.VariantIndex;
+
+		uint64_t packed = entry->PackedVariants[state.VariantIndex];
+		for (const PropertyValue& property : values)
+		{
+			const KeyField* field = FindField(*entry, property.Key);
+			if (!field)
+				continue;
+
+			auto valueIt = std::find(field->Values.begin(), field->Values.end(), property.Value);
+			if (valueIt == field->Values.end())
+				continue;
+
+			const uint64_t slot = static_cast<uint64_t>(valueIt - field->Values.begin()) + 1;
+			const uint64_t mask = ((uint64_t(1) << field->Bits) - 1) << field->Shift;
+			packed = (packed & ~mask) | (slot << field->Shift);
+		}
+
+		auto it = entry->VariantByPacked.find(packed);
+		if (it != entry->VariantByPacked.end())
+			return it->second;
+
+		// No variant with exactly these properties : best match for the whole set, like the transitions
+		std::map<std::string, std::string> properties =
+			BlockstateRegistry::Get().at(state.ID)[state.VariantIndex].Properties;
+		for (const PropertyValue& property : values)
+		{
+			const KeyField* field = FindField(*entry, property.Key);
+			if (field && std::find(field->Values.begin(), field->Values.end(), property.Value) != field->Values.end())
+				properties[m_KeyNames[property.Key]] = m_ValueNames[property.Value];
+		}
+
+		return BlockstateRegistry::GetVariantIndex(state.ID, properties);
+	}
+
+	PropertyId BlockPropertyTable::Intern(std::unordered_map<std::string, PropertyId>& ids,
+										  std::vector<std::string>& names,
+										  const std::string& name)
+	{
+		auto [it, inserted] = ids.try_emplace(name, static_cast<PropertyId>(names.size()));
+		if (inserted)
+			names.push_back(name);
+
+		return it->second;
+	}
+
+	const BlockPropertyTable::BlockEntry* BlockPropertyTable::GetEntry(BlockId id) const
+	{
+		const size_t blockIndex = static_cast<size_t>(id);
+		if (blockIndex >= m_Blocks.size() || m_Blocks[blockIndex].PackedVariants.empty())
+			return nullptr;
+
+		return &m_Blocks[blockIndex];
+	}
+
+	const BlockPropertyTable::KeyField* BlockPropertyTable::FindField(const BlockEntry& entry, PropertyId key)
+	{
+		for (const KeyField& field : entry.Keys)
+		{
+			if (field.Key == key)
+				return &field;
+		}
+
+		return nullptr;
+	}
+} // namespace onion::voxel
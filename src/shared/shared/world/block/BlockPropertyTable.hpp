@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <shared/world/block/BlockId.hpp>
+#include <shared/world/block/BlockState.hpp>
+
+namespace onion::voxel
+{
+	/// @brief Interned id of a blockstate property key ("facing") or value ("north").
+	using PropertyId = uint16_t;
+	constexpr PropertyId INVALID_PROPERTY = UINT16_MAX;
+
+	struct PropertyValue
+	{
+		PropertyId Key = INVALID_PROPERTY;
+		PropertyId Value = INVALID_PROPERTY;
+	};
+
+	/// @brief Blockstate properties compiled from BlockstateRegistry into integers.
+	/// Keys and values are interned, the properties of each variant are packed in a bitfield (one field per key of
+	/// the block, 0 when the variant does not have the key), and the variant obtained by changing one property of a
+	/// variant is precomputed. Reading or changing a property is a few integer operations, no string involved.
+	class BlockPropertyTable
+	{
+		// ----- Public API -----
+	  public:
+		/// @brief Get the table, built on first use from BlockstateRegistry.
+		static const BlockPropertyTable& Get();
+
+		/// @brief Interned id of a key or value, INVALID_PROPERTY if no block uses it. Meant to be resolved once.
+		PropertyId GetKeyId(const std::string& key) const;
+		PropertyId GetValueId(const std::string& value) const;
+		const std::string& GetValueName(PropertyId value) const;
+
+		/// @brief Whether any variant of the block has the key.
+		bool HasProperty(BlockId id, PropertyId key) const;
+
+		/// @brief Value of the key for the variant, INVALID_PROPERTY if the variant does not have it.
+		PropertyId GetValue(const BlockState& state, PropertyId key) const;
+
+		/// @brief Variant of the block with the key set to value, the other properties unchanged.
+		/// Falls back to BlockstateRegistry::GetVariantIndex when no variant has exactly these properties.
+		/// Returns the current variant if the block has no such key or value.
+		uint8_t WithValue(const BlockState& state, PropertyId key, PropertyId value) const;
+
+		/// @brief Variant of the block with all the keys set at once, the other properties unchanged.
+		/// Chaining WithValue could go through fallback variants and end elsewhere : changing several properties
+		/// resolves them in a single lookup, like GetVariantIndex with the full property set.
+		/// Keys or values the block does not have are ignored.
+		uint8_t WithValues(const BlockState& state, std::span<const PropertyValue> values) const;
+
+		// ----- Constructor -----
+	  private:
+		BlockPropertyTable();
+
+		// ----- Private Structs -----
+	  private:
+		struct KeyField
+		{
+			PropertyId Key = INVALID_PROPERTY;
+			uint8_t Shift = 0;
+			uint8_t Bits = 0;
+			uint32_t TransitionOffset = 0;	// Offset of the key's transitions in a variant's transition row
+			std::vector<PropertyId> Values; // Field value N is Values[N - 1], 0 is "no value"
+		};
+
+		struct BlockEntry
+		{
+			std::vector<KeyField> Keys;
+			std::vector<uint64_t> PackedVariants; // One bitfield per variant
+			std::unordered_map<uint64_t, uint8_t> VariantByPacked; // First variant of each bitfield
+			// Row of each variant : for each key, the variant obtained with each field value
+			std::vector<uint8_t> Transitions;
+			uint32_t TransitionStride = 0;
+		};
+
+		// ----- Private Members -----
+	  private:
+		std::unordered_map<std::string, PropertyId> m_KeyIds;
+		std::unordered_map<std::string, PropertyId> m_ValueIds;
+		std::vector<std::string> m_KeyNames;
+		std::vector<std::string> m_ValueNames;
+
+		std::vector<BlockEntry> m_Blocks; // Indexed by BlockId
+
+		static PropertyId Intern(std::unordered_map<std::string, PropertyId>& ids,
+								 std::vector<std::string>& names,
+								 const std::string& name);
+		const BlockEntry* GetEntry(BlockId id) const;
+		static const KeyField* FindField(const BlockEntry& entry, PropertyId key);
+	};
+} // namespace onion::voxel
@@ -2,11 +2,10 @@
 
 #include <shared/world/block/BlockstateRegistry.hpp>
 
+#include <algorithm>
+
 namespace onion::voxel
 {
-	// Per-variant full-block lookup table — write-once at load time
-	std::unordered_map<BlockId, std::vector<bool>> BlockState::s_FullBlockLookupTable;
-
 	// ----- Static Initialization -----
 	std::vector<bool> BlockState::s_TransparencyLookupTable = []()
 	{
@@ -480,6 +479,10 @@ namespace onion::voxel
 		BlockId::PitcherPlant,
 	};
 
+	// Block-level flags only until the registry is loaded (BuildFlagTable is never called on the server)
+	std::vector<std::unique_ptr<uint8_t[]>> BlockState::s_FlagTables;
+	std::atomic<const uint8_t*> BlockState::s_FlagTable{RetainFlagTable(CreateFlagTable(false))};
+
 	// ----- Constructor / Destructor -----
 
 	BlockState::BlockState(BlockId blockID) : ID(blockID) {}
@@ -496,39 +499,59 @@ namespace onion::voxel
 		return !(*this == other);
 	}
 
-	bool BlockState::IsTransparent(BlockId blockID)
+	void BlockState::SetTransparency(BlockId blockID, bool transparent)
 	{
-		std::shared_lock lock(s_TransparencyLookupTableMutex);
-		return s_TransparencyLookupTable[static_cast<size_t>(blockID)];
+		std::lock_guard lock(s_FlagTableMutex);
+		s_TransparencyLookupTable[static_cast<size_t>(blockID)] = transparent;
 	}
 
-	bool BlockState::IsSolid(BlockId blockID)
+	void BlockState::BuildFlagTable()
 	{
-		return s_SolidLookupTable[static_cast<size_t>(blockID)];
+		s_FlagTable.store(RetainFlagTable(CreateFlagTable(true)), std::memory_order_release);
 	}
 
-	bool BlockState::IsFlower(BlockId blockId)
+	std::unique_ptr<uint8_t[]> BlockState::CreateFlagTable(bool withVariants)
 	{
-		return std::find(Flowers.begin(), Flowers.end(), blockId) != Flowers.end();
-	}
+		constexpr size_t VARIANTS_PER_BLOCK = 256;
+		const size_t blockCount = static_cast<size_t>(BlockIds::GetBlockIdCount());
 
-	void BlockState::SetTransparency(BlockId blockID, bool transparent)
-	{
-		std::lock_guard lock(s_TransparencyLookupTableMutex);
-		s_TransparencyLookupTable[static_cast<size_t>(blockID)] = transparent;
-	}
+		std::unique_ptr<uint8_t[]> table(new uint8_t[blockCount * VARIANTS_PER_BLOCK]);
 
-	void BlockState::BuildFullBlockLookup()
-	{
-		s_FullBlockLookupTable.clear();
+		// ---- Block-level flags, in every variant slot of the block ----
+		{
+			std::lock_guard lock(s_FlagTableMutex);
+
+			for (size_t i = 0; i < blockCount; i++)
+			{
+				uint8_t flags = 0;
+				if (s_TransparencyLookupTable[i])
+					flags |= FLAG_TRANSPARENT;
+				if (s_SolidLookupTable[i])
+					flags |= FLAG_SOLID;
+
+				std::fill_n(table.get() + i * VARIANTS_PER_BLOCK, VARIANTS_PER_BLOCK, flags);
+			}
+		}
+
+		for (BlockId flower : Flowers)
+		{
+			uint8_t* slots = table.get() + GetStateId(flower, 0);
+			for (size_t v = 0; v < VARIANTS_PER_BLOCK; v++)
+				slots[v] |= FLAG_FLOWER;
+		}
 
+		if (!withVariants)
+			return table;
+
+		// ---- Per-variant flags ----
 		const auto& registry = BlockstateRegistry::Get();
 		for (const auto& [blockId, variants] : registry)
 		{
-			auto& vec = s_FullBlockLookupTable[blockId];
-			vec.resize(variants.size(), false);
+			if (static_cast<size_t>(blockId) >= blockCount)
+				continue;
 
-			for (size_t i = 0; i < variants.size(); ++i)
+			const size_t variantCount = std::min(variants.size(), VARIANTS_PER_BLOCK);
+			for (size_t i = 0; i < variantCount; ++i)
 			{
 				// Skip the injected GUI variant — it's not a world block
 				const auto& props = variants[i].Properties;
@@ -546,18 +569,24 @@ namespace onion::voxel
 						break;
 					}
 				}
-				vec[i] = full;
+
+				if (!full)
+					continue;
+
+				uint8_t& flags = table[GetStateId(blockId, static_cast<uint8_t>(i))];
+				flags |= FLAG_FULL_BLOCK;
+				if (blockId != BlockId::Air && variants[i].Model.AmbientOcclusion)
+					flags |= FLAG_COUNTS_IN_AO;
 			}
 		}
+
+		return table;
 	}
 
-	bool BlockState::IsFullBlock(BlockId blockID, uint8_t variantIndex)
+	const uint8_t* BlockState::RetainFlagTable(std::unique_ptr<uint8_t[]> table)
 	{
-		auto it = s_FullBlockLookupTable.find(blockID);
-		if (it == s_FullBlockLookupTable.end())
-			return false;
-		if (variantIndex >= it->second.size())
-			return false;
-		return it->second[variantIndex];
+		std::lock_guard lock(s_FlagTableMutex);
+		s_FlagTables.push_back(std::move(table));
+		return s_FlagTables.back().get();
 	}
 } // namespace onion::voxel
@@ -2,8 +2,11 @@
 
 #include <glm/glm.hpp>
 
-#include <shared_mutex>
-#include <unordered_map>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "BlockIds.hpp"
@@ -33,31 +36,74 @@ namespace onion::voxel
 
 		// ----- Static Helpers -----
 	  public:
-		static bool IsTransparent(BlockId blockID);
-		static bool IsSolid(BlockId blockID);
-		static bool IsFlower(BlockId blockId);
+		static bool IsTransparent(BlockId blockID) { return (GetFlags(blockID, 0) & FLAG_TRANSPARENT) != 0; }
+		static bool IsSolid(BlockId blockID) { return (GetFlags(blockID, 0) & FLAG_SOLID) != 0; }
+		static bool IsFlower(BlockId blockId) { return (GetFlags(blockId, 0) & FLAG_FLOWER) != 0; }
 
 		/// Returns true if the given block variant completely fills its voxel cell
-		static bool IsFullBlock(BlockId blockID, uint8_t variantIndex);
-
+		static bool IsFullBlock(BlockId blockID, uint8_t variantIndex)
+		{
+			return (GetFlags(blockID, variantIndex) & FLAG_FULL_BLOCK) != 0;
+		}
+
+		/// Returns true if the given block variant darkens its neighbors' ambient occlusion
+		static bool CountsInAO(BlockId blockID, uint8_t variantIndex)
+		{
+			return (GetFlags(blockID, variantIndex) & FLAG_COUNTS_IN_AO) != 0;
+		}
+
+		/// Marks the block as transparent. Takes effect on the next BuildFlagTable.
 		static void SetTransparency(BlockId blockID, bool transparent);
 
-		/// Builds the IsFullBlock lookup table from the BlockstateRegistry.
-		/// Must be called once after the registry is fully loaded (after ReloadTextures).
-		static void BuildFullBlockLookup();
+		/// Builds the per-variant flags (full block, AO) from the BlockstateRegistry and publishes the new flag table.
+		/// Must be called after the registry is fully loaded (after ReloadTextures), and again on each reload.
+		static void BuildFlagTable();
+
+		// ----- Flag Table -----
+	  public:
+		static constexpr uint8_t FLAG_TRANSPARENT = 1 << 0;
+		static constexpr uint8_t FLAG_SOLID = 1 << 1;
+		static constexpr uint8_t FLAG_FLOWER = 1 << 2;
+		static constexpr uint8_t FLAG_FULL_BLOCK = 1 << 3;
+		static constexpr uint8_t FLAG_COUNTS_IN_AO = 1 << 4;
+
+		/// Global id of a (BlockId, variant) state : every block has a slot for each of its 256 possible variants.
+		static constexpr uint32_t GetStateId(BlockId blockID, uint8_t variantIndex)
+		{
+			return (static_cast<uint32_t>(blockID) << 8) | variantIndex;
+		}
+
+		/// All the flags of a state, from one load in the published table. Lock free.
+		/// Every block has a slot for each uint8_t variant, only the id can be out of the table : an invalid id (e.g.
+		/// from a corrupted chunk) reads the flags of Air.
+		static uint8_t GetFlags(BlockId blockID, uint8_t variantIndex)
+		{
+			const bool isValidId = static_cast<size_t>(blockID) < static_cast<size_t>(BlockId::Count);
+			assert(isValidId && "BlockState::GetFlags: invalid BlockId");
+			if (!isValidId)
+				blockID = BlockId::Air;
+
+			return s_FlagTable.load(std::memory_order_acquire)[GetStateId(blockID, variantIndex)];
+		}
 
 		// ----- Static Members -----
 	  private:
-		// A lookup table for block transparency, indexed by BlockId
+		// A lookup table for block transparency, indexed by BlockId.
+		// Only written while loading textures, read when building the flag table.
 		static std::vector<bool> s_TransparencyLookupTable;
-		static inline std::shared_mutex s_TransparencyLookupTableMutex;
+		static inline std::mutex s_FlagTableMutex;
 
 		// A lookup table for block solidity, indexed by BlockId
 		static const std::vector<bool> s_SolidLookupTable;
 
-		// Per-variant full-block lookup: [BlockId] -> [variantIndex] -> bool
-		// Write-once at load time; no mutex required.
-		static std::unordered_map<BlockId, std::vector<bool>> s_FullBlockLookupTable;
+		// Flags of every state, indexed by GetStateId (~300 KB, only the lines of the blocks in use get cached).
+		// Immutable once published : a reload builds a new table and swaps the pointer. The previous tables are
+		// kept alive since readers may still hold them, reloads are rare.
+		static std::atomic<const uint8_t*> s_FlagTable;
+		static std::vector<std::unique_ptr<uint8_t[]>> s_FlagTables;
+
+		static std::unique_ptr<uint8_t[]> CreateFlagTable(bool withVariants);
+		static const uint8_t* RetainFlagTable(std::unique_ptr<uint8_t[]> table);
 
 		// ----- Lists of block IDs for different categories -----
 	  public:
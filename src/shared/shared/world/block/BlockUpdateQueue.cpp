@@ -0,0 +1,81 @@
+#include "BlockUpdateQueue.hpp"
+
+namespace onion::voxel
+{
+	void BlockUpdateQueue::Schedule(const glm::ivec3& worldPosition, uint32_t delay)
+	{
+		std::lock_guard lock(m_Mutex);
+		Schedule_Unsafe(worldPosition, delay);
+	}
+
+	void BlockUpdateQueue::Schedule(const std::vector<glm::ivec3>& worldPositions, uint32_t delay)
+	{
+		std::lock_guard lock(m_Mutex);
+		for (const glm::ivec3& worldPosition : worldPositions)
+		{
+			Schedule_Unsafe(worldPosition, delay);
+		}
+	}
+
+	std::vector<glm::ivec3> BlockUpdateQueue::TakeDue(size_t budget)
+	{
+		std::lock_guard lock(m_Mutex);
+
+		std::vector<glm::ivec3> due;
+		while (due.size() < budget && !m_Entries.empty() && m_Entries.top().DueTick <= m_CurrentTick)
+		{
+			const Entry entry = m_Entries.top();
+			m_Entries.pop();
+
+			auto it = m_Pending.find(entry.Position);
+			if (it == m_Pending.end() || it->second != entry.DueTick)
+				continue; // Rescheduled earlier, already taken
+
+			m_Pending.erase(it);
+			due.push_back(entry.Position);
+		}
+
+		return due;
+	}
+
+	void BlockUpdateQueue::AdvanceTick()
+	{
+		std::lock_guard lock(m_Mutex);
+		m_CurrentTick++;
+	}
+
+	void BlockUpdateQueue::Clear()
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Entries = {};
+		m_Pending.clear();
+	}
+
+	uint64_t BlockUpdateQueue::GetCurrentTick() const
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_CurrentTick;
+	}
+
+	size_t BlockUpdateQueue::GetPendingCount() const
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_Pending.size();
+	}
+
+	void BlockUpdateQueue::Schedule_Unsafe(const glm::ivec3& worldPosition, uint32_t delay)
+	{
+		const uint64_t dueTick = m_CurrentTick + delay;
+
+		auto [it, inserted] = m_Pending.try_emplace(worldPosition, dueTick);
+		if (!inserted)
+		{
+			if (it->second <= dueTick)
+				return; // Already due earlier
+
+			it->second = dueTick;
+		}
+
+		m_Entries.push({dueTick, m_NextSequence++, worldPosition});
+	}
+} // namespace onion::voxel
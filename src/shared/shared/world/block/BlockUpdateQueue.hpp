@@ -0,0 +1,66 @@
+#pragma once
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace onion::voxel
+{
+	/// Pending block updates, each one due at a tick of the queue.
+	/// A position is pending at most once : scheduling it again keeps the earliest due tick.
+	/// The owner takes the due updates once per tick within a budget, the rest is carried over to the next tick.
+	/// Thread-safe.
+	class BlockUpdateQueue
+	{
+		// ----- Public API -----
+	  public:
+		/// @brief Schedule an update of the block at worldPosition, delay ticks after the current tick.
+		void Schedule(const glm::ivec3& worldPosition, uint32_t delay = 0);
+		void Schedule(const std::vector<glm::ivec3>& worldPositions, uint32_t delay = 0);
+
+		/// @brief Take up to budget updates due at the current tick or before, earliest first.
+		std::vector<glm::ivec3> TakeDue(size_t budget);
+
+		/// @brief Move to the next tick. Updates scheduled with no delay from now on are due at that tick.
+		void AdvanceTick();
+
+		void Clear();
+
+		// ----- Getters -----
+	  public:
+		uint64_t GetCurrentTick() const;
+		size_t GetPendingCount() const;
+
+		// ----- Private Members -----
+	  private:
+		struct Entry
+		{
+			uint64_t DueTick = 0;
+			uint64_t Sequence = 0; // Keeps the scheduling order between updates due at the same tick
+			glm::ivec3 Position{};
+		};
+
+		struct IsLater
+		{
+			bool operator()(const Entry& a, const Entry& b) const
+			{
+				return a.DueTick != b.DueTick ? a.DueTick > b.DueTick : a.Sequence > b.Sequence;
+			}
+		};
+
+		mutable std::mutex m_Mutex;
+		uint64_t m_CurrentTick = 0;
+		uint64_t m_NextSequence = 0;
+		std::priority_queue<Entry, std::vector<Entry>, IsLater> m_Entries;
+		// Due tick of each pending position, entries of the heap with another due tick are stale
+		std::unordered_map<glm::ivec3, uint64_t> m_Pending;
+
+		void Schedule_Unsafe(const glm::ivec3& worldPosition, uint32_t delay);
+	};
+} // namespace onion::voxel
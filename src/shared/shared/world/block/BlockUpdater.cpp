@@ -2,33 +2,146 @@
 
 #include <shared/world/block/Block.hpp>
 #include <shared/world/block/BlockIds.hpp>
+#include <shared/world/block/BlockPropertyTable.hpp>
 #include <shared/world/block/BlockState.hpp>
 #include <shared/world/block/BlockstateRegistry.hpp>
 #include <shared/world/world_manager/WorldManager.hpp>
 
+#include <array>
+#include <vector>
+
 namespace
 {
 	using namespace onion::voxel;
 
+	// Interned ids of the properties used by the updater, resolved once.
+	// Keys and values are interned separately : the "north" key is not the "north" value.
+	struct UpdaterProperties
+	{
+		PropertyId Facing, Half, Shape, InWall, Open, Up;
+		std::array<PropertyId, 4> CardinalKeys; // north, south, west, east
+
+		PropertyId North, South, West, East;
+		PropertyId True, False, Low, None;
+		PropertyId Lower, Upper;
+		PropertyId Straight, InnerLeft, InnerRight, OuterLeft, OuterRight;
+	};
+
+	const UpdaterProperties& GetProperties()
+	{
+		static const UpdaterProperties properties = []()
+		{
+			const BlockPropertyTable& table = BlockPropertyTable::Get();
+
+			UpdaterProperties p;
+			p.Facing = table.GetKeyId("facing");
+			p.Half = table.GetKeyId("half");
+			p.Shape = table.GetKeyId("shape");
+			p.InWall = table.GetKeyId("in_wall");
+			p.Open = table.GetKeyId("open");
+			p.Up = table.GetKeyId("up");
+			p.CardinalKeys = {
+				table.GetKeyId("north"), table.GetKeyId("south"), table.GetKeyId("west"), table.GetKeyId("east")};
+
+			p.North = table.GetValueId("north");
+			p.South = table.GetValueId("south");
+			p.West = table.GetValueId("west");
+			p.East = table.GetValueId("east");
+			p.True = table.GetValueId("true");
+			p.False = table.GetValueId("false");
+			p.Low = table.GetValueId("low");
+			p.None = table.GetValueId("none");
+			p.Lower = table.GetValueId("lower");
+			p.Upper = table.GetValueId("upper");
+			p.Straight = table.GetValueId("straight");
+			p.InnerLeft = table.GetValueId("inner_left");
+			p.InnerRight = table.GetValueId("inner_right");
+			p.OuterLeft = table.GetValueId("outer_left");
+			p.OuterRight = table.GetValueId("outer_right");
+			return p;
+		}();
+
+		return properties;
+	}
+
+	// Kinds of blocks the updater cares about, as flags per BlockId
+	enum eBlockKind : uint8_t
+	{
+		Connectable = 1 << 0, // Has cardinal connection properties (fences, walls, panes)
+		Wall = 1 << 1,
+		Pane = 1 << 2,
+		FenceGate = 1 << 3,
+		Stair = 1 << 4,
+		TallPlant = 1 << 5,
+	};
+
+	uint8_t GetBlockKind(BlockId id)
+	{
+		// Built once : detecting a kind scans the variants of the block and its name
+		static const std::vector<uint8_t> kinds = []()
+		{
+			const BlockPropertyTable& table = BlockPropertyTable::Get();
+			const UpdaterProperties& p = GetProperties();
+
+			std::vector<uint8_t> result(static_cast<size_t>(BlockId::Count), 0);
+			for (size_t i = 0; i < result.size(); ++i)
+			{
+				const BlockId blockId = static_cast<BlockId>(i);
+				const std::string& name = BlockIds::GetName(blockId);
+
+				uint8_t kind = 0;
+				if (table.HasProperty(blockId, p.CardinalKeys[0]))
+				{
+					kind |= Connectable;
+					if (name.find("Wall") != std::string::npos)
+						kind |= Wall;
+					if (name.find("Pane") != std::string::npos)
+						kind |= Pane;
+				}
+				if (table.HasProperty(blockId, p.InWall))
+					kind |= FenceGate;
+				if (table.HasProperty(blockId, p.Shape))
+					kind |= Stair;
+				if (BlockstateRegistry::IsTallPlant(blockId))
+					kind |= TallPlant;
+
+				result[i] = kind;
+			}
+			return result;
+		}();
+
+		const size_t index = static_cast<size_t>(id);
+		return index < kinds.size() ? kinds[index] : 0;
+	}
+
 	// Returns true if the fence gate at neighborState is oriented so that its
-	// open mouth faces dirKey (the direction from the connecting block to the gate).
+	// open mouth faces the cardinal (the direction from the connecting block to the gate).
 	//   facing=north/south → gate runs along Z → open mouths face north/south
 	//   facing=east/west   → gate runs along X → open mouths face east/west
-	static bool FenceGateConnectsFrom(const BlockState& neighborState, const std::string& dirKey)
+	// Cardinal indices : 0 = north, 1 = south, 2 = west, 3 = east
+	static bool FenceGateConnectsFrom(const BlockState& neighborState, int cardinal)
 	{
-		const auto& registry = BlockstateRegistry::Get();
-		auto it = registry.find(neighborState.ID);
-		if (it == registry.end())
+		const UpdaterProperties& p = GetProperties();
+		const PropertyId facing = BlockPropertyTable::Get().GetValue(neighborState, p.Facing);
+		if (facing == INVALID_PROPERTY)
 			return false;
-		const auto& props = it->second[neighborState.VariantIndex].Properties;
-		auto facingIt = props.find("facing");
-		if (facingIt == props.end())
-			return false;
-		const std::string& facing = facingIt->second;
 
-		if (facing == "north" || facing == "south")
-			return dirKey == "east" || dirKey == "west";
-		return dirKey == "north" || dirKey == "south";
+		if (facing == p.North || facing == p.South)
+			return cardinal == 2 || cardinal == 3;
+		return cardinal == 0 || cardinal == 1;
+	}
+
+	static void SetVariantIfChanged(const BlockState& target,
+									uint8_t newVariant,
+									const glm::ivec3& worldPos,
+									WorldManager& world)
+	{
+		if (newVariant == target.VariantIndex)
+			return;
+
+		world.SetBlock(Block(worldPos, BlockState(target.ID, newVariant)),
+					   WorldManager::BlocksChangedEventArgs::eOrigin::ServerRequest,
+					   /*notify=*/false);
 	}
 } // namespace
 
@@ -55,6 +168,14 @@ namespace onion::voxel
 		UpdateConnections(target, neighbors, worldPos, world);
 	}
 
+	bool BlockUpdater::MayUpdate(BlockId id)
+	{
+		// Air may orphan a tall-plant half, the others recompute their connections
+		if (static_cast<size_t>(id) >= static_cast<size_t>(BlockId::Count))
+			return true;
+		return id == BlockId::Air || (GetBlockKind(id) & (Connectable | FenceGate | Stair)) != 0;
+	}
+
 	// -------------------------------------------------------------------------
 	// Private — multi-block integrity
 	// -------------------------------------------------------------------------
@@ -68,48 +189,31 @@ namespace onion::voxel
 		if (target.ID != BlockId::Air)
 			return;
 
+		const BlockPropertyTable& table = BlockPropertyTable::Get();
+		const UpdaterProperties& p = GetProperties();
+
 		// Check the block above: if it is a tall-plant upper half whose lower
 		// half is now missing (this cell is Air), break it.
 		const BlockState& above = neighbors[kUp];
-		if (above.ID != BlockId::Air && BlockstateRegistry::IsTallPlant(above.ID))
+		if (above.ID != BlockId::Air && IsTallPlant(above.ID) && table.GetValue(above, p.Half) == p.Upper)
 		{
-			const auto& registry = BlockstateRegistry::Get();
-			auto it = registry.find(above.ID);
-			if (it != registry.end())
-			{
-				const auto& variant = it->second[above.VariantIndex];
-				auto halfIt = variant.Properties.find("half");
-				if (halfIt != variant.Properties.end() && halfIt->second == "upper")
-				{
-					// The upper half lost its lower partner — break it.
-					const glm::ivec3 abovePos = worldPos + glm::ivec3{0, 1, 0};
-					world.SetBlock(Block(abovePos, BlockState(BlockId::Air)),
-								   WorldManager::BlocksChangedEventArgs::eOrigin::ServerRequest,
-								   /*notify=*/false);
-				}
-			}
+			// The upper half lost its lower partner — break it.
+			const glm::ivec3 abovePos = worldPos + glm::ivec3{0, 1, 0};
+			world.SetBlock(Block(abovePos, BlockState(BlockId::Air)),
+						   WorldManager::BlocksChangedEventArgs::eOrigin::ServerRequest,
+						   /*notify=*/false);
 		}
 
 		// Check the block below: if it is a tall-plant lower half whose upper
 		// half is now missing, break it.
 		const BlockState& below = neighbors[kDown];
-		if (below.ID != BlockId::Air && BlockstateRegistry::IsTallPlant(below.ID))
+		if (below.ID != BlockId::Air && IsTallPlant(below.ID) && table.GetValue(below, p.Half) == p.Lower)
 		{
-			const auto& registry = BlockstateRegistry::Get();
-			auto it = registry.find(below.ID);
-			if (it != registry.end())
-			{
-				const auto& variant = it->second[below.VariantIndex];
-				auto halfIt = variant.Properties.find("half");
-				if (halfIt != variant.Properties.end() && halfIt->second == "lower")
-				{
-					// The lower half lost its upper partner — break it.
-					const glm::ivec3 belowPos = worldPos + glm::ivec3{0, -1, 0};
-					world.SetBlock(Block(belowPos, BlockState(BlockId::Air)),
-								   WorldManager::BlocksChangedEventArgs::eOrigin::ServerRequest,
-								   /*notify=*/false);
-				}
-			}
+			// The lower half lost its upper partner — break it.
+			const glm::ivec3 belowPos = worldPos + glm::ivec3{0, -1, 0};
+			world.SetBlock(Block(belowPos, BlockState(BlockId::Air)),
+						   WorldManager::BlocksChangedEventArgs::eOrigin::ServerRequest,
+						   /*notify=*/false);
 		}
 	}
 
@@ -125,6 +229,9 @@ namespace onion::voxel
 		if (target.ID == BlockId::Air)
 			return;
 
+		const BlockPropertyTable& table = BlockPropertyTable::Get();
+		const UpdaterProperties& p = GetProperties();
+
 		// Horizontal neighbors in cardinal order used below.
 		// Indices into the neighbors array:  N=2  S=3  W=4  E=5
 		const BlockState* cardinals[4] = {
@@ -133,34 +240,25 @@ namespace onion::voxel
 			&neighbors[kWest],
 			&neighbors[kEast],
 		};
-		static const char* kCardinalKeys[4] = {"north", "south", "west", "east"};
+
+		// Properties are changed through the precomputed transitions, all the connections of a block in one lookup,
+		// the ones not recomputed here (e.g. waterlogged) are kept.
 
 		// -----------------------------------------------------------------
 		// Fence gates — only update in_wall; preserve facing and open.
 		// -----------------------------------------------------------------
 		if (IsFenceGate(target.ID))
 		{
-			const auto& registry = BlockstateRegistry::Get();
-			auto it = registry.find(target.ID);
-			if (it == registry.end())
+			const PropertyId facing = table.GetValue(target, p.Facing);
+			if (facing == INVALID_PROPERTY || table.GetValue(target, p.Open) == INVALID_PROPERTY)
 				return;
 
-			const auto& currentProps = it->second[target.VariantIndex].Properties;
-
-			auto facingIt = currentProps.find("facing");
-			auto openIt = currentProps.find("open");
-			if (facingIt == currentProps.end() || openIt == currentProps.end())
-				return;
-
-			const std::string& facing = facingIt->second;
-			const std::string& open = openIt->second;
-
 			// The two neighbors perpendicular to the gate's facing direction
 			// are the ones that could be walls.
 			// facing north/south → check west and east neighbors
 			// facing east/west   → check north and south neighbors
 			bool adjacentToWall = false;
-			if (facing == "north" || facing == "south")
+			if (facing == p.North || facing == p.South)
 			{
 				adjacentToWall = IsWall(neighbors[kWest].ID) || IsWall(neighbors[kEast].ID);
 			}
@@ -169,21 +267,8 @@ namespace onion::voxel
 				adjacentToWall = IsWall(neighbors[kNorth].ID) || IsWall(neighbors[kSouth].ID);
 			}
 
-			const std::string inWall = adjacentToWall ? "true" : "false";
-
-			std::map<std::string, std::string> newProps = {
-				{"facing", facing},
-				{"open", open},
-				{"in_wall", inWall},
-			};
-
-			const uint8_t newVariant = BlockstateRegistry::GetVariantIndex(target.ID, newProps);
-			if (newVariant != target.VariantIndex)
-			{
-				world.SetBlock(Block(worldPos, BlockState(target.ID, newVariant)),
-							   WorldManager::BlocksChangedEventArgs::eOrigin::ServerRequest,
-							   /*notify=*/false);
-			}
+			SetVariantIfChanged(
+				target, table.WithValue(target, p.InWall, adjacentToWall ? p.True : p.False), worldPos, world);
 			return;
 		}
 
@@ -192,36 +277,26 @@ namespace onion::voxel
 		// -----------------------------------------------------------------
 		if (IsWall(target.ID))
 		{
-			int connectionCount = 0;
 			bool connected[4] = {false, false, false, false};
 
 			for (int i = 0; i < 4; ++i)
 			{
 				const BlockId nid = cardinals[i]->ID;
-				connected[i] = IsWall(nid) || IsPane(nid) ||
-					(IsFenceGate(nid) && FenceGateConnectsFrom(*cardinals[i], kCardinalKeys[i]));
-				if (connected[i])
-					++connectionCount;
+				connected[i] =
+					IsWall(nid) || IsPane(nid) || (IsFenceGate(nid) && FenceGateConnectsFrom(*cardinals[i], i));
 			}
 
 			// up=false only for a straight wall (exactly two opposite connections,
 			// no others): N+S or W+E. Otherwise show the post (up=true).
 			bool straightNS = connected[0] && connected[1] && !connected[2] && !connected[3];
 			bool straightWE = connected[2] && connected[3] && !connected[0] && !connected[1];
-			const std::string up = (straightNS || straightWE) ? "false" : "true";
 
-			std::map<std::string, std::string> newProps;
-			newProps["up"] = up;
+			std::array<PropertyValue, 5> values;
+			values[4] = {p.Up, (straightNS || straightWE) ? p.False : p.True};
 			for (int i = 0; i < 4; ++i)
-				newProps[kCardinalKeys[i]] = connected[i] ? "low" : "none";
+				values[i] = {p.CardinalKeys[i], connected[i] ? p.Low : p.None};
 
-			const uint8_t newVariant = BlockstateRegistry::GetVariantIndex(target.ID, newProps);
-			if (newVariant != target.VariantIndex)
-			{
-				world.SetBlock(Block(worldPos, BlockState(target.ID, newVariant)),
-							   WorldManager::BlocksChangedEventArgs::eOrigin::ServerRequest,
-							   /*notify=*/false);
-			}
+			SetVariantIfChanged(target, table.WithValues(target, values), worldPos, world);
 			return;
 		}
 
@@ -231,20 +306,15 @@ namespace onion::voxel
 		// -----------------------------------------------------------------
 		if (IsPane(target.ID))
 		{
-			std::map<std::string, std::string> newProps;
+			std::array<PropertyValue, 4> values;
 			for (int i = 0; i < 4; ++i)
 			{
 				const BlockId nid = cardinals[i]->ID;
-				newProps[kCardinalKeys[i]] = (IsPane(nid) || IsWall(nid)) ? "true" : "false";
+				const bool connected = IsPane(nid) || IsWall(nid);
+				values[i] = {p.CardinalKeys[i], connected ? p.True : p.False};
 			}
 
-			const uint8_t newVariant = BlockstateRegistry::GetVariantIndex(target.ID, newProps);
-			if (newVariant != target.VariantIndex)
-			{
-				world.SetBlock(Block(worldPos, BlockState(target.ID, newVariant)),
-							   WorldManager::BlocksChangedEventArgs::eOrigin::ServerRequest,
-							   /*notify=*/false);
-			}
+			SetVariantIfChanged(target, table.WithValues(target, values), worldPos, world);
 			return;
 		}
 
@@ -254,24 +324,16 @@ namespace onion::voxel
 		// -----------------------------------------------------------------
 		if (IsConnectableBlock(target.ID))
 		{
-			std::map<std::string, std::string> newProps;
+			std::array<PropertyValue, 4> values;
 			for (int i = 0; i < 4; ++i)
 			{
 				const BlockId nid = cardinals[i]->ID;
-				newProps[kCardinalKeys[i]] =
-					(IsConnectableBlock(nid) && !IsWall(nid) && !IsPane(nid) ||
-					 (IsFenceGate(nid) && FenceGateConnectsFrom(*cardinals[i], kCardinalKeys[i])))
-					? "true"
-					: "false";
+				const bool connected = (IsConnectableBlock(nid) && !IsWall(nid) && !IsPane(nid)) ||
+					(IsFenceGate(nid) && FenceGateConnectsFrom(*cardinals[i], i));
+				values[i] = {p.CardinalKeys[i], connected ? p.True : p.False};
 			}
 
-			const uint8_t newVariant = BlockstateRegistry::GetVariantIndex(target.ID, newProps);
-			if (newVariant != target.VariantIndex)
-			{
-				world.SetBlock(Block(worldPos, BlockState(target.ID, newVariant)),
-							   WorldManager::BlocksChangedEventArgs::eOrigin::ServerRequest,
-							   /*notify=*/false);
-			}
+			SetVariantIfChanged(target, table.WithValues(target, values), worldPos, world);
 		}
 
 		// -----------------------------------------------------------------
@@ -279,36 +341,27 @@ namespace onion::voxel
 		// -----------------------------------------------------------------
 		if (IsStair(target.ID))
 		{
-			const auto& registry = BlockstateRegistry::Get();
-			auto it = registry.find(target.ID);
-			if (it == registry.end())
-				return;
-
-			const auto& currentProps = it->second[target.VariantIndex].Properties;
-			auto facingIt = currentProps.find("facing");
-			auto halfIt = currentProps.find("half");
-			if (facingIt == currentProps.end() || halfIt == currentProps.end())
+			const PropertyId facing = table.GetValue(target, p.Facing);
+			const PropertyId half = table.GetValue(target, p.Half);
+			if (facing == INVALID_PROPERTY || half == INVALID_PROPERTY)
 				return;
 
-			const std::string& facing = facingIt->second;
-			const std::string& half = halfIt->second;
-
 			// Front = neighbor in the direction the stair faces.
 			// Back  = neighbor behind (opposite of facing).
 			const BlockState* front = nullptr;
 			const BlockState* back = nullptr;
 
-			if (facing == "north")
+			if (facing == p.North)
 			{
 				front = &neighbors[kNorth];
 				back = &neighbors[kSouth];
 			}
-			else if (facing == "south")
+			else if (facing == p.South)
 			{
 				front = &neighbors[kSouth];
 				back = &neighbors[kNorth];
 			}
-			else if (facing == "east")
+			else if (facing == p.East)
 			{
 				front = &neighbors[kEast];
 				back = &neighbors[kWest];
@@ -320,55 +373,43 @@ namespace onion::voxel
 			}
 
 			// 90° clockwise rotation: north→east→south→west→north
-			auto rotateCW = [](const std::string& f) -> std::string
+			auto rotateCW = [&p](PropertyId f)
 			{
-				if (f == "north")
-					return "east";
-				if (f == "east")
-					return "south";
-				if (f == "south")
-					return "west";
-				return "north"; // west
+				if (f == p.North)
+					return p.East;
+				if (f == p.East)
+					return p.South;
+				if (f == p.South)
+					return p.West;
+				return p.North; // west
 			};
-			auto rotateCCW = [](const std::string& f) -> std::string
+			auto rotateCCW = [&p](PropertyId f)
 			{
-				if (f == "north")
-					return "west";
-				if (f == "west")
-					return "south";
-				if (f == "south")
-					return "east";
-				return "north"; // east
+				if (f == p.North)
+					return p.West;
+				if (f == p.West)
+					return p.South;
+				if (f == p.South)
+					return p.East;
+				return p.North; // east
 			};
 
 			// Back neighbor determines inner corners; front determines outer corners.
 			// CW turn relative to us → right side; CCW turn → left side.
-			const std::string frontFacing = GetStairFacing(*front, half);
-			const std::string backFacing = GetStairFacing(*back, half);
+			const PropertyId frontFacing = GetStairFacing(*front, half);
+			const PropertyId backFacing = GetStairFacing(*back, half);
 
-			std::string shape = "straight";
+			PropertyId shape = p.Straight;
 			if (backFacing == rotateCW(facing))
-				shape = "inner_right";
+				shape = p.InnerRight;
 			else if (backFacing == rotateCCW(facing))
-				shape = "inner_left";
+				shape = p.InnerLeft;
 			else if (frontFacing == rotateCW(facing))
-				shape = "outer_right";
+				shape = p.OuterRight;
 			else if (frontFacing == rotateCCW(facing))
-				shape = "outer_left";
+				shape = p.OuterLeft;
 
-			std::map<std::string, std::string> newProps = {
-				{"facing", facing},
-				{"half", half},
-				{"shape", shape},
-			};
-
-			const uint8_t newVariant = BlockstateRegistry::GetVariantIndex(target.ID, newProps);
-			if (newVariant != target.VariantIndex)
-			{
-				world.SetBlock(Block(worldPos, BlockState(target.ID, newVariant)),
-							   WorldManager::BlocksChangedEventArgs::eOrigin::ServerRequest,
-							   /*notify=*/false);
-			}
+			SetVariantIfChanged(target, table.WithValue(target, p.Shape, shape), worldPos, world);
 		}
 	}
 
@@ -376,71 +417,48 @@ namespace onion::voxel
 	// Private — detection helpers
 	// -------------------------------------------------------------------------
 
-	bool BlockUpdater::BlockHasProperty(BlockId id, const std::string& key)
-	{
-		const auto& registry = BlockstateRegistry::Get();
-		auto it = registry.find(id);
-		if (it == registry.end())
-			return false;
-
-		for (const auto& variant : it->second)
-		{
-			if (variant.Properties.count(key) > 0)
-				return true;
-		}
-		return false;
-	}
-
 	bool BlockUpdater::IsConnectableBlock(BlockId id)
 	{
-		return BlockHasProperty(id, "north");
+		return (GetBlockKind(id) & Connectable) != 0;
 	}
 
 	bool BlockUpdater::IsWall(BlockId id)
 	{
-		if (!IsConnectableBlock(id))
-			return false;
-		const std::string& name = BlockIds::GetName(id);
-		return name.find("Wall") != std::string::npos;
+		return (GetBlockKind(id) & Wall) != 0;
 	}
 
 	bool BlockUpdater::IsPane(BlockId id)
 	{
-		if (!IsConnectableBlock(id))
-			return false;
-		const std::string& name = BlockIds::GetName(id);
-		return name.find("Pane") != std::string::npos;
+		return (GetBlockKind(id) & Pane) != 0;
 	}
 
 	bool BlockUpdater::IsFenceGate(BlockId id)
 	{
-		return BlockHasProperty(id, "in_wall");
+		return (GetBlockKind(id) & FenceGate) != 0;
 	}
 
 	bool BlockUpdater::IsStair(BlockId id)
 	{
-		return BlockHasProperty(id, "shape");
+		return (GetBlockKind(id) & Stair) != 0;
 	}
 
-	std::string BlockUpdater::GetStairFacing(const BlockState& neighbor, const std::string& requiredHalf)
+	bool BlockUpdater::IsTallPlant(BlockId id)
+	{
+		return (GetBlockKind(id) & TallPlant) != 0;
+	}
+
+	PropertyId BlockUpdater::GetStairFacing(const BlockState& neighbor, PropertyId requiredHalf)
 	{
 		if (!IsStair(neighbor.ID))
-			return "";
-
-		const auto& registry = BlockstateRegistry::Get();
-		auto it = registry.find(neighbor.ID);
-		if (it == registry.end())
-			return "";
-
-		const auto& props = it->second[neighbor.VariantIndex].Properties;
-		auto halfIt = props.find("half");
-		auto facingIt = props.find("facing");
-		if (halfIt == props.end() || facingIt == props.end())
-			return "";
-		if (halfIt->second != requiredHalf)
-			return ""; // different half — no shape influence
-
-		return facingIt->second;
+			return INVALID_PROPERTY;
+
+		const BlockPropertyTable& table = BlockPropertyTable::Get();
+		const UpdaterProperties& p = GetProperties();
+
+		if (table.GetValue(neighbor, p.Half) != requiredHalf)
+			return INVALID_PROPERTY; // different half (or no half) — no shape influence
+
+		return table.GetValue(neighbor, p.Facing);
 	}
 
 } // namespace onion::voxel
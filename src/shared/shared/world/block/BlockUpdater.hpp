@@ -1,11 +1,11 @@
 #pragma once
 
 #include <array>
-#include <string>
 
 #include <glm/glm.hpp>
 
 #include <shared/world/block/BlockId.hpp>
+#include <shared/world/block/BlockPropertyTable.hpp>
 #include <shared/world/block/BlockState.hpp>
 
 namespace onion::voxel
@@ -38,6 +38,10 @@ namespace onion::voxel
 						   const glm::ivec3& worldPos,
 						   WorldManager& world);
 
+		/// False when Update can not change anything around a block of this id, whatever its neighbors.
+		/// Lets bulk edits skip reading the neighbors of plain blocks.
+		static bool MayUpdate(BlockId id);
+
 	  private:
 		/// Breaks orphaned halves of tall-plant structures (e.g. tall flowers, tall grass).
 		static void UpdateMultiBlock(const BlockState& target,
@@ -53,9 +57,6 @@ namespace onion::voxel
 
 		// ----- Detection helpers -----
 	  private:
-		/// True if any variant of id has the given property key.
-		static bool BlockHasProperty(BlockId id, const std::string& key);
-
 		/// True if the block has cardinal connection properties (north/south/east/west).
 		/// Covers fences, walls, and panes.
 		static bool IsConnectableBlock(BlockId id);
@@ -72,8 +73,11 @@ namespace onion::voxel
 		/// True if the block has a "shape" property with stair values (stairs).
 		static bool IsStair(BlockId id);
 
+		/// True if the block is a two-block tall plant (BlockstateRegistry::IsTallPlant).
+		static bool IsTallPlant(BlockId id);
+
 		/// Returns the facing of a stair neighbor if it is a stair with the same half,
-		/// or an empty string if the neighbor is not a qualifying stair.
-		static std::string GetStairFacing(const BlockState& neighbor, const std::string& requiredHalf);
+		/// or INVALID_PROPERTY if the neighbor is not a qualifying stair.
+		static PropertyId GetStairFacing(const BlockState& neighbor, PropertyId requiredHalf);
 	};
 } // namespace onion::voxel
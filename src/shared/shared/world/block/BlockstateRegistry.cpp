@@ -1,12 +1,24 @@
 #include "BlockstateRegistry.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iostream>
+#include <latch>
 #include <limits>
+#include <mutex>
 #include <set>
 #include <sstream>
+#include <thread>
+#include <unordered_set>
 
+#include <onion/ThreadPool.hpp>
+
+#include <shared/utils/Stopwatch.hpp>
 #include <shared/zip_archive/ZipArchive.hpp>
 
 #include <shared/world/block/BlockState.hpp>
+#include <shared/world/block/BlockstateRegistryCache.hpp>
 
 namespace
 {
@@ -597,7 +609,7 @@ namespace
 	}
 
 	static void InjectGuiVariant(const std::string& blockResourceName,
-								 const onion::voxel::ZipArchive& modelArchive,
+								 const std::unordered_set<std::string>& modelFiles,
 								 std::vector<onion::voxel::VariantModel>& variants)
 	{
 		using namespace onion::voxel;
@@ -613,7 +625,7 @@ namespace
 		bool guiModelResolved = false;
 
 		const std::filesystem::path itemModelPath = std::filesystem::path("item") / (blockResourceName + ".json");
-		if (modelArchive.FileExists(itemModelPath))
+		if (modelFiles.contains(itemModelPath.generic_string()))
 		{
 			guiVariant.Model =
 				BlockModel::FromFile((std::filesystem::path("item") / blockResourceName).generic_string());
@@ -624,7 +636,7 @@ namespace
 		{
 			const std::filesystem::path inventoryModelPath =
 				std::filesystem::path("block") / (blockResourceName + "_inventory.json");
-			if (modelArchive.FileExists(inventoryModelPath))
+			if (modelFiles.contains(inventoryModelPath.generic_string()))
 			{
 				guiVariant.Model = BlockModel::FromFile(blockResourceName + "_inventory");
 				guiModelResolved = true;
@@ -641,7 +653,7 @@ namespace
 		if (!guiModelResolved)
 		{
 			const std::filesystem::path blockModelPath = std::filesystem::path("block") / (blockResourceName + ".json");
-			if (modelArchive.FileExists(blockModelPath))
+			if (modelFiles.contains(blockModelPath.generic_string()))
 			{
 				guiVariant.Model = BlockModel::FromFile(blockResourceName);
 				guiModelResolved = true;
@@ -761,60 +773,171 @@ namespace onion::voxel
 		return 0;
 	}
 
-	bool BlockstateRegistry::CountsInAO(BlockId id, uint8_t variantIndex)
+	std::unordered_map<BlockId, std::vector<VariantModel>> BlockstateRegistry::LoadVariantsModel()
 	{
-		auto& blockstateMap = Get();
+		// Init BlockModel archive first since VariantModel depends on it (same directory, but different file name)
+		// Also needed on a warm start : models are still loaded by name elsewhere (e.g. items)
+		BlockModel::SetModelArchive(s_ModelArchiveFilePath);
 
-		if (id == BlockId::Air)
-			return false;
+		Stopwatch stopwatch;
+		stopwatch.Start();
 
-		if (!BlockState::IsFullBlock(id, variantIndex))
-			return false;
+		const uint64_t sourceHash =
+			BlockstateRegistryCache::HashSources({s_BlockstateArchiveFilePath, s_ModelArchiveFilePath});
 
-		auto it = blockstateMap.find(id);
-		if (it != blockstateMap.end())
+		if (auto cached = BlockstateRegistryCache::Load(s_CacheFilePath, sourceHash))
 		{
-			return it->second[variantIndex].Model.AmbientOcclusion;
+			std::cout << "[BlockstateRegistry] Loaded " << cached->size() << " blocks from the compiled registry in "
+					  << stopwatch.ElapsedMs() << " ms (warm start)." << std::endl;
+			return std::move(*cached);
 		}
 
-		return false;
+		std::unordered_map<BlockId, std::vector<VariantModel>> blockstateMap = BuildVariantsModel();
+		std::cout << "[BlockstateRegistry] Built " << blockstateMap.size() << " blocks from the archives in "
+				  << stopwatch.ElapsedMs() << " ms (cold start)." << std::endl;
+
+		BlockstateRegistryCache::Save(s_CacheFilePath, sourceHash, blockstateMap);
+		return blockstateMap;
 	}
 
-	std::unordered_map<BlockId, std::vector<VariantModel>> BlockstateRegistry::LoadVariantsModel()
+	std::unordered_map<BlockId, std::vector<VariantModel>> BlockstateRegistry::BuildVariantsModel()
 	{
-		// Init BlockModel archive first since VariantModel depends on it (same directory, but different file name)
-		BlockModel::SetModelArchive(s_ModelArchiveFilePath);
+		struct BlockstateFile
+		{
+			BlockId Id = BlockId::Air;
+			std::filesystem::path ArchivePath;
+			std::string ResourceName;
+			std::vector<VariantModel> Variants;
+		};
 
-		std::unordered_map<BlockId, std::vector<VariantModel>> blockstateMap;
+		// ---- List the archives, the files are read (inflated) by the workers ----
+		const ZipArchive archive(s_BlockstateArchiveFilePath);
 
-		ZipArchive archive(s_BlockstateArchiveFilePath);
-		ZipArchive modelArchive(s_ModelArchiveFilePath);
-		std::vector<std::filesystem::path> blockstateFiles = archive.GetFileList();
+		std::vector<BlockstateFile> files;
+		for (const auto& blockstateFile : archive.GetFileList())
+		{
+			BlockstateFile& file = files.emplace_back();
+			file.Id = BlockIds::GetId(ToBlockName(blockstateFile.filename().string()));
+			file.ArchivePath = blockstateFile;
+			file.ResourceName = blockstateFile.stem().string();
+		}
 
-		for (const auto& blockstateFile : blockstateFiles)
+		std::unordered_set<std::string> modelFiles;
 		{
-			std::string jsonText = archive.GetFileText(blockstateFile);
-			nlohmann::json json = nlohmann::json::parse(jsonText);
+			const ZipArchive modelArchive(s_ModelArchiveFilePath);
+			for (const auto& modelFile : modelArchive.GetFileList())
+				modelFiles.insert(modelFile.generic_string());
+		}
+
+		// ---- Parse the blockstates and resolve their models on every core ----
+		// Shared parents (e.g. block/cube_all) are loaded once, see BlockModel::GetModel
+		const size_t threadCount =
+			std::clamp<size_t>(std::thread::hardware_concurrency(), 1, std::max<size_t>(1, files.size()));
 
-			const std::string blockName = ToBlockName(blockstateFile.filename().string());
-			BlockId blockId = BlockIds::GetId(blockName);
-			const std::string blockResourceName = blockstateFile.stem().string();
+		std::atomic<size_t> nextFile = 0;
+		std::mutex errorMutex;
+		std::exception_ptr error;
 
-			if (json.contains("variants") && json.at("variants").is_object())
+		auto parseFiles = [&]()
+		{
+			for (size_t i = nextFile++; i < files.size(); i = nextFile++)
 			{
-				const auto& variants = json.at("variants");
+				try
+				{
+					const std::string jsonText = archive.GetFileText(files[i].ArchivePath);
+					files[i].Variants = LoadBlockstate(files[i].ResourceName, jsonText, modelFiles);
+				}
+				catch (...)
+				{
+					std::lock_guard lock(errorMutex);
+					if (!error)
+						error = std::current_exception();
+				}
+			}
+		};
 
-				// ---- Iterate variants ----
-				for (auto it = variants.begin(); it != variants.end(); it++)
+		if (threadCount == 1)
+		{
+			parseFiles();
+		}
+		else
+		{
+			ThreadPool threadPool(threadCount);
+			std::latch done(static_cast<std::ptrdiff_t>(threadCount));
+			for (size_t t = 0; t < threadCount; t++)
+			{
+				threadPool.Dispatch(
+					[&parseFiles, &done]()
+					{
+						parseFiles();
+						done.count_down();
+					});
+			}
+			done.wait();
+			threadPool.Close();
+		}
+
+		if (error)
+			std::rethrow_exception(error);
+
+		// ---- Merge in archive order, so variant indices do not depend on scheduling ----
+		std::unordered_map<BlockId, std::vector<VariantModel>> blockstateMap;
+		for (auto& file : files)
+		{
+			if (file.Variants.empty())
+				continue;
+
+			auto& variants = blockstateMap[file.Id];
+			variants.insert(variants.end(),
+							std::make_move_iterator(file.Variants.begin()),
+							std::make_move_iterator(file.Variants.end()));
+		}
+
+		return blockstateMap;
+	}
+
+	std::vector<VariantModel> BlockstateRegistry::LoadBlockstate(const std::string& blockResourceName,
+																  const std::string& jsonText,
+																  const std::unordered_set<std::string>& modelFiles)
+	{
+		std::vector<VariantModel> blockVariants;
+
+		nlohmann::json json = nlohmann::json::parse(jsonText);
+
+		if (json.contains("variants") && json.at("variants").is_object())
+		{
+			const auto& variants = json.at("variants");
+
+			// ---- Iterate variants ----
+			for (auto it = variants.begin(); it != variants.end(); it++)
+			{
+				const std::string& variantKey = it.key();
+				const nlohmann::json& variantValue = it.value();
+
+				auto properties = ParseProperties(variantKey);
+
+				if (variantValue.is_object())
 				{
-					const std::string& variantKey = it.key();
-					const nlohmann::json& variantValue = it.value();
+					VariantModel variantModel = VariantModelFromJson(variantValue);
+					variantModel.Properties = properties;
 
-					auto properties = ParseProperties(variantKey);
+					// ----- Bake blockstate rotation into element geometry -----
+					const int stepsX = ((variantModel.RotationX / 90) % 4 + 4) % 4;
+					const int stepsY = ((variantModel.RotationY / 90) % 4 + 4) % 4;
+					if (stepsX != 0 || stepsY != 0)
+						RotateModel(variantModel.Model, stepsX, stepsY, variantModel.UVLock);
 
-					if (variantValue.is_object())
+					// Resets rotation because it's already baked into the model geometry.
+					variantModel.RotationX = 0;
+					variantModel.RotationY = 0;
+
+					blockVariants.push_back(std::move(variantModel));
+				}
+				else if (variantValue.is_array())
+				{
+					for (const auto& entry : variantValue)
 					{
-						VariantModel variantModel = VariantModelFromJson(variantValue);
+						VariantModel variantModel = VariantModelFromJson(entry);
 						variantModel.Properties = properties;
 
 						// ----- Bake blockstate rotation into element geometry -----
@@ -827,72 +950,51 @@ namespace onion::voxel
 						variantModel.RotationX = 0;
 						variantModel.RotationY = 0;
 
-						blockstateMap[blockId].push_back(std::move(variantModel));
-					}
-					else if (variantValue.is_array())
-					{
-						for (const auto& entry : variantValue)
-						{
-							VariantModel variantModel = VariantModelFromJson(entry);
-							variantModel.Properties = properties;
-
-							// ----- Bake blockstate rotation into element geometry -----
-							const int stepsX = ((variantModel.RotationX / 90) % 4 + 4) % 4;
-							const int stepsY = ((variantModel.RotationY / 90) % 4 + 4) % 4;
-							if (stepsX != 0 || stepsY != 0)
-								RotateModel(variantModel.Model, stepsX, stepsY, variantModel.UVLock);
-
-							// Resets rotation because it's already baked into the model geometry.
-							variantModel.RotationX = 0;
-							variantModel.RotationY = 0;
-
-							blockstateMap[blockId].push_back(std::move(variantModel));
-						}
+						blockVariants.push_back(std::move(variantModel));
 					}
 				}
 			}
-			else if (json.contains("multipart") && json.at("multipart").is_array())
-			{
-				const std::vector<MultipartEntry> multipartEntries = ParseMultipartEntries(json.at("multipart"));
-				if (multipartEntries.empty())
-					continue;
-
-				std::map<std::string, std::set<std::string>> propertyDomain;
-				for (const auto& entry : multipartEntries)
-					CollectPropertyDomainFromPredicate(entry.When, propertyDomain);
-
-				std::set<std::string> seenSignatures;
-				EnumerateAssignments(propertyDomain,
-									 [&](const std::map<std::string, std::string>& assignment)
+		}
+		else if (json.contains("multipart") && json.at("multipart").is_array())
+		{
+			const std::vector<MultipartEntry> multipartEntries = ParseMultipartEntries(json.at("multipart"));
+			if (multipartEntries.empty())
+				return blockVariants;
+
+			std::map<std::string, std::set<std::string>> propertyDomain;
+			for (const auto& entry : multipartEntries)
+				CollectPropertyDomainFromPredicate(entry.When, propertyDomain);
+
+			std::set<std::string> seenSignatures;
+			EnumerateAssignments(propertyDomain,
+								 [&](const std::map<std::string, std::string>& assignment)
+								 {
+									 std::vector<ApplySpec> matchedApplies;
+									 for (const auto& entry : multipartEntries)
 									 {
-										 std::vector<ApplySpec> matchedApplies;
-										 for (const auto& entry : multipartEntries)
-										 {
-											 if (!EvaluateWhenPredicate(entry.When, assignment))
-												 continue;
-											 matchedApplies.insert(
-												 matchedApplies.end(), entry.Applies.begin(), entry.Applies.end());
-										 }
-
-										 if (matchedApplies.empty())
-											 return;
-
-										 const std::string signature = BuildPropertiesSignature(assignment);
-										 if (!seenSignatures.insert(signature).second)
-											 return;
-
-										 VariantModel variant = ComposeMultipartVariant(matchedApplies, assignment);
-										 if (!variant.Model.Elements.empty())
-											 blockstateMap[blockId].push_back(std::move(variant));
-									 });
-			}
-
-			auto blockIt = blockstateMap.find(blockId);
-			if (blockIt != blockstateMap.end())
-				InjectGuiVariant(blockResourceName, modelArchive, blockIt->second);
+										 if (!EvaluateWhenPredicate(entry.When, assignment))
+											 continue;
+										 matchedApplies.insert(
+											 matchedApplies.end(), entry.Applies.begin(), entry.Applies.end());
+									 }
+
+									 if (matchedApplies.empty())
+										 return;
+
+									 const std::string signature = BuildPropertiesSignature(assignment);
+									 if (!seenSignatures.insert(signature).second)
+										 return;
+
+									 VariantModel variant = ComposeMultipartVariant(matchedApplies, assignment);
+									 if (!variant.Model.Elements.empty())
+										 blockVariants.push_back(std::move(variant));
+								 });
 		}
 
-		return blockstateMap;
+		if (!blockVariants.empty())
+			InjectGuiVariant(blockResourceName, modelFiles, blockVariants);
+
+		return blockVariants;
 	}
 
 	VariantModel BlockstateRegistry::VariantModelFromJson(const nlohmann::json& json)
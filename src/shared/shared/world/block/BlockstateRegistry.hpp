@@ -4,6 +4,7 @@
 #include <map>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <nlohmann/json.hpp>
@@ -37,16 +38,24 @@ namespace onion::voxel
 		/// (most properties) wins. Returns 0 if no match is found.
 		static uint8_t GetVariantIndex(BlockId id, const std::map<std::string, std::string>& properties);
 
-		static bool CountsInAO(BlockId id, uint8_t variantIndex);
-
 		// ----- Private Methods -----
 	  private:
 		static inline const std::filesystem::path s_BlockstateArchiveFilePath =
 			Utils::GetExecutableDirectory() / "assets" / "blockstates.zip";
 		static inline const std::filesystem::path s_ModelArchiveFilePath =
 			Utils::GetExecutableDirectory() / "assets" / "models.zip";
+		static inline const std::filesystem::path s_CacheFilePath =
+			Utils::GetExecutableDirectory() / "assets" / "blockstates.cache";
 
+		/// Loads the compiled registry (cf BlockstateRegistryCache), rebuilds it from the archives when outdated.
 		static std::unordered_map<BlockId, std::vector<VariantModel>> LoadVariantsModel();
+		static std::unordered_map<BlockId, std::vector<VariantModel>> BuildVariantsModel();
+
+		/// Parses one blockstate file into its variants. Thread safe.
+		/// @param modelFiles Paths of the files in the model archive.
+		static std::vector<VariantModel> LoadBlockstate(const std::string& blockResourceName,
+														const std::string& jsonText,
+														const std::unordered_set<std::string>& modelFiles);
 
 		static VariantModel VariantModelFromJson(const nlohmann::json& json);
 	};
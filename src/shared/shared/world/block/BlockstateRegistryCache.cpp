@@ -0,0 +1,193 @@
+#include "BlockstateRegistryCache.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/array.hpp>
+#include <cereal/types/map.hpp>
+#include <cereal/types/optional.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/unordered_map.hpp>
+#include <cereal/types/vector.hpp>
+
+#include <shared/data_transfer_objects/serializer/GlmSerialization.hpp>
+#include <shared/utils/Utils.hpp>
+
+namespace onion::voxel
+{
+	// ----- Serialization of the resolved models (found by ADL) -----
+
+	template <class Archive> void serialize(Archive& ar, BlockModel::Face& face)
+	{
+		ar(face.UV, face.Texture, face.CullFace, face.TintIndex, face.Rotation);
+	}
+
+	template <class Archive> void serialize(Archive& ar, BlockModel::ElementRotation& rotation)
+	{
+		ar(rotation.Origin, rotation.Axis, rotation.Angle, rotation.Rescale);
+	}
+
+	template <class Archive> void serialize(Archive& ar, BlockModel::Element& element)
+	{
+		ar(element.From, element.To, element.Rotation, element.Shade, element.Faces);
+	}
+
+	template <class Archive> void serialize(Archive& ar, BlockModel::DisplayInfo& display)
+	{
+		ar(display.Rotation, display.Translation, display.Scale);
+	}
+
+	// The parent path is not saved : parents are already merged into the model
+	template <class Archive> void serialize(Archive& ar, BlockModel& model)
+	{
+		ar(model.AmbientOcclusion, model.ModelTextures, model.Elements, model.ModelDisplay.Gui);
+	}
+
+	template <class Archive> void serialize(Archive& ar, VariantModel& variant)
+	{
+		ar(variant.Properties, variant.Model, variant.RotationX, variant.RotationY, variant.UVLock);
+	}
+
+	// ----- Public API -----
+
+	uint64_t BlockstateRegistryCache::HashSources(const std::vector<std::filesystem::path>& archivePaths)
+	{
+		constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+		constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+		uint64_t hash = FNV_OFFSET;
+		auto mix = [&hash](const char* data, size_t size)
+		{
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= static_cast<uint8_t>(data[i]);
+				hash *= FNV_PRIME;
+			}
+		};
+
+		// Separator, so moving bytes from one source to the next changes the hash
+		auto separate = [&hash]()
+		{
+			hash ^= 0xFF;
+			hash *= FNV_PRIME;
+		};
+
+		std::vector<char> buffer(1 << 16);
+
+		for (const auto& archivePath : archivePaths)
+		{
+			std::ifstream file(archivePath, std::ios::binary);
+			while (file)
+			{
+				file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+				mix(buffer.data(), static_cast<size_t>(file.gcount()));
+			}
+
+			separate();
+		}
+
+		// The registry is built for these blocks : a block added, removed or renamed without a change to the
+		// archives must still rebuild it, or the new block would have no variants
+		const uint32_t blockCount = static_cast<uint32_t>(BlockIds::GetBlockIdCount());
+		mix(reinterpret_cast<const char*>(&blockCount), sizeof(blockCount));
+		separate();
+
+		for (int i = 0; i < BlockIds::GetBlockIdCount(); i++)
+		{
+			const std::string& name = BlockIds::GetName(static_cast<BlockId>(i));
+			mix(name.data(), name.size());
+			separate();
+		}
+
+		return hash;
+	}
+
+	std::optional<BlockstateRegistryCache::Registry> BlockstateRegistryCache::Load(
+		const std::filesystem::path& cacheFilePath, uint64_t sourceHash)
+	{
+		std::ifstream file(cacheFilePath, std::ios::binary);
+		if (!file.is_open())
+			return std::nullopt;
+
+		try
+		{
+			cereal::BinaryInputArchive archive(file);
+
+			uint32_t magic = 0;
+			uint32_t version = 0;
+			uint64_t hash = 0;
+			archive(magic, version, hash);
+
+			if (magic != MAGIC || version != FORMAT_VERSION || hash != sourceHash)
+				return std::nullopt;
+
+			// Blocks are saved by name : BlockId values change when blocks are added
+			uint64_t blockCount = 0;
+			archive(blockCount);
+
+			Registry registry;
+			registry.reserve(static_cast<size_t>(blockCount));
+
+			for (uint64_t i = 0; i < blockCount; i++)
+			{
+				std::string blockName;
+				std::vector<VariantModel> variants;
+				archive(blockName, variants);
+
+				registry[BlockIds::GetId(blockName)] = std::move(variants);
+			}
+
+			return registry;
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "[BlockstateRegistryCache] Ignoring unreadable cache " << cacheFilePath << ": " << e.what()
+					  << std::endl;
+			return std::nullopt;
+		}
+	}
+
+	void BlockstateRegistryCache::Save(const std::filesystem::path& cacheFilePath,
+									   uint64_t sourceHash,
+									   const Registry& registry)
+	{
+		try
+		{
+			std::ostringstream stream(std::ios::binary);
+			{
+				cereal::BinaryOutputArchive archive(stream);
+				archive(MAGIC, FORMAT_VERSION, sourceHash);
+
+				archive(static_cast<uint64_t>(registry.size()));
+				for (const auto& [blockId, variants] : registry)
+				{
+					archive(BlockIds::GetName(blockId), variants);
+				}
+			}
+			const std::string data = stream.str();
+
+			std::filesystem::path tempFilePath = cacheFilePath;
+			tempFilePath += ".tmp";
+
+			std::ofstream file(tempFilePath, std::ios::binary);
+			if (!file.is_open())
+			{
+				std::cerr << "[BlockstateRegistryCache] Failed to open cache file for writing: " << tempFilePath
+						  << std::endl;
+				return;
+			}
+			file.write(data.data(), static_cast<std::streamsize>(data.size()));
+			file.flush();
+			file.close();
+
+			Utils::ReplaceFileAtomic(cacheFilePath, tempFilePath);
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "[BlockstateRegistryCache] Failed to write cache " << cacheFilePath << ": " << e.what()
+					  << std::endl;
+		}
+	}
+} // namespace onion::voxel
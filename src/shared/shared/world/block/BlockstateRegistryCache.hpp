@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <shared/world/block/BlockstateRegistry.hpp>
+
+namespace onion::voxel
+{
+	/// @brief Compiled form of the BlockstateRegistry, saved next to the assets.
+	/// Holds the fully resolved variants (parents merged, multiparts enumerated, rotations baked), so a warm start
+	/// skips the archives' JSON entirely. The file is keyed by a hash of the source archives and a format version :
+	/// it is rebuilt whenever one of the archives or the BlockIds table changes.
+	class BlockstateRegistryCache
+	{
+		using Registry = std::unordered_map<BlockId, std::vector<VariantModel>>;
+
+		// ----- Public API -----
+	  public:
+		/// @brief FNV-1a hash of everything the registry is built from : the content of the archives, in order
+		/// (missing files hash as empty), and the BlockIds name table (count and names).
+		static uint64_t HashSources(const std::vector<std::filesystem::path>& archivePaths);
+
+		/// @brief Load the registry from the cache file.
+		/// Returns nothing if the file is missing, from another format version or built from other archives.
+		static std::optional<Registry> Load(const std::filesystem::path& cacheFilePath, uint64_t sourceHash);
+
+		/// @brief Write the registry to the cache file (atomically replaced). Failures are only logged.
+		static void Save(const std::filesystem::path& cacheFilePath, uint64_t sourceHash, const Registry& registry);
+
+		// ----- Format -----
+	  private:
+		static constexpr uint32_t MAGIC = 0x5242564F; // "OVBR"
+
+		/// Bump when VariantModel / BlockModel or the way the registry is built changes (BuildVariantsModel,
+		/// LoadBlockstate, BlockModel parent merging...) : the hash only covers the archives and the BlockIds table,
+		/// a stale cache built by the old code would still load.
+		static constexpr uint32_t FORMAT_VERSION = 1;
+	};
+} // namespace onion::voxel
@@ -67,6 +67,44 @@ namespace onion::voxel
 		return m_BlocksPalette[blockIndex];
 	}
 
+	void Chunk::GetBlocks(const glm::ivec3& localMin,
+						  const glm::ivec3& localMax,
+						  std::vector<BlockState>& outBlocks) const
+	{
+		assert(localMin.x >= 0 && localMax.x < WorldConstants::CHUNK_SIZE && localMin.x <= localMax.x);
+		assert(localMin.z >= 0 && localMax.z < WorldConstants::CHUNK_SIZE && localMin.z <= localMax.z);
+		assert(localMin.y <= localMax.y);
+
+		const glm::ivec3 size = localMax - localMin + glm::ivec3(1);
+		outBlocks.resize(static_cast<size_t>(size.x) * size.y * size.z);
+
+		std::shared_lock lock(m_Mutex);
+
+		const int chunkHeight = static_cast<int>(m_SubChunks.size()) * WorldConstants::CHUNK_SIZE;
+
+		size_t i = 0;
+		for (int z = localMin.z; z <= localMax.z; z++)
+		{
+			for (int y = localMin.y; y <= localMax.y; y++)
+			{
+				if (y < 0 || y >= chunkHeight)
+				{
+					std::fill_n(outBlocks.begin() + i, size.x, BlockState(BlockId::Air));
+					i += size.x;
+					continue;
+				}
+
+				const SubChunk& subChunk = m_SubChunks[y / WorldConstants::CHUNK_SIZE];
+				const int subChunkY = y % WorldConstants::CHUNK_SIZE;
+
+				for (int x = localMin.x; x <= localMax.x; x++)
+				{
+					outBlocks[i++] = m_BlocksPalette[subChunk.GetBlockIndexInPalette({x, subChunkY, z})];
+				}
+			}
+		}
+	}
+
 	void Chunk::SetBlock(const glm::ivec3& localPosition, const BlockState& block)
 	{
 		// Check if localPosition is within bounds of the chunk
@@ -101,6 +139,67 @@ namespace onion::voxel
 		subChunk.SetBlockIndexInPalette(localPositionInSubChunk, indexInPalette);
 	}
 
+	size_t Chunk::SetBlocks(const std::vector<std::pair<glm::ivec3, BlockState>>& localBlocks,
+							std::vector<bool>& outChanged)
+	{
+		outChanged.assign(localBlocks.size(), false);
+
+		std::unique_lock lock(m_Mutex);
+
+		// Distinct blocks of an edit are few : a short list beats the linear search over the whole palette
+		std::vector<std::pair<BlockState, uint16_t>> resolvedIndices;
+		auto resolveIndex = [this, &resolvedIndices](const BlockState& block)
+		{
+			for (const auto& [resolvedBlock, index] : resolvedIndices)
+			{
+				if (resolvedBlock == block)
+					return index;
+			}
+
+			const uint16_t index = GetOrAddPaletteIndex(block);
+			resolvedIndices.emplace_back(block, index);
+			return index;
+		};
+
+		size_t changedCount = 0;
+		for (size_t i = 0; i < localBlocks.size(); i++)
+		{
+			const auto& [localPosition, block] = localBlocks[i];
+
+			assert(localPosition.x >= 0 && localPosition.x < WorldConstants::CHUNK_SIZE);
+			assert(localPosition.y >= 0);
+			assert(localPosition.z >= 0 && localPosition.z < WorldConstants::CHUNK_SIZE);
+
+			const size_t subChunkIndex = static_cast<size_t>(localPosition.y / WorldConstants::CHUNK_SIZE);
+			const uint8_t subChunkY = static_cast<uint8_t>(localPosition.y % WorldConstants::CHUNK_SIZE);
+
+			// Above the chunk is air
+			if (subChunkIndex >= m_SubChunks.size())
+			{
+				if (block == BlockState(BlockId::Air))
+					continue;
+
+				m_SubChunks.resize(subChunkIndex + 1);
+				m_ChunkHeight = static_cast<int>(m_SubChunks.size() * WorldConstants::CHUNK_SIZE);
+			}
+
+			SubChunk& subChunk = m_SubChunks[subChunkIndex];
+			const glm::ivec3 subChunkPosition{localPosition.x, subChunkY, localPosition.z};
+			if (m_BlocksPalette[subChunk.GetBlockIndexInPalette(subChunkPosition)] == block)
+				continue;
+
+			subChunk.SetBlockIndexInPalette_Unsafe(static_cast<uint8_t>(localPosition.x),
+												   subChunkY,
+												   static_cast<uint8_t>(localPosition.z),
+												   resolveIndex(block));
+
+			outChanged[i] = true;
+			changedCount++;
+		}
+
+		return changedCount;
+	}
+
 	void voxel::Chunk::SetBlock_Unsafe(const uint8_t x, const uint16_t y, const uint8_t z, const BlockState& block)
 	{
 		// Add the block to the palette and get the block data index
@@ -4,6 +4,7 @@
 
 #include <mutex>
 #include <shared_mutex>
+#include <utility>
 #include <vector>
 
 #include <shared/world/block/Block.hpp>
@@ -34,7 +35,16 @@ namespace onion::voxel
 		glm::ivec2 GetPosition() const;
 
 		BlockState GetBlock(const glm::ivec3& localPosition) const;
+		/// @brief Copy the blocks of the local box [localMin, localMax] under a single lock, x first, then y, then z.
+		/// Positions below or above the chunk are air. outBlocks is resized, its capacity is reused.
+		void
+		GetBlocks(const glm::ivec3& localMin, const glm::ivec3& localMax, std::vector<BlockState>& outBlocks) const;
 		void SetBlock(const glm::ivec3& localPosition, const BlockState& block);
+		/// @brief Set several blocks under a single exclusive lock, resolving each distinct block in the palette once.
+		/// Blocks already in the requested state are skipped. outChanged[i] tells whether localBlocks[i] was written.
+		/// @return The number of blocks written
+		size_t
+		SetBlocks(const std::vector<std::pair<glm::ivec3, BlockState>>& localBlocks, std::vector<bool>& outChanged);
 
 		void SetBlock_Unsafe(const uint8_t x, const uint16_t y, const uint8_t z, const BlockState& block);
 
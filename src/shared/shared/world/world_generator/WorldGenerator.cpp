@@ -2,7 +2,7 @@
 
 #include <iostream>
 
-#include <shared/utils/Stopwatch.hpp>
+#include <shared/profiler/Profiler.hpp>
 #include <shared/utils/Utils.hpp>
 
 #include <shared/world/block/BlockstateRegistry.hpp>
@@ -115,6 +115,8 @@ namespace onion::voxel
 
 	void WorldGenerator::GenerateChunkAsync(const glm::ivec2& chunkPosition)
 	{
+		m_PendingChunkCount.fetch_add(1, std::memory_order_relaxed);
+
 		m_ThreadPool.Dispatch(
 			[this, chunkPosition]()
 			{
@@ -124,6 +126,8 @@ namespace onion::voxel
 					EvtChunkGenerated.Trigger(genChunk);
 					FinishGeneratingChunk(chunkPosition);
 				}
+
+				m_PendingChunkCount.fetch_sub(1, std::memory_order_relaxed);
 			});
 	}
 
@@ -135,6 +139,11 @@ namespace onion::voxel
 		}
 	}
 
+	size_t WorldGenerator::GetPendingChunkCount() const
+	{
+		return m_PendingChunkCount.load(std::memory_order_relaxed);
+	}
+
 	uint32_t WorldGenerator::GetSeed() const
 	{
 		return m_Seed;
@@ -184,8 +193,7 @@ namespace onion::voxel
 
 	WorldGenerator::GenChunk WorldGenerator::GenerateChunk(const glm::ivec2& chunkPosition)
 	{
-		Stopwatch stopwatch;
-		stopwatch.Start();
+		ONION_PROFILE_ZONE("WorldGenerator::GenerateChunk");
 
 		GenChunk genChunk;
 
@@ -210,10 +218,6 @@ namespace onion::voxel
 				throw std::runtime_error("Invalid world generation type");
 		}
 
-		double elapsedMs = stopwatch.ElapsedMs();
-		(void) elapsedMs; // Currently unused
-		//std::cout << elapsedMs << " ms" << std::endl;
-
 		return genChunk;
 	}
 
@@ -541,158 +545,149 @@ namespace onion::voxel
 
 		constexpr int CHUNK_SIZE = WorldConstants::CHUNK_SIZE;
 
-		//Stopwatch swTotal;
-		//swTotal.Start();
+		ONION_PROFILE_ZONE("WorldGenerator::ClassicNoBiomes");
 
 		// Gets the height map
-		//Stopwatch swHeightMap;
-		//swHeightMap.Start();
 		uint16_t heightMap[CHUNK_SIZE][CHUNK_SIZE] = {0};
-		for (uint8_t z = 0; z < CHUNK_SIZE; z++)
 		{
-			for (uint8_t x = 0; x < CHUNK_SIZE; x++)
+			ONION_PROFILE_ZONE("WorldGenerator::HeightMap");
+
+			for (uint8_t z = 0; z < CHUNK_SIZE; z++)
 			{
-				// ------- GENERATE HEIGHT MAP WITHOUT BIOMES -------
+				for (uint8_t x = 0; x < CHUNK_SIZE; x++)
+				{
+					// ------- GENERATE HEIGHT MAP WITHOUT BIOMES -------
 
-				int realWorldX = (chunkPosition.x * CHUNK_SIZE + x);
-				int realWorldZ = (chunkPosition.y * CHUNK_SIZE + z);
+					int realWorldX = (chunkPosition.x * CHUNK_SIZE + x);
+					int realWorldZ = (chunkPosition.y * CHUNK_SIZE + z);
 
-				float warpX =
-					GetFractalNoise(m_NoiseWarp, (float) realWorldX, (float) realWorldZ, 2, 2.0f, 0.5f) * 200.0f;
-				float warpZ =
-					GetFractalNoise(m_NoiseWarp2, (float) realWorldX, (float) realWorldZ, 2, 2.0f, 0.5f) * 200.0f;
+					float warpX =
+						GetFractalNoise(m_NoiseWarp, (float) realWorldX, (float) realWorldZ, 2, 2.0f, 0.5f) * 200.0f;
+					float warpZ =
+						GetFractalNoise(m_NoiseWarp2, (float) realWorldX, (float) realWorldZ, 2, 2.0f, 0.5f) * 200.0f;
 
-				float continents = GetFractalNoise(
-					m_NoiseContinent, (float) realWorldX + warpX, (float) realWorldZ + warpZ, 3, 2.0f, 0.5f);
+					float continents = GetFractalNoise(
+						m_NoiseContinent, (float) realWorldX + warpX, (float) realWorldZ + warpZ, 3, 2.0f, 0.5f);
 
-				float mountains =
-					GetFractalNoise(m_NoiseMountain, (float) realWorldX, (float) realWorldZ, 4, 2.0f, 0.5f);
-				float detail = GetFractalNoise(m_NoiseDetail, (float) realWorldX, (float) realWorldZ, 3, 2.0f, 0.5f);
+					float mountains =
+						GetFractalNoise(m_NoiseMountain, (float) realWorldX, (float) realWorldZ, 4, 2.0f, 0.5f);
+					float detail =
+						GetFractalNoise(m_NoiseDetail, (float) realWorldX, (float) realWorldZ, 3, 2.0f, 0.5f);
 
-				// Map continent noise to [0,1]
-				float continentMask = (continents + 1.0f) * 0.5f;
+					// Map continent noise to [0,1]
+					float continentMask = (continents + 1.0f) * 0.5f;
 
-				float mountainStart = 0.35f;
-				float mountainEnd = 0.85f;
+					float mountainStart = 0.35f;
+					float mountainEnd = 0.85f;
 
-				// Create a mask for mountains so that they only appear in the higher parts of the continents
-				continentMask = std::clamp((continentMask - mountainStart) / (mountainEnd - mountainStart), 0.0f, 1.0f);
-				continentMask = continentMask * continentMask * (3.0f - 2.0f * continentMask);
+					// Create a mask for mountains so that they only appear in the higher parts of the continents
+					continentMask =
+						std::clamp((continentMask - mountainStart) / (mountainEnd - mountainStart), 0.0f, 1.0f);
+					continentMask = continentMask * continentMask * (3.0f - 2.0f * continentMask);
 
-				// Map mountains noise to [0,1], and apply a curve to have more flat areas and less extreme mountains
-				mountains = (mountains + 1.0f) * 0.5f;
-				mountains = mountains * mountains;
+					// Map mountains noise to [0,1], and apply a curve to have more flat areas and less extreme
+					// mountains
+					mountains = (mountains + 1.0f) * 0.5f;
+					mountains = mountains * mountains;
 
-				// Apply the continent mask to the mountains so that they only appear on continents
-				mountains *= continentMask;
+					// Apply the continent mask to the mountains so that they only appear on continents
+					mountains *= continentMask;
 
-				float height = m_SeaLevel + continents * 50.0f + mountains * 300.0f + detail * 5.0f;
+					float height = m_SeaLevel + continents * 50.0f + mountains * 300.0f + detail * 5.0f;
 
-				heightMap[z][x] =
-					static_cast<uint16_t>(std::clamp(height, 1.0f, static_cast<float>(m_WorldHeight - 1)));
+					heightMap[z][x] =
+						static_cast<uint16_t>(std::clamp(height, 1.0f, static_cast<float>(m_WorldHeight - 1)));
+				}
 			}
 		}
-		//double heightMapMs = swHeightMap.ElapsedMs();
 
 		// Fills the chunks with blocks based on the height map
-		//double foliageAccumMs = 0.0;
-		//Stopwatch swBlockFill;
-		//swBlockFill.Start();
-
-		// Pre-resolve palette indices once to avoid repeated linear scans inside the fill loops
-		const uint16_t idxBedrock = chunk->GetOrAddPaletteIndex(BlockState(BlockId::Bedrock));
-		const uint16_t idxStone = chunk->GetOrAddPaletteIndex(BlockState(BlockId::Stone));
-		const uint16_t idxDirt = chunk->GetOrAddPaletteIndex(BlockState(BlockId::Dirt));
-		const uint16_t idxGrass = chunk->GetOrAddPaletteIndex(BlockState(BlockId::GrassBlock));
-		const uint16_t idxSnow = chunk->GetOrAddPaletteIndex(BlockState(BlockId::SnowBlock));
-		const uint16_t idxWater = chunk->GetOrAddPaletteIndex(BlockState(BlockId::Water));
-		const uint16_t idxSand = chunk->GetOrAddPaletteIndex(BlockState(BlockId::Sand));
-		const uint16_t idxGravel = chunk->GetOrAddPaletteIndex(BlockState(BlockId::Gravel));
-
-		for (uint8_t z = 0; z < CHUNK_SIZE; z++)
 		{
-			for (uint8_t x = 0; x < CHUNK_SIZE; x++)
+			ONION_PROFILE_ZONE("WorldGenerator::BlockFill");
+
+			// Pre-resolve palette indices once to avoid repeated linear scans inside the fill loops
+			const uint16_t idxBedrock = chunk->GetOrAddPaletteIndex(BlockState(BlockId::Bedrock));
+			const uint16_t idxStone = chunk->GetOrAddPaletteIndex(BlockState(BlockId::Stone));
+			const uint16_t idxDirt = chunk->GetOrAddPaletteIndex(BlockState(BlockId::Dirt));
+			const uint16_t idxGrass = chunk->GetOrAddPaletteIndex(BlockState(BlockId::GrassBlock));
+			const uint16_t idxSnow = chunk->GetOrAddPaletteIndex(BlockState(BlockId::SnowBlock));
+			const uint16_t idxWater = chunk->GetOrAddPaletteIndex(BlockState(BlockId::Water));
+			const uint16_t idxSand = chunk->GetOrAddPaletteIndex(BlockState(BlockId::Sand));
+			const uint16_t idxGravel = chunk->GetOrAddPaletteIndex(BlockState(BlockId::Gravel));
+
+			for (uint8_t z = 0; z < CHUNK_SIZE; z++)
 			{
-				uint16_t height = heightMap[z][x];
+				for (uint8_t x = 0; x < CHUNK_SIZE; x++)
+				{
+					uint16_t height = heightMap[z][x];
 
-				const glm::ivec3 worldPos = {
-					chunkPosition.x * CHUNK_SIZE + x, height, chunkPosition.y * CHUNK_SIZE + z};
+					const glm::ivec3 worldPos = {
+						chunkPosition.x * CHUNK_SIZE + x, height, chunkPosition.y * CHUNK_SIZE + z};
 
-				int adjustedSnowLevel = m_SnowLevel;
-				double val = m_SeededRandom.GetValue(worldPos);
-				constexpr int snowLevelVariation = 10;
+					int adjustedSnowLevel = m_SnowLevel;
+					double val = m_SeededRandom.GetValue(worldPos);
+					constexpr int snowLevelVariation = 10;
 
-				// From range [0,1] to range [-snowLevelVariation, snowLevelVariation]
-				int snowLevelOffset = static_cast<int>((val * 2.0 - 1.0) * snowLevelVariation);
-				adjustedSnowLevel += snowLevelOffset;
+					// From range [0,1] to range [-snowLevelVariation, snowLevelVariation]
+					int snowLevelOffset = static_cast<int>((val * 2.0 - 1.0) * snowLevelVariation);
+					adjustedSnowLevel += snowLevelOffset;
 
-				// Higher than sea level
-				if (height >= m_SeaLevel)
-				{
-					const uint16_t idxTop = (height >= adjustedSnowLevel) ? idxSnow : idxGrass;
-
-					float altitudeFactor = std::clamp(
-						(float) (height - m_SeaLevel) / (float) (adjustedSnowLevel - m_SeaLevel), 0.0f, 1.0f);
-					int numDirtLayers = (int) std::round((1.0f - altitudeFactor) * 3.0f);
-
-					// Bedrock
-					chunk->FillColumn_Unsafe(x, 0, 0, z, idxBedrock);
-					// Stone
-					if (height - numDirtLayers > 1)
-						chunk->FillColumn_Unsafe(x, 1, (uint16_t) (height - numDirtLayers - 1), z, idxStone);
-					// Dirt
-					if (numDirtLayers > 0)
-						chunk->FillColumn_Unsafe(
-							x, (uint16_t) (height - numDirtLayers), (uint16_t) (height - 1), z, idxDirt);
-					// Top block
-					chunk->FillColumn_Unsafe(x, height, height, z, idxTop);
-				}
-				else
-				{
-					const uint16_t idxSeaFloor = (height < m_SeaLevel - 8) ? idxGravel : idxSand;
-
-					// Bedrock
-					chunk->FillColumn_Unsafe(x, 0, 0, z, idxBedrock);
-					// Stone
-					if (height > 4)
-						chunk->FillColumn_Unsafe(x, 1, (uint16_t) (height - 4), z, idxStone);
-					// Sand / Gravel
-					if (height >= 1)
-						chunk->FillColumn_Unsafe(x, (uint16_t) std::max(1, height - 3), height, z, idxSeaFloor);
-					// Water
-					if (height + 1 < m_SeaLevel)
-						chunk->FillColumn_Unsafe(x, (uint16_t) (height + 1), (uint16_t) (m_SeaLevel - 1), z, idxWater);
-				}
+					// Higher than sea level
+					if (height >= m_SeaLevel)
+					{
+						const uint16_t idxTop = (height >= adjustedSnowLevel) ? idxSnow : idxGrass;
+
+						float altitudeFactor = std::clamp(
+							(float) (height - m_SeaLevel) / (float) (adjustedSnowLevel - m_SeaLevel), 0.0f, 1.0f);
+						int numDirtLayers = (int) std::round((1.0f - altitudeFactor) * 3.0f);
+
+						// Bedrock
+						chunk->FillColumn_Unsafe(x, 0, 0, z, idxBedrock);
+						// Stone
+						if (height - numDirtLayers > 1)
+							chunk->FillColumn_Unsafe(x, 1, (uint16_t) (height - numDirtLayers - 1), z, idxStone);
+						// Dirt
+						if (numDirtLayers > 0)
+							chunk->FillColumn_Unsafe(
+								x, (uint16_t) (height - numDirtLayers), (uint16_t) (height - 1), z, idxDirt);
+						// Top block
+						chunk->FillColumn_Unsafe(x, height, height, z, idxTop);
+					}
+					else
+					{
+						const uint16_t idxSeaFloor = (height < m_SeaLevel - 8) ? idxGravel : idxSand;
+
+						// Bedrock
+						chunk->FillColumn_Unsafe(x, 0, 0, z, idxBedrock);
+						// Stone
+						if (height > 4)
+							chunk->FillColumn_Unsafe(x, 1, (uint16_t) (height - 4), z, idxStone);
+						// Sand / Gravel
+						if (height >= 1)
+							chunk->FillColumn_Unsafe(x, (uint16_t) std::max(1, height - 3), height, z, idxSeaFloor);
+						// Water
+						if (height + 1 < m_SeaLevel)
+							chunk->FillColumn_Unsafe(
+								x, (uint16_t) (height + 1), (uint16_t) (m_SeaLevel - 1), z, idxWater);
+					}
 
-				// If top block is not transparent, try to generate foliage on top of it
-				bool isAboveSeaLevel = height > m_SeaLevel;
-				bool isBlockTransparent = BlockState::IsTransparent(chunk->GetBlock(glm::ivec3(x, height, z)).ID);
-				if (isAboveSeaLevel && !isBlockTransparent)
-				{
-					glm::ivec3 localPosAbove = {x, height + 1, z};
-					//Stopwatch swFoliage;
-					//swFoliage.Start();
-					AddFoliage(genChunk, worldPos + glm::ivec3(0, 1, 0), localPosAbove, Biome::Forest);
-					//foliageAccumMs += swFoliage.ElapsedMs();
+					// If top block is not transparent, try to generate foliage on top of it
+					bool isAboveSeaLevel = height > m_SeaLevel;
+					bool isBlockTransparent = BlockState::IsTransparent(chunk->GetBlock(glm::ivec3(x, height, z)).ID);
+					if (isAboveSeaLevel && !isBlockTransparent)
+					{
+						glm::ivec3 localPosAbove = {x, height + 1, z};
+						AddFoliage(genChunk, worldPos + glm::ivec3(0, 1, 0), localPosAbove, Biome::Forest);
+					}
 				}
 			}
 		}
-		//double blockFillMs = swBlockFill.ElapsedMs();
 
 		// Optimize the chunk (less memory, faster to send to clients)
-		//Stopwatch swOptimize;
-		//swOptimize.Start();
-		chunk->Optimize();
-		//double optimizeMs = swOptimize.ElapsedMs();
-
-		//double totalMs = swTotal.ElapsedMs();
-		//std::cout << "[ClassicNoBiomes] Chunk (" << chunkPosition.x << ", " << chunkPosition.y << ")\n"
-		//		  << "  HeightMap:  " << heightMapMs << " ms\n"
-		//		  << "  BlockFill:  " << blockFillMs << " ms"
-		//		  << "  (Foliage: " << foliageAccumMs << " ms,"
-		//		  << " Net: " << (blockFillMs - foliageAccumMs) << " ms)\n"
-		//		  << "  Optimize:   " << optimizeMs << " ms\n"
-		//		  << "  Total:      " << totalMs << " ms\n";
+		{
+			ONION_PROFILE_ZONE("WorldGenerator::Optimize");
+			chunk->Optimize();
+		}
 
 		return genChunk;
 	}
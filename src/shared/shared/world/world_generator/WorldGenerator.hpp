@@ -2,6 +2,7 @@
 
 #include <FastNoiseLite.h>
 
+#include <atomic>
 #include <memory>
 #include <random>
 #include <thread>
@@ -80,6 +81,9 @@ namespace onion::voxel
 		void SetSeed(uint32_t seed);
 
 		eWorldGenerationType GetWorldGenerationType() const;
+
+		/// @brief Chunks requested and not generated yet (queued or being generated).
+		size_t GetPendingChunkCount() const;
 		void SetWorldGenerationType(eWorldGenerationType worldGenerationType);
 
 		// ----- Helpers -----
@@ -103,6 +107,7 @@ namespace onion::voxel
 		// ----- Chunk Generation Thread -----
 	  private:
 		ThreadPool m_ThreadPool{4};
+		std::atomic_size_t m_PendingChunkCount{0};
 
 		GenChunk GenerateChunk(const glm::ivec2& chunkPosition);
 
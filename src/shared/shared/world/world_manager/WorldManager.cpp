@@ -3,7 +3,9 @@
 #include <shared/utils/Utils.hpp>
 #include <shared/world/block/BlockUpdater.hpp>
 
+#include <cstdlib>
 #include <iostream>
+#include <unordered_set>
 
 namespace onion::voxel
 {
@@ -189,6 +191,8 @@ namespace onion::voxel
 
 		m_EntityManager->ClearAllEntities();
 
+		m_BlockUpdateQueue.Clear();
+
 		{
 			std::unique_lock lock(m_MutexOutOfBoundsBlocks);
 			if (m_WorldSave)
@@ -220,6 +224,11 @@ namespace onion::voxel
 		return m_EntityManager->GetAllPlayersPosition();
 	}
 
+	std::vector<std::string> WorldManager::GetPlayersNearChunk(const glm::ivec2& chunkPosition, int distance) const
+	{
+		return m_EntityManager->GetPlayersNearChunk(chunkPosition, distance);
+	}
+
 	std::shared_ptr<Player> WorldManager::GetPlayer(const std::string& uuid) const
 	{
 		return m_EntityManager->GetPlayer(uuid);
@@ -233,7 +242,8 @@ namespace onion::voxel
 	void WorldManager::SetChunkPersistanceDistance(uint8_t distance)
 	{
 		m_ChunkPersistanceDistance = distance;
-		RemoveDistantChunks();
+		m_EntityManager->SetInterestDistance(distance);
+		UpdateChunkTickets();
 	}
 
 	void WorldManager::SetChunkLoadingDistance(uint8_t distance)
@@ -330,6 +340,9 @@ namespace onion::voxel
 			player->SetHotbar(updatedPlayer->GetHotbar());
 		}
 
+		// The components were copied through the player, the spatial index has not seen the move
+		m_EntityManager->RefreshPlayerChunk(player->UUID);
+
 		if (newChunkPos != oldChunkPos)
 		{
 			PlayerChangedChunkEventArgs args;
@@ -355,6 +368,11 @@ namespace onion::voxel
 		return m_EntityManager->GetAllPlayers();
 	}
 
+	std::shared_ptr<EntityStore> WorldManager::GetEntityStore() const
+	{
+		return m_EntityManager->GetEntityStore();
+	}
+
 	void WorldManager::SetSingleplayerPlayerUUID(const std::string& playerUUID)
 	{
 		std::unique_lock lock(m_MutexSingleplayer);
@@ -423,8 +441,7 @@ namespace onion::voxel
 		//		  << args.OldChunkPosition.y << " to " << args.NewChunkPosition.x << ", " << args.NewChunkPosition.y
 		//		  << std::endl;
 
-		RemoveDistantChunks();
-		RequestAllMissingChunks();
+		UpdateChunkTickets(GetChunksEnteringLoadingArea(args));
 
 		// Save Players to the world save (if it exists)
 		if (m_WorldSave)
@@ -519,35 +536,37 @@ namespace onion::voxel
 	size_t
 	WorldManager::SetBlocks(const std::vector<Block>& blocks, BlocksChangedEventArgs::eOrigin origin, bool notify)
 	{
-		std::unordered_map<glm::ivec2, std::vector<std::pair<glm::ivec3, Block>>> blocksByChunk;
+		// Indices of the blocks, grouped by chunk
+		std::unordered_map<glm::ivec2, std::vector<size_t>> blocksByChunk;
 		std::vector<Block> blocksToNotify;
 
 		// Group blocks by chunk
-		for (const auto& block : blocks)
+		for (size_t i = 0; i < blocks.size(); i++)
 		{
-			glm::ivec2 chunkPos = Utils::WorldToChunkPosition(block.Position);
-			glm::ivec3 localPos = Utils::WorldToLocalPosition(block.Position);
-			blocksByChunk[chunkPos].emplace_back(localPos, block);
+			blocksByChunk[Utils::WorldToChunkPosition(blocks[i].Position)].push_back(i);
 		}
 
-		// Set blocks for each chunk
-		for (const auto& [chunkPos, blocksInChunk] : blocksByChunk)
+		// Set blocks for each chunk, under one lock per chunk
+		std::vector<std::pair<glm::ivec3, BlockState>> localBlocks;
+		std::vector<bool> changed;
+		for (const auto& [chunkPos, blockIndices] : blocksByChunk)
 		{
 			std::shared_ptr<Chunk> chunk = GetChunk(chunkPos);
 			if (chunk)
 			{
-				for (const auto& [localPos, block] : blocksInChunk)
+				localBlocks.clear();
+				for (const size_t i : blockIndices)
 				{
-					BlockState currentBlock = chunk->GetBlock(localPos);
-					if (currentBlock != block.State)
-					{
-						chunk->SetBlock(localPos, block.State);
+					localBlocks.emplace_back(Utils::WorldToLocalPosition(blocks[i].Position), blocks[i].State);
+				}
 
-						const glm::ivec3 worldPos = Utils::LocalToWorldPosition(localPos, chunkPos);
-						UpdateBlock(worldPos, true);
+				if (chunk->SetBlocks(localBlocks, changed) == 0)
+					continue;
 
-						blocksToNotify.push_back(block);
-					}
+				for (size_t j = 0; j < blockIndices.size(); j++)
+				{
+					if (changed[j])
+						blocksToNotify.push_back(blocks[blockIndices[j]]);
 				}
 			}
 			else
@@ -555,13 +574,16 @@ namespace onion::voxel
 				// If chunk is not loaded, add blocks to out-of-bounds map so they can be placed when the chunk is loaded
 				std::unique_lock lock(m_MutexOutOfBoundsBlocks);
 
-				for (const auto& [localPos, block] : blocksInChunk)
+				for (const size_t i : blockIndices)
 				{
-					m_OutOfBoundsBlocks[chunkPos].push_back(block);
+					m_OutOfBoundsBlocks[chunkPos].push_back(blocks[i]);
 				}
 			}
 		}
 
+		// The changed blocks and their neighbors are updated by the next ProcessBlockUpdates calls
+		ScheduleBlockUpdates(blocksToNotify);
+
 		size_t numBlocksSet = blocksToNotify.size();
 		if (notify && numBlocksSet > 0)
 		{
@@ -740,7 +762,12 @@ namespace onion::voxel
 
 	void WorldManager::Handle_ChunkAdded(const std::shared_ptr<Chunk>& chunk)
 	{
-		(void) chunk; // Unused parameter
+		// Chunks added out of every player's area (spawn chunk, late generation) never get a ticket to release
+		if (!m_EntityManager->IsInInterestArea(chunk->GetPosition()))
+		{
+			ScheduleUnload(chunk->GetPosition());
+		}
+
 		PlaceOutOfBoundsBlocks();
 	}
 
@@ -776,7 +803,6 @@ namespace onion::voxel
 	void WorldManager::RequestAllMissingChunks()
 	{
 		std::vector<glm::ivec2> missingChunks;
-		std::unordered_map<std::string, glm::vec3> playersPosition;
 		std::unordered_map<glm::ivec2, std::shared_ptr<Chunk>> chunks = GetAllChunks();
 
 		// Request the spawn chunk if missing.
@@ -785,38 +811,43 @@ namespace onion::voxel
 			missingChunks.push_back(m_SpawnChunkPosition);
 		}
 
+		const int loadingDistance = std::min(GetChunkPersistanceDistance(), m_ChunkLoadingDistance.load());
+
 		if (!m_SingleplayerPlayerUUID.empty())
 		{
 			// In SinglePlayer : Only consider the single player for determining missing chunks.
 			auto player = GetPlayer(m_SingleplayerPlayerUUID);
 			if (player)
 			{
-				playersPosition[player->UUID] = player->GetPosition();
+				glm::ivec2 playerChunkPos = Utils::WorldToChunkPosition(player->GetPosition());
+
+				for (int x = -loadingDistance; x <= loadingDistance; x++)
+				{
+					for (int y = -loadingDistance; y <= loadingDistance; y++)
+					{
+						glm::ivec2 chunkPos = playerChunkPos + glm::ivec2(x, y);
+						if (chunks.find(chunkPos) == chunks.end())
+						{
+							missingChunks.push_back(chunkPos); // Mark chunk as missing if it is not loaded
+						}
+					}
+				}
 			}
 		}
 		else
 		{
-			// In Multiplayer, consider all players for determining missing chunks.
-			playersPosition = GetPlayersPosition();
-		}
+			// In Multiplayer, consider all players : the interest area is the union of the players' areas
+			const bool isLoadingAreaSmaller = loadingDistance < m_EntityManager->GetInterestDistance();
 
-		// For each player, check the chunks within the persistance distance and mark them as missing if they are not loaded
-		int persistanceDistance = std::min(GetChunkPersistanceDistance(), m_ChunkLoadingDistance.load());
+			for (const glm::ivec2& chunkPos : m_EntityManager->GetInterestArea())
+			{
+				if (chunks.find(chunkPos) != chunks.end())
+					continue;
 
-		for (const auto& [clientHandle, playerPos] : playersPosition)
-		{
-			glm::ivec2 playerChunkPos = Utils::WorldToChunkPosition(playerPos);
+				if (isLoadingAreaSmaller && m_EntityManager->GetPlayersNearChunk(chunkPos, loadingDistance).empty())
+					continue;
 
-			for (int x = -persistanceDistance; x <= persistanceDistance; x++)
-			{
-				for (int y = -persistanceDistance; y <= persistanceDistance; y++)
-				{
-					glm::ivec2 chunkPos = playerChunkPos + glm::ivec2(x, y);
-					if (chunks.find(chunkPos) == chunks.end())
-					{
-						missingChunks.push_back(chunkPos); // Mark chunk as missing if it is not loaded
-					}
-				}
+				missingChunks.push_back(chunkPos); // Mark chunk as missing if it is not loaded
 			}
 		}
 
@@ -836,82 +867,241 @@ namespace onion::voxel
 		}
 	}
 
-	void WorldManager::UpdateBlock(const glm::ivec3& worldPosition, bool propagateToNeighbors)
+	void WorldManager::ScheduleBlockUpdate(const glm::ivec3& worldPosition, uint32_t delay)
 	{
-		const BlockState target = GetBlock(worldPosition);
+		m_BlockUpdateQueue.Schedule(worldPosition, delay);
+	}
 
-		const std::array<BlockState, 6> neighbors = {
-			GetBlock(worldPosition + glm::ivec3{0, -1, 0}), // Down
-			GetBlock(worldPosition + glm::ivec3{0, 1, 0}),	// Up
-			GetBlock(worldPosition + glm::ivec3{0, 0, -1}), // North
-			GetBlock(worldPosition + glm::ivec3{0, 0, 1}),	// South
-			GetBlock(worldPosition + glm::ivec3{-1, 0, 0}), // West
-			GetBlock(worldPosition + glm::ivec3{1, 0, 0}),	// East
+	size_t WorldManager::ProcessBlockUpdates(size_t budget)
+	{
+		const std::vector<glm::ivec3> positions = m_BlockUpdateQueue.TakeDue(budget);
+
+		// Updates scheduled by the ones below (through SetBlock) wait for the next call
+		m_BlockUpdateQueue.AdvanceTick();
+
+		static const std::array<glm::ivec3, 6> kOffsets = {
+			glm::ivec3{0, -1, 0},
+			glm::ivec3{0, 1, 0},
+			glm::ivec3{0, 0, -1},
+			glm::ivec3{0, 0, 1},
+			glm::ivec3{-1, 0, 0},
+			glm::ivec3{1, 0, 0},
 		};
 
-		BlockUpdater::Update(target, neighbors, worldPosition, *this);
+		// Reads go through the last chunk used, updates are spatially coherent
+		std::shared_ptr<Chunk> cachedChunk;
+		glm::ivec2 cachedChunkPos{};
+		auto getBlock = [this, &cachedChunk, &cachedChunkPos](const glm::ivec3& worldPosition)
+		{
+			const glm::ivec2 chunkPos = Utils::WorldToChunkPosition(worldPosition);
+			if (!cachedChunk || chunkPos != cachedChunkPos)
+			{
+				cachedChunk = GetChunk(chunkPos);
+				cachedChunkPos = chunkPos;
+			}
+
+			if (!cachedChunk)
+				return BlockState(BlockId::Air);
+
+			return cachedChunk->GetBlock(Utils::WorldToLocalPosition(worldPosition));
+		};
 
-		if (propagateToNeighbors)
+		for (const glm::ivec3& position : positions)
 		{
-			static const std::array<glm::ivec3, 6> kOffsets = {
-				glm::ivec3{0, -1, 0},
-				glm::ivec3{0, 1, 0},
-				glm::ivec3{0, 0, -1},
-				glm::ivec3{0, 0, 1},
-				glm::ivec3{-1, 0, 0},
-				glm::ivec3{1, 0, 0},
-			};
+			const BlockState target = getBlock(position);
+			if (!BlockUpdater::MayUpdate(target.ID))
+				continue;
 
-			for (const auto& offset : kOffsets)
-				UpdateBlock(worldPosition + offset, false);
+			std::array<BlockState, 6> neighbors;
+			for (size_t i = 0; i < kOffsets.size(); i++)
+			{
+				neighbors[i] = getBlock(position + kOffsets[i]);
+			}
+
+			BlockUpdater::Update(target, neighbors, position, *this);
 		}
+
+		return positions.size();
+	}
+
+	size_t WorldManager::GetPendingBlockUpdateCount() const
+	{
+		return m_BlockUpdateQueue.GetPendingCount();
+	}
+
+	size_t WorldManager::GetLoadedChunkCount() const
+	{
+		std::shared_lock lock(m_MutexChunks);
+		return m_Chunks.size();
+	}
+
+	size_t WorldManager::GetPendingGenerationCount() const
+	{
+		return m_WorldGenerator ? m_WorldGenerator->GetPendingChunkCount() : 0;
+	}
+
+	size_t WorldManager::GetPendingChunkSaveCount() const
+	{
+		return m_WorldSave ? m_WorldSave->GetPendingChunkSaveCount() : 0;
 	}
 
-	void WorldManager::RemoveDistantChunks()
+	void WorldManager::ScheduleBlockUpdates(const std::vector<Block>& changedBlocks)
 	{
-		auto playersPosition = GetPlayersPosition();
+		if (changedBlocks.empty())
+			return;
+
+		static const std::array<glm::ivec3, 6> kOffsets = {
+			glm::ivec3{0, -1, 0},
+			glm::ivec3{0, 1, 0},
+			glm::ivec3{0, 0, -1},
+			glm::ivec3{0, 0, 1},
+			glm::ivec3{-1, 0, 0},
+			glm::ivec3{1, 0, 0},
+		};
+
+		// The queue deduplicates : neighbors shared by adjacent edits are updated once
+		std::vector<glm::ivec3> positions;
+		positions.reserve(changedBlocks.size() * (kOffsets.size() + 1));
 
-		// Initialize all chunks as not to be kept
-		std::unordered_map<glm::ivec2, bool> chunksToKeep;
+		for (const Block& block : changedBlocks)
 		{
-			std::shared_lock lock(m_MutexChunks);
-			for (const auto& [chunkPos, chunk] : m_Chunks)
+			positions.push_back(block.Position);
+			for (const auto& offset : kOffsets)
 			{
-				chunksToKeep[chunkPos] = false;
+				positions.push_back(block.Position + offset);
 			}
 		}
 
-		// Mark chunks that are within the persistance distance of any player to be kept
-		int persistanceDistance = GetChunkPersistanceDistance();
+		m_BlockUpdateQueue.Schedule(positions);
+	}
 
-		for (const auto& [clientHandle, playerPos] : playersPosition)
+	void WorldManager::UpdateChunkTickets()
+	{
+		UpdateChunkTickets({});
+	}
+
+	void WorldManager::UpdateChunkTickets(const std::vector<glm::ivec2>& enteredLoadingArea)
+	{
+		// Players moved by the client physics are not reported to the entity manager
+		m_EntityManager->RefreshAllPlayerChunks();
+
+		const EntityManager::InterestChanges changes = m_EntityManager->TakeInterestChanges();
+
+		// Chunks that got their first ticket, or that came within the loading distance of a player, are loaded
+		std::vector<glm::ivec2> chunksToLoad;
+		std::unordered_set<glm::ivec2> visited;
+		auto visit = [&](const glm::ivec2& chunkPos)
 		{
-			glm::ivec2 playerChunkPos = Utils::WorldToChunkPosition(playerPos);
+			if (!visited.insert(chunkPos).second)
+				return;
 
-			for (int x = -persistanceDistance; x <= persistanceDistance; x++)
+			if (m_EntityManager->IsInInterestArea(chunkPos) && !IsChunkLoaded(chunkPos) && IsInLoadingArea(chunkPos))
 			{
-				for (int y = -persistanceDistance; y <= persistanceDistance; y++)
-				{
-					glm::ivec2 chunkPos = playerChunkPos + glm::ivec2(x, y);
-					chunksToKeep[chunkPos] = true; // Mark chunk as to be kept
-				}
+				chunksToLoad.push_back(chunkPos);
+			}
+		};
+
+		for (const glm::ivec2& chunkPos : changes.Entered)
+		{
+			visit(chunkPos);
+		}
+		for (const glm::ivec2& chunkPos : enteredLoadingArea)
+		{
+			visit(chunkPos);
+		}
+
+		// Chunks that lost their last ticket are unloaded once the delay is over, unless a ticket came back
+		for (const glm::ivec2& chunkPos : changes.Left)
+		{
+			if (!m_EntityManager->IsInInterestArea(chunkPos))
+			{
+				ScheduleUnload(chunkPos);
 			}
 		}
 
-		// Collect chunks that are not to be kept for removal
 		std::vector<glm::ivec2> chunksToRemove;
-		for (const auto& [chunkPos, keep] : chunksToKeep)
 		{
-			if (!keep)
+			std::lock_guard lock(m_MutexChunkTickets);
+
+			const auto now = std::chrono::steady_clock::now();
+			while (!m_PendingUnloads.empty() && m_PendingUnloads.front().Deadline <= now)
 			{
-				chunksToRemove.push_back(chunkPos); // Mark chunk for removal if it is not to be kept
+				const PendingUnload pendingUnload = m_PendingUnloads.front();
+				m_PendingUnloads.pop_front();
+
+				auto it = m_UnloadDeadlines.find(pendingUnload.ChunkPosition);
+				if (it == m_UnloadDeadlines.end() || it->second != pendingUnload.Deadline)
+					continue; // Rescheduled later
+
+				m_UnloadDeadlines.erase(it);
+
+				if (!m_EntityManager->IsInInterestArea(pendingUnload.ChunkPosition))
+				{
+					chunksToRemove.push_back(pendingUnload.ChunkPosition);
+				}
 			}
 		}
 
-		// Remove chunks that are not to be kept
 		for (const auto& chunkPos : chunksToRemove)
 		{
 			RemoveChunk(chunkPos);
 		}
+
+		if (!chunksToLoad.empty())
+		{
+			RequestMissingChunksAsync(chunksToLoad);
+		}
+	}
+
+	void WorldManager::ScheduleUnload(const glm::ivec2& chunkPosition)
+	{
+		std::lock_guard lock(m_MutexChunkTickets);
+
+		const auto deadline = std::chrono::steady_clock::now() + CHUNK_UNLOAD_DELAY;
+		m_UnloadDeadlines[chunkPosition] = deadline;
+		m_PendingUnloads.push_back({chunkPosition, deadline});
+	}
+
+	std::vector<glm::ivec2> WorldManager::GetChunksEnteringLoadingArea(const PlayerChangedChunkEventArgs& args) const
+	{
+		const int loadingDistance = std::min(GetChunkPersistanceDistance(), m_ChunkLoadingDistance.load());
+
+		std::vector<glm::ivec2> chunks;
+		for (int x = -loadingDistance; x <= loadingDistance; x++)
+		{
+			for (int y = -loadingDistance; y <= loadingDistance; y++)
+			{
+				const glm::ivec2 chunkPos = args.NewChunkPosition + glm::ivec2(x, y);
+				const bool wasInLoadingArea = std::abs(chunkPos.x - args.OldChunkPosition.x) <= loadingDistance &&
+					std::abs(chunkPos.y - args.OldChunkPosition.y) <= loadingDistance;
+
+				if (!wasInLoadingArea)
+				{
+					chunks.push_back(chunkPos);
+				}
+			}
+		}
+
+		return chunks;
+	}
+
+	bool WorldManager::IsInLoadingArea(const glm::ivec2& chunkPosition) const
+	{
+		const int loadingDistance = std::min(GetChunkPersistanceDistance(), m_ChunkLoadingDistance.load());
+
+		// In SinglePlayer, only the single player loads chunks (see RequestAllMissingChunks)
+		const std::string singleplayerUUID = GetSingleplayerPlayerUUID();
+		if (!singleplayerUUID.empty())
+		{
+			auto player = GetPlayer(singleplayerUUID);
+			if (!player)
+				return false;
+
+			const glm::ivec2 playerChunkPos = Utils::WorldToChunkPosition(player->GetPosition());
+			return std::abs(chunkPosition.x - playerChunkPos.x) <= loadingDistance &&
+				std::abs(chunkPosition.y - playerChunkPos.y) <= loadingDistance;
+		}
+
+		return !m_EntityManager->GetPlayersNearChunk(chunkPosition, loadingDistance).empty();
 	}
 } // namespace onion::voxel
@@ -4,8 +4,11 @@
 #include <glm/glm.hpp>
 #include <glm/gtx/hash.hpp>
 
+#include <chrono>
+#include <deque>
 #include <filesystem>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <unordered_map>
 
@@ -13,6 +16,7 @@
 #include <onion/Timer.hpp>
 
 #include <shared/entities/entity_manager/EntityManager.hpp>
+#include <shared/world/block/BlockUpdateQueue.hpp>
 #include <shared/world/block/BlockstateRegistry.hpp>
 #include <shared/world/chunk/Chunk.hpp>
 #include <shared/world/world_generator/WorldGenerator.hpp>
@@ -57,7 +61,9 @@ namespace onion::voxel
 		void AddChunk(const std::shared_ptr<Chunk> chunk, const std::vector<Block>& outOfBoundsBlocks);
 		void RemoveChunk(const glm::ivec2& chunkPosition);
 
-		void RemoveDistantChunks();
+		/// @brief Load the chunks that got their first player ticket, unload the ones without tickets since
+		/// CHUNK_UNLOAD_DELAY. Only the ticket changes since the last call are visited : cheap enough for every frame.
+		void UpdateChunkTickets();
 		void RemoveAllChunks();
 
 		void ClearWorld();
@@ -80,7 +86,21 @@ namespace onion::voxel
 
 		void RequestAllMissingChunks();
 
-		void UpdateBlock(const glm::ivec3& worldPosition, bool propagateToNeighbors);
+		/// @brief Schedule an update of the block, delay calls of ProcessBlockUpdates from now.
+		/// Changed blocks and their neighbors are scheduled by SetBlocks.
+		void ScheduleBlockUpdate(const glm::ivec3& worldPosition, uint32_t delay = 0);
+
+		/// @brief Run the block updates due, at most budget of them, the others wait for the next call.
+		/// Called once per tick. Updates scheduled while running are due at the next call at the earliest.
+		/// @return The number of block updates run
+		size_t ProcessBlockUpdates(size_t budget);
+		size_t GetPendingBlockUpdateCount() const;
+
+		size_t GetLoadedChunkCount() const;
+		/// @brief Chunks requested to the generator and not generated yet.
+		size_t GetPendingGenerationCount() const;
+		/// @brief Chunks waiting to be written by the world save.
+		size_t GetPendingChunkSaveCount() const;
 
 		// ----- Getters / Setters -----
 	  public:
@@ -88,6 +108,8 @@ namespace onion::voxel
 		void SetSeed(uint32_t seed);
 
 		std::unordered_map<std::string, glm::vec3> GetPlayersPosition() const;
+		/// @brief Get the UUIDs of the players within distance chunks of the chunk (entity manager spatial index).
+		std::vector<std::string> GetPlayersNearChunk(const glm::ivec2& chunkPosition, int distance) const;
 
 		std::shared_ptr<Player> GetPlayer(const std::string& uuid) const;
 
@@ -105,6 +127,7 @@ namespace onion::voxel
 
 		std::vector<std::shared_ptr<Entity>> GetAllEntities() const;
 		std::unordered_map<std::string, std::shared_ptr<Player>> GetAllPlayers() const;
+		std::shared_ptr<EntityStore> GetEntityStore() const;
 
 		void SetSingleplayerPlayerUUID(const std::string& playerUUID);
 		std::string GetSingleplayerPlayerUUID() const;
@@ -153,10 +176,43 @@ namespace onion::voxel
 		mutable std::shared_mutex m_MutexSingleplayer;
 		std::string m_SingleplayerPlayerUUID;
 
+		// ----- Chunk Tickets -----
+	  private:
+		// Hysteresis : a chunk without tickets is kept this long, so walking back and forth over a border does not
+		// reload the same chunks
+		static constexpr std::chrono::seconds CHUNK_UNLOAD_DELAY{3};
+
+		struct PendingUnload
+		{
+			glm::ivec2 ChunkPosition{};
+			std::chrono::steady_clock::time_point Deadline;
+		};
+
+		std::mutex m_MutexChunkTickets;
+		// Ordered by deadline, since the delay is constant
+		std::deque<PendingUnload> m_PendingUnloads;
+		// Latest deadline of each chunk, older entries of the queue are stale
+		std::unordered_map<glm::ivec2, std::chrono::steady_clock::time_point> m_UnloadDeadlines;
+
+		void ScheduleUnload(const glm::ivec2& chunkPosition);
+		bool IsInLoadingArea(const glm::ivec2& chunkPosition) const;
+
+		/// @brief Chunks of the loading square around the new chunk that were not in the square around the old one.
+		/// When the persistence distance is the larger, they already hold a ticket and are never in the interest
+		/// changes : without this they would wait for the missing chunks timer.
+		std::vector<glm::ivec2> GetChunksEnteringLoadingArea(const PlayerChangedChunkEventArgs& args) const;
+		/// @brief UpdateChunkTickets, also loading the given chunks if they are still missing and in the loading area.
+		void UpdateChunkTickets(const std::vector<glm::ivec2>& enteredLoadingArea);
+
 		// ----- Private Methods -----
 	  private:
 		void RequestMissingChunksAsync(const std::vector<glm::ivec2>& chunkPositions);
 
+		/// @brief Schedule the updates of the changed blocks and of their neighbors.
+		void ScheduleBlockUpdates(const std::vector<Block>& changedBlocks);
+
+		BlockUpdateQueue m_BlockUpdateQueue;
+
 		// ----- Periodic Tasks -----
 	  private:
 		void PlaceOutOfBoundsBlocks();
@@ -6,6 +6,7 @@
 
 #include <nlohmann/json.hpp>
 
+#include <shared/profiler/Profiler.hpp>
 #include <shared/utils/Utils.hpp>
 
 #include <shared/data_transfer_objects/serializer/SerializerDTO.hpp>
@@ -90,8 +91,16 @@ namespace onion::voxel
 		m_ChunksToSave[chunk->GetPosition()] = chunk;
 	}
 
+	size_t WorldSave::GetPendingChunkSaveCount() const
+	{
+		std::lock_guard lock(m_MutexChunksToSave);
+		return m_ChunksToSave.size();
+	}
+
 	std::shared_ptr<Chunk> WorldSave::LoadChunk(const glm::ivec2& chunkPosition)
 	{
+		ONION_PROFILE_ZONE("WorldSave::LoadChunk");
+
 		// First check if the chunk is in the chunks to save map.
 		{
 			std::lock_guard lock(m_MutexChunksToSave);
@@ -129,6 +138,8 @@ namespace onion::voxel
 		if (chunkData.empty())
 			return nullptr;
 
+		ONION_PROFILE_COUNT("WorldSave::ChunkBytesRead", chunkData.size());
+
 		// Create a stream from the raw buffer
 		std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
 		ss.write(reinterpret_cast<const char*>(chunkData.data()), chunkData.size());
@@ -291,6 +302,8 @@ namespace onion::voxel
 
 	void WorldSave::SaveChunks()
 	{
+		ONION_PROFILE_ZONE("WorldSave::SaveChunks");
+
 		std::unordered_map<glm::ivec2, std::shared_ptr<Chunk>> chunksToSaveCopy;
 		{
 			std::lock_guard lock(m_MutexChunksToSave);
@@ -315,9 +328,13 @@ namespace onion::voxel
 		}
 
 		{
+			ONION_PROFILE_ZONE("WorldSave::WriteChunks");
+
 			std::lock_guard lock(m_MutexDiskAccess);
 			for (const auto& [chunkFilePath, chunkData] : chunksDataToWrite)
 			{
+				ONION_PROFILE_COUNT("WorldSave::ChunkBytesWritten", chunkData.size());
+
 				std::filesystem::create_directories(chunkFilePath.parent_path());
 
 				std::filesystem::path tempFilePath = chunkFilePath;
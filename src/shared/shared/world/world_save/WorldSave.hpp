@@ -30,6 +30,8 @@ namespace onion::voxel
 		static bool DeleteWorld(const WorldInfos& infos);
 
 		void SaveChunkAsync(const std::shared_ptr<Chunk>& chunk);
+		/// @brief Chunks waiting for the next periodic save.
+		size_t GetPendingChunkSaveCount() const;
 		std::shared_ptr<Chunk> LoadChunk(const glm::ivec2& chunkPosition);
 
 		void SavePlayersAsync(const std::unordered_map<std::string, std::shared_ptr<Player>>& players);
@@ -3,84 +3,218 @@
 #include <cstring>
 #include <stdexcept>
 
+#include "miniz.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace onion::voxel
 {
+	namespace
+	{
+		constexpr uint32_t LOCAL_HEADER_SIGNATURE = 0x04034b50;
+		constexpr size_t LOCAL_HEADER_SIZE = 30;
+		constexpr uint16_t METHOD_STORED = 0;
+		constexpr uint16_t METHOD_DEFLATE = 8;
+
+		uint16_t ReadU16(const unsigned char* p)
+		{
+			return static_cast<uint16_t>(p[0] | (p[1] << 8));
+		}
+
+		uint32_t ReadU32(const unsigned char* p)
+		{
+			return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+				(static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+		}
+	} // namespace
+
+	// ------------ Mapped File ------------
 
-	ZipArchive::ZipArchive(const std::filesystem::path& filePath)
+	ZipArchive::MappedFile::MappedFile(const std::filesystem::path& filePath)
 	{
-		memset(&m_Zip, 0, sizeof(m_Zip));
+#ifdef _WIN32
+		HANDLE file = CreateFileW(filePath.wstring().c_str(),
+								  GENERIC_READ,
+								  FILE_SHARE_READ,
+								  nullptr,
+								  OPEN_EXISTING,
+								  FILE_ATTRIBUTE_NORMAL,
+								  nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			throw std::runtime_error("Failed to open zip archive: " + filePath.string());
 
-		if (!mz_zip_reader_init_file(&m_Zip, filePath.string().c_str(), 0))
+		LARGE_INTEGER size{};
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
 		{
+			CloseHandle(file);
 			throw std::runtime_error("Failed to open zip archive: " + filePath.string());
 		}
 
-		m_IsOpen = true;
-	}
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+		if (!mapping)
+			throw std::runtime_error("Failed to map zip archive: " + filePath.string());
+
+		// The view keeps the mapping alive
+		void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(mapping);
+		if (!view)
+			throw std::runtime_error("Failed to map zip archive: " + filePath.string());
+
+		m_Data = static_cast<const unsigned char*>(view);
+		m_Size = static_cast<size_t>(size.QuadPart);
+#else
+		const int fd = open(filePath.c_str(), O_RDONLY);
+		if (fd < 0)
+			throw std::runtime_error("Failed to open zip archive: " + filePath.string());
 
-	ZipArchive::~ZipArchive()
-	{
-		if (m_IsOpen)
+		struct stat fileStat{};
+		if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
 		{
-			mz_zip_reader_end(&m_Zip);
+			close(fd);
+			throw std::runtime_error("Failed to open zip archive: " + filePath.string());
 		}
+
+		// The mapping stays valid once the descriptor is closed
+		void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if (view == MAP_FAILED)
+			throw std::runtime_error("Failed to map zip archive: " + filePath.string());
+
+		m_Data = static_cast<const unsigned char*>(view);
+		m_Size = static_cast<size_t>(fileStat.st_size);
+#endif
 	}
 
-	ZipArchive::ZipArchive(ZipArchive&& other) noexcept
+	ZipArchive::MappedFile::~MappedFile()
 	{
-		m_Zip = other.m_Zip;
-		m_IsOpen = other.m_IsOpen;
+		Unmap();
+	}
 
-		other.m_IsOpen = false;
+	ZipArchive::MappedFile::MappedFile(MappedFile&& other) noexcept : m_Data(other.m_Data), m_Size(other.m_Size)
+	{
+		other.m_Data = nullptr;
+		other.m_Size = 0;
 	}
 
-	ZipArchive& ZipArchive::operator=(ZipArchive&& other) noexcept
+	ZipArchive::MappedFile& ZipArchive::MappedFile::operator=(MappedFile&& other) noexcept
 	{
 		if (this != &other)
 		{
-			if (m_IsOpen)
-				mz_zip_reader_end(&m_Zip);
+			Unmap();
 
-			m_Zip = other.m_Zip;
-			m_IsOpen = other.m_IsOpen;
+			m_Data = other.m_Data;
+			m_Size = other.m_Size;
 
-			other.m_IsOpen = false;
+			other.m_Data = nullptr;
+			other.m_Size = 0;
 		}
 
 		return *this;
 	}
 
-	bool ZipArchive::FileExists(const std::filesystem::path& filePath) const
+	void ZipArchive::MappedFile::Unmap()
 	{
-		return mz_zip_reader_locate_file(&m_Zip, filePath.generic_string().c_str(), nullptr, 0) >= 0;
+		if (!m_Data)
+			return;
+
+#ifdef _WIN32
+		UnmapViewOfFile(m_Data);
+#else
+		munmap(const_cast<unsigned char*>(m_Data), m_Size);
+#endif
+
+		m_Data = nullptr;
+		m_Size = 0;
 	}
 
-	std::vector<std::filesystem::path> ZipArchive::GetFileList(const std::filesystem::path& directory) const
+	// ------------ Zip Archive ------------
+
+	ZipArchive::ZipArchive(const std::filesystem::path& filePath) : m_File(filePath)
 	{
-		std::vector<std::filesystem::path> files;
+		// miniz only reads the central directory, extraction does not go through it
+		mz_zip_archive zip;
+		memset(&zip, 0, sizeof(zip));
 
-		mz_uint fileCount = mz_zip_reader_get_num_files(&m_Zip);
+		if (!mz_zip_reader_init_mem(&zip, m_File.GetData(), m_File.GetSize(), 0))
+		{
+			throw std::runtime_error("Failed to open zip archive: " + filePath.string());
+		}
 
-		std::string dir = directory.generic_string();
-		if (!dir.empty() && dir.back() != '/')
-			dir += '/';
+		const mz_uint fileCount = mz_zip_reader_get_num_files(&zip);
+		m_Entries.reserve(fileCount);
+		m_Index.reserve(fileCount);
 
 		for (mz_uint i = 0; i < fileCount; i++)
 		{
 			mz_zip_archive_file_stat stat;
+			if (!mz_zip_reader_file_stat(&zip, i, &stat))
+				continue;
+
+			// Locate the data : the local header's name and extra field lengths may differ from the central ones
+			const uint64_t headerOffset = stat.m_local_header_ofs;
+			if (headerOffset + LOCAL_HEADER_SIZE > m_File.GetSize())
+				continue;
 
-			if (!mz_zip_reader_file_stat(&m_Zip, i, &stat))
+			const unsigned char* header = m_File.GetData() + headerOffset;
+			if (ReadU32(header) != LOCAL_HEADER_SIGNATURE)
 				continue;
 
-			std::string name = stat.m_filename;
+			Entry entry;
+			entry.Name = stat.m_filename;
+			entry.DataOffset = headerOffset + LOCAL_HEADER_SIZE + ReadU16(header + 26) + ReadU16(header + 28);
+			entry.CompressedSize = stat.m_comp_size;
+			entry.UncompressedSize = stat.m_uncomp_size;
+			entry.Crc32 = stat.m_crc32;
+			entry.Method = static_cast<uint16_t>(stat.m_method);
+
+			if (entry.DataOffset + entry.CompressedSize > m_File.GetSize())
+				continue;
+
+			m_Index.try_emplace(entry.Name, m_Entries.size());
+			m_Entries.push_back(std::move(entry));
+		}
+
+		mz_zip_reader_end(&zip);
+	}
+
+	ZipArchive::~ZipArchive() = default;
+
+	ZipArchive::ZipArchive(ZipArchive&&) noexcept = default;
+
+	ZipArchive& ZipArchive::operator=(ZipArchive&&) noexcept = default;
+
+	bool ZipArchive::FileExists(const std::filesystem::path& filePath) const
+	{
+		return FindEntry(filePath) != nullptr;
+	}
 
+	std::vector<std::filesystem::path> ZipArchive::GetFileList(const std::filesystem::path& directory) const
+	{
+		std::vector<std::filesystem::path> files;
+
+		std::string dir = directory.generic_string();
+		if (!dir.empty() && dir.back() != '/')
+			dir += '/';
+
+		for (const Entry& entry : m_Entries)
+		{
 			if (!dir.empty())
 			{
-				if (name.rfind(dir, 0) != 0)
+				if (entry.Name.rfind(dir, 0) != 0)
 					continue;
 			}
 
-			files.emplace_back(name);
+			files.emplace_back(entry.Name);
 		}
 
 		return files;
@@ -88,35 +222,97 @@ namespace onion::voxel
 
 	std::string ZipArchive::GetFileText(const std::filesystem::path& filePath) const
 	{
-		size_t size = 0;
+		const Entry* entry = FindEntry(filePath);
+		if (!entry)
+			return {};
 
-		void* data = mz_zip_reader_extract_file_to_heap(&m_Zip, filePath.generic_string().c_str(), &size, 0);
+		std::string result(static_cast<size_t>(entry->UncompressedSize), '\0');
+		try
+		{
+			Extract(*entry, reinterpret_cast<unsigned char*>(result.data()));
+		}
+		catch (const std::runtime_error&)
+		{
+			return {};
+		}
+
+		return result;
+	}
 
-		if (!data)
+	std::vector<unsigned char> ZipArchive::GetFileBinary(const std::filesystem::path& filePath) const
+	{
+		const Entry* entry = FindEntry(filePath);
+		if (!entry)
 			return {};
 
-		std::string result(static_cast<char*>(data), size);
+		std::vector<unsigned char> buffer(static_cast<size_t>(entry->UncompressedSize));
+		try
+		{
+			Extract(*entry, buffer.data());
+		}
+		catch (const std::runtime_error&)
+		{
+			return {};
+		}
 
-		mz_free(data);
+		return buffer;
+	}
 
-		return result;
+	std::optional<ZipArchive::FileInfo> ZipArchive::GetFileInfo(const std::filesystem::path& filePath) const
+	{
+		const Entry* entry = FindEntry(filePath);
+		if (!entry)
+			return std::nullopt;
+
+		return FileInfo{entry->Crc32, entry->UncompressedSize};
 	}
 
-	std::vector<unsigned char> ZipArchive::GetFileBinary(const std::filesystem::path& filePath) const
+	std::optional<std::span<const unsigned char>> ZipArchive::GetFileView(const std::filesystem::path& filePath) const
 	{
-		size_t size = 0;
+		const Entry* entry = FindEntry(filePath);
+		if (!entry || entry->Method != METHOD_STORED)
+			return std::nullopt;
 
-		void* data = mz_zip_reader_extract_file_to_heap(&m_Zip, filePath.generic_string().c_str(), &size, 0);
+		return std::span<const unsigned char>(m_File.GetData() + entry->DataOffset,
+											  static_cast<size_t>(entry->UncompressedSize));
+	}
 
-		if (!data)
-			return {};
+	const ZipArchive::Entry* ZipArchive::FindEntry(const std::filesystem::path& filePath) const
+	{
+		auto it = m_Index.find(filePath.generic_string());
+		if (it == m_Index.end())
+			return nullptr;
 
-		std::vector<unsigned char> buffer(size);
-		std::memcpy(buffer.data(), data, size);
+		return &m_Entries[it->second];
+	}
 
-		mz_free(data);
+	void ZipArchive::Extract(const Entry& entry, unsigned char* out) const
+	{
+		const unsigned char* data = m_File.GetData() + entry.DataOffset;
+		const size_t size = static_cast<size_t>(entry.UncompressedSize);
 
-		return buffer;
+		if (entry.Method == METHOD_STORED)
+		{
+			if (entry.CompressedSize != entry.UncompressedSize)
+				throw std::runtime_error("Corrupted zip entry: " + entry.Name);
+
+			std::memcpy(out, data, size);
+		}
+		else if (entry.Method == METHOD_DEFLATE)
+		{
+			// Raw deflate stream, no zlib header. Stateless : safe from any thread.
+			const size_t inflated =
+				tinfl_decompress_mem_to_mem(out, size, data, static_cast<size_t>(entry.CompressedSize), 0);
+			if (inflated == TINFL_DECOMPRESS_MEM_TO_MEM_FAILED || inflated != size)
+				throw std::runtime_error("Corrupted zip entry: " + entry.Name);
+		}
+		else
+		{
+			throw std::runtime_error("Unsupported zip compression method for entry: " + entry.Name);
+		}
+
+		if (mz_crc32(MZ_CRC32_INIT, out, size) != entry.Crc32)
+			throw std::runtime_error("Corrupted zip entry: " + entry.Name);
 	}
 
 } // namespace onion::voxel
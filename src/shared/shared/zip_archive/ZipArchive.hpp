@@ -1,13 +1,19 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
+#include <optional>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
-#include "miniz.h"
-
 namespace onion::voxel
 {
+	/// @brief Read-only zip archive, memory-mapped.
+	/// The central directory is indexed once when opening, entries are then found with a hash lookup and inflated
+	/// straight from the mapping. Nothing is modified after construction : every method can be called from any
+	/// number of threads at once.
 	class ZipArchive
 	{
 		// ------------ Constructor / Destructor ------------
@@ -23,6 +29,13 @@ namespace onion::voxel
 
 		// ------------ Public API ------------
 	  public:
+		/// @brief Identifies the content of an entry without reading it : equal infos mean (almost surely) equal bytes.
+		struct FileInfo
+		{
+			uint32_t Crc32 = 0;
+			uint64_t Size = 0; // Uncompressed
+		};
+
 		std::vector<std::filesystem::path> GetFileList(const std::filesystem::path& directory = "") const;
 
 		bool FileExists(const std::filesystem::path& filePath) const;
@@ -31,10 +44,59 @@ namespace onion::voxel
 
 		std::vector<unsigned char> GetFileBinary(const std::filesystem::path& filePath) const;
 
+		std::optional<FileInfo> GetFileInfo(const std::filesystem::path& filePath) const;
+
+		/// @brief View of a stored (uncompressed) entry, directly in the mapped archive. No copy.
+		/// Returns nothing if the entry does not exist or is compressed. Valid as long as the archive.
+		std::optional<std::span<const unsigned char>> GetFileView(const std::filesystem::path& filePath) const;
+
+		// ------------ Private Structs ------------
+	  private:
+		struct Entry
+		{
+			std::string Name;
+			uint64_t DataOffset = 0; // Offset of the (compressed) data in the archive
+			uint64_t CompressedSize = 0;
+			uint64_t UncompressedSize = 0;
+			uint32_t Crc32 = 0;
+			uint16_t Method = 0; // 0 = stored, 8 = deflate
+		};
+
+		/// @brief Read-only mapping of a whole file.
+		class MappedFile
+		{
+		  public:
+			MappedFile() = default;
+			explicit MappedFile(const std::filesystem::path& filePath);
+			~MappedFile();
+
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			MappedFile(MappedFile&& other) noexcept;
+			MappedFile& operator=(MappedFile&& other) noexcept;
+
+			const unsigned char* GetData() const { return m_Data; }
+			size_t GetSize() const { return m_Size; }
+
+		  private:
+			const unsigned char* m_Data = nullptr;
+			size_t m_Size = 0;
+
+			void Unmap();
+		};
+
 		// ------------ Private Members ------------
 	  private:
-		mutable mz_zip_archive m_Zip{};
-		bool m_IsOpen = false;
+		MappedFile m_File;
+
+		std::vector<Entry> m_Entries;					 // Central directory order
+		std::unordered_map<std::string, size_t> m_Index; // Name -> index in m_Entries
+
+		const Entry* FindEntry(const std::filesystem::path& filePath) const;
+
+		/// @brief Inflate (or copy) the entry into out, which must be UncompressedSize bytes long.
+		void Extract(const Entry& entry, unsigned char* out) const;
 	};
 
 } // namespace onion::voxel